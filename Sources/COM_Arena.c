@@ -0,0 +1,399 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Arena.c
+ * \brief   File to handle the frame arena.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "COM_Log.h"
+#include "COM_Util.h"
+#include "COM_Arena.h"
+
+/* ========================================================================= */
+
+/*! Minimum size of a block allocated on the side (In bytes). */
+#define COM_ARENA_CHUNK_SIZE 4096
+
+/*!
+ * \struct COM_ArenaChunk
+ * \brief  Structure to handle a block allocated on the side (Data after it).
+ */
+typedef struct COM_ArenaChunk
+{
+    struct COM_ArenaChunk *pNext;     /*!< Previous block. */
+    size_t                 iCapacity; /*!< Size of the data (In bytes). */
+    size_t                 iUsed;     /*!< Bytes used in the data. */
+    size_t                 iPadding;  /*!< Unused (Size of the header multiple of 16 bytes). */
+} COM_ArenaChunk;
+
+/*!
+ * \struct COM_ArenaSide
+ * \brief  Structure to handle a buffer of the arena.
+ */
+typedef struct
+{
+    unsigned char  *pBuffer;     /*!< Buffer. */
+    size_t          iCapacity;   /*!< Size of the buffer (In bytes). */
+    size_t          iUsed;       /*!< Bytes used in the buffer. */
+    COM_ArenaChunk *pChunks;     /*!< Blocks allocated on the side (Last first). */
+    size_t          iTotal;      /*!< Bytes used in the frame (Buffer and blocks). */
+    size_t          iPeak;       /*!< Highest number of bytes used in the frame. */
+    int             bOverflowed; /*!< Flag set if a block was allocated on the side in the frame. */
+} COM_ArenaSide;
+
+/*!
+ * \struct COM_Arena
+ * \brief  Structure to handle the frame arena.
+ */
+typedef struct
+{
+    COM_ArenaSide  arrSides[2];   /*!< Buffers of the arena (Only the first without double buffering). */
+    int            iCurrent;      /*!< Buffer of the current frame. */
+    int            bDoubleBuffer; /*!< Flag set to keep the memory of a frame until the end of the next one. */
+    COM_ArenaStats sStats;        /*!< Statistics of the arena. */
+} COM_Arena;
+
+/*! Global variable to handle the frame arena. */
+static COM_Arena COM_arena;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to move the pointer of a buffer.
+ *
+ * \param  pBase     Buffer (Can be NULL).
+ * \param  iCapacity Size of the buffer.
+ * \param  pUsed     Pointer to the bytes used in the buffer.
+ * \param  iSize     Size of the allocation.
+ * \param  iAlign    Alignment of the allocation (Power of two).
+ * \return The allocation, or NULL if the buffer is full.
+ */
+static void *COM_Arena_Bump(unsigned char *pBase, size_t iCapacity, size_t *pUsed, size_t iSize, size_t iAlign)
+{
+    size_t iStart = 0;
+
+    if (!pBase)
+    {
+        return NULL;
+    }
+
+    iStart = ((((size_t) pBase + *pUsed) + iAlign - 1) & ~(iAlign - 1)) - (size_t) pBase;
+
+    if ((iStart > iCapacity) || (iSize > iCapacity - iStart))
+    {
+        return NULL;
+    }
+
+    *pUsed = iStart + iSize;
+
+    return pBase + iStart;
+}
+
+/*!
+ * \brief  Function to free the blocks allocated on the side.
+ *
+ * \param  pSide  Buffer of the blocks.
+ * \param  pStop  First block to keep (NULL => All freed).
+ * \return None.
+ */
+static void COM_Arena_FreeChunks(COM_ArenaSide *pSide, void *pStop)
+{
+    COM_ArenaChunk *pChunk = NULL;
+
+    while (pSide->pChunks && (pSide->pChunks != pStop))
+    {
+        pChunk         = pSide->pChunks;
+        pSide->pChunks = pChunk->pNext;
+
+        UTIL_Free(pChunk);
+    }
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to initialize the frame arena.
+ *
+ * \param  iCapacity     Size of a buffer (0 => COM_ARENA_DEFAULT_SIZE).
+ * \param  bDoubleBuffer Flag set to keep the memory of a frame until the end of the next one.
+ * \return None.
+ *
+ * \remark The arena still works if a buffer can't be allocated (Blocks on the side).
+ */
+void COM_Arena_Init(size_t iCapacity, int bDoubleBuffer)
+{
+    COM_ArenaSide *pSide = NULL;
+    int            i     = 0;
+
+    COM_Arena_Quit( );
+
+    COM_arena.bDoubleBuffer = bDoubleBuffer;
+
+    for (i = 0; i < (bDoubleBuffer ? 2 : 1); i++)
+    {
+        pSide            = &COM_arena.arrSides[i];
+        pSide->pBuffer   = (unsigned char *) UTIL_Malloc(iCapacity ? iCapacity : COM_ARENA_DEFAULT_SIZE);
+        pSide->iCapacity = pSide->pBuffer ? (iCapacity ? iCapacity : COM_ARENA_DEFAULT_SIZE) : 0;
+    }
+}
+
+/*!
+ * \brief  Function to allocate memory for the current frame.
+ *
+ * \param  iSize Size of the allocation.
+ * \return The allocation (Aligned on COM_ARENA_ALIGN), or NULL if error.
+ */
+void *COM_Arena_Alloc(size_t iSize)
+{
+    return COM_Arena_AllocAligned(iSize, COM_ARENA_ALIGN);
+}
+
+/*!
+ * \brief  Function to allocate aligned memory for the current frame.
+ *
+ * \param  iSize  Size of the allocation.
+ * \param  iAlign Alignment of the allocation (Power of two).
+ * \return The allocation, or NULL if error.
+ *
+ * \remark Once the buffer is full, the frame goes on in the blocks on the
+ *         side, so the marks stay in order.
+ */
+void *COM_Arena_AllocAligned(size_t iSize, size_t iAlign)
+{
+    COM_ArenaSide  *pSide   = &COM_arena.arrSides[COM_arena.iCurrent];
+    COM_ArenaChunk *pChunk  = pSide->pChunks;
+    void           *pMemory = NULL;
+    size_t          iBefore = 0;
+    size_t          iChunk  = 0;
+
+    if (!iAlign || (iAlign & (iAlign - 1)))
+    {
+        return NULL;
+    }
+
+    if (!pChunk)
+    {
+        iBefore = pSide->iUsed;
+        pMemory = COM_Arena_Bump(pSide->pBuffer, pSide->iCapacity, &pSide->iUsed, iSize, iAlign);
+        iBefore = pSide->iUsed - iBefore;
+    }
+    else
+    {
+        iBefore = pChunk->iUsed;
+        pMemory = COM_Arena_Bump((unsigned char *) (pChunk + 1), pChunk->iCapacity, &pChunk->iUsed, iSize, iAlign);
+        iBefore = pChunk->iUsed - iBefore;
+    }
+
+    /* ~~~ Full => Block on the side, freed at the reset ~~~ */
+    if (!pMemory)
+    {
+        iChunk = (iSize + iAlign > COM_ARENA_CHUNK_SIZE) ? (iSize + iAlign) : COM_ARENA_CHUNK_SIZE;
+        pChunk = (COM_ArenaChunk *) UTIL_Malloc(sizeof(COM_ArenaChunk) + iChunk);
+
+        if (!pChunk)
+        {
+            return NULL;
+        }
+
+        pChunk->pNext      = pSide->pChunks;
+        pChunk->iCapacity  = iChunk;
+        pChunk->iUsed      = 0;
+        pSide->pChunks     = pChunk;
+        pSide->bOverflowed = 1;
+        COM_arena.sStats.iNbOverflow++;
+
+        pMemory = COM_Arena_Bump((unsigned char *) (pChunk + 1), pChunk->iCapacity, &pChunk->iUsed, iSize, iAlign);
+        iBefore = pChunk->iUsed;
+    }
+
+    pSide->iTotal += iBefore;
+
+    if (pSide->iTotal > pSide->iPeak)
+    {
+        pSide->iPeak = pSide->iTotal;
+    }
+
+    if (pSide->iTotal > COM_arena.sStats.iPeak)
+    {
+        COM_arena.sStats.iPeak = pSide->iTotal;
+    }
+
+    return pMemory;
+}
+
+/*!
+ * \brief  Function to build a string for the current frame.
+ *
+ * \param  szStart Pointer to the first string.
+ * \return A pointer to the string, or NULL if error.
+ *
+ * \remark The last string must be NULL (See UTIL_StrBuild).
+ */
+char *COM_Arena_StrBuild(const char *szStart, ...)
+{
+    va_list     ap;
+    const char *pSrc    = NULL;
+    char       *szDest  = NULL;
+    char       *pDest   = NULL;
+    size_t      iLength = 0;
+
+    va_start(ap, szStart);
+
+    for (pSrc = szStart; pSrc; pSrc = va_arg(ap, const char *))
+    {
+        iLength += strlen(pSrc);
+    }
+
+    va_end(ap);
+
+    szDest = (char *) COM_Arena_AllocAligned(iLength + 1, 1);
+
+    if (szDest)
+    {
+        pDest = szDest;
+
+        va_start(ap, szStart);
+
+        for (pSrc = szStart; pSrc; pSrc = va_arg(ap, const char *))
+        {
+            iLength = strlen(pSrc);
+            memcpy(pDest, pSrc, iLength);
+            pDest  += iLength;
+        }
+
+        va_end(ap);
+
+        *pDest = '\0';
+    }
+
+    return szDest;
+}
+
+/*!
+ * \brief  Function to get the position of the arena.
+ *
+ * \param  pMark Pointer to the position (See COM_Arena_Rewind).
+ * \return None.
+ */
+void COM_Arena_Mark(COM_ArenaMark *pMark)
+{
+    const COM_ArenaSide *pSide = &COM_arena.arrSides[COM_arena.iCurrent];
+
+    pMark->iUsed      = pSide->iUsed;
+    pMark->pChunk     = pSide->pChunks;
+    pMark->iChunkUsed = pSide->pChunks ? pSide->pChunks->iUsed : 0;
+    pMark->iTotal     = pSide->iTotal;
+}
+
+/*!
+ * \brief  Function to give back the memory allocated since a position.
+ *
+ * \param  pMark Position (See COM_Arena_Mark, in the same frame).
+ * \return None.
+ */
+void COM_Arena_Rewind(const COM_ArenaMark *pMark)
+{
+    COM_ArenaSide *pSide = &COM_arena.arrSides[COM_arena.iCurrent];
+
+    COM_Arena_FreeChunks(pSide, pMark->pChunk);
+
+    if (pSide->pChunks)
+    {
+        pSide->pChunks->iUsed = pMark->iChunkUsed;
+    }
+
+    pSide->iUsed  = pMark->iUsed;
+    pSide->iTotal = pMark->iTotal;
+}
+
+/*!
+ * \brief  Function to end the frame of the arena.
+ *
+ * \return None.
+ *
+ * \remark With the double buffering, the memory of the previous frame is
+ *         given back, else the memory of this one. A buffer which overflowed
+ *         is grown to its peak, out of the frame.
+ */
+void COM_Arena_Reset(void)
+{
+    COM_ArenaSide *pSide     = NULL;
+    size_t         iCapacity = 0;
+
+    if (COM_arena.bDoubleBuffer)
+    {
+        COM_arena.iCurrent ^= 1;
+    }
+
+    pSide = &COM_arena.arrSides[COM_arena.iCurrent];
+
+    COM_Arena_FreeChunks(pSide, NULL);
+
+    if (pSide->bOverflowed)
+    {
+        iCapacity = pSide->iCapacity ? pSide->iCapacity : COM_ARENA_DEFAULT_SIZE;
+
+        while (iCapacity < pSide->iPeak)
+        {
+            iCapacity *= 2;
+        }
+
+        UTIL_Free(pSide->pBuffer);
+        pSide->pBuffer   = (unsigned char *) UTIL_Malloc(iCapacity);
+        pSide->iCapacity = pSide->pBuffer ? iCapacity : 0;
+        COM_arena.sStats.iNbGrowths++;
+    }
+
+    pSide->iUsed       = 0;
+    pSide->iTotal      = 0;
+    pSide->iPeak       = 0;
+    pSide->bOverflowed = 0;
+    COM_arena.sStats.iNbFrames++;
+}
+
+/*!
+ * \brief  Function to get the statistics of the arena.
+ *
+ * \param  pStats Pointer to the statistics.
+ * \return None.
+ */
+void COM_Arena_GetStats(COM_ArenaStats *pStats)
+{
+    *pStats           = COM_arena.sStats;
+    pStats->iCapacity = COM_arena.arrSides[COM_arena.iCurrent].iCapacity;
+    pStats->iUsed     = COM_arena.arrSides[COM_arena.iCurrent].iTotal;
+}
+
+/*!
+ * \brief  Function to free the frame arena.
+ *
+ * \return None.
+ */
+void COM_Arena_Quit(void)
+{
+    int i = 0;
+
+    if (COM_arena.sStats.iNbFrames)
+    {
+        COM_Log_Print(COM_LOG_INFO, "Arena: peak %u KB in a frame (Buffer %u KB), %u blocks on the side, %u growths in %u frames.",
+                      (unsigned int) (COM_arena.sStats.iPeak >> 10), (unsigned int) (COM_arena.arrSides[COM_arena.iCurrent].iCapacity >> 10),
+                      COM_arena.sStats.iNbOverflow, COM_arena.sStats.iNbGrowths, COM_arena.sStats.iNbFrames);
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        COM_Arena_FreeChunks(&COM_arena.arrSides[i], NULL);
+        UTIL_Free(COM_arena.arrSides[i].pBuffer);
+    }
+
+    memset(&COM_arena, 0, sizeof(COM_arena));
+}
+
+/* ========================================================================= */
@@ -0,0 +1,79 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Arena.h
+ * \brief   File to interface with the frame arena.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#ifndef __COM_ARENA_H__
+#define __COM_ARENA_H__
+
+    #include "COM_Shared.h"
+
+    /*
+     * The arena gives the transient memory of a frame (Paths, texts,
+     * scratch buffers...) by moving a pointer in a buffer, and is emptied by
+     * COM_Arena_Reset at the end of the frame, so nothing is freed one by
+     * one. With the double buffering, the memory of a frame is kept until
+     * the end of the next one. A function can also give back what it took
+     * with COM_Arena_Mark and COM_Arena_Rewind (Same frame, LIFO order).
+     *
+     * When the buffer is full, the allocations go to blocks allocated on
+     * the side, freed at the reset, and the buffer is grown to the peak, so
+     * a steady frame loop doesn't allocate anymore. The arena is used only
+     * by the main thread.
+     */
+
+    /*! Default size of a buffer of the arena (In bytes). */
+    #ifndef COM_ARENA_DEFAULT_SIZE
+        #define COM_ARENA_DEFAULT_SIZE  65536
+    #endif
+    /*! Default alignment of the allocations (In bytes, power of two). */
+    #define COM_ARENA_ALIGN             16
+
+    /*!
+     * \struct COM_ArenaMark
+     * \brief  Structure to handle a position of the arena.
+     */
+    typedef struct
+    {
+        size_t  iUsed;      /*!< Bytes used in the buffer. */
+        void   *pChunk;     /*!< Last block on the side. */
+        size_t  iChunkUsed; /*!< Bytes used in the last block on the side. */
+        size_t  iTotal;     /*!< Bytes used in the frame. */
+    } COM_ArenaMark;
+
+    /*!
+     * \struct COM_ArenaStats
+     * \brief  Structure to handle the statistics of the arena.
+     */
+    typedef struct
+    {
+        size_t       iCapacity;   /*!< Size of a buffer (In bytes). */
+        size_t       iUsed;       /*!< Bytes used in the current frame. */
+        size_t       iPeak;       /*!< Highest number of bytes used in a frame (High-water mark). */
+        unsigned int iNbFrames;   /*!< Number of resets. */
+        unsigned int iNbOverflow; /*!< Number of blocks allocated on the side (Buffer full). */
+        unsigned int iNbGrowths;  /*!< Number of times a buffer was grown. */
+    } COM_ArenaStats;
+
+    void  COM_Arena_Init        (size_t iCapacity, int bDoubleBuffer);
+    void *COM_Arena_Alloc       (size_t iSize);
+    void *COM_Arena_AllocAligned(size_t iSize, size_t iAlign);
+    char *COM_Arena_StrBuild    (const char *szStart, ...);
+    void  COM_Arena_Mark        (COM_ArenaMark *pMark);
+    void  COM_Arena_Rewind      (const COM_ArenaMark *pMark);
+    void  COM_Arena_Reset       (void);
+    void  COM_Arena_GetStats    (COM_ArenaStats *pStats);
+    void  COM_Arena_Quit        (void);
+
+#endif // __COM_ARENA_H__
+
+/* ========================================================================= */
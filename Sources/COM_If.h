@@ -10,13 +10,19 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 09/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add COM_Prof.h.                                      */
+/* Nyuu    | 18/10/26 | Add the LZ4 block codec.                             */
+/* Nyuu    | 18/10/26 | Add the frame arena.                                 */
 /* ========================================================================= */
 
 #ifndef __COM_IF_H__
 #define __COM_IF_H__
     
+    #include "COM_Arena.h"
     #include "COM_Log.h"
+    #include "COM_Lz4.h"
     #include "COM_Math.h"
+    #include "COM_Prof.h"
     #include "COM_Shared.h"
     #include "COM_Util.h"
     
@@ -13,28 +13,711 @@
 /* Red     | 10/06/15 | Add basics functions.                                */
 /* Red     | 14/06/15 | Remove szLogName from the structure, useless         */
 /*         |          | File is now created in logs/name.log                 */
+/* Nyuu    | 18/10/26 | Write the logs on a thread from a lock-free ring.    */
+/* Nyuu    | 18/10/26 | Add the binary mode (Deferred formatting).           */
+/* Nyuu    | 18/10/26 | Async-signal-safe writes of the crash handler.       */
 /* ========================================================================= */
 
+#include <errno.h>
+#include <signal.h>
+#include <SDL.h>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
 #include "COM_Util.h"
 #include "COM_Log.h"
 
 /* ========================================================================= */
 
+/*! Size of the buffer of the writes (In bytes). */
+#define COM_LOG_BATCH_SIZE 65536
+
+/*!
+ * \struct COM_LogRecord
+ * \brief  Structure to handle a message of the ring.
+ */
+typedef struct
+{
+    SDL_atomic_t iSeq;                           /*!< Position of the slot (Free if equal to the head, ready if +1). */
+    COM_LogType  iPrintLevel;                    /*!< Type of the message. */
+    Uint32       iSite;                          /*!< Call site of the arguments (0 => Text). */
+    Uint32       iLength;                        /*!< Length of the text or of the arguments. */
+    Uint64       iTime;                          /*!< Timestamp of the message. */
+    char         szText[COM_LOG_MESSAGE_SIZE];   /*!< Text or arguments of the message. */
+} COM_LogRecord;
+
+/*!
+ * \struct COM_LogSite
+ * \brief  Structure to handle a call site registered (Binary mode).
+ */
+typedef struct
+{
+    const char    *szFormat;                  /*!< Format of the messages. */
+    const char    *szFile;                    /*!< File of the call. */
+    int            iLine;                     /*!< Line of the call. */
+    unsigned char  arrArgs[COM_LOG_MAX_ARGS]; /*!< Types of the arguments (See COM_LogArg). */
+    int            iNbArgs;                   /*!< Number of arguments. */
+    int            iFixedSize;                /*!< Size of the arguments without the chars of the strings. */
+} COM_LogSite;
+
+/*!
+ * \struct COM_LogBatch
+ * \brief  Structure to handle a buffer of the writes.
+ */
+typedef struct
+{
+    char   *pBuffer; /*!< Buffer (COM_LOG_BATCH_SIZE bytes). */
+    size_t  iUsed;   /*!< Number of bytes used in the buffer. */
+    int     bRaw;    /*!< Flag set to write with write(2) (Crash handler), else with fwrite. */
+} COM_LogBatch;
+
 /*!
  * \struct COM_Log
  * \brief  Structure to handle the logs.
  */
 typedef struct
 {
-    FILE        *pLogFile;    /*!< Pointer to the logs file. */
-    COM_LogType  iPrintLevel; /*!< Type of logs allowed. */
+    FILE          *pLogFile;                         /*!< Pointer to the logs file. */
+    int            iFd;                              /*!< Descriptor of the logs file (Crash handler, -1 => None). */
+    COM_LogType    iPrintLevel;                      /*!< Type of logs allowed. */
+    COM_LogMode    iMode;                            /*!< Mode of the logs file. */
+    COM_LogRecord  arrRing[COM_LOG_RING_SIZE];       /*!< Ring of the messages (Many producers, one consumer). */
+    SDL_atomic_t   iHead;                            /*!< Position of the next message pushed. */
+    Uint32         iTail;                            /*!< Position of the next message written. */
+    SDL_atomic_t   iDropped;                         /*!< Number of messages dropped (Ring full). */
+    int            iReported;                        /*!< Number of messages dropped already written in the logs. */
+    COM_LogSite    arrSites[COM_LOG_MAX_SITES];      /*!< Call sites registered (Id - 1). */
+    SDL_atomic_t   iNbSites;                         /*!< Number of call sites registered. */
+    SDL_SpinLock   iSiteLock;                        /*!< Lock of the registration of the call sites. */
+    int            iSitesWritten;                    /*!< Number of call sites already written in the logs. */
+    SDL_SpinLock   iDrainLock;                       /*!< Lock of the consumer (Writer, flush or crash). */
+    char           arrBatch[COM_LOG_BATCH_SIZE];     /*!< Buffer of the writes. */
+    char           arrCrash[COM_LOG_BATCH_SIZE];     /*!< Buffer of the writes of the crash handler. */
+    SDL_Thread    *pThread;                          /*!< Writer thread. */
+    SDL_sem       *pWake;                            /*!< Semaphore to wake the writer up. */
+    SDL_atomic_t   iQuit;                            /*!< Flag to stop the writer. */
 } COM_Log;
 
 /*! Global variable to handle the logs. */
 static COM_Log COM_log;
 
+/*! Prefixes of the messages (See COM_LogType). */
+static const char *COM_szLogTxt[] = {"Debug   : ",
+                                     "Info    : ",
+                                     "Warning : ",
+                                     "Error   : ",
+                                     "Critical: "};
+
+/*! Crash signals flushing the logs. */
+static const int COM_arrLogSignals[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#ifdef SIGBUS
+                                        SIGBUS,
+#endif
+                                       };
+
+/*! Number of crash signals. */
+#define COM_LOG_NB_SIGNALS ((int) (sizeof(COM_arrLogSignals) / sizeof(COM_arrLogSignals[0])))
+
 /* ========================================================================= */
 
+/*!
+ * \brief  Function to write bytes in the logs file with write(2).
+ *
+ * \param  pData Pointer to the bytes.
+ * \param  iSize Number of bytes.
+ * \return None.
+ *
+ * \remark Async-signal-safe (The crash handler writes with it).
+ */
+static void COM_Log_WriteRaw(const char *pData, size_t iSize)
+{
+    long iWritten = 0;
+
+    while (iSize && (COM_log.iFd >= 0))
+    {
+#ifdef _WIN32
+        iWritten = (long) _write(COM_log.iFd, pData, (unsigned int) iSize);
+#else
+        iWritten = (long) write(COM_log.iFd, pData, iSize);
+#endif
+
+        if (iWritten <= 0)
+        {
+#ifdef EINTR
+            if ((iWritten < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+#endif
+            return;
+        }
+
+        pData += iWritten;
+        iSize -= (size_t) iWritten;
+    }
+}
+
+/*!
+ * \brief  Function to write an integer in decimal.
+ *
+ * \param  pDest  Buffer (At least 12 chars).
+ * \param  iValue Integer.
+ * \return The number of chars written (No null char).
+ *
+ * \remark Async-signal-safe, unlike snprintf.
+ */
+static size_t COM_Log_FormatInt(char *pDest, int iValue)
+{
+    char         arrDigits[12];
+    unsigned int iAbs    = (iValue < 0) ? (0U - (unsigned int) iValue) : (unsigned int) iValue;
+    size_t       iLength = 0;
+    size_t       i       = 0;
+
+    do
+    {
+        arrDigits[i++] = (char) ('0' + iAbs % 10);
+        iAbs          /= 10;
+    } while (iAbs);
+
+    if (iValue < 0)
+    {
+        pDest[iLength++] = '-';
+    }
+
+    while (i)
+    {
+        pDest[iLength++] = arrDigits[--i];
+    }
+
+    return iLength;
+}
+
+/*!
+ * \brief  Function to write the buffer of the writes in the logs file.
+ *
+ * \param  pBatch Buffer of the writes.
+ * \return None.
+ */
+static void COM_Log_BatchWrite(COM_LogBatch *pBatch)
+{
+    if (pBatch->bRaw)
+    {
+        COM_Log_WriteRaw(pBatch->pBuffer, pBatch->iUsed);
+    }
+    else
+    {
+        fwrite(pBatch->pBuffer, 1, pBatch->iUsed, COM_log.pLogFile);
+    }
+
+    pBatch->iUsed = 0;
+}
+
+/*!
+ * \brief  Function to copy bytes in the buffer of the writes.
+ *
+ * \param  pData  Pointer to the bytes.
+ * \param  iSize  Number of bytes (Less than COM_LOG_BATCH_SIZE).
+ * \param  pBatch Buffer of the writes.
+ * \return None.
+ */
+static void COM_Log_Batch(const void *pData, size_t iSize, COM_LogBatch *pBatch)
+{
+    if (pBatch->iUsed + iSize > COM_LOG_BATCH_SIZE)
+    {
+        COM_Log_BatchWrite(pBatch);
+    }
+
+    memcpy(pBatch->pBuffer + pBatch->iUsed, pData, iSize);
+    pBatch->iUsed += iSize;
+}
+
+/*!
+ * \brief  Function to copy a string in the buffer of the writes (Binary mode).
+ *
+ * \param  szText String.
+ * \param  pBatch Buffer of the writes.
+ * \return None.
+ */
+static void COM_Log_BatchString(const char *szText, COM_LogBatch *pBatch)
+{
+    size_t iLength = strlen(szText);
+    Uint16 iStored = (Uint16) (iLength > 0xFFFF ? 0xFFFF : iLength);
+
+    COM_Log_Batch(&iStored, sizeof(iStored), pBatch);
+    COM_Log_Batch(szText, iStored, pBatch);
+}
+
+/*!
+ * \brief  Function to copy the call sites not written yet (Binary mode).
+ *
+ * \param  pBatch Buffer of the writes.
+ * \return None.
+ */
+static void COM_Log_BatchSites(COM_LogBatch *pBatch)
+{
+    const COM_LogSite *pSite = NULL;
+    Uint8              iKind = COM_LOG_ENTRY_SITE;
+    Uint32             iId   = 0;
+    Uint32             iLine = 0;
+
+    while (COM_log.iSitesWritten < SDL_AtomicGet(&COM_log.iNbSites))
+    {
+        pSite = &COM_log.arrSites[COM_log.iSitesWritten++];
+        iId   = (Uint32) COM_log.iSitesWritten;
+        iLine = (Uint32) pSite->iLine;
+
+        COM_Log_Batch(&iKind, sizeof(iKind), pBatch);
+        COM_Log_Batch(&iId, sizeof(iId), pBatch);
+        COM_Log_Batch(&iLine, sizeof(iLine), pBatch);
+        COM_Log_BatchString(pSite->szFile, pBatch);
+        COM_Log_BatchString(pSite->szFormat, pBatch);
+    }
+}
+
+/*!
+ * \brief  Function to copy a message in the buffer of the writes.
+ *
+ * \param  pRecord Message.
+ * \param  pBatch  Buffer of the writes.
+ * \return None.
+ */
+static void COM_Log_BatchRecord(const COM_LogRecord *pRecord, COM_LogBatch *pBatch)
+{
+    Uint8  iKind  = pRecord->iSite ? COM_LOG_ENTRY_MESSAGE : COM_LOG_ENTRY_TEXT;
+    Uint8  iLevel = (Uint8) pRecord->iPrintLevel;
+    Uint16 iSize  = (Uint16) pRecord->iLength;
+
+    if (COM_log.iMode == COM_LOG_TEXT)
+    {
+        COM_Log_Batch(COM_szLogTxt[pRecord->iPrintLevel], strlen(COM_szLogTxt[pRecord->iPrintLevel]), pBatch);
+        COM_Log_Batch(pRecord->szText, pRecord->iLength, pBatch);
+        COM_Log_Batch("\n", 1, pBatch);
+        return;
+    }
+
+    /* ~~~ The site before its first message ~~~ */
+    if (pRecord->iSite > (Uint32) COM_log.iSitesWritten)
+    {
+        COM_Log_BatchSites(pBatch);
+    }
+
+    COM_Log_Batch(&iKind, sizeof(iKind), pBatch);
+
+    if (pRecord->iSite)
+    {
+        COM_Log_Batch(&pRecord->iSite, sizeof(pRecord->iSite), pBatch);
+    }
+
+    COM_Log_Batch(&iLevel, sizeof(iLevel), pBatch);
+    COM_Log_Batch(&pRecord->iTime, sizeof(pRecord->iTime), pBatch);
+    COM_Log_Batch(&iSize, sizeof(iSize), pBatch);
+    COM_Log_Batch(pRecord->szText, iSize, pBatch);
+}
+
+/*!
+ * \brief  Function to write the messages of the ring in the logs file.
+ *
+ * \param  bRaw Flag set to write with write(2) from the buffer of the crash handler.
+ * \return None.
+ *
+ * \remark The lock of the consumer must be held, except by the crash
+ *         handler. Async-signal-safe with bRaw.
+ */
+static void COM_Log_Drain(int bRaw)
+{
+    COM_LogRecord *pRecord  = NULL;
+    COM_LogBatch   sBatch;
+    char           szNumber[12];
+    size_t         iLength  = 0;
+    int            iDropped = 0;
+    Uint8          iKind    = COM_LOG_ENTRY_DROPPED;
+    Uint32         iCount   = 0;
+
+    if (!COM_log.pLogFile)
+    {
+        return;
+    }
+
+    sBatch.pBuffer = bRaw ? COM_log.arrCrash : COM_log.arrBatch;
+    sBatch.iUsed   = 0;
+    sBatch.bRaw    = bRaw;
+
+    for (;;)
+    {
+        pRecord = &COM_log.arrRing[COM_log.iTail & (COM_LOG_RING_SIZE - 1)];
+
+        /* ~~~ Not pushed yet (Or pushed but not written by the producer) ~~~ */
+        if ((Uint32) SDL_AtomicGet(&pRecord->iSeq) != COM_log.iTail + 1)
+        {
+            break;
+        }
+
+        COM_Log_BatchRecord(pRecord, &sBatch);
+
+        /* ~~~ The slot is free for the next turn of the ring ~~~ */
+        SDL_AtomicSet(&pRecord->iSeq, (int) (COM_log.iTail + COM_LOG_RING_SIZE));
+        COM_log.iTail++;
+    }
+
+    iDropped = SDL_AtomicGet(&COM_log.iDropped);
+
+    if (iDropped != COM_log.iReported)
+    {
+        if (COM_log.iMode == COM_LOG_TEXT)
+        {
+            iLength = strlen(COM_szLogTxt[COM_LOG_WARNING]);
+            COM_Log_Batch(COM_szLogTxt[COM_LOG_WARNING], iLength, &sBatch);
+            iLength = COM_Log_FormatInt(szNumber, iDropped - COM_log.iReported);
+            COM_Log_Batch(szNumber, iLength, &sBatch);
+            COM_Log_Batch(" messages dropped (Logs ring full)\n", strlen(" messages dropped (Logs ring full)\n"), &sBatch);
+        }
+        else
+        {
+            iCount = (Uint32) (iDropped - COM_log.iReported);
+            COM_Log_Batch(&iKind, sizeof(iKind), &sBatch);
+            COM_Log_Batch(&iCount, sizeof(iCount), &sBatch);
+        }
+
+        COM_log.iReported = iDropped;
+    }
+
+    if (sBatch.iUsed)
+    {
+        COM_Log_BatchWrite(&sBatch);
+
+        if (!bRaw)
+        {
+            fflush(COM_log.pLogFile);
+        }
+    }
+}
+
+/*!
+ * \brief  Function of the writer thread.
+ *
+ * \param  pData Unused.
+ * \return 0.
+ */
+static int COM_Log_Writer(void *pData)
+{
+    (void) pData;
+
+    while (!SDL_AtomicGet(&COM_log.iQuit))
+    {
+        SDL_SemWaitTimeout(COM_log.pWake, COM_LOG_WRITE_DELAY);
+
+        SDL_AtomicLock(&COM_log.iDrainLock);
+        COM_Log_Drain(0);
+        SDL_AtomicUnlock(&COM_log.iDrainLock);
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief  Function to flush the logs on a crash signal.
+ *
+ * \param  iSignal Signal received.
+ * \return None.
+ *
+ * \remark Only async-signal-safe calls: the messages are copied in a buffer
+ *         of their own and written with write(2), so a crash inside stdio
+ *         or malloc can't lock the handler. The lock of the consumer is not
+ *         waited: if the writer holds it (Or crashed with it), the ring is
+ *         drained anyway, so a message can be written twice or be lost in
+ *         the buffer of the writer.
+ */
+static void COM_Log_Crash(int iSignal)
+{
+    char   szNumber[12];
+    size_t iLength = 0;
+    Uint8  iKind   = COM_LOG_ENTRY_SIGNAL;
+    Uint32 iNumber = (Uint32) iSignal;
+
+    (void) SDL_AtomicTryLock(&COM_log.iDrainLock);
+
+    COM_Log_Drain(1);
+
+    if (COM_log.pLogFile)
+    {
+        if (COM_log.iMode == COM_LOG_TEXT)
+        {
+            iLength = strlen(COM_szLogTxt[COM_LOG_CRITICAL]);
+            COM_Log_WriteRaw(COM_szLogTxt[COM_LOG_CRITICAL], iLength);
+            COM_Log_WriteRaw("Signal ", strlen("Signal "));
+            iLength = COM_Log_FormatInt(szNumber, iSignal);
+            COM_Log_WriteRaw(szNumber, iLength);
+            COM_Log_WriteRaw(" received\n", strlen(" received\n"));
+        }
+        else
+        {
+            COM_Log_WriteRaw((const char *) &iKind, sizeof(iKind));
+            COM_Log_WriteRaw((const char *) &iNumber, sizeof(iNumber));
+        }
+    }
+
+    /* ~~~ Default behavior (Core dump...) ~~~ */
+    signal(iSignal, SIG_DFL);
+    raise(iSignal);
+}
+
+/*!
+ * \brief  Function to register a call site (Binary mode).
+ *
+ * \param  pSite    Pointer to the id of the call site.
+ * \param  iLine    Line of the call.
+ * \param  szFile   File of the call.
+ * \param  szFormat Format of the messages (String literal).
+ * \return The id of the call site, or -1 if its messages are formatted by the caller.
+ */
+static int COM_Log_Register(int *pSite, int iLine, const char *szFile, const char *szFormat)
+{
+    COM_LogSite *pNewSite = NULL;
+    const char  *pChar    = szFormat;
+    int          iNbSites = 0;
+    int          i        = 0;
+
+    SDL_AtomicLock(&COM_log.iSiteLock);
+
+    /* ~~~ Registered by another thread meanwhile ~~~ */
+    if (*pSite)
+    {
+        SDL_AtomicUnlock(&COM_log.iSiteLock);
+        return *pSite;
+    }
+
+    iNbSites = SDL_AtomicGet(&COM_log.iNbSites);
+    *pSite   = -1;
+
+    if (iNbSites < COM_LOG_MAX_SITES)
+    {
+        pNewSite          = &COM_log.arrSites[iNbSites];
+        pNewSite->iNbArgs = 0;
+
+        while (pChar && *pChar)
+        {
+            pChar = (*pChar == '%') ? COM_Log_ParseSpec(pChar, pNewSite->arrArgs, &pNewSite->iNbArgs) : (pChar + 1);
+        }
+
+        if (pChar)
+        {
+            pNewSite->szFormat   = szFormat;
+            pNewSite->szFile     = szFile;
+            pNewSite->iLine      = iLine;
+            pNewSite->iFixedSize = 0;
+
+            for (i = 0; i < pNewSite->iNbArgs; i++)
+            {
+                pNewSite->iFixedSize += (pNewSite->arrArgs[i] == COM_LOG_ARG_INT)    ? 4 :
+                                        (pNewSite->arrArgs[i] == COM_LOG_ARG_STRING) ? 2 : 8;
+            }
+
+            SDL_AtomicSet(&COM_log.iNbSites, iNbSites + 1);
+            *pSite = iNbSites + 1;
+        }
+    }
+
+    SDL_AtomicUnlock(&COM_log.iSiteLock);
+
+    return *pSite;
+}
+
+/*!
+ * \brief  Function to store the raw arguments of a message (Binary mode).
+ *
+ * \param  pSite Call site of the message.
+ * \param  ap    Arguments of the message.
+ * \param  pData Pointer to the output (COM_LOG_MESSAGE_SIZE bytes).
+ * \return The size of the arguments.
+ *
+ * \remark The strings share the bytes left by the other arguments, and are
+ *         cut when they don't fit.
+ */
+static Uint32 COM_Log_Pack(const COM_LogSite *pSite, va_list ap, char *pData)
+{
+    char       *pOut    = pData;
+    size_t      iRoom   = (size_t) (COM_LOG_MESSAGE_SIZE - pSite->iFixedSize);
+    const char *szText  = NULL;
+    size_t      iLength = 0;
+    Uint16      iStored = 0;
+    int         iInt    = 0;
+    Sint64      iLong   = 0;
+    Uint64      iSize   = 0;
+    double      fDouble = 0.0;
+    int         i       = 0;
+
+    for (i = 0; i < pSite->iNbArgs; i++)
+    {
+        switch (pSite->arrArgs[i])
+        {
+            case COM_LOG_ARG_INT:
+                iInt = va_arg(ap, int);
+                memcpy(pOut, &iInt, 4);
+                pOut += 4;
+                break;
+
+            case COM_LOG_ARG_LONG:
+            case COM_LOG_ARG_LLONG:
+                iLong = (pSite->arrArgs[i] == COM_LOG_ARG_LONG) ? (Sint64) va_arg(ap, long) : (Sint64) va_arg(ap, long long);
+                memcpy(pOut, &iLong, 8);
+                pOut += 8;
+                break;
+
+            case COM_LOG_ARG_SIZE:
+            case COM_LOG_ARG_POINTER:
+                iSize = (pSite->arrArgs[i] == COM_LOG_ARG_SIZE) ? (Uint64) va_arg(ap, size_t) : (Uint64) (size_t) va_arg(ap, void *);
+                memcpy(pOut, &iSize, 8);
+                pOut += 8;
+                break;
+
+            case COM_LOG_ARG_DOUBLE:
+                fDouble = va_arg(ap, double);
+                memcpy(pOut, &fDouble, 8);
+                pOut += 8;
+                break;
+
+            default:
+                szText  = va_arg(ap, const char *);
+                szText  = szText ? szText : "(null)";
+                iLength = strlen(szText);
+                iStored = (Uint16) (iLength > iRoom ? iRoom : iLength);
+                iRoom  -= iStored;
+                memcpy(pOut, &iStored, 2);
+                memcpy(pOut + 2, szText, iStored);
+                pOut   += 2 + iStored;
+                break;
+        }
+    }
+
+    return (Uint32) (pOut - pData);
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to parse a conversion of a format.
+ *
+ * \param  szSpec   Pointer to the conversion (On the '%').
+ * \param  pArrArgs Array of the types of arguments to complete (COM_LOG_MAX_ARGS).
+ * \param  pNbArgs  Pointer to the number of types in the array.
+ * \return The format after the conversion, or NULL if it can't be stored raw.
+ *
+ * \remark A conversion uses up to 3 arguments ('*' width and precision).
+ */
+const char *COM_Log_ParseSpec(const char *szSpec, unsigned char *pArrArgs, int *pNbArgs)
+{
+    static const unsigned char arrIntArgs[] = {COM_LOG_ARG_INT, COM_LOG_ARG_LONG, COM_LOG_ARG_LLONG, COM_LOG_ARG_SIZE};
+    int                        iModifier    = 0;
+    int                        iArg         = 0;
+
+    if (*(++szSpec) == '%')
+    {
+        return szSpec + 1;
+    }
+
+    /* ~~~ Flags, width and precision ~~~ */
+    while (*szSpec && strchr("-+ #0", *szSpec))
+    {
+        szSpec++;
+    }
+
+    for (iArg = 0; iArg < 2; iArg++)
+    {
+        if (iArg && (*szSpec != '.'))
+        {
+            break;
+        }
+
+        szSpec += iArg;
+
+        if (*szSpec == '*')
+        {
+            if (*pNbArgs >= COM_LOG_MAX_ARGS)
+            {
+                return NULL;
+            }
+
+            pArrArgs[(*pNbArgs)++] = COM_LOG_ARG_INT;
+            szSpec++;
+        }
+
+        while ((*szSpec >= '0') && (*szSpec <= '9'))
+        {
+            szSpec++;
+        }
+    }
+
+    /* ~~~ Modifier (0: none or short, 1: long, 2: long long, 3: size_t) ~~~ */
+    if (*szSpec == 'h')
+    {
+        szSpec += (szSpec[1] == 'h') ? 2 : 1;
+        iModifier = -1;
+    }
+    else if (*szSpec == 'l')
+    {
+        iModifier = (szSpec[1] == 'l') ? 2 : 1;
+        szSpec   += iModifier;
+    }
+    else if (*szSpec == 'z')
+    {
+        szSpec++;
+        iModifier = 3;
+    }
+
+    switch (*szSpec)
+    {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            iArg = arrIntArgs[iModifier < 0 ? 0 : iModifier];
+            break;
+
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            iArg = (iModifier <= 1) ? COM_LOG_ARG_DOUBLE : -1;
+            break;
+
+        case 'c':
+            iArg = iModifier ? -1 : COM_LOG_ARG_INT;
+            break;
+
+        case 's':
+            iArg = iModifier ? -1 : COM_LOG_ARG_STRING;
+            break;
+
+        case 'p':
+            iArg = iModifier ? -1 : COM_LOG_ARG_POINTER;
+            break;
+
+        default:
+            iArg = -1;
+            break;
+    }
+
+    if ((iArg < 0) || (*pNbArgs >= COM_LOG_MAX_ARGS))
+    {
+        return NULL;
+    }
+
+    pArrArgs[(*pNbArgs)++] = (unsigned char) iArg;
+
+    return szSpec + 1;
+}
+
+/*!
+ * \brief Function to set the mode of the logs file.
+ *
+ * \param iMode Mode of the logs file (See COM_LogMode).
+ * \return None.
+ *
+ * \remark To call before COM_Log_Init.
+ */
+void COM_Log_SetMode(COM_LogMode iMode)
+{
+    COM_log.iMode = iMode;
+}
+
 /*!
  * \brief Function to initialize the logs.
  *
@@ -48,22 +731,71 @@ void COM_Log_Init(COM_LogType iPrintLevel, const char *szLogName)
     char      *szLogPath = NULL;
     time_t     sTime;
     struct tm *pTimeinfo = NULL;
+    Uint32     iVersion  = COM_LOG_VERSION;
+    Uint64     iValue    = 0;
+    int        i         = 0;
 
-    szLogPath = UTIL_StrBuild("logs/", szLogName, ".log", NULL);
+    szLogPath = UTIL_StrBuild("logs/", szLogName, (COM_log.iMode == COM_LOG_BINARY) ? ".blog" : ".log", NULL);
 
     if (szLogPath)
     {
-        COM_log.pLogFile = fopen(szLogPath, "w+");
+        COM_log.pLogFile = fopen(szLogPath, (COM_log.iMode == COM_LOG_BINARY) ? "w+b" : "w+");
 
         if (COM_log.pLogFile)
         {
             time(&sTime);
-            pTimeinfo = localtime(&sTime);
-            strftime(szTimeBuffer, sizeof(szTimeBuffer), "%A %Y-%m-%d -- %H:%M:%S", pTimeinfo);
 
-            fprintf(COM_log.pLogFile, "***********************************************************************\n");
-            fprintf(COM_log.pLogFile, "                    %s\n", szTimeBuffer);
-            fprintf(COM_log.pLogFile, "***********************************************************************\n\n");
+            if (COM_log.iMode == COM_LOG_BINARY)
+            {
+                fwrite(COM_LOG_MAGIC, 1, 4, COM_log.pLogFile);
+                fwrite(&iVersion, sizeof(iVersion), 1, COM_log.pLogFile);
+                iValue = SDL_GetPerformanceFrequency( );
+                fwrite(&iValue, sizeof(iValue), 1, COM_log.pLogFile);
+                iValue = (Uint64) sTime;
+                fwrite(&iValue, sizeof(iValue), 1, COM_log.pLogFile);
+            }
+            else
+            {
+                pTimeinfo = localtime(&sTime);
+                strftime(szTimeBuffer, sizeof(szTimeBuffer), "%A %Y-%m-%d -- %H:%M:%S", pTimeinfo);
+
+                fprintf(COM_log.pLogFile, "***********************************************************************\n");
+                fprintf(COM_log.pLogFile, "                    %s\n", szTimeBuffer);
+                fprintf(COM_log.pLogFile, "***********************************************************************\n\n");
+            }
+
+            /* ~~~ The crash handler writes after the header, with the descriptor ~~~ */
+            fflush(COM_log.pLogFile);
+#ifdef _WIN32
+            COM_log.iFd = _fileno(COM_log.pLogFile);
+#else
+            COM_log.iFd = fileno(COM_log.pLogFile);
+#endif
+
+            for (i = 0; i < COM_LOG_RING_SIZE; i++)
+            {
+                SDL_AtomicSet(&COM_log.arrRing[i].iSeq, i);
+            }
+
+            SDL_AtomicSet(&COM_log.iHead, 0);
+            SDL_AtomicSet(&COM_log.iDropped, 0);
+            SDL_AtomicSet(&COM_log.iQuit, 0);
+            COM_log.iTail         = 0;
+            COM_log.iReported     = 0;
+            COM_log.iSitesWritten = 0;
+
+            for (i = 0; i < COM_LOG_NB_SIGNALS; i++)
+            {
+                signal(COM_arrLogSignals[i], COM_Log_Crash);
+            }
+
+            /* ~~~ Without writer, the messages are written by the caller ~~~ */
+            COM_log.pWake = SDL_CreateSemaphore(0);
+
+            if (COM_log.pWake)
+            {
+                COM_log.pThread = SDL_CreateThread(COM_Log_Writer, "log", NULL);
+            }
 
             COM_log.iPrintLevel = iPrintLevel;
         }
@@ -73,36 +805,106 @@ void COM_Log_Init(COM_LogType iPrintLevel, const char *szLogName)
 }
 
 /*!
- * \brief Function to print a log message.
+ * \brief Function to print a log message (See COM_Log_Print).
  *
+ * \param pSite       Pointer to the id of the call site (0 => Not registered yet).
+ * \param iLine       Line of the call.
+ * \param szFile      File of the call.
  * \param iPrintLevel Prefix of log message to use (See COM_LogType).
  * \param szFormat    The formatted message to write.
  * \return None.
+ *
+ * \remark The message is only pushed in the ring (Never waits for the disk).
  */
-void COM_Log_Print(COM_LogType iPrintLevel, const char *szFormat, ...)
+void COM_Log_PrintEx(int *pSite, int iLine, const char *szFile, COM_LogType iPrintLevel, const char *szFormat, ...)
 {
-    static const char *szLogTxt[] = {"Debug   : ", 
-                                     "Info    : ", 
-                                     "Warning : ", 
-                                     "Error   : ", 
-                                     "Critical: "};
-    va_list            ap;
+    COM_LogRecord *pRecord = NULL;
+    Uint32         iPos    = 0;
+    Sint32         iDiff   = 0;
+    int            iSite   = 0;
+    int            iLength = 0;
+    va_list        ap;
 
     if (COM_log.pLogFile && COM_log.iPrintLevel <= iPrintLevel)
     {
-        fputs(szLogTxt[iPrintLevel], COM_log.pLogFile);
+        if (COM_log.iMode == COM_LOG_BINARY)
+        {
+            iSite = *pSite;
+
+            if (!iSite)
+            {
+                iSite = COM_Log_Register(pSite, iLine, szFile, szFormat);
+            }
+            else
+            {
+                SDL_MemoryBarrierAcquire( );
+            }
+        }
+
+        /* ~~~ Claim a slot ~~~ */
+        for (;;)
+        {
+            iPos    = (Uint32) SDL_AtomicGet(&COM_log.iHead);
+            pRecord = &COM_log.arrRing[iPos & (COM_LOG_RING_SIZE - 1)];
+            iDiff   = (Sint32) ((Uint32) SDL_AtomicGet(&pRecord->iSeq) - iPos);
+
+            if (iDiff < 0)
+            {
+                SDL_AtomicAdd(&COM_log.iDropped, 1);
+                return;
+            }
+
+            if ((!iDiff) && (SDL_AtomicCAS(&COM_log.iHead, (int) iPos, (int) (iPos + 1))))
+            {
+                break;
+            }
+        }
 
         va_start(ap, szFormat);
-        vfprintf(COM_log.pLogFile, szFormat, ap);
+
+        if (iSite > 0)
+        {
+            pRecord->iLength = COM_Log_Pack(&COM_log.arrSites[iSite - 1], ap, pRecord->szText);
+            pRecord->iSite   = (Uint32) iSite;
+        }
+        else
+        {
+            iLength          = vsnprintf(pRecord->szText, COM_LOG_MESSAGE_SIZE, szFormat, ap);
+            pRecord->iLength = (Uint32) (iLength < 0 ? 0 : (iLength >= COM_LOG_MESSAGE_SIZE ? COM_LOG_MESSAGE_SIZE - 1 : iLength));
+            pRecord->iSite   = 0;
+        }
+
         va_end(ap);
 
-        fputc('\n', COM_log.pLogFile);
+        pRecord->iPrintLevel = iPrintLevel;
+        pRecord->iTime       = (COM_log.iMode == COM_LOG_BINARY) ? SDL_GetPerformanceCounter( ) : 0;
 
-        // If crash...
-        fflush(COM_log.pLogFile);
+        /* ~~~ Ready for the writer ~~~ */
+        SDL_AtomicSet(&pRecord->iSeq, (int) (iPos + 1));
+
+        if (!COM_log.pThread)
+        {
+            COM_Log_Flush( );
+        }
+        else if ((iPrintLevel >= COM_LOG_WARNING) || (!(iPos & (COM_LOG_RING_SIZE / 2 - 1))))
+        {
+            SDL_SemPost(COM_log.pWake);
+        }
     }
 }
 
+/*!
+ * \brief Function to write the pending messages in the logs file.
+ *
+ * \return None.
+ */
+void COM_Log_Flush(void)
+{
+    SDL_AtomicLock(&COM_log.iDrainLock);
+    COM_Log_Drain(0);
+    SDL_AtomicUnlock(&COM_log.iDrainLock);
+}
+
 /*!
  * \brief Function to close the logs.
  *
@@ -110,6 +912,33 @@ void COM_Log_Print(COM_LogType iPrintLevel, const char *szFormat, ...)
  */
 void COM_Log_Quit(void)
 {
+    int i = 0;
+
+    if (COM_log.pThread)
+    {
+        SDL_AtomicSet(&COM_log.iQuit, 1);
+        SDL_SemPost(COM_log.pWake);
+        SDL_WaitThread(COM_log.pThread, NULL);
+        COM_log.pThread = NULL;
+    }
+
+    if (COM_log.pWake)
+    {
+        SDL_DestroySemaphore(COM_log.pWake);
+        COM_log.pWake = NULL;
+    }
+
+    if (COM_log.pLogFile)
+    {
+        for (i = 0; i < COM_LOG_NB_SIGNALS; i++)
+        {
+            signal(COM_arrLogSignals[i], SIG_DFL);
+        }
+    }
+
+    COM_Log_Flush( );
+
+    COM_log.iFd = -1;
     UTIL_FileClose(&COM_log.pLogFile);
 }
 
@@ -12,13 +12,71 @@
 /* Nyuu    | 09/06/15 | Creation.                                            */
 /* Red     | 10/06/15 | Add COM_LogType and COM_Log structure with basic     */
 /*         |          | functions                                            */
+/* Nyuu    | 18/10/26 | Write the logs on a thread from a lock-free ring.    */
+/* Nyuu    | 18/10/26 | Add the binary mode (Deferred formatting).           */
 /* ========================================================================= */
 
 #ifndef __COM_LOG_H__
 #define __COM_LOG_H__
 
     #include "COM_Shared.h"
-    
+
+    /*
+     * The messages are formatted by the caller into a lock-free ring, then
+     * written in batches by a writer thread, so any thread can log and no
+     * caller waits for the disk. A message which finds the ring full is
+     * dropped and counted. The ring is flushed by COM_Log_Flush, by the
+     * quit and by the crash signals (SIGSEGV, SIGABRT...).
+     *
+     * In binary mode (See COM_Log_SetMode), the format of each call site is
+     * registered once and a message only stores the id of its site, a
+     * timestamp and the raw bytes of its arguments (Strings copied). The
+     * text is built offline by the decoder ('Tools/Decode'). A format which
+     * can't be stored raw (%n, %j, %t, %L, %lc, %ls or too many arguments)
+     * is formatted by the caller, as in text mode.
+     *
+     * Binary file (Native byte order):
+     *     Header  : "NLOG", Uint32 version, Uint64 frequency of the
+     *               timestamps, Uint64 date of the start (time_t).
+     *     Entries : Uint8 kind (See COM_LogEntry), then:
+     *         SITE    : Uint32 id, Uint32 line, Uint16 length + file,
+     *                   Uint16 length + format.
+     *         MESSAGE : Uint32 id, Uint8 level, Uint64 timestamp,
+     *                   Uint16 size + arguments.
+     *         TEXT    : Uint8 level, Uint64 timestamp, Uint16 length + text.
+     *         DROPPED : Uint32 number of messages dropped.
+     *         SIGNAL  : Uint32 crash signal received.
+     *     Arguments : int as 4 bytes, long, long long, size_t, pointer and
+     *                 double as 8 bytes, string as Uint16 length + chars.
+     */
+
+    /*! Number of messages in the ring (Power of two). */
+    #ifndef COM_LOG_RING_SIZE
+        #define COM_LOG_RING_SIZE   4096
+    #endif
+    /*! Maximum length of a message (Longer ones are cut). */
+    #define COM_LOG_MESSAGE_SIZE    232
+    /*! Maximum delay before the writer wakes up (In ms). */
+    #define COM_LOG_WRITE_DELAY     20
+    /*! Maximum number of call sites registered (Binary mode). */
+    #ifndef COM_LOG_MAX_SITES
+        #define COM_LOG_MAX_SITES   1024
+    #endif
+    /*! Maximum number of arguments of a message (Binary mode). */
+    #define COM_LOG_MAX_ARGS        16
+    /*! Magic number of a binary logs file. */
+    #define COM_LOG_MAGIC           "NLOG"
+    /*! Version of the binary logs file. */
+    #define COM_LOG_VERSION         1
+
+    /*! Macro to print a log message (The call site is registered once in binary mode). */
+    #define COM_Log_Print(iPrintLevel, ...)                                                 \
+    do                                                                                      \
+    {                                                                                       \
+        static int iLogSite = 0;                                                            \
+        COM_Log_PrintEx(&iLogSite, __LINE__, __FILENAME__, iPrintLevel, __VA_ARGS__);       \
+    } while (0)
+
     /*!
      * \enum  COM_LogType
      * \brief Enumeration of the possible type of logs.
@@ -32,9 +90,50 @@
         COM_LOG_CRITICAL = 4, /*!< Value 'critical' log. */
     } COM_LogType;
 
-    void COM_Log_Init(COM_LogType iPrintLevel, const char *szLogName);
-    void COM_Log_Print(COM_LogType iPrintLevel, const char *szFormat, ...);
-    void COM_Log_Quit(void);
+    /*!
+     * \enum  COM_LogMode
+     * \brief Enumeration of the modes of the logs file.
+     */
+    typedef enum
+    {
+        COM_LOG_TEXT   = 0, /*!< Messages formatted by the caller ('logs/name.log'). */
+        COM_LOG_BINARY = 1, /*!< Messages formatted by the decoder ('logs/name.blog'). */
+    } COM_LogMode;
+
+    /*!
+     * \enum  COM_LogEntry
+     * \brief Enumeration of the kinds of entries of a binary logs file.
+     */
+    typedef enum
+    {
+        COM_LOG_ENTRY_SITE    = 1, /*!< Call site (Format of its messages). */
+        COM_LOG_ENTRY_MESSAGE = 2, /*!< Message of a call site. */
+        COM_LOG_ENTRY_TEXT    = 3, /*!< Message formatted by the caller. */
+        COM_LOG_ENTRY_DROPPED = 4, /*!< Messages dropped (Ring full). */
+        COM_LOG_ENTRY_SIGNAL  = 5, /*!< Crash signal. */
+    } COM_LogEntry;
+
+    /*!
+     * \enum  COM_LogArg
+     * \brief Enumeration of the types of arguments of a message.
+     */
+    typedef enum
+    {
+        COM_LOG_ARG_INT     = 0, /*!< int (Also char and short, promoted). */
+        COM_LOG_ARG_LONG    = 1, /*!< long. */
+        COM_LOG_ARG_LLONG   = 2, /*!< long long. */
+        COM_LOG_ARG_SIZE    = 3, /*!< size_t. */
+        COM_LOG_ARG_DOUBLE  = 4, /*!< double (Also float, promoted). */
+        COM_LOG_ARG_POINTER = 5, /*!< void *. */
+        COM_LOG_ARG_STRING  = 6, /*!< char * (Copied). */
+    } COM_LogArg;
+
+    void        COM_Log_SetMode(COM_LogMode iMode);
+    void        COM_Log_Init(COM_LogType iPrintLevel, const char *szLogName);
+    void        COM_Log_PrintEx(int *pSite, int iLine, const char *szFile, COM_LogType iPrintLevel, const char *szFormat, ...);
+    void        COM_Log_Flush(void);
+    void        COM_Log_Quit(void);
+    const char *COM_Log_ParseSpec(const char *szSpec, unsigned char *pArrArgs, int *pNbArgs);
 
 #endif // __COM_LOG_H__
 
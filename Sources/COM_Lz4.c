@@ -0,0 +1,317 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Lz4.c
+ * \brief   File to handle the LZ4 block codec.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "COM_Lz4.h"
+
+/* ========================================================================= */
+
+/*! Length of the shortest match. */
+#define COM_LZ4_MIN_MATCH     4
+/*! Number of bytes at the end of a block always stored as literals. */
+#define COM_LZ4_LAST_LITERALS 5
+/*! Number of bytes at the end of a block where no match can start. */
+#define COM_LZ4_MF_LIMIT      12
+/*! Maximum distance of a match. */
+#define COM_LZ4_MAX_DISTANCE  65535
+/*! Number of bits of the hash table of the compressor. */
+#define COM_LZ4_HASH_BITS     12
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to read 4 bytes of a block.
+ *
+ * \param  pData Pointer to the bytes.
+ * \return The 4 bytes (Native order, only compared).
+ */
+static unsigned int COM_Lz4_Read32(const unsigned char *pData)
+{
+    unsigned int iValue = 0;
+
+    memcpy(&iValue, pData, sizeof(iValue));
+
+    return iValue;
+}
+
+/*!
+ * \brief  Function to write a length in the extra bytes of a sequence.
+ *
+ * \param  pDst    Pointer to the output.
+ * \param  pDstEnd Pointer to the end of the output.
+ * \param  iLength Length to write, minus the 15 stored in the token.
+ * \return The output after the bytes, or NULL if it is full.
+ */
+static unsigned char *COM_Lz4_WriteLength(unsigned char *pDst, unsigned char *pDstEnd, size_t iLength)
+{
+    while (iLength >= 255)
+    {
+        if (pDst >= pDstEnd)
+        {
+            return NULL;
+        }
+
+        *pDst++  = 255;
+        iLength -= 255;
+    }
+
+    if (pDst >= pDstEnd)
+    {
+        return NULL;
+    }
+
+    *pDst++ = (unsigned char) iLength;
+
+    return pDst;
+}
+
+/*!
+ * \brief  Function to write a sequence (Literals, then a match).
+ *
+ * \param  pDst       Pointer to the output.
+ * \param  pDstEnd    Pointer to the end of the output.
+ * \param  pLiterals  Pointer to the literals.
+ * \param  iNbLiteral Number of literals.
+ * \param  iOffset    Distance of the match (0 => Last sequence, no match).
+ * \param  iMatchLen  Length of the match.
+ * \return The output after the sequence, or NULL if it is full.
+ */
+static unsigned char *COM_Lz4_WriteSequence(unsigned char *pDst, unsigned char *pDstEnd, const unsigned char *pLiterals,
+                                            size_t iNbLiteral, size_t iOffset, size_t iMatchLen)
+{
+    unsigned char *pToken = pDst++;
+
+    if (pToken >= pDstEnd)
+    {
+        return NULL;
+    }
+
+    /* ~~~ Literals ~~~ */
+    *pToken = (unsigned char) ((iNbLiteral < 15 ? iNbLiteral : 15) << 4);
+
+    if (iNbLiteral >= 15)
+    {
+        pDst = COM_Lz4_WriteLength(pDst, pDstEnd, iNbLiteral - 15);
+    }
+
+    if (!pDst || ((size_t) (pDstEnd - pDst) < iNbLiteral))
+    {
+        return NULL;
+    }
+
+    memcpy(pDst, pLiterals, iNbLiteral);
+    pDst += iNbLiteral;
+
+    if (!iOffset)
+    {
+        return pDst;
+    }
+
+    /* ~~~ Match (Offset in little endian) ~~~ */
+    if (pDstEnd - pDst < 2)
+    {
+        return NULL;
+    }
+
+    *pDst++    = (unsigned char) (iOffset & 0xFF);
+    *pDst++    = (unsigned char) (iOffset >> 8);
+    iMatchLen -= COM_LZ4_MIN_MATCH;
+    *pToken   |= (unsigned char) (iMatchLen < 15 ? iMatchLen : 15);
+
+    if (iMatchLen >= 15)
+    {
+        pDst = COM_Lz4_WriteLength(pDst, pDstEnd, iMatchLen - 15);
+    }
+
+    return pDst;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to compress a block.
+ *
+ * \param  pSrc         Pointer to the data.
+ * \param  iSrcSize     Size of the data (In bytes).
+ * \param  pDst         Pointer to the output.
+ * \param  iDstCapacity Size of the output (See COM_Lz4_Bound).
+ * \return The size of the compressed block, or 0 if the output is too small.
+ *
+ * \remark The block is in the LZ4 block format, so it can be read by any
+ *         LZ4 decoder. The compressor is greedy, like the fast mode of LZ4.
+ */
+size_t COM_Lz4_Compress(const void *pSrc, size_t iSrcSize, void *pDst, size_t iDstCapacity)
+{
+    const unsigned char *pIn       = (const unsigned char *) pSrc;
+    unsigned char       *pOut      = (unsigned char *) pDst;
+    unsigned char       *pOutEnd   = pOut + iDstCapacity;
+    size_t               arrTable[1 << COM_LZ4_HASH_BITS];
+    size_t               iPos      = 0;
+    size_t               iAnchor   = 0;
+    size_t               iRef      = 0;
+    size_t               iLength   = 0;
+    unsigned int         iHash     = 0;
+
+    /* ~~~ Positions + 1, so 0 is an empty slot ~~~ */
+    memset(arrTable, 0, sizeof(arrTable));
+
+    if (iSrcSize > COM_LZ4_MF_LIMIT)
+    {
+        while (iPos < iSrcSize - COM_LZ4_MF_LIMIT)
+        {
+            iHash           = (COM_Lz4_Read32(pIn + iPos) * 2654435761U) >> (32 - COM_LZ4_HASH_BITS);
+            iRef            = arrTable[iHash];
+            arrTable[iHash] = iPos + 1;
+
+            if ((!iRef) || (iPos - (iRef - 1) > COM_LZ4_MAX_DISTANCE) || (COM_Lz4_Read32(pIn + iRef - 1) != COM_Lz4_Read32(pIn + iPos)))
+            {
+                iPos++;
+                continue;
+            }
+
+            iRef--;
+
+            /* ~~~ Extend the match, without touching the last literals ~~~ */
+            iLength = COM_LZ4_MIN_MATCH;
+
+            while ((iPos + iLength < iSrcSize - COM_LZ4_LAST_LITERALS) && (pIn[iRef + iLength] == pIn[iPos + iLength]))
+            {
+                iLength++;
+            }
+
+            pOut = COM_Lz4_WriteSequence(pOut, pOutEnd, pIn + iAnchor, iPos - iAnchor, iPos - iRef, iLength);
+
+            if (!pOut)
+            {
+                return 0;
+            }
+
+            iPos   += iLength;
+            iAnchor = iPos;
+        }
+    }
+
+    /* ~~~ Last literals ~~~ */
+    pOut = COM_Lz4_WriteSequence(pOut, pOutEnd, pIn + iAnchor, iSrcSize - iAnchor, 0, 0);
+
+    return pOut ? (size_t) (pOut - (unsigned char *) pDst) : 0;
+}
+
+/*!
+ * \brief  Function to decompress a block.
+ *
+ * \param  pSrc     Pointer to the compressed block.
+ * \param  iSrcSize Size of the compressed block (In bytes).
+ * \param  pDst     Pointer to the output.
+ * \param  iDstSize Size of the output (In bytes).
+ * \return The size of the data, or 0 if the block is corrupted.
+ *
+ * \remark Every read and write is checked, so a corrupted block can't
+ *         overflow the output.
+ */
+size_t COM_Lz4_Decompress(const void *pSrc, size_t iSrcSize, void *pDst, size_t iDstSize)
+{
+    const unsigned char *pIn     = (const unsigned char *) pSrc;
+    const unsigned char *pInEnd  = pIn + iSrcSize;
+    unsigned char       *pOut    = (unsigned char *) pDst;
+    unsigned char       *pOutEnd = pOut + iDstSize;
+    const unsigned char *pMatch  = NULL;
+    size_t               iLength = 0;
+    unsigned int         iToken  = 0;
+    unsigned int         iByte   = 0;
+
+    while (pIn < pInEnd)
+    {
+        iToken = *pIn++;
+
+        /* ~~~ Literals ~~~ */
+        iLength = iToken >> 4;
+
+        if (iLength == 15)
+        {
+            do
+            {
+                if (pIn >= pInEnd)
+                {
+                    return 0;
+                }
+
+                iByte    = *pIn++;
+                iLength += iByte;
+            } while (iByte == 255);
+        }
+
+        if (((size_t) (pInEnd - pIn) < iLength) || ((size_t) (pOutEnd - pOut) < iLength))
+        {
+            return 0;
+        }
+
+        memcpy(pOut, pIn, iLength);
+        pIn  += iLength;
+        pOut += iLength;
+
+        /* ~~~ The last sequence has no match ~~~ */
+        if (pIn == pInEnd)
+        {
+            break;
+        }
+
+        /* ~~~ Match ~~~ */
+        if (pInEnd - pIn < 2)
+        {
+            return 0;
+        }
+
+        iLength = (size_t) pIn[0] | ((size_t) pIn[1] << 8);
+        pIn    += 2;
+
+        if ((!iLength) || (iLength > (size_t) (pOut - (unsigned char *) pDst)))
+        {
+            return 0;
+        }
+
+        pMatch  = pOut - iLength;
+        iLength = iToken & 15;
+
+        if (iLength == 15)
+        {
+            do
+            {
+                if (pIn >= pInEnd)
+                {
+                    return 0;
+                }
+
+                iByte    = *pIn++;
+                iLength += iByte;
+            } while (iByte == 255);
+        }
+
+        iLength += COM_LZ4_MIN_MATCH;
+
+        if ((size_t) (pOutEnd - pOut) < iLength)
+        {
+            return 0;
+        }
+
+        /* ~~~ Byte by byte: the match can overlap the output ~~~ */
+        while (iLength--)
+        {
+            *pOut++ = *pMatch++;
+        }
+    }
+
+    return (size_t) (pOut - (unsigned char *) pDst);
+}
+
+/* ========================================================================= */
@@ -0,0 +1,28 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Lz4.h
+ * \brief   File to interface with the LZ4 block codec.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#ifndef __COM_LZ4_H__
+#define __COM_LZ4_H__
+
+    #include "COM_Shared.h"
+
+    /*! Macro to get the worst size of a compressed block (In bytes). */
+    #define COM_Lz4_Bound(iSize) ((iSize) + ((iSize) / 255) + 16)
+
+    size_t COM_Lz4_Compress  (const void *pSrc, size_t iSrcSize, void *pDst, size_t iDstCapacity);
+    size_t COM_Lz4_Decompress(const void *pSrc, size_t iSrcSize, void *pDst, size_t iDstSize);
+
+#endif // __COM_LZ4_H__
+
+/* ========================================================================= */
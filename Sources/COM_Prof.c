@@ -0,0 +1,304 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Prof.c
+ * \brief   File to handle the profiler.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "COM_Log.h"
+#include "COM_Prof.h"
+#include "COM_Util.h"
+
+#ifdef COM_PROFILE
+
+#include <SDL.h>
+
+/* ========================================================================= */
+
+#ifdef _MSC_VER
+    /*! Storage class of the variables local to a thread. */
+    #define COM_PROF_TLS __declspec(thread)
+#else
+    /*! Storage class of the variables local to a thread. */
+    #define COM_PROF_TLS __thread
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    /*! Macro to read the counter of the zones (Time stamp counter, calibrated at the export). */
+    #define COM_Prof_Counter() ((Uint64) __rdtsc( ))
+#else
+    /*! Macro to read the counter of the zones. */
+    #define COM_Prof_Counter() SDL_GetPerformanceCounter( )
+#endif
+
+/*! Mask to wrap an index in the ring of a thread. */
+#define COM_PROF_RING_MASK (COM_PROF_RING_SIZE - 1)
+
+/* ========================================================================= */
+
+/*!
+ * \struct COM_ProfZone
+ * \brief  Structure to handle a zone recorded.
+ */
+typedef struct
+{
+    const char *szName; /*!< Name of the zone. */
+    Uint64      iStart; /*!< Counter when the zone was opened. */
+    Uint64      iEnd;   /*!< Counter when the zone was closed. */
+} COM_ProfZone;
+
+/*! Typedef to handle the zones of a thread. */
+typedef struct COM_ProfThread COM_ProfThread;
+
+/*!
+ * \struct COM_ProfThread
+ * \brief  Structure to handle the zones of a thread.
+ */
+struct COM_ProfThread
+{
+    COM_ProfZone    arrRing[COM_PROF_RING_SIZE];   /*!< Ring of the zones closed. */
+    COM_ProfZone    arrStack[COM_PROF_MAX_DEPTH];  /*!< Stack of the zones opened. */
+    volatile Uint32 iHead;                         /*!< Number of zones closed since the start. */
+    Uint32          iDepth;                        /*!< Number of zones opened (Can exceed the stack). */
+    unsigned long   iThreadID;                     /*!< Identifier of the thread. */
+    COM_ProfThread *pNext;                         /*!< Pointer to the next thread. */
+};
+
+/*!
+ * \struct COM_Prof
+ * \brief  Structure to handle the profiler.
+ */
+typedef struct
+{
+    COM_ProfThread *pFirstThread; /*!< Pointer to the first thread recorded. */
+    SDL_SpinLock    iLock;        /*!< Lock of the list of threads. */
+    Uint64          iOrigin;      /*!< Counter of the zones at the init. */
+    Uint64          iOriginPerf;  /*!< Performance counter at the init. */
+    char           *szExitPath;   /*!< Path of the trace written by the quit (Can be NULL). */
+} COM_Prof;
+
+/*! Global variable to handle the profiler. */
+static COM_Prof COM_prof;
+
+/*! Global variable to handle the zones of the current thread. */
+static COM_PROF_TLS COM_ProfThread *COM_pProfThread;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the zones of the current thread.
+ *
+ * \return A pointer to the zones of the thread, or NULL if error.
+ *
+ * \remark The zones are allocated at the first zone of the thread, and kept
+ *         until the quit so they can be written after the thread ends.
+ */
+static COM_ProfThread *COM_Prof_GetThread(void)
+{
+    COM_ProfThread *pThread = COM_pProfThread;
+
+    if (!pThread)
+    {
+        pThread = (COM_ProfThread *) UTIL_Malloc(sizeof(COM_ProfThread));
+
+        if (pThread)
+        {
+            pThread->iHead     = 0;
+            pThread->iDepth    = 0;
+            pThread->iThreadID = SDL_ThreadID( );
+
+            SDL_AtomicLock(&COM_prof.iLock);
+            pThread->pNext        = COM_prof.pFirstThread;
+            COM_prof.pFirstThread = pThread;
+            SDL_AtomicUnlock(&COM_prof.iLock);
+
+            COM_pProfThread = pThread;
+        }
+    }
+
+    return pThread;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to initialize the profiler.
+ *
+ * \param  szExitPath Path of the trace written by COM_Prof_Quit (Can be NULL).
+ * \return None.
+ */
+void COM_Prof_Init(const char *szExitPath)
+{
+    COM_prof.pFirstThread = NULL;
+    COM_prof.iLock        = 0;
+    COM_prof.iOrigin      = COM_Prof_Counter( );
+    COM_prof.iOriginPerf  = SDL_GetPerformanceCounter( );
+    COM_prof.szExitPath   = szExitPath ? UTIL_StrCopy(szExitPath) : NULL;
+}
+
+/*!
+ * \brief  Function to open a zone.
+ *
+ * \param  szName Name of the zone (String literal).
+ * \return None.
+ */
+void COM_Prof_Begin(const char *szName)
+{
+    COM_ProfThread *pThread = COM_Prof_GetThread( );
+    COM_ProfZone   *pZone   = NULL;
+
+    if (pThread)
+    {
+        if (pThread->iDepth < COM_PROF_MAX_DEPTH)
+        {
+            pZone         = &pThread->arrStack[pThread->iDepth];
+            pZone->szName = szName;
+            pZone->iStart = COM_Prof_Counter( );
+        }
+
+        pThread->iDepth++;
+    }
+}
+
+/*!
+ * \brief  Function to close the last zone opened.
+ *
+ * \return None.
+ */
+void COM_Prof_End(void)
+{
+    COM_ProfThread *pThread = COM_pProfThread;
+    COM_ProfZone   *pZone   = NULL;
+    Uint64          iEnd    = COM_Prof_Counter( );
+    Uint32          iHead   = 0;
+
+    if (pThread && pThread->iDepth)
+    {
+        pThread->iDepth--;
+
+        if (pThread->iDepth < COM_PROF_MAX_DEPTH)
+        {
+            iHead       = pThread->iHead;
+            pZone       = &pThread->arrRing[iHead & COM_PROF_RING_MASK];
+            *pZone      = pThread->arrStack[pThread->iDepth];
+            pZone->iEnd = iEnd;
+
+            /* ~~~ Publish the zone to the export (Only the owner writes the head) ~~~ */
+            SDL_MemoryBarrierRelease( );
+            pThread->iHead = iHead + 1;
+        }
+    }
+}
+
+/*!
+ * \brief  Function to write the zones recorded in a trace file.
+ *
+ * \param  szPath Path of the trace file.
+ * \return 1 on success, else 0.
+ *
+ * \remark The file is a JSON trace for chrome://tracing or Perfetto. The
+ *         zones closed by another thread during the export can be torn.
+ */
+int COM_Prof_Export(const char *szPath)
+{
+    COM_ProfThread *pThread = NULL;
+    COM_ProfZone   *pZone   = NULL;
+    FILE           *pFile   = UTIL_FileOpen(szPath, "w");
+    const char     *szSep   = "";
+    double          dToUs   = 0.0;
+    Uint64          iTicks  = 0;
+    Uint32          iHead   = 0;
+    Uint32          iCount  = 0;
+    Uint32          i       = 0;
+
+    if (!pFile)
+    {
+        return 0;
+    }
+
+    /* ~~~ Rate of the counter of the zones, measured since the init ~~~ */
+    iTicks = COM_Prof_Counter( ) - COM_prof.iOrigin;
+    dToUs  = (double) (SDL_GetPerformanceCounter( ) - COM_prof.iOriginPerf) * 1000000.0 / (double) SDL_GetPerformanceFrequency( );
+    dToUs  = iTicks ? (dToUs / (double) iTicks) : 0.0;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", pFile);
+
+    SDL_AtomicLock(&COM_prof.iLock);
+
+    for (pThread = COM_prof.pFirstThread ; pThread ; pThread = pThread->pNext)
+    {
+        iHead  = pThread->iHead;
+        SDL_MemoryBarrierAcquire( );
+        iCount = (iHead < COM_PROF_RING_SIZE) ? iHead : COM_PROF_RING_SIZE;
+
+        for (i = iHead - iCount ; i != iHead ; ++i)
+        {
+            pZone = &pThread->arrRing[i & COM_PROF_RING_MASK];
+
+            fprintf(pFile, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                    szSep, pZone->szName, pThread->iThreadID,
+                    (double) (pZone->iStart - COM_prof.iOrigin) * dToUs,
+                    (double) (pZone->iEnd - pZone->iStart) * dToUs);
+
+            szSep = ",\n";
+        }
+    }
+
+    SDL_AtomicUnlock(&COM_prof.iLock);
+
+    fputs("\n]}\n", pFile);
+    UTIL_FileClose(&pFile);
+
+    COM_Log_Print(COM_LOG_INFO, "Profiler trace written: \"%s\".", szPath);
+
+    return 1;
+}
+
+/*!
+ * \brief  Function to close the profiler.
+ *
+ * \return None.
+ *
+ * \remark The trace is written if a path was given to the init. No zone
+ *         must be opened after the quit.
+ */
+void COM_Prof_Quit(void)
+{
+    COM_ProfThread *pThread = NULL;
+
+    if (COM_prof.szExitPath)
+    {
+        COM_Prof_Export(COM_prof.szExitPath);
+        UTIL_Free(COM_prof.szExitPath);
+    }
+
+    SDL_AtomicLock(&COM_prof.iLock);
+
+    while (COM_prof.pFirstThread)
+    {
+        pThread               = COM_prof.pFirstThread;
+        COM_prof.pFirstThread = pThread->pNext;
+
+        UTIL_Free(pThread);
+    }
+
+    SDL_AtomicUnlock(&COM_prof.iLock);
+
+    COM_pProfThread = NULL;
+}
+
+#endif // COM_PROFILE
+
+/* ========================================================================= */
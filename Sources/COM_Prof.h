@@ -0,0 +1,73 @@
+/* ========================================================================= */
+/*!
+ * \file    COM_Prof.h
+ * \brief   File to interface with the profiler.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Document where the main calls the init and the quit. */
+/* ========================================================================= */
+
+#ifndef __COM_PROF_H__
+#define __COM_PROF_H__
+
+    #include "COM_Shared.h"
+
+    /*
+     * The zones are compiled only when COM_PROFILE is defined, else every
+     * macro below expands to nothing. A zone is opened by COM_PROF_BEGIN and
+     * closed by COM_PROF_END in the same function, before each return.
+     *
+     *     COM_PROF_BEGIN("ENG_Scheduler_Draw");
+     *     ...
+     *     COM_PROF_END( );
+     *
+     * The name is kept as a pointer, so it must be a string literal.
+     *
+     * The main calls COM_PROF_INIT right after COM_Log_Init, before any
+     * thread is started, with the path of the trace written at the exit (Or
+     * NULL, and COM_PROF_EXPORT when needed). It calls COM_PROF_QUIT once
+     * the threads are stopped (After SDL_Precache_Free), before COM_Log_Quit.
+     * See Tools/Bench ('--trace').
+     */
+
+    #ifdef COM_PROFILE
+        /*! Number of zones kept for each thread (Power of two, the oldest are overwritten). */
+        #ifndef COM_PROF_RING_SIZE
+            #define COM_PROF_RING_SIZE  32768
+        #endif
+        /*! Maximum number of zones opened at the same time in a thread. */
+        #define COM_PROF_MAX_DEPTH      32
+
+        /*! Macro to initialize the profiler. */
+        #define COM_PROF_INIT(szPath)   COM_Prof_Init(szPath)
+        /*! Macro to open a zone. */
+        #define COM_PROF_BEGIN(szName)  COM_Prof_Begin(szName)
+        /*! Macro to close the last zone opened. */
+        #define COM_PROF_END()          COM_Prof_End( )
+        /*! Macro to write the zones recorded in a trace file. */
+        #define COM_PROF_EXPORT(szPath) COM_Prof_Export(szPath)
+        /*! Macro to close the profiler. */
+        #define COM_PROF_QUIT()         COM_Prof_Quit( )
+
+        void COM_Prof_Init  (const char *szExitPath);
+        void COM_Prof_Begin (const char *szName);
+        void COM_Prof_End   (void);
+        int  COM_Prof_Export(const char *szPath);
+        void COM_Prof_Quit  (void);
+    #else
+        #define COM_PROF_INIT(szPath)   ((void) 0)
+        #define COM_PROF_BEGIN(szName)  ((void) 0)
+        #define COM_PROF_END()          ((void) 0)
+        #define COM_PROF_EXPORT(szPath) (0)
+        #define COM_PROF_QUIT()         ((void) 0)
+    #endif // COM_PROFILE
+
+#endif // __COM_PROF_H__
+
+/* ========================================================================= */
@@ -12,17 +12,437 @@
 /* Nyuu    | 09/06/15 | Creation.                                            */
 /* Orlyn   | 10/06/15 | Add new functions UTIL_*                             */
 /* Orlyn   | 11/06/15 | Add UTIL_StrCopy                                     */
+/* Nyuu    | 18/10/26 | Count the allocations in every build.                */
+/* Nyuu    | 18/10/26 | Track the blocks by call site (Debug).               */
+/* Nyuu    | 18/10/26 | Check the allocations of the frame loop (Debug).     */
+/* Nyuu    | 18/10/26 | Track a realloc under the lock of the tracker.       */
+/* Nyuu    | 18/10/26 | Count the allocations with an atomic (Workers).      */
 /* ========================================================================= */
 
+#include <SDL.h>
+
 #include "COM_Log.h"
 #include "COM_Util.h"
 
 /* ========================================================================= */
 
+/*! Global variable to count the blocks allocated since the start (Workers included) */
+static SDL_atomic_t COM_iAllocTotal;
+
+/* ========================================================================= */
+
 #ifdef _DEBUG
 
-/*! Global variable to count the allocations */
-static unsigned int COM_iMallocCounter;
+/*! Initial capacity of the tables of the tracker (Power of two). */
+#define COM_MEM_INITIAL 1024
+
+/*!
+ * \struct COM_MemSite
+ * \brief  Structure to handle a call site of the allocations.
+ */
+typedef struct
+{
+    const char *szFile;        /*!< File of the call. */
+    const char *szFct;         /*!< Function of the call. */
+    size_t      iLine;         /*!< Line of the call. */
+    size_t      iLiveBlocks;   /*!< Number of blocks still allocated. */
+    size_t      iLiveBytes;    /*!< Bytes still allocated. */
+    size_t      iPeakBytes;    /*!< Highest number of bytes allocated at the same time. */
+    size_t      iNbAllocs;     /*!< Number of allocations since the start. */
+    size_t      iNbReported;   /*!< Number of allocations at the last report. */
+} COM_MemSite;
+
+/*!
+ * \struct COM_MemBlock
+ * \brief  Structure to handle a block allocated.
+ */
+typedef struct
+{
+    void   *pMemory; /*!< Block (NULL => Empty slot). */
+    size_t  iSize;   /*!< Size of the block. */
+    size_t  iSite;   /*!< Call site of the allocation. */
+} COM_MemBlock;
+
+/*!
+ * \struct COM_Mem
+ * \brief  Structure to handle the tracker of the allocations.
+ *
+ * \remark The blocks and the sites are in open addressing tables, allocated
+ *         with malloc (Not tracked).
+ */
+typedef struct
+{
+    SDL_SpinLock  iLock;         /*!< Lock of the tracker (Allocations done by the workers). */
+    COM_MemBlock *pArrBlocks;    /*!< Table of the blocks allocated. */
+    size_t        iMaxBlocks;    /*!< Capacity of the table of the blocks. */
+    size_t        iNbBlocks;     /*!< Number of blocks allocated. */
+    COM_MemSite  *pArrSites;     /*!< Array of the call sites. */
+    size_t        iNbSites;      /*!< Number of call sites. */
+    size_t       *pArrIndex;     /*!< Table of the call sites (Index + 1, 0 => Empty). */
+    size_t        iMaxIndex;     /*!< Capacity of the table of the call sites. */
+    size_t        iLiveBytes;    /*!< Bytes allocated. */
+    size_t        iPeakBytes;    /*!< Highest number of bytes allocated. */
+    size_t        iNbUntracked;  /*!< Number of blocks not tracked (Tables full). */
+    size_t        iNbUnknown;    /*!< Number of blocks freed but not tracked. */
+    Uint32        iLastReport;   /*!< Time of the last report (In ms). */
+} COM_Mem;
+
+/*! Global variable to handle the tracker of the allocations. */
+static COM_Mem COM_mem;
+
+/*! Maximum number of call sites listed in the report of a frame. */
+#define COM_FRAME_MAX_SITES 16
+
+/*!
+ * \struct COM_FrameSite
+ * \brief  Structure to handle a call site of the events of a frame.
+ */
+typedef struct
+{
+    const char      *szFct;  /*!< Function of the call. */
+    const char      *szFile; /*!< File of the call. */
+    size_t           iLine;  /*!< Line of the call. */
+    UTIL_FrameEvent  iEvent; /*!< Event of the call. */
+    size_t           iCount; /*!< Number of events in the frame. */
+} COM_FrameSite;
+
+/*!
+ * \struct COM_Frame
+ * \brief  Structure to handle the check of the frame loop.
+ */
+typedef struct
+{
+    SDL_bool       bInside;                         /*!< Flag set between UTIL_FrameBegin and UTIL_FrameEnd. */
+    SDL_threadID   iThread;                         /*!< Thread of the frame loop. */
+    Uint32         iFrame;                          /*!< Number of frames ended. */
+    Uint32         iWarmup;                         /*!< Number of frames not checked. */
+    SDL_bool       bTrap;                           /*!< Flag set to stop on the first event. */
+    size_t         arrCounts[UTIL_FRAME_EVENTS];    /*!< Number of events of the frame. */
+    COM_FrameSite  arrSites[COM_FRAME_MAX_SITES];   /*!< Call sites of the events of the frame. */
+    size_t         iNbSites;                        /*!< Number of call sites of the frame. */
+    Uint32         iNbDirty;                        /*!< Number of frames checked with events. */
+} COM_Frame;
+
+/*! Global variable to handle the check of the frame loop. */
+static COM_Frame COM_frame;
+
+/*! Names of the events of the frame loop (See UTIL_FrameEvent). */
+static const char *COM_szFrameEvents[] = {"malloc", "realloc", "free", "texture"};
+
+/*!
+ * \brief  Function to get the first slot to probe in a table.
+ *
+ * \param  iKey Key (Block, or call site).
+ * \param  iMax Capacity of the table (Power of two).
+ * \return The first slot to probe.
+ */
+static size_t COM_Mem_Hash(Uint64 iKey, size_t iMax)
+{
+    return (size_t) ((iKey * 11400714819323198485ULL) >> 32) & (iMax - 1);
+}
+
+/*! Macro to get the key of a block. */
+#define COM_Mem_BlockKey(pMemory)     (((Uint64) (size_t) (pMemory)) >> 4)
+/*! Macro to get the key of a call site. */
+#define COM_Mem_SiteKey(szFile,iLine) (((Uint64) (size_t) (szFile)) ^ ((Uint64) (iLine) << 40))
+
+/*!
+ * \brief  Function to get a call site, added if it is new.
+ *
+ * \param  szFct  Function of the call.
+ * \param  iLine  Line of the call.
+ * \param  szFile File of the call.
+ * \return The index of the call site, or (size_t) -1 if the tables are full.
+ *
+ * \remark The lock of the tracker must be held.
+ */
+static size_t COM_Mem_Site(const char *szFct, size_t iLine, const char *szFile)
+{
+    COM_MemSite *pSite   = NULL;
+    size_t      *pIndex  = NULL;
+    size_t       iMax    = 0;
+    size_t       iSlot   = 0;
+    size_t       i       = 0;
+
+    /* ~~~ Table at most half full ~~~ */
+    if (COM_mem.iNbSites * 2 >= COM_mem.iMaxIndex)
+    {
+        iMax   = COM_mem.iMaxIndex ? (COM_mem.iMaxIndex * 2) : COM_MEM_INITIAL;
+        pIndex = (size_t *) calloc(iMax, sizeof(size_t));
+        pSite  = (COM_MemSite *) realloc(COM_mem.pArrSites, sizeof(COM_MemSite) * iMax / 2);
+
+        if (pSite)
+        {
+            COM_mem.pArrSites = pSite;
+        }
+
+        if (!pIndex || !pSite)
+        {
+            free(pIndex);
+            return (size_t) -1;
+        }
+
+        free(COM_mem.pArrIndex);
+        COM_mem.pArrIndex = pIndex;
+        COM_mem.iMaxIndex = iMax;
+
+        for (i = 0; i < COM_mem.iNbSites; i++)
+        {
+            iSlot = COM_Mem_Hash(COM_Mem_SiteKey(COM_mem.pArrSites[i].szFile, COM_mem.pArrSites[i].iLine), iMax);
+
+            while (pIndex[iSlot])
+            {
+                iSlot = (iSlot + 1) & (iMax - 1);
+            }
+
+            pIndex[iSlot] = i + 1;
+        }
+    }
+
+    /* ~~~ Same site => Same pointer to the file and same line ~~~ */
+    iSlot = COM_Mem_Hash(COM_Mem_SiteKey(szFile, iLine), COM_mem.iMaxIndex);
+
+    while (COM_mem.pArrIndex[iSlot])
+    {
+        pSite = &COM_mem.pArrSites[COM_mem.pArrIndex[iSlot] - 1];
+
+        if ((pSite->szFile == szFile) && (pSite->iLine == iLine))
+        {
+            return COM_mem.pArrIndex[iSlot] - 1;
+        }
+
+        iSlot = (iSlot + 1) & (COM_mem.iMaxIndex - 1);
+    }
+
+    pSite = &COM_mem.pArrSites[COM_mem.iNbSites];
+    memset(pSite, 0, sizeof(COM_MemSite));
+    pSite->szFile = szFile;
+    pSite->szFct  = szFct;
+    pSite->iLine  = iLine;
+
+    COM_mem.pArrIndex[iSlot] = ++COM_mem.iNbSites;
+
+    return COM_mem.iNbSites - 1;
+}
+
+/*!
+ * \brief  Function to track a block allocated.
+ *
+ * \param  pMemory Block.
+ * \param  iSize   Size of the block.
+ * \param  szFct   Function of the call.
+ * \param  iLine   Line of the call.
+ * \param  szFile  File of the call.
+ * \return None.
+ *
+ * \remark The lock of the tracker must be held.
+ */
+static void COM_Mem_Add(void *pMemory, size_t iSize, const char *szFct, size_t iLine, const char *szFile)
+{
+    COM_MemBlock *pArrOld = COM_mem.pArrBlocks;
+    COM_MemSite  *pSite   = NULL;
+    size_t        iMaxOld = COM_mem.iMaxBlocks;
+    size_t        iSite   = COM_Mem_Site(szFct, iLine, szFile);
+    size_t        iSlot   = 0;
+    size_t        i       = 0;
+
+    if (iSite == (size_t) -1)
+    {
+        COM_mem.iNbUntracked++;
+        return;
+    }
+
+    /* ~~~ Table at most half full ~~~ */
+    if (COM_mem.iNbBlocks * 2 >= COM_mem.iMaxBlocks)
+    {
+        COM_mem.iMaxBlocks = iMaxOld ? (iMaxOld * 2) : COM_MEM_INITIAL;
+        COM_mem.pArrBlocks = (COM_MemBlock *) calloc(COM_mem.iMaxBlocks, sizeof(COM_MemBlock));
+
+        if (!COM_mem.pArrBlocks)
+        {
+            COM_mem.pArrBlocks = pArrOld;
+            COM_mem.iMaxBlocks = iMaxOld;
+            COM_mem.iNbUntracked++;
+            return;
+        }
+
+        for (i = 0; i < iMaxOld; i++)
+        {
+            if (pArrOld[i].pMemory)
+            {
+                iSlot = COM_Mem_Hash(COM_Mem_BlockKey(pArrOld[i].pMemory), COM_mem.iMaxBlocks);
+
+                while (COM_mem.pArrBlocks[iSlot].pMemory)
+                {
+                    iSlot = (iSlot + 1) & (COM_mem.iMaxBlocks - 1);
+                }
+
+                COM_mem.pArrBlocks[iSlot] = pArrOld[i];
+            }
+        }
+
+        free(pArrOld);
+    }
+
+    iSlot = COM_Mem_Hash(COM_Mem_BlockKey(pMemory), COM_mem.iMaxBlocks);
+
+    while (COM_mem.pArrBlocks[iSlot].pMemory)
+    {
+        iSlot = (iSlot + 1) & (COM_mem.iMaxBlocks - 1);
+    }
+
+    COM_mem.pArrBlocks[iSlot].pMemory = pMemory;
+    COM_mem.pArrBlocks[iSlot].iSize   = iSize;
+    COM_mem.pArrBlocks[iSlot].iSite   = iSite;
+    COM_mem.iNbBlocks++;
+
+    pSite = &COM_mem.pArrSites[iSite];
+    pSite->iLiveBlocks++;
+    pSite->iLiveBytes += iSize;
+    pSite->iNbAllocs++;
+    pSite->iPeakBytes  = SDL_max(pSite->iPeakBytes, pSite->iLiveBytes);
+
+    COM_mem.iLiveBytes += iSize;
+    COM_mem.iPeakBytes  = SDL_max(COM_mem.iPeakBytes, COM_mem.iLiveBytes);
+    SDL_AtomicAdd(&COM_iAllocTotal, 1);
+}
+
+/*!
+ * \brief  Function to stop tracking a block freed.
+ *
+ * \param  pMemory Block.
+ * \return None.
+ *
+ * \remark The lock of the tracker must be held.
+ */
+static void COM_Mem_Remove(void *pMemory)
+{
+    COM_MemSite *pSite = NULL;
+    size_t       iMask = COM_mem.iMaxBlocks - 1;
+    size_t       iSlot = 0;
+    size_t       iNext = 0;
+    size_t       iHome = 0;
+
+    if (!COM_mem.iMaxBlocks)
+    {
+        COM_mem.iNbUnknown++;
+        return;
+    }
+
+    iSlot = COM_Mem_Hash(COM_Mem_BlockKey(pMemory), COM_mem.iMaxBlocks);
+
+    while (COM_mem.pArrBlocks[iSlot].pMemory != pMemory)
+    {
+        if (!COM_mem.pArrBlocks[iSlot].pMemory)
+        {
+            COM_mem.iNbUnknown++;
+            return;
+        }
+
+        iSlot = (iSlot + 1) & iMask;
+    }
+
+    pSite = &COM_mem.pArrSites[COM_mem.pArrBlocks[iSlot].iSite];
+    pSite->iLiveBlocks--;
+    pSite->iLiveBytes  -= COM_mem.pArrBlocks[iSlot].iSize;
+    COM_mem.iLiveBytes -= COM_mem.pArrBlocks[iSlot].iSize;
+    COM_mem.iNbBlocks--;
+
+    /* ~~~ Shift back the next blocks of the cluster (No tombstone) ~~~ */
+    for (iNext = (iSlot + 1) & iMask; COM_mem.pArrBlocks[iNext].pMemory; iNext = (iNext + 1) & iMask)
+    {
+        iHome = COM_Mem_Hash(COM_Mem_BlockKey(COM_mem.pArrBlocks[iNext].pMemory), COM_mem.iMaxBlocks);
+
+        if (((iNext - iHome) & iMask) >= ((iNext - iSlot) & iMask))
+        {
+            COM_mem.pArrBlocks[iSlot] = COM_mem.pArrBlocks[iNext];
+            iSlot                     = iNext;
+        }
+    }
+
+    COM_mem.pArrBlocks[iSlot].pMemory = NULL;
+}
+
+/*!
+ * \brief  Function to compare the call sites by bytes allocated (qsort).
+ *
+ * \param  pA First call site.
+ * \param  pB Second call site.
+ * \return Less than 0, 0 or more than 0.
+ */
+static int COM_Mem_CompareSites(const void *pA, const void *pB)
+{
+    const COM_MemSite *pSiteA = *(const COM_MemSite * const *) pA;
+    const COM_MemSite *pSiteB = *(const COM_MemSite * const *) pB;
+
+    if (pSiteA->iLiveBytes != pSiteB->iLiveBytes)
+    {
+        return (pSiteA->iLiveBytes < pSiteB->iLiveBytes) ? 1 : -1;
+    }
+
+    return (pSiteA->iPeakBytes < pSiteB->iPeakBytes) ? 1 : ((pSiteA->iPeakBytes > pSiteB->iPeakBytes) ? -1 : 0);
+}
+
+/*!
+ * \brief  Function to copy the call sites sorted by bytes allocated.
+ *
+ * \param  pNbSites Pointer to the number of call sites.
+ * \return The array of the call sites (To free with free), or NULL.
+ *
+ * \remark The sites are copied, so they are logged without the lock.
+ */
+static COM_MemSite *COM_Mem_SortSites(size_t *pNbSites)
+{
+    COM_MemSite  *pArrCopy = NULL;
+    COM_MemSite **pArrSort = NULL;
+    COM_MemSite  *pArrOut  = NULL;
+    size_t        i        = 0;
+
+    SDL_AtomicLock(&COM_mem.iLock);
+
+    *pNbSites = COM_mem.iNbSites;
+    pArrCopy  = (COM_MemSite *) malloc(sizeof(COM_MemSite) * (*pNbSites + 1));
+
+    if (pArrCopy)
+    {
+        memcpy(pArrCopy, COM_mem.pArrSites, sizeof(COM_MemSite) * *pNbSites);
+
+        for (i = 0; i < *pNbSites; i++)
+        {
+            COM_mem.pArrSites[i].iNbReported = COM_mem.pArrSites[i].iNbAllocs;
+        }
+    }
+
+    SDL_AtomicUnlock(&COM_mem.iLock);
+
+    pArrSort = (COM_MemSite **) malloc(sizeof(COM_MemSite *) * (*pNbSites + 1));
+    pArrOut  = (COM_MemSite *) malloc(sizeof(COM_MemSite) * (*pNbSites + 1));
+
+    if (pArrCopy && pArrSort && pArrOut)
+    {
+        for (i = 0; i < *pNbSites; i++)
+        {
+            pArrSort[i] = &pArrCopy[i];
+        }
+
+        qsort(pArrSort, *pNbSites, sizeof(COM_MemSite *), COM_Mem_CompareSites);
+
+        for (i = 0; i < *pNbSites; i++)
+        {
+            pArrOut[i] = *pArrSort[i];
+        }
+    }
+    else
+    {
+        free(pArrOut);
+        pArrOut = NULL;
+    }
+
+    free(pArrCopy);
+    free(pArrSort);
+
+    return pArrOut;
+}
 
 /*!
  * \brief Function to allocate a memory block (Debug).
@@ -39,14 +459,15 @@ void *UTIL_MallocEx(size_t iSize, const char *szFct, size_t iLine, const char *s
 
     if (pAllocatedMemory != NULL)
     {
-        COM_Log_Print(COM_LOG_DEBUG, "File %s (l. %d) - Function %s:", szFile, iLine, szFct);
-        COM_Log_Print(COM_LOG_DEBUG, ">> UTIL_Malloc: %u bytes (@: %p).", iSize, pAllocatedMemory);
+        SDL_AtomicLock(&COM_mem.iLock);
+        COM_Mem_Add(pAllocatedMemory, iSize, szFct, iLine, szFile);
+        SDL_AtomicUnlock(&COM_mem.iLock);
 
-        COM_iMallocCounter++;
+        UTIL_FrameCountEx(UTIL_FRAME_MALLOC, szFct, iLine, szFile);
     }
     else
     {
-        COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory!", iSize);
+        COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory (%s l. %u) !", iSize, szFile, iLine);
     }
 
     return pAllocatedMemory;
@@ -61,31 +482,39 @@ void *UTIL_MallocEx(size_t iSize, const char *szFct, size_t iLine, const char *s
  * \param iLine           Line of the call to malloc.
  * \param szFile          Name of the file where the function is located.
  * \return A pointer to the (re)allocated block, or NULL if error
+ *
+ * \remark The block is counted for the call site of the last realloc. On a
+ *         failure, the old block is still allocated, so it is still tracked.
+ *         The lock is held across realloc: once the old block is freed, a
+ *         worker can get its address before it is untracked here.
 */
 void *UTIL_ReallocEx(void *pOldMemoryBlock, size_t iNewSize, const char *szFct, size_t iLine, const char *szFile)
 {
     void *pNewMemoryBlock;
 
+    SDL_AtomicLock(&COM_mem.iLock);
+
     pNewMemoryBlock = realloc(pOldMemoryBlock, iNewSize);
 
     if (pNewMemoryBlock != NULL)
     {
-        if(pOldMemoryBlock == NULL)
+        if (pOldMemoryBlock != NULL)
         {
-            COM_iMallocCounter++;
+            COM_Mem_Remove(pOldMemoryBlock);
         }
 
-        COM_Log_Print(COM_LOG_DEBUG, "File %s (l. %d) - Function %s:", szFile, iLine, szFct);
-        COM_Log_Print(COM_LOG_DEBUG, ">> UTIL_Realloc: %u bytes (@: %p -> %p).", iNewSize, pOldMemoryBlock, pNewMemoryBlock);
+        COM_Mem_Add(pNewMemoryBlock, iNewSize, szFct, iLine, szFile);
+    }
+
+    SDL_AtomicUnlock(&COM_mem.iLock);
+
+    if (pNewMemoryBlock != NULL)
+    {
+        UTIL_FrameCountEx(pOldMemoryBlock ? UTIL_FRAME_REALLOC : UTIL_FRAME_MALLOC, szFct, iLine, szFile);
     }
     else
     {
-        if(pOldMemoryBlock != NULL)
-        {
-            COM_iMallocCounter--;
-        }
-
-        COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory!", iNewSize);
+        COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory (%s l. %u) !", iNewSize, szFile, iLine);
     }
 
     return pNewMemoryBlock;
@@ -104,17 +533,211 @@ void UTIL_FreeEx(void** ppMemory, const char *szFct, size_t iLine, const char *s
 {
     if (*ppMemory != NULL)
     {
-      free(*ppMemory);
+        SDL_AtomicLock(&COM_mem.iLock);
+        COM_Mem_Remove(*ppMemory);
+        SDL_AtomicUnlock(&COM_mem.iLock);
 
-      COM_iMallocCounter--;
-    }
+        free(*ppMemory);
 
-    COM_Log_Print(COM_LOG_DEBUG, "File %s (l. %d) - Function %s:", szFile, iLine, szFct);
-    COM_Log_Print(COM_LOG_DEBUG, ">> UTIL_Free: still %u blocks remaining (@: %p).", COM_iMallocCounter, *ppMemory);
+        UTIL_FrameCountEx(UTIL_FRAME_FREE, szFct, iLine, szFile);
+    }
 
     *ppMemory = NULL;
 }
 
+/*!
+ * \brief Function to log the allocations of each call site (Debug).
+ *
+ * \return None.
+ *
+ * \remark The rates are computed since the last report (Or the start).
+ */
+void UTIL_MemReport(void)
+{
+    COM_MemSite *pArrSites = NULL;
+    COM_Mem      sTotals;
+    size_t       iNbSites  = 0;
+    Uint32       iNow      = SDL_GetTicks( );
+    double       dSeconds  = (double) (iNow - COM_mem.iLastReport) / 1000.0;
+    size_t       i         = 0;
+
+    SDL_AtomicLock(&COM_mem.iLock);
+    sTotals = COM_mem;
+    SDL_AtomicUnlock(&COM_mem.iLock);
+
+    pArrSites           = COM_Mem_SortSites(&iNbSites);
+    COM_mem.iLastReport = iNow;
+
+    COM_Log_Print(COM_LOG_INFO, "Memory: %u blocks, %u KB allocated (Peak %u KB), %u call sites, %u untracked, %u unknown frees.",
+                  (unsigned int) sTotals.iNbBlocks, (unsigned int) (sTotals.iLiveBytes / 1024), (unsigned int) (sTotals.iPeakBytes / 1024),
+                  (unsigned int) iNbSites, (unsigned int) sTotals.iNbUntracked, (unsigned int) sTotals.iNbUnknown);
+
+    for (i = 0; pArrSites && (i < iNbSites); i++)
+    {
+        COM_Log_Print(COM_LOG_INFO, ">> %-24s l. %-5u %-32s live %8u B (%6u blocks), peak %8u B, %8.1f allocs/s.",
+                      pArrSites[i].szFile, (unsigned int) pArrSites[i].iLine, pArrSites[i].szFct,
+                      (unsigned int) pArrSites[i].iLiveBytes, (unsigned int) pArrSites[i].iLiveBlocks, (unsigned int) pArrSites[i].iPeakBytes,
+                      dSeconds > 0.0 ? (double) (pArrSites[i].iNbAllocs - pArrSites[i].iNbReported) / dSeconds : 0.0);
+    }
+
+    free(pArrSites);
+
+    if (COM_frame.iFrame > COM_frame.iWarmup)
+    {
+        COM_Log_Print(COM_LOG_INFO, "Frames: %u of %u checked with allocations or textures created.",
+                      COM_frame.iNbDirty, COM_frame.iFrame - COM_frame.iWarmup);
+    }
+}
+
+/*!
+ * \brief  Function to log the blocks still allocated, by call site (Debug).
+ *
+ * \return The number of blocks still allocated.
+ *
+ * \remark To call at exit, once everything is freed.
+ */
+size_t UTIL_MemLeaks(void)
+{
+    COM_MemSite *pArrSites = NULL;
+    size_t       iNbSites  = 0;
+    size_t       iNbBlocks = COM_mem.iNbBlocks;
+    size_t       i         = 0;
+
+    if (!iNbBlocks)
+    {
+        COM_Log_Print(COM_LOG_INFO, "Memory: no leak.");
+    }
+    else
+    {
+        pArrSites = COM_Mem_SortSites(&iNbSites);
+
+        COM_Log_Print(COM_LOG_WARNING, "Memory: %u blocks leaked (%u bytes) !", (unsigned int) iNbBlocks, (unsigned int) COM_mem.iLiveBytes);
+
+        for (i = 0; pArrSites && (i < iNbSites) && pArrSites[i].iLiveBlocks; i++)
+        {
+            COM_Log_Print(COM_LOG_WARNING, ">> %u bytes in %u blocks allocated by %s (%s l. %u).",
+                          (unsigned int) pArrSites[i].iLiveBytes, (unsigned int) pArrSites[i].iLiveBlocks,
+                          pArrSites[i].szFct, pArrSites[i].szFile, (unsigned int) pArrSites[i].iLine);
+        }
+
+        free(pArrSites);
+    }
+
+    return iNbBlocks;
+}
+
+/*!
+ * \brief Function to set the check of the frame loop (Debug).
+ *
+ * \param iWarmup Number of frames not checked (Loading, first spawns...).
+ * \param bTrap   Flag set to stop the debugger on the first event checked.
+ * \return None.
+ */
+void UTIL_FrameCheck(unsigned int iWarmup, int bTrap)
+{
+    COM_frame.iWarmup = iWarmup;
+    COM_frame.bTrap   = bTrap ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief Function to mark the start of a frame (Debug).
+ *
+ * \return None.
+ *
+ * \remark Only the events of the thread calling it are counted.
+ */
+void UTIL_FrameBegin(void)
+{
+    COM_frame.iThread = SDL_ThreadID( );
+    COM_frame.bInside = (COM_frame.iFrame >= COM_frame.iWarmup) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief Function to count an event of the frame loop (Debug).
+ *
+ * \param iEvent Event (See UTIL_FrameEvent).
+ * \param szFct  Function of the call.
+ * \param iLine  Line of the call.
+ * \param szFile File of the call.
+ * \return None.
+ */
+void UTIL_FrameCountEx(UTIL_FrameEvent iEvent, const char *szFct, size_t iLine, const char *szFile)
+{
+    COM_FrameSite *pSite = NULL;
+    size_t         i     = 0;
+
+    if (!COM_frame.bInside || (SDL_ThreadID( ) != COM_frame.iThread))
+    {
+        return;
+    }
+
+    COM_frame.arrCounts[iEvent]++;
+
+    for (i = 0; (i < COM_frame.iNbSites) && !pSite; i++)
+    {
+        if ((COM_frame.arrSites[i].szFile == szFile) && (COM_frame.arrSites[i].iLine == iLine) && (COM_frame.arrSites[i].iEvent == iEvent))
+        {
+            pSite = &COM_frame.arrSites[i];
+        }
+    }
+
+    /* ~~~ The sites beyond the limit are only in the totals ~~~ */
+    if (!pSite && (COM_frame.iNbSites < COM_FRAME_MAX_SITES))
+    {
+        pSite         = &COM_frame.arrSites[COM_frame.iNbSites++];
+        pSite->szFct  = szFct;
+        pSite->szFile = szFile;
+        pSite->iLine  = iLine;
+        pSite->iEvent = iEvent;
+        pSite->iCount = 0;
+    }
+
+    if (pSite)
+    {
+        pSite->iCount++;
+    }
+
+    if (COM_frame.bTrap)
+    {
+        COM_Log_Print(COM_LOG_CRITICAL, "Frame %u: %s in the frame loop by %s (%s l. %u) !",
+                      COM_frame.iFrame, COM_szFrameEvents[iEvent], szFct, szFile, (unsigned int) iLine);
+        COM_Log_Flush( );
+
+        SDL_TriggerBreakpoint( );
+    }
+}
+
+/*!
+ * \brief Function to mark the end of a frame, and report its events (Debug).
+ *
+ * \return None.
+ */
+void UTIL_FrameEnd(void)
+{
+    size_t i = 0;
+
+    if (COM_frame.iNbSites)
+    {
+        COM_frame.iNbDirty++;
+
+        COM_Log_Print(COM_LOG_WARNING, "Frame %u: %u mallocs, %u reallocs, %u frees and %u textures in the frame loop (%u frames so far).",
+                      COM_frame.iFrame, (unsigned int) COM_frame.arrCounts[UTIL_FRAME_MALLOC], (unsigned int) COM_frame.arrCounts[UTIL_FRAME_REALLOC],
+                      (unsigned int) COM_frame.arrCounts[UTIL_FRAME_FREE], (unsigned int) COM_frame.arrCounts[UTIL_FRAME_TEXTURE], COM_frame.iNbDirty);
+
+        for (i = 0; i < COM_frame.iNbSites; i++)
+        {
+            COM_Log_Print(COM_LOG_WARNING, ">> %4u %-7s by %s (%s l. %u).",
+                          (unsigned int) COM_frame.arrSites[i].iCount, COM_szFrameEvents[COM_frame.arrSites[i].iEvent],
+                          COM_frame.arrSites[i].szFct, COM_frame.arrSites[i].szFile, (unsigned int) COM_frame.arrSites[i].iLine);
+        }
+    }
+
+    memset(COM_frame.arrCounts, 0, sizeof(COM_frame.arrCounts));
+    COM_frame.iNbSites = 0;
+    COM_frame.bInside  = SDL_FALSE;
+    COM_frame.iFrame++;
+}
+
 #else
 
 /*!
@@ -127,7 +750,11 @@ void *UTIL_Malloc(size_t iSize)
 {
     void *pAllocatedMemory = malloc(iSize);
 
-    if (pAllocatedMemory == NULL)
+    if (pAllocatedMemory != NULL)
+    {
+        SDL_AtomicAdd(&COM_iAllocTotal, 1);
+    }
+    else
     {
         COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory!", iSize);
     }
@@ -146,7 +773,11 @@ void *UTIL_Realloc(void *pOldMemoryBlock, size_t iNewSize)
 {
     void *pNewMemoryBlock = realloc(pOldMemoryBlock, iNewSize);
 
-    if (pNewMemoryBlock == NULL)
+    if (pNewMemoryBlock != NULL)
+    {
+        SDL_AtomicAdd(&COM_iAllocTotal, 1);
+    }
+    else
     {
         COM_Log_Print(COM_LOG_CRITICAL, "Failed to allocated %u bytes, not enough memory!", iNewSize);
     }
@@ -156,6 +787,20 @@ void *UTIL_Realloc(void *pOldMemoryBlock, size_t iNewSize)
 
 #endif // _DEBUG
 
+/*!
+ * \brief Function to get the number of allocations since the start.
+ *
+ * \return The number of blocks allocated or reallocated.
+ *
+ * \remark The counter never decreases, so the difference between two calls
+ *         gives the number of allocations done in between. It is 32 bits
+ *         wide, so the difference must be taken on 32 bits.
+ */
+size_t UTIL_GetAllocCount(void)
+{
+    return (size_t) (unsigned int) SDL_AtomicGet(&COM_iAllocTotal);
+}
+
 /* ========================================================================= */
 
 /*!
@@ -12,6 +12,9 @@
 /* Nyuu    | 09/06/15 | Creation.                                            */
 /* Orlyn   | 10/06/15 | Add new functions COM_UTIL_*                         */
 /* Orlyn   | 11/06/15 | Add COM_UTIL_StrCopy                                 */
+/* Nyuu    | 18/10/26 | Add UTIL_GetAllocCount.                              */
+/* Nyuu    | 18/10/26 | Add UTIL_MemReport and UTIL_MemLeaks.                */
+/* Nyuu    | 18/10/26 | Add the check of the allocations of the frame loop.  */
 /* ========================================================================= */
 
 #ifndef __COM_UTIL_H__
@@ -20,18 +23,62 @@
     #include "COM_Shared.h"
     
     /* --- Memory management :: Start --- */
+
+    /*
+     * In debug, the frame loop can be checked for allocations: every
+     * UTIL_Malloc, UTIL_Realloc, UTIL_Free and texture created (SDL_Render)
+     * by the thread of the frame, between UTIL_FrameBegin and UTIL_FrameEnd,
+     * is counted with its call site and reported at the end of the frame.
+     * With the trap (See UTIL_FrameCheck), the first one is logged and the
+     * debugger is stopped on it. The sites of the textures are the functions
+     * of SDL_Render, the caller is in the call stack of the trap.
+     */
+
+    /*!
+     * \enum  UTIL_FrameEvent
+     * \brief Enumeration of the events counted in the frame loop.
+     */
+    typedef enum
+    {
+        UTIL_FRAME_MALLOC = 0, /*!< Block allocated. */
+        UTIL_FRAME_REALLOC,    /*!< Block reallocated. */
+        UTIL_FRAME_FREE,       /*!< Block freed. */
+        UTIL_FRAME_TEXTURE,    /*!< Texture created. */
+        UTIL_FRAME_EVENTS      /*!< Number of events. */
+    } UTIL_FrameEvent;
+
     #ifdef _DEBUG
         #define UTIL_Malloc(x)    UTIL_MallocEx(x, __FUNCTION__, __LINE__, __FILENAME__)
         #define UTIL_Realloc(x,y) UTIL_ReallocEx(x, y, __FUNCTION__, __LINE__, __FILENAME__)
         #define UTIL_Free(x)      UTIL_FreeEx((void**)&x, __FUNCTION__, __LINE__, __FILENAME__) 
 
-        void *UTIL_MallocEx(size_t iSize, const char *szFct, size_t iLine, const char *szFile);
-        void *UTIL_ReallocEx(void* pOldMemoryBlock, size_t iNewSize, const char *szFct, size_t iLine, const char *szFile);
-        void  UTIL_FreeEx(void** ppMemory, const char *szFct, size_t iLine, const char *szFile);
+        void  *UTIL_MallocEx(size_t iSize, const char *szFct, size_t iLine, const char *szFile);
+        void  *UTIL_ReallocEx(void* pOldMemoryBlock, size_t iNewSize, const char *szFct, size_t iLine, const char *szFile);
+        void   UTIL_FreeEx(void** ppMemory, const char *szFct, size_t iLine, const char *szFile);
+        void   UTIL_MemReport(void);
+        size_t UTIL_MemLeaks(void);
+
+        /*! Macro to count an event of the frame loop at the call site. */
+        #define UTIL_FrameCount(iEvent) UTIL_FrameCountEx(iEvent, __FUNCTION__, __LINE__, __FILENAME__)
+
+        void   UTIL_FrameCheck(unsigned int iWarmup, int bTrap);
+        void   UTIL_FrameBegin(void);
+        void   UTIL_FrameCountEx(UTIL_FrameEvent iEvent, const char *szFct, size_t iLine, const char *szFile);
+        void   UTIL_FrameEnd(void);
     #else
         void *UTIL_Malloc(size_t iSize);
         void *UTIL_Realloc(void* pOldMemoryBlock, size_t iNewSize);
 
+        /*! Macros of the tracker of the blocks (Debug only). */
+        #define UTIL_MemReport() ((void) 0)
+        #define UTIL_MemLeaks()  ((size_t) 0)
+
+        /*! Macros of the check of the frame loop (Debug only). */
+        #define UTIL_FrameCheck(iWarmup,bTrap) ((void) 0)
+        #define UTIL_FrameBegin()              ((void) 0)
+        #define UTIL_FrameCount(iEvent)        ((void) 0)
+        #define UTIL_FrameEnd()                ((void) 0)
+
         /*! Macro to free an allocated memory blocks */
         #define UTIL_Free(x) \
         do                   \
@@ -43,6 +90,8 @@
             }                \
         } while(x)
     #endif // _DEBUG
+
+    size_t UTIL_GetAllocCount(void);
     /* --- Memory management :: End --- */
 
     /*! Macro to compute the size of an array */
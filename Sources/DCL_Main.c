@@ -10,6 +10,9 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 04/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Precache the sprites of the decals in bulk.          */
+/* Nyuu    | 18/10/26 | Release the references of the bulk precache.         */
+/* Nyuu    | 18/10/26 | Release only the references taken by the bulk.       */
 /* ========================================================================= */
 
 #include "DCL_Main.h"
@@ -45,12 +48,26 @@ static const ENG_DecalInfo ENG_decalInfo[ ] =
  */
 void DCL_Main_Init(void)
 {
-    Uint32 i;
+    SDL_PrecacheAsset arrAssets[UTIL_ArraySize(ENG_decalInfo)];
+    SDL_bool          arrTaken[UTIL_ArraySize(ENG_decalInfo)];
+    Uint32            i;
+
+    /* ~~~ Decode the sprites in parallel, the registers find them precached ~~~ */
+    for (i = 0 ; i < UTIL_ArraySize(ENG_decalInfo) ; ++i)
+    {
+        arrAssets[i].iType  = SDL_PRECACHE_SPRITE;
+        arrAssets[i].szName = ENG_decalInfo[i].szSprName;
+    }
+
+    SDL_Precache_Bulk(arrAssets, UTIL_ArraySize(arrAssets), arrTaken);
 
     for (i = 0 ; i < UTIL_ArraySize(ENG_decalInfo) ; ++i)
     {
         ENG_Linker_RegisterDecal(&ENG_decalInfo[i]);
     }
+
+    /* ~~~ The linker holds its own references ~~~ */
+    SDL_Precache_ReleaseBulk(arrAssets, UTIL_ArraySize(arrAssets), arrTaken);
 }
 
 /* ========================================================================= */
@@ -10,105 +10,570 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 04/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Decals are linked in the bucket of their layer.      */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Cull the decals outside the view before drawing.     */
+/* Nyuu    | 18/10/26 | Index the decals in the grid of the scheduler.       */
+/* Nyuu    | 18/10/26 | Track the new and recycled decals for the baking.    */
+/* Nyuu    | 18/10/26 | Draw the decals of an area found with the grid.      */
 /* ========================================================================= */
 
-#include "ENG_View.h"
 #include "ENG_Decal.h"
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    /*! Number of decals culled at once. */
+    #define ENG_DECAL_CULL_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    /*! Number of decals culled at once. */
+    #define ENG_DECAL_CULL_WIDTH 4
+#else
+    /*! Number of decals culled at once. */
+    #define ENG_DECAL_CULL_WIDTH 1
+#endif
+
+/* ========================================================================= */
+
+/*! Minimum number of decals allocated in a pool. */
+#define ENG_DECAL_CAPACITY_MIN 256
+
+/* ========================================================================= */
+
+/*!
+ * \struct ENG_DecalArea
+ * \brief  Structure to handle the decals of an area found in the grid.
+ */
+typedef struct
+{
+    const ENG_DecalPool *pPool;     /*!< Pointer to the pool of the decals. */
+    Uint32               iAge;      /*!< Age of the first decal to keep. */
+    Uint32              *pArrAges;  /*!< Array of the ages of the decals found. */
+    Uint32               iNbFound;  /*!< Number of decals found. */
+    Uint32               iMaxFound; /*!< Number of ages allocated. */
+} ENG_DecalArea;
+
 /* ========================================================================= */
 
 /*!
- * \brief  Function to allocate a decal.
+ * \brief  Function to get the index of a decal in a pool.
+ *
+ * \param  pPool Pointer to the pool.
+ * \param  iAge  Age of the decal (0 => Oldest).
+ * \return The index of the decal.
+ */
+static Uint32 ENG_Decal_GetIndex(const ENG_DecalPool *pPool, const Uint32 iAge)
+{
+    Uint32 iIdx = pPool->iOldest + iAge;
+
+    if (iIdx >= pPool->iCapacity)
+    {
+        iIdx -= pPool->iCapacity;
+    }
+
+    return iIdx;
+}
+
+/*!
+ * \brief  Function to remove a decal from the grid.
+ *
+ * \param  pPool Pointer to the pool.
+ * \param  iIdx  Index of the decal.
+ * \return None.
+ */
+static void ENG_Decal_Unindex(ENG_DecalPool *pPool, const Uint32 iIdx)
+{
+    if (pPool->pArrNode[iIdx] != ENG_GRID_INVALID)
+    {
+        ENG_Grid_Remove(pPool->pGrid, pPool->pArrNode[iIdx]);
+        pPool->pArrNode[iIdx] = ENG_GRID_INVALID;
+    }
+    else
+    {
+        pPool->iNbOutside--;
+    }
+}
+
+/*!
+ * \brief  Function to keep a decal found in the grid (ENG_GridCallback).
+ *
+ * \param  pNode Pointer to the node of the decal.
+ * \param  pData Pointer to the area.
+ * \return None.
+ */
+static void ENG_Decal_Collect(const ENG_GridNode *pNode, void *pData)
+{
+    ENG_DecalArea       *pArea = (ENG_DecalArea *) pData;
+    const ENG_DecalPool *pPool = pArea->pPool;
+    Uint32               iAge  = 0;
+
+    /* ~~~ The grid is shared by the pools of every layer ~~~ */
+    if (pNode->pItem != pPool)
+    {
+        return;
+    }
+
+    iAge = (pNode->iIndex >= pPool->iOldest) ? (pNode->iIndex - pPool->iOldest) : (pNode->iIndex + pPool->iCapacity - pPool->iOldest);
+
+    if ((iAge >= pArea->iAge) && (pArea->iNbFound < pArea->iMaxFound))
+    {
+        pArea->pArrAges[pArea->iNbFound++] = iAge;
+    }
+}
+
+/*!
+ * \brief  Function to compare two ages of decals (For qsort).
+ *
+ * \param  pA Pointer to the first age.
+ * \param  pB Pointer to the second age.
+ * \return A negative value if the first decal is older than the second one.
+ */
+static int ENG_Decal_CompareAges(const void *pA, const void *pB)
+{
+    Uint32 iA = *(const Uint32 *) pA;
+    Uint32 iB = *(const Uint32 *) pB;
+
+    return (iA > iB) - (iA < iB);
+}
+
+/*!
+ * \brief  Function to reallocate a pool.
+ *
+ * \param  pPool     Pointer to the pool.
+ * \param  iCapacity New number of decals allocated.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The newest decals are kept, from the oldest to the newest.
+ */
+static SDL_bool ENG_Decal_Resize(ENG_DecalPool *pPool, const Uint32 iCapacity)
+{
+    Sint32      *pArrX      = (Sint32 *)      UTIL_Malloc(sizeof(Sint32)       * iCapacity);
+    Sint32      *pArrY      = (Sint32 *)      UTIL_Malloc(sizeof(Sint32)       * iCapacity);
+    SDL_Sprite **pArrSprite = (SDL_Sprite **) UTIL_Malloc(sizeof(SDL_Sprite *) * iCapacity);
+    Uint32      *pArrFrame  = (Uint32 *)      UTIL_Malloc(sizeof(Uint32)       * iCapacity);
+    Uint32      *pArrNode   = (Uint32 *)      UTIL_Malloc(sizeof(Uint32)       * iCapacity);
+    Uint32       iNbDecals  = COM_Math_Min(pPool->iNbDecals, iCapacity);
+    Uint32       iSrc       = 0;
+    Uint32       i          = 0;
+
+    if (!pArrX || !pArrY || !pArrSprite || !pArrFrame || !pArrNode) // Error: must free...
+    {
+        UTIL_Free(pArrX);
+        UTIL_Free(pArrY);
+        UTIL_Free(pArrSprite);
+        UTIL_Free(pArrFrame);
+        UTIL_Free(pArrNode);
+
+        return SDL_FALSE;
+    }
+
+    /* ~~~ Remove the dropped decals from the grid ~~~ */
+    for (i = 0 ; i < pPool->iNbDecals - iNbDecals ; ++i)
+    {
+        ENG_Decal_Unindex(pPool, ENG_Decal_GetIndex(pPool, i));
+    }
+
+    /* ~~~ Copy the newest decals, unrolling the ring ~~~ */
+    for (i = 0 ; i < iNbDecals ; ++i)
+    {
+        iSrc = ENG_Decal_GetIndex(pPool, pPool->iNbDecals - iNbDecals + i);
+
+        pArrX[i]      = pPool->pArrX[iSrc];
+        pArrY[i]      = pPool->pArrY[iSrc];
+        pArrSprite[i] = pPool->pArrSprite[iSrc];
+        pArrFrame[i]  = pPool->pArrFrame[iSrc];
+        pArrNode[i]   = pPool->pArrNode[iSrc];
+
+        if (pArrNode[i] != ENG_GRID_INVALID)
+        {
+            ENG_Grid_SetIndex(pPool->pGrid, pArrNode[i], i);
+        }
+    }
+
+    UTIL_Free(pPool->pArrX);
+    UTIL_Free(pPool->pArrY);
+    UTIL_Free(pPool->pArrSprite);
+    UTIL_Free(pPool->pArrFrame);
+    UTIL_Free(pPool->pArrNode);
+
+    pPool->pArrX      = pArrX;
+    pPool->pArrY      = pArrY;
+    pPool->pArrSprite = pArrSprite;
+    pPool->pArrFrame  = pArrFrame;
+    pPool->pArrNode   = pArrNode;
+    pPool->iNbDecals  = iNbDecals;
+    pPool->iCapacity  = iCapacity;
+    pPool->iOldest    = 0;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to draw a decal if it is inside a rectangle.
+ *
+ * \param  pPool Pointer to the pool.
+ * \param  iIdx  Index of the decal.
+ * \param  pView Pointer to the rectangle of the view.
+ * \return None.
+ */
+static void ENG_Decal_DrawOne(ENG_DecalPool *pPool, const Uint32 iIdx, const SDL_Rect *pView)
+{
+    SDL_Point sPosition;
+    SDL_Rect  sSize;
+
+    sPosition.x = pPool->pArrX[iIdx] - pView->x;
+    sPosition.y = pPool->pArrY[iIdx] - pView->y;
+
+    SDL_Sprite_GetFrameSize(pPool->pArrSprite[iIdx], &sSize);
+
+    if ((sPosition.x < pView->w) && (sPosition.x + sSize.w > 0) &&
+        (sPosition.y < pView->h) && (sPosition.y + sSize.h > 0))
+    {
+        SDL_Sprite_Draw(pPool->pArrSprite[iIdx], &sPosition, pPool->pArrFrame[iIdx]);
+    }
+}
+
+/*!
+ * \brief  Function to cull and draw a contiguous range of decals.
+ *
+ * \param  pPool  Pointer to the pool.
+ * \param  iStart Index of the first decal.
+ * \param  iEnd   Index after the last decal.
+ * \param  pView  Pointer to the rectangle of the view.
+ * \return None.
  *
- * \return A pointer to the allocated decal, or NULL if error.
+ * \remark The vectorized test uses the biggest frame of the pool, so it
+ *         only rejects; the survivors are tested again with their own frame.
  */
-ENG_Decal *ENG_Decal_Alloc(void)
+static void ENG_Decal_DrawRange(ENG_DecalPool *pPool, Uint32 iStart, const Uint32 iEnd, const SDL_Rect *pView)
 {
-    ENG_Decal *pDecal = (ENG_Decal *) UTIL_Malloc(sizeof(ENG_Decal));
+#if (ENG_DECAL_CULL_WIDTH > 1)
+    int iMask = 0;
+    int iBit  = 0;
+#endif
+
+#if (ENG_DECAL_CULL_WIDTH == 8)
+    const __m256i vMinX = _mm256_set1_epi32(pView->x - pPool->iMaxW);
+    const __m256i vMaxX = _mm256_set1_epi32(pView->x + pView->w);
+    const __m256i vMinY = _mm256_set1_epi32(pView->y - pPool->iMaxH);
+    const __m256i vMaxY = _mm256_set1_epi32(pView->y + pView->h);
+    __m256i       vX;
+    __m256i       vY;
+    __m256i       vIn;
+
+    for ( ; iStart + 8 <= iEnd ; iStart += 8)
+    {
+        vX    = _mm256_loadu_si256((const __m256i *) &pPool->pArrX[iStart]);
+        vY    = _mm256_loadu_si256((const __m256i *) &pPool->pArrY[iStart]);
+        vIn   = _mm256_and_si256(_mm256_cmpgt_epi32(vX, vMinX), _mm256_cmpgt_epi32(vMaxX, vX));
+        vIn   = _mm256_and_si256(vIn, _mm256_cmpgt_epi32(vY, vMinY));
+        vIn   = _mm256_and_si256(vIn, _mm256_cmpgt_epi32(vMaxY, vY));
+        iMask = _mm256_movemask_ps(_mm256_castsi256_ps(vIn));
+
+        for (iBit = 0 ; iMask ; ++iBit, iMask >>= 1)
+        {
+            if (iMask & 1)
+            {
+                ENG_Decal_DrawOne(pPool, iStart + iBit, pView);
+            }
+        }
+    }
+#elif (ENG_DECAL_CULL_WIDTH == 4)
+    const __m128i vMinX = _mm_set1_epi32(pView->x - pPool->iMaxW);
+    const __m128i vMaxX = _mm_set1_epi32(pView->x + pView->w);
+    const __m128i vMinY = _mm_set1_epi32(pView->y - pPool->iMaxH);
+    const __m128i vMaxY = _mm_set1_epi32(pView->y + pView->h);
+    __m128i       vX;
+    __m128i       vY;
+    __m128i       vIn;
 
-    if (pDecal)
+    for ( ; iStart + 4 <= iEnd ; iStart += 4)
     {
-        memset(pDecal, 0, sizeof(ENG_Decal));
+        vX    = _mm_loadu_si128((const __m128i *) &pPool->pArrX[iStart]);
+        vY    = _mm_loadu_si128((const __m128i *) &pPool->pArrY[iStart]);
+        vIn   = _mm_and_si128(_mm_cmpgt_epi32(vX, vMinX), _mm_cmpgt_epi32(vMaxX, vX));
+        vIn   = _mm_and_si128(vIn, _mm_cmpgt_epi32(vY, vMinY));
+        vIn   = _mm_and_si128(vIn, _mm_cmpgt_epi32(vMaxY, vY));
+        iMask = _mm_movemask_ps(_mm_castsi128_ps(vIn));
+
+        for (iBit = 0 ; iMask ; ++iBit, iMask >>= 1)
+        {
+            if (iMask & 1)
+            {
+                ENG_Decal_DrawOne(pPool, iStart + iBit, pView);
+            }
+        }
     }
+#endif
 
-    return pDecal;
+    /* ~~~ Remaining decals ~~~ */
+    for ( ; iStart < iEnd ; ++iStart)
+    {
+        ENG_Decal_DrawOne(pPool, iStart, pView);
+    }
 }
 
+/* ========================================================================= */
+
 /*!
- * \brief  Function to set a decal origin.
+ * \brief  Function to init a pool of decals.
  *
- * \param  pDecal  Pointer to the decal.
- * \param  pOrigin Pointer to an origin.
+ * \param  pPool      Pointer to the pool.
+ * \param  iLayer     Index of the layer of the pool.
+ * \param  iMaxDecals Maximum number of decals before recycling.
+ * \param  pGrid      Pointer to the grid indexing the decals.
  * \return None.
+ *
+ * \remark The pool is allocated on the first add.
  */
-void ENG_Decal_SetOrigin(ENG_Decal *pDecal, const SDL_Point *pOrigin)
+void ENG_Decal_Init(ENG_DecalPool *pPool, Uint32 iLayer, Uint32 iMaxDecals, ENG_Grid *pGrid)
 {
-    pDecal->sOrigin.x = pOrigin->x;
-    pDecal->sOrigin.y = pOrigin->y;
+    memset(pPool, 0, sizeof(ENG_DecalPool));
+
+    pPool->iLayer     = iLayer;
+    pPool->iMaxDecals = iMaxDecals;
+    pPool->pGrid      = pGrid;
 }
 
 /*!
- * \brief  Function to set a decal layer.
+ * \brief  Function to set the maximum number of decals of a pool.
  *
- * \param  pDecal Pointer to the decal.
- * \param  iLayer Index of a layer.
+ * \param  pPool      Pointer to the pool.
+ * \param  iMaxDecals Maximum number of decals before recycling.
  * \return None.
+ *
+ * \remark The oldest decals are dropped if the pool shrinks.
+ */
+void ENG_Decal_SetMax(ENG_DecalPool *pPool, Uint32 iMaxDecals)
+{
+    if (iMaxDecals == 0)
+    {
+        ENG_Decal_Free(pPool);
+    }
+    else if (iMaxDecals < pPool->iCapacity)
+    {
+        if (!ENG_Decal_Resize(pPool, iMaxDecals))
+        {
+            return;
+        }
+    }
+
+    pPool->iMaxDecals = iMaxDecals;
+}
+
+/*!
+ * \brief  Function to add a decal to a pool.
+ *
+ * \param  pPool   Pointer to the pool.
+ * \param  pOrigin Pointer to the decal origin.
+ * \param  pSprite Pointer to the sprite to draw.
+ * \param  iFrame  Index of the frame to draw.
+ * \return The index of the decal, or ENG_DECAL_INVALID if error.
+ *
+ * \remark The oldest decal is recycled when the pool is full.
  */
-void ENG_Decal_SetLayer(ENG_Decal *pDecal, const Uint32 iLayer)
+Uint32 ENG_Decal_Add(ENG_DecalPool *pPool, const SDL_Point *pOrigin, SDL_Sprite *pSprite, const Uint32 iFrame)
 {
-    pDecal->iLayer = iLayer;
+    Uint32   iIdx = ENG_DECAL_INVALID;
+    SDL_Rect sSize;
+
+    if (pPool->iNbDecals == pPool->iMaxDecals)
+    {
+        if (pPool->iMaxDecals)
+        {
+            iIdx           = pPool->iOldest;
+            pPool->iOldest = ENG_Decal_GetIndex(pPool, 1);
+
+            ENG_Decal_Unindex(pPool, iIdx);
+
+            /* ~~~ Remember where the recycled decal was drawn ~~~ */
+            SDL_Sprite_GetFrameSize(pPool->pArrSprite[iIdx], &sSize);
+
+            sSize.x = pPool->pArrX[iIdx];
+            sSize.y = pPool->pArrY[iIdx];
+
+            if (pPool->bRecycled)
+            {
+                SDL_UnionRect(&pPool->sRecycled, &sSize, &pPool->sRecycled);
+            }
+            else
+            {
+                pPool->sRecycled = sSize;
+                pPool->bRecycled = SDL_TRUE;
+            }
+        }
+    }
+    else
+    {
+        if (pPool->iNbDecals == pPool->iCapacity)
+        {
+            if (!ENG_Decal_Resize(pPool, COM_Math_Min(COM_Math_Max(pPool->iCapacity << 1, ENG_DECAL_CAPACITY_MIN), pPool->iMaxDecals)))
+            {
+                return ENG_DECAL_INVALID;
+            }
+        }
+
+        iIdx = pPool->iNbDecals++;
+    }
+
+    if (iIdx != ENG_DECAL_INVALID)
+    {
+        pPool->pArrX[iIdx]      = pOrigin->x;
+        pPool->pArrY[iIdx]      = pOrigin->y;
+        pPool->pArrSprite[iIdx] = pSprite;
+        pPool->pArrFrame[iIdx]  = iFrame;
+
+        SDL_Sprite_GetFrameSize(pSprite, &sSize);
+
+        pPool->iMaxW = COM_Math_Max(pPool->iMaxW, sSize.w);
+        pPool->iMaxH = COM_Math_Max(pPool->iMaxH, sSize.h);
+
+        sSize.x               = pOrigin->x;
+        sSize.y               = pOrigin->y;
+        pPool->pArrNode[iIdx] = ENG_Grid_Insert(pPool->pGrid, &sSize, pPool, iIdx);
+
+        if (pPool->pArrNode[iIdx] == ENG_GRID_INVALID)
+        {
+            pPool->iNbOutside++;
+        }
+
+        pPool->iNbAdded++;
+    }
+
+    return iIdx;
 }
 
 /*!
- * \brief  Function to set a decal sprite.
+ * \brief  Function to draw a pool of decals.
  *
- * \param  pDecal  Pointer to the decal.
- * \param  pSprite Pointer to an allocated sprite.
+ * \param  pPool Pointer to the pool.
+ * \param  pView Pointer to the rectangle of the view (In origin coordinates).
  * \return None.
+ *
+ * \remark The decals are drawn from the oldest to the newest, the decals
+ *         outside the view are skipped.
  */
-void ENG_Decal_SetSprite(ENG_Decal *pDecal, SDL_Sprite *pSprite)
+void ENG_Decal_Draw(ENG_DecalPool *pPool, const SDL_Rect *pView)
 {
-    pDecal->pSprite = pSprite;
+    ENG_Decal_DrawFrom(pPool, 0, pView);
 }
 
 /*!
- * \brief  Function to set a decal frame.
+ * \brief  Function to draw the newest decals of a pool.
  *
- * \param  pDecal Pointer to the decal.
- * \param  iFrame Index of a frame.
+ * \param  pPool Pointer to the pool.
+ * \param  iAge  Age of the first decal to draw (0 => Oldest).
+ * \param  pView Pointer to the rectangle of the view (In origin coordinates).
  * \return None.
+ *
+ * \remark The decals are positioned relative to the view, so a render
+ *         target can be given as view to bake the decals into it.
  */
-void ENG_Decal_SetFrame(ENG_Decal *pDecal, const Uint32 iFrame)
+void ENG_Decal_DrawFrom(ENG_DecalPool *pPool, const Uint32 iAge, const SDL_Rect *pView)
 {
-    pDecal->iFrame = iFrame;
+    Uint32 iStart = 0;
+    Uint32 iEnd   = pPool->iOldest + pPool->iNbDecals;
+
+    if (iAge >= pPool->iNbDecals)
+    {
+        return;
+    }
+
+    iStart = ENG_Decal_GetIndex(pPool, iAge);
+
+    if (iEnd > pPool->iCapacity)
+    {
+        iEnd -= pPool->iCapacity;
+
+        if (iStart >= iEnd)
+        {
+            ENG_Decal_DrawRange(pPool, iStart, pPool->iCapacity, pView);
+            iStart = 0;
+        }
+    }
+
+    ENG_Decal_DrawRange(pPool, iStart, iEnd, pView);
 }
 
 /*!
- * \brief  Function to draw a decal.
+ * \brief  Function to draw the newest decals of a pool overlapping a rectangle.
  *
- * \param  pDecal Pointer to the decal.
- * \param  iLayer Index of the current layer.
+ * \param  pPool Pointer to the pool.
+ * \param  iAge  Age of the first decal to draw (0 => Oldest).
+ * \param  pView Pointer to the rectangle of the view (In origin coordinates).
  * \return None.
+ *
+ * \remark Same as ENG_Decal_DrawFrom, but the decals are found with the grid
+ *         (Sorted by age in the frame arena), so a small rectangle does not
+ *         visit the whole pool.
  */
-void ENG_Decal_Draw(ENG_Decal *pDecal, const Uint32 iLayer)
+void ENG_Decal_DrawArea(ENG_DecalPool *pPool, const Uint32 iAge, const SDL_Rect *pView)
 {
-    if (pDecal->iLayer == iLayer)
+    ENG_DecalArea sArea;
+    COM_ArenaMark sMark;
+    Uint32        i     = 0;
+
+    if (iAge >= pPool->iNbDecals)
+    {
+        return;
+    }
+
+    COM_Arena_Mark(&sMark);
+
+    sArea.pPool     = pPool;
+    sArea.iAge      = iAge;
+    sArea.iNbFound  = 0;
+    sArea.iMaxFound = pPool->iNbDecals - iAge;
+    sArea.pArrAges  = (Uint32 *) COM_Arena_Alloc(sizeof(Uint32) * sArea.iMaxFound);
+
+    /* ~~~ The decals outside the grid are only found by a full draw ~~~ */
+    if (!sArea.pArrAges || pPool->iNbOutside)
     {
-        ENG_View_ConvOrigin(&pDecal->sOrigin, &pDecal->sPosition);
+        COM_Arena_Rewind(&sMark);
+        ENG_Decal_DrawFrom(pPool, iAge, pView);
+        return;
+    }
+
+    ENG_Grid_Query(pPool->pGrid, pView, ENG_Decal_Collect, &sArea);
+
+    /* ~~~ Keep the order of the draws, from the oldest to the newest ~~~ */
+    SDL_qsort(sArea.pArrAges, sArea.iNbFound, sizeof(Uint32), ENG_Decal_CompareAges);
 
-        SDL_Sprite_Draw(pDecal->pSprite, &pDecal->sPosition, pDecal->iFrame);
+    for (i = 0 ; i < sArea.iNbFound ; ++i)
+    {
+        ENG_Decal_DrawOne(pPool, ENG_Decal_GetIndex(pPool, sArea.pArrAges[i]), pView);
     }
+
+    COM_Arena_Rewind(&sMark);
 }
 
 /*!
- * \brief  Function to free a decal.
+ * \brief  Function to free a pool of decals.
  *
- * \param  ppDecal Pointer to pointer to the decal.
+ * \param  pPool Pointer to the pool.
  * \return None.
  */
-void ENG_Decal_Free(ENG_Decal **ppDecal)
+void ENG_Decal_Free(ENG_DecalPool *pPool)
 {
-    UTIL_Free(*ppDecal);
+    Uint32 i = 0;
+
+    for (i = 0 ; i < pPool->iNbDecals ; ++i)
+    {
+        ENG_Decal_Unindex(pPool, ENG_Decal_GetIndex(pPool, i));
+    }
+
+    UTIL_Free(pPool->pArrX);
+    UTIL_Free(pPool->pArrY);
+    UTIL_Free(pPool->pArrSprite);
+    UTIL_Free(pPool->pArrFrame);
+    UTIL_Free(pPool->pArrNode);
+
+    pPool->iNbDecals  = 0;
+    pPool->iCapacity  = 0;
+    pPool->iOldest    = 0;
+    pPool->iMaxW      = 0;
+    pPool->iMaxH      = 0;
+    pPool->iNbOutside = 0;
 }
 
 /* ========================================================================= */
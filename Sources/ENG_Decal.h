@@ -10,39 +10,61 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 04/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Decals are linked in the bucket of their layer.      */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Cull the decals outside the view before drawing.     */
+/* Nyuu    | 18/10/26 | Index the decals in the grid of the scheduler.       */
+/* Nyuu    | 18/10/26 | Track the new and recycled decals for the baking.    */
+/* Nyuu    | 18/10/26 | Draw the decals of an area found with the grid.      */
 /* ========================================================================= */
 
 #ifndef __ENG_DECAL_H__
 #define __ENG_DECAL_H__
 
-    #include "ENG_Shared.h"
-    
-    /*! Typedef to handle a decal. */
-    typedef struct ENG_Decal ENG_Decal;
+    #include "ENG_Grid.h"
 
+    /*! Default maximum number of decals in a pool. */
+    #define ENG_DECAL_DEFAULT_MAX 8192
+    /*! Value of an invalid decal index. */
+    #define ENG_DECAL_INVALID     0xFFFFFFFF
+    
     /*!
-     * \struct ENG_Decal
-     * \brief  Structure to handle a decal.
+     * \struct ENG_DecalPool
+     * \brief  Structure to handle a pool of decals (Ring buffer stored by fields).
      */
-    struct ENG_Decal
+    typedef struct
     {
-        SDL_Point   sOrigin;   /*!< Origin of the decal. */
-        SDL_Point   sPosition; /*!< Position of the decal. */
-        Uint32      iLayer;    /*!< Layer to draw the decal. */
-        SDL_Sprite *pSprite;   /*!< Pointer to the sprite to draw. */
-        Uint32      iFrame;    /*!< Frame of the sprite to draw. */
-
-        ENG_Decal  *pNext;     /*!< Pointer to the next decal. */
-    };
+        Sint32      *pArrX;      /*!< Array of the origins on x. */
+        Sint32      *pArrY;      /*!< Array of the origins on y. */
+        SDL_Sprite **pArrSprite; /*!< Array of the sprites to draw. */
+        Uint32      *pArrFrame;  /*!< Array of the frames of the sprites to draw. */
+        Uint32      *pArrNode;   /*!< Array of the nodes in the grid. */
+        Uint32       iNbOutside; /*!< Number of decals not indexed in the grid (Insert failed). */
+
+        Uint32       iNbDecals;  /*!< Number of decals in the pool. */
+        Uint32       iMaxDecals; /*!< Maximum number of decals before recycling. */
+        Uint32       iCapacity;  /*!< Number of decals allocated. */
+        Uint32       iOldest;    /*!< Index of the oldest decal. */
+
+        Sint32       iMaxW;      /*!< Maximum frame width of the sprites (For the culling). */
+        Sint32       iMaxH;      /*!< Maximum frame height of the sprites (For the culling). */
+
+        Uint32       iNbAdded;   /*!< Number of decals added since the creation (Wraps). */
+        SDL_bool     bRecycled;  /*!< Flag set if decals were recycled since the last reset. */
+        SDL_Rect     sRecycled;  /*!< Area covered by the decals recycled since the last reset. */
+
+        Uint32       iLayer;     /*!< Index of the layer of the pool. */
+        ENG_Grid    *pGrid;      /*!< Pointer to the grid indexing the decals. */
+    } ENG_DecalPool;
     
     /* ----- Use ONLY by the scheduler / linker ----- */
-    ENG_Decal *ENG_Decal_Alloc    (void);
-    void       ENG_Decal_SetOrigin(ENG_Decal *pDecal, const SDL_Point *pOrigin);
-    void       ENG_Decal_SetLayer (ENG_Decal *pDecal, const Uint32 iLayer);
-    void       ENG_Decal_SetSprite(ENG_Decal *pDecal, SDL_Sprite *pSprite);
-    void       ENG_Decal_SetFrame (ENG_Decal *pDecal, const Uint32 iFrame);
-    void       ENG_Decal_Draw     (ENG_Decal *pDecal, const Uint32 iLayer);
-    void       ENG_Decal_Free     (ENG_Decal **ppDecal);
+    void   ENG_Decal_Init    (ENG_DecalPool *pPool, Uint32 iLayer, Uint32 iMaxDecals, ENG_Grid *pGrid);
+    void   ENG_Decal_SetMax  (ENG_DecalPool *pPool, Uint32 iMaxDecals);
+    Uint32 ENG_Decal_Add     (ENG_DecalPool *pPool, const SDL_Point *pOrigin, SDL_Sprite *pSprite, const Uint32 iFrame);
+    void   ENG_Decal_Draw    (ENG_DecalPool *pPool, const SDL_Rect *pView);
+    void   ENG_Decal_DrawFrom(ENG_DecalPool *pPool, const Uint32 iAge, const SDL_Rect *pView);
+    void   ENG_Decal_DrawArea(ENG_DecalPool *pPool, const Uint32 iAge, const SDL_Rect *pView);
+    void   ENG_Decal_Free    (ENG_DecalPool *pPool);
     /* ---------------------------------------------- */
 
 #endif // __ENG_DECAL_H__
@@ -10,35 +10,57 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 15/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Effects are linked in the bucket of their layer.     */
+/* Nyuu    | 18/10/26 | Thinks & kills are queued in the scheduler.          */
+/* Nyuu    | 18/10/26 | Effects are allocated in the slab of their type.     */
+/* Nyuu    | 18/10/26 | Add an optional bounding box for the culling.        */
+/* Nyuu    | 18/10/26 | Index the bounded effects in the scheduler grid.     */
 /* ========================================================================= */
 
 #include "ENG_View.h"
+#include "ENG_Scheduler.h"
 #include "ENG_Effect.h"
 
 /* ========================================================================= */
 
+/*! Size of an effect header in a slot (The private data stays aligned). */
+#define ENG_EFFECT_HEADER_SIZE ENG_Slab_AlignSize(sizeof(ENG_Effect))
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the size of a slot holding an effect.
+ *
+ * \param  iPrivDataSize Size of the private data in bytes.
+ * \return The size of the slot in bytes.
+ */
+Uint32 ENG_Effect_GetSlotSize(Uint32 iPrivDataSize)
+{
+    return ENG_EFFECT_HEADER_SIZE + iPrivDataSize;
+}
+
 /*!
  * \brief  Function to allocate an effect.
  *
+ * \param  pSlab         Pointer to the slab of the effect type.
  * \param  iPrivDataSize Size of the private data in bytes.
  * \return A pointer to the allocated effect, or NULL if error.
+ *
+ * \remark The slots of the slab must hold the private data (See ENG_Effect_GetSlotSize).
  */
-ENG_Effect *ENG_Effect_Alloc(Uint32 iPrivDataSize)
+ENG_Effect *ENG_Effect_Alloc(ENG_Slab *pSlab, Uint32 iPrivDataSize)
 {
-    ENG_Effect *pEffect = (ENG_Effect *) UTIL_Malloc(sizeof(ENG_Effect));
+    ENG_Effect *pEffect = (ENG_Effect *) ENG_Slab_Take(pSlab);
 
     if (pEffect)
     {
-        memset(pEffect, 0, sizeof(ENG_Effect));
+        memset(pEffect, 0, ENG_Effect_GetSlotSize(iPrivDataSize));
+
+        pEffect->pSlab = pSlab;
 
         if (iPrivDataSize)
         {
-            pEffect->pPrivData = UTIL_Malloc(iPrivDataSize);
-
-            if (pEffect->pPrivData == NULL)
-            {
-                UTIL_Free(pEffect);
-            }
+            pEffect->pPrivData = (Uint8 *) pEffect + ENG_EFFECT_HEADER_SIZE;
         }
     }
 
@@ -54,7 +76,14 @@ ENG_Effect *ENG_Effect_Alloc(Uint32 iPrivDataSize)
  */
 void ENG_Effect_SetLayer(ENG_Effect *pEffect, const Uint32 iLayer)
 {
-    pEffect->iLayer = iLayer;
+    if (pEffect->bLinked)
+    {
+        ENG_Scheduler_MoveEffect(pEffect, iLayer);
+    }
+    else
+    {
+        pEffect->iLayer = iLayer;
+    }
 }
 
 /*!
@@ -67,6 +96,41 @@ void ENG_Effect_SetLayer(ENG_Effect *pEffect, const Uint32 iLayer)
 void ENG_Effect_SetNextThink(ENG_Effect *pEffect, const Uint32 iNextThink)
 {
     pEffect->iNextThink = iNextThink;
+
+    if (pEffect->bLinked)
+    {
+        ENG_Scheduler_ThinkEffect(pEffect);
+    }
+}
+
+/*!
+ * \brief  Function to set an effect bounding box.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  pBounds Pointer to the bounding box in origin coordinates (NULL => Never culled).
+ * \return None.
+ *
+ * \remark The effect is found by the area queries only if it has a bounding box.
+ */
+void ENG_Effect_SetBounds(ENG_Effect *pEffect, const SDL_Rect *pBounds)
+{
+    if (pBounds)
+    {
+        pEffect->sBounds.x  = pBounds->x;
+        pEffect->sBounds.y  = pBounds->y;
+        pEffect->sBounds.w  = pBounds->w;
+        pEffect->sBounds.h  = pBounds->h;
+        pEffect->bHasBounds = SDL_TRUE;
+    }
+    else
+    {
+        pEffect->bHasBounds = SDL_FALSE;
+    }
+
+    if (pEffect->bLinked)
+    {
+        ENG_Scheduler_BoundEffect(pEffect);
+    }
 }
 
 /*!
@@ -77,7 +141,15 @@ void ENG_Effect_SetNextThink(ENG_Effect *pEffect, const Uint32 iNextThink)
  */
 void ENG_Effect_Kill(ENG_Effect *pEffect)
 {
-    pEffect->bKillMe = SDL_TRUE;
+    if (!pEffect->bKillMe)
+    {
+        pEffect->bKillMe = SDL_TRUE;
+
+        if (pEffect->bLinked)
+        {
+            ENG_Scheduler_KillEffect(pEffect);
+        }
+    }
 }
 
 /*!
@@ -137,16 +209,27 @@ void ENG_Effect_Think(ENG_Effect *pEffect, const Uint32 iTime)
     }
 }
 
+/*!
+ * \brief  Function to check if an effect may be seen.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  pView   Pointer to the rectangle of the view.
+ * \return SDL_FALSE if the bounding box is outside the view, else SDL_TRUE.
+ */
+SDL_bool ENG_Effect_IsVisible(const ENG_Effect *pEffect, const SDL_Rect *pView)
+{
+    return pEffect->bHasBounds ? SDL_HasIntersection(&pEffect->sBounds, pView) : SDL_TRUE;
+}
+
 /*!
  * \brief  Function to execute the effect function 'Draw'.
  *
  * \param  pEffect Pointer to the effect.
- * \param  iLayer  Index of the current layer.
  * \return None.
  */
-void ENG_Effect_Draw(ENG_Effect *pEffect, const Uint32 iLayer)
+void ENG_Effect_Draw(ENG_Effect *pEffect)
 {
-    if (pEffect->pTable->pftDraw && pEffect->iLayer == iLayer)
+    if (pEffect->pTable->pftDraw)
     {
         pEffect->pTable->pftDraw(pEffect);
     }
@@ -174,8 +257,8 @@ void ENG_Effect_Die(ENG_Effect *pEffect)
  */
 void ENG_Effect_Free(ENG_Effect **ppEffect)
 {
-    UTIL_Free((*ppEffect)->pPrivData);
-    UTIL_Free(*ppEffect);
+    ENG_Slab_Give((*ppEffect)->pSlab, *ppEffect);
+    *ppEffect = NULL;
 }
 
 /* ========================================================================= */
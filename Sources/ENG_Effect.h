@@ -10,12 +10,18 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 15/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Effects are linked in the bucket of their layer.     */
+/* Nyuu    | 18/10/26 | Thinks & kills are queued in the scheduler.          */
+/* Nyuu    | 18/10/26 | Effects are allocated in the slab of their type.     */
+/* Nyuu    | 18/10/26 | Add an optional bounding box for the culling.        */
+/* Nyuu    | 18/10/26 | Index the bounded effects in the scheduler grid.     */
+/* Nyuu    | 18/10/26 | Add the flag of the effects polled by the scheduler. */
 /* ========================================================================= */
 
 #ifndef __ENG_EFFECT_H__
 #define __ENG_EFFECT_H__
 
-    #include "ENG_Shared.h"
+    #include "ENG_Slab.h"
     
     /*! Typedef to handle an effect. */
     typedef struct ENG_Effect ENG_Effect;
@@ -41,23 +47,37 @@
         Uint32                 iLayer;     /*!< Layer to draw the decal. */
         Uint32                 iNextThink; /*!< Time before the next think must occur. */
         SDL_bool               bKillMe;    /*!< Flag to kill the effect. */
+        SDL_bool               bLinked;    /*!< Flag set while the effect is in the scheduler. */
+        Uint32                 iThinkIdx;  /*!< Index in the think queue + 1 (0 if not queued). */
+        SDL_bool               bPolled;    /*!< Flag set if the effect thinks outside the queue (Queue full). */
+        SDL_bool               bHasBounds; /*!< Flag set if the effect has a bounding box. */
+        SDL_Rect               sBounds;    /*!< Bounding box of the effect (In origin coordinates). */
+        Uint32                 iGridIdx;   /*!< Index of the node in the grid + 1 (0 if not indexed). */
 
-        void                  *pPrivData;  /*!< Pointer to the private data. */
+        void                  *pPrivData;  /*!< Pointer to the private data (Inline in the slot). */
+        ENG_Slab              *pSlab;      /*!< Pointer to the slab of the effect. */
         const ENG_EffectTable *pTable;     /*!< Pointer to the functions table. */
+        ENG_Effect            *pPrev;      /*!< Pointer to the previous effect. */
         ENG_Effect            *pNext;      /*!< Pointer to the next effect. */
+        ENG_Effect            *pNextKill;  /*!< Pointer to the next effect to kill. */
+        ENG_Effect            *pLayerPrev; /*!< Pointer to the previous effect of the layer. */
+        ENG_Effect            *pLayerNext; /*!< Pointer to the next effect of the layer. */
     };
 
     void        ENG_Effect_SetLayer    (ENG_Effect *pEffect, const Uint32 iLayer);
     void        ENG_Effect_SetNextThink(ENG_Effect *pEffect, const Uint32 iNextThink);
+    void        ENG_Effect_SetBounds   (ENG_Effect *pEffect, const SDL_Rect *pBounds);
     void        ENG_Effect_Kill        (ENG_Effect *pEffect);
     void       *ENG_Effect_GetPrivData (ENG_Effect *pEffect);
 
     /* ----- Use ONLY by the scheduler / linker ----- */
-    ENG_Effect *ENG_Effect_Alloc       (Uint32 iPrivDataSize);
+    Uint32      ENG_Effect_GetSlotSize (Uint32 iPrivDataSize);
+    ENG_Effect *ENG_Effect_Alloc       (ENG_Slab *pSlab, Uint32 iPrivDataSize);
     void        ENG_Effect_SetTable    (ENG_Effect *pEffect, const ENG_EffectTable *pTable);
     void        ENG_Effect_Spawn       (ENG_Effect *pEffect, const SDL_Point *pOrigin);
     void        ENG_Effect_Think       (ENG_Effect *pEffect, const Uint32 iTime);
-    void        ENG_Effect_Draw        (ENG_Effect *pEffect, const Uint32 iLayer);
+    SDL_bool    ENG_Effect_IsVisible   (const ENG_Effect *pEffect, const SDL_Rect *pView);
+    void        ENG_Effect_Draw        (ENG_Effect *pEffect);
     void        ENG_Effect_Die         (ENG_Effect *pEffect);
     void        ENG_Effect_Free        (ENG_Effect **ppEffect);
     /* ---------------------------------------------- */
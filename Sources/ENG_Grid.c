@@ -0,0 +1,368 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Grid.c
+ * \brief   File to handle the grids.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Keep the entries bigger than a cell in a list.       */
+/* ========================================================================= */
+
+#include "ENG_Grid.h"
+
+/* ========================================================================= */
+
+/*! Minimum number of nodes allocated in a grid. */
+#define ENG_GRID_NODES_MIN 256
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the cell of a coordinate.
+ *
+ * \param  iCoord Coordinate (In origin coordinates).
+ * \return The cell containing the coordinate (Rounded down).
+ */
+static Sint32 ENG_Grid_GetCell(const Sint32 iCoord)
+{
+    return (iCoord >= 0) ? (iCoord >> ENG_GRID_CELL_SHIFT) : (-((-(iCoord + 1)) >> ENG_GRID_CELL_SHIFT) - 1);
+}
+
+/*!
+ * \brief  Function to get the bucket of a cell.
+ *
+ * \param  iCellX Cell on x.
+ * \param  iCellY Cell on y.
+ * \return The index of the bucket.
+ */
+static Uint32 ENG_Grid_GetBucket(const Sint32 iCellX, const Sint32 iCellY)
+{
+    return (((Uint32) iCellX * 73856093U) ^ ((Uint32) iCellY * 19349663U)) & (ENG_GRID_NB_BUCKETS - 1);
+}
+
+/*!
+ * \brief  Function to check if an entry is bigger than a cell.
+ *
+ * \param  pBounds Pointer to the bounding box of the entry.
+ * \return SDL_TRUE if the entry is kept in the list of the big entries, else SDL_FALSE.
+ */
+static SDL_bool ENG_Grid_IsBig(const SDL_Rect *pBounds)
+{
+    return ((pBounds->w > ENG_GRID_CELL_SIZE) || (pBounds->h > ENG_GRID_CELL_SIZE)) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to link a node in the bucket of its cell.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \param  iNode Index of the node.
+ * \return None.
+ *
+ * \remark The entries bigger than a cell are linked in the list of the big
+ *         entries, so the queries are only extended by one cell.
+ */
+static void ENG_Grid_Link(ENG_Grid *pGrid, const Uint32 iNode)
+{
+    ENG_GridNode *pNode = &pGrid->pArrNodes[iNode];
+
+    pNode->iCellX  = ENG_Grid_GetCell(pNode->sBounds.x);
+    pNode->iCellY  = ENG_Grid_GetCell(pNode->sBounds.y);
+    pNode->iBucket = ENG_Grid_IsBig(&pNode->sBounds) ? ENG_GRID_NB_BUCKETS : ENG_Grid_GetBucket(pNode->iCellX, pNode->iCellY);
+
+    pNode->iPrev   = ENG_GRID_INVALID;
+    pNode->iNext   = pGrid->pArrBuckets[pNode->iBucket];
+
+    if (pNode->iNext != ENG_GRID_INVALID)
+    {
+        pGrid->pArrNodes[pNode->iNext].iPrev = iNode;
+    }
+
+    pGrid->pArrBuckets[pNode->iBucket] = iNode;
+}
+
+/*!
+ * \brief  Function to unlink a node from the bucket of its cell.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \param  iNode Index of the node.
+ * \return None.
+ */
+static void ENG_Grid_Unlink(ENG_Grid *pGrid, const Uint32 iNode)
+{
+    ENG_GridNode *pNode = &pGrid->pArrNodes[iNode];
+
+    if (pNode->iPrev != ENG_GRID_INVALID)
+    {
+        pGrid->pArrNodes[pNode->iPrev].iNext = pNode->iNext;
+    }
+    else
+    {
+        pGrid->pArrBuckets[pNode->iBucket] = pNode->iNext;
+    }
+
+    if (pNode->iNext != ENG_GRID_INVALID)
+    {
+        pGrid->pArrNodes[pNode->iNext].iPrev = pNode->iPrev;
+    }
+}
+
+/*!
+ * \brief  Function to allocate more nodes in a grid.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool ENG_Grid_Grow(ENG_Grid *pGrid)
+{
+    ENG_GridNode *pArrNodes = NULL;
+    Uint32        iNewMax   = COM_Math_Max(pGrid->iMaxNodes << 1, ENG_GRID_NODES_MIN);
+    Uint32        i         = 0;
+
+    if (!pGrid->pArrBuckets)
+    {
+        pGrid->pArrBuckets = (Uint32 *) UTIL_Malloc(sizeof(Uint32) * (ENG_GRID_NB_BUCKETS + 1));
+
+        if (!pGrid->pArrBuckets)
+        {
+            return SDL_FALSE;
+        }
+
+        for (i = 0 ; i <= ENG_GRID_NB_BUCKETS ; ++i)
+        {
+            pGrid->pArrBuckets[i] = ENG_GRID_INVALID;
+        }
+    }
+
+    pArrNodes = (ENG_GridNode *) UTIL_Realloc(pGrid->pArrNodes, sizeof(ENG_GridNode) * iNewMax);
+
+    if (!pArrNodes)
+    {
+        return SDL_FALSE;
+    }
+
+    /* ~~~ Chain the new nodes in the free list ~~~ */
+    for (i = iNewMax ; i > pGrid->iMaxNodes ; --i)
+    {
+        pArrNodes[i - 1].pItem = NULL;
+        pArrNodes[i - 1].iNext = pGrid->iFirstFree;
+        pGrid->iFirstFree      = i - 1;
+    }
+
+    pGrid->pArrNodes = pArrNodes;
+    pGrid->iMaxNodes = iNewMax;
+
+    return SDL_TRUE;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to init a grid.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \return None.
+ *
+ * \remark The grid is allocated on the first insert.
+ */
+void ENG_Grid_Init(ENG_Grid *pGrid)
+{
+    memset(pGrid, 0, sizeof(ENG_Grid));
+
+    pGrid->iFirstFree = ENG_GRID_INVALID;
+}
+
+/*!
+ * \brief  Function to insert an entry in a grid.
+ *
+ * \param  pGrid   Pointer to the grid.
+ * \param  pBounds Pointer to the bounding box of the entry.
+ * \param  pItem   Pointer to the owner of the entry (Not NULL).
+ * \param  iIndex  Index of the entry in its owner.
+ * \return The index of the node, or ENG_GRID_INVALID if error.
+ */
+Uint32 ENG_Grid_Insert(ENG_Grid *pGrid, const SDL_Rect *pBounds, void *pItem, const Uint32 iIndex)
+{
+    ENG_GridNode *pNode = NULL;
+    Uint32        iNode = ENG_GRID_INVALID;
+
+    if ((pGrid->iFirstFree == ENG_GRID_INVALID) && !ENG_Grid_Grow(pGrid))
+    {
+        return ENG_GRID_INVALID;
+    }
+
+    iNode             = pGrid->iFirstFree;
+    pNode             = &pGrid->pArrNodes[iNode];
+    pGrid->iFirstFree = pNode->iNext;
+
+    pNode->sBounds.x  = pBounds->x;
+    pNode->sBounds.y  = pBounds->y;
+    pNode->sBounds.w  = pBounds->w;
+    pNode->sBounds.h  = pBounds->h;
+    pNode->pItem      = pItem;
+    pNode->iIndex     = iIndex;
+
+    ENG_Grid_Link(pGrid, iNode);
+    pGrid->iNbNodes++;
+
+    return iNode;
+}
+
+/*!
+ * \brief  Function to move an entry of a grid.
+ *
+ * \param  pGrid   Pointer to the grid.
+ * \param  iNode   Index of the node.
+ * \param  pBounds Pointer to the new bounding box of the entry.
+ * \return None.
+ *
+ * \remark The buckets are only touched if the entry changes of cell, or
+ *         becomes bigger or smaller than a cell.
+ */
+void ENG_Grid_Move(ENG_Grid *pGrid, const Uint32 iNode, const SDL_Rect *pBounds)
+{
+    ENG_GridNode *pNode   = &pGrid->pArrNodes[iNode];
+    SDL_bool      bWasBig = (pNode->iBucket == ENG_GRID_NB_BUCKETS) ? SDL_TRUE : SDL_FALSE;
+    SDL_bool      bIsBig  = ENG_Grid_IsBig(pBounds);
+
+    pNode->sBounds.x = pBounds->x;
+    pNode->sBounds.y = pBounds->y;
+    pNode->sBounds.w = pBounds->w;
+    pNode->sBounds.h = pBounds->h;
+
+    if ((bWasBig != bIsBig) ||
+        (!bIsBig && ((ENG_Grid_GetCell(pBounds->x) != pNode->iCellX) || (ENG_Grid_GetCell(pBounds->y) != pNode->iCellY))))
+    {
+        ENG_Grid_Unlink(pGrid, iNode);
+        ENG_Grid_Link(pGrid, iNode);
+    }
+}
+
+/*!
+ * \brief  Function to change the index of an entry in its owner.
+ *
+ * \param  pGrid  Pointer to the grid.
+ * \param  iNode  Index of the node.
+ * \param  iIndex New index of the entry in its owner.
+ * \return None.
+ */
+void ENG_Grid_SetIndex(ENG_Grid *pGrid, const Uint32 iNode, const Uint32 iIndex)
+{
+    pGrid->pArrNodes[iNode].iIndex = iIndex;
+}
+
+/*!
+ * \brief  Function to remove an entry from a grid.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \param  iNode Index of the node.
+ * \return None.
+ */
+void ENG_Grid_Remove(ENG_Grid *pGrid, const Uint32 iNode)
+{
+    ENG_Grid_Unlink(pGrid, iNode);
+
+    pGrid->pArrNodes[iNode].pItem = NULL;
+    pGrid->pArrNodes[iNode].iNext = pGrid->iFirstFree;
+    pGrid->iFirstFree             = iNode;
+    pGrid->iNbNodes--;
+}
+
+/*!
+ * \brief  Function to find the entries of a grid overlapping a rectangle.
+ *
+ * \param  pGrid     Pointer to the grid.
+ * \param  pRect     Pointer to the rectangle (In origin coordinates).
+ * \param  pCallback Function called for each entry found.
+ * \param  pData     Pointer given to the callback.
+ * \return None.
+ *
+ * \remark Only the cells overlapped by the rectangle are visited (Extended
+ *         by one cell, as an entry is stored in its top left cell), then
+ *         the big entries. The callback must not insert, move or remove entries.
+ */
+void ENG_Grid_Query(const ENG_Grid *pGrid, const SDL_Rect *pRect, ENG_GridCallback pCallback, void *pData)
+{
+    const ENG_GridNode *pNode  = NULL;
+    Uint32              iNode  = 0;
+    Sint32              iMinX  = 0;
+    Sint32              iMinY  = 0;
+    Sint32              iMaxX  = 0;
+    Sint32              iMaxY  = 0;
+    Sint32              iCellX = 0;
+    Sint32              iCellY = 0;
+
+    if (!pGrid->iNbNodes || (pRect->w <= 0) || (pRect->h <= 0))
+    {
+        return;
+    }
+
+    iMinX = ENG_Grid_GetCell(pRect->x - ENG_GRID_CELL_SIZE + 1);
+    iMinY = ENG_Grid_GetCell(pRect->y - ENG_GRID_CELL_SIZE + 1);
+    iMaxX = ENG_Grid_GetCell(pRect->x + pRect->w - 1);
+    iMaxY = ENG_Grid_GetCell(pRect->y + pRect->h - 1);
+
+    /* ~~~ Cheaper to visit every node than every cell ~~~ */
+    if ((Uint64) (iMaxX - iMinX + 1) * (Uint64) (iMaxY - iMinY + 1) > pGrid->iNbNodes)
+    {
+        for (iNode = 0 ; iNode < pGrid->iMaxNodes ; ++iNode)
+        {
+            pNode = &pGrid->pArrNodes[iNode];
+
+            if (pNode->pItem && SDL_HasIntersection(&pNode->sBounds, pRect))
+            {
+                pCallback(pNode, pData);
+            }
+        }
+
+        return;
+    }
+
+    for (iCellY = iMinY ; iCellY <= iMaxY ; ++iCellY)
+    {
+        for (iCellX = iMinX ; iCellX <= iMaxX ; ++iCellX)
+        {
+            for (iNode = pGrid->pArrBuckets[ENG_Grid_GetBucket(iCellX, iCellY)] ; iNode != ENG_GRID_INVALID ; iNode = pNode->iNext)
+            {
+                pNode = &pGrid->pArrNodes[iNode];
+
+                /* ~~~ The buckets are shared by several cells ~~~ */
+                if ((pNode->iCellX == iCellX) && (pNode->iCellY == iCellY) && SDL_HasIntersection(&pNode->sBounds, pRect))
+                {
+                    pCallback(pNode, pData);
+                }
+            }
+        }
+    }
+
+    /* ~~~ Check the big entries ~~~ */
+    for (iNode = pGrid->pArrBuckets[ENG_GRID_NB_BUCKETS] ; iNode != ENG_GRID_INVALID ; iNode = pNode->iNext)
+    {
+        pNode = &pGrid->pArrNodes[iNode];
+
+        if (SDL_HasIntersection(&pNode->sBounds, pRect))
+        {
+            pCallback(pNode, pData);
+        }
+    }
+}
+
+/*!
+ * \brief  Function to free a grid.
+ *
+ * \param  pGrid Pointer to the grid.
+ * \return None.
+ */
+void ENG_Grid_Free(ENG_Grid *pGrid)
+{
+    UTIL_Free(pGrid->pArrBuckets);
+    UTIL_Free(pGrid->pArrNodes);
+
+    ENG_Grid_Init(pGrid);
+}
+
+/* ========================================================================= */
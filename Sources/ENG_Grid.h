@@ -0,0 +1,73 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Grid.h
+ * \brief   File to interface with the grids.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Keep the entries bigger than a cell in a list.       */
+/* ========================================================================= */
+
+#ifndef __ENG_GRID_H__
+#define __ENG_GRID_H__
+
+    #include "ENG_Shared.h"
+
+    /*! Size of a cell of a grid (1 << ENG_GRID_CELL_SHIFT pixels). */
+    #define ENG_GRID_CELL_SHIFT  7
+    /*! Size of a cell of a grid (In pixels). */
+    #define ENG_GRID_CELL_SIZE   (1 << ENG_GRID_CELL_SHIFT)
+    /*! Number of buckets of the cells hash table (Power of two). */
+    #define ENG_GRID_NB_BUCKETS  4096
+    /*! Value of an invalid node index. */
+    #define ENG_GRID_INVALID     0xFFFFFFFF
+
+    /*!
+     * \struct ENG_GridNode
+     * \brief  Structure to handle an entry of a grid.
+     */
+    typedef struct
+    {
+        SDL_Rect  sBounds; /*!< Bounding box of the entry (In origin coordinates). */
+        Sint32    iCellX;  /*!< Cell of the top left corner on x. */
+        Sint32    iCellY;  /*!< Cell of the top left corner on y. */
+        Uint32    iBucket; /*!< Index of the bucket of the node (ENG_GRID_NB_BUCKETS => Big entries). */
+        Uint32    iPrev;   /*!< Index of the previous node of the bucket. */
+        Uint32    iNext;   /*!< Index of the next node of the bucket (Or of the free list). */
+
+        void     *pItem;   /*!< Pointer to the owner of the entry. */
+        Uint32    iIndex;  /*!< Index of the entry in its owner. */
+    } ENG_GridNode;
+
+    /*! Callback called for each entry found by a query. */
+    typedef void (*ENG_GridCallback)(const ENG_GridNode *pNode, void *pData);
+
+    /*!
+     * \struct ENG_Grid
+     * \brief  Structure to handle a grid (Spatial hash of uniform cells).
+     */
+    typedef struct
+    {
+        Uint32       *pArrBuckets; /*!< Array of the first node of each bucket (+ The list of the big entries). */
+        ENG_GridNode *pArrNodes;   /*!< Array of the nodes. */
+        Uint32        iNbNodes;    /*!< Number of nodes in use. */
+        Uint32        iMaxNodes;   /*!< Number of nodes allocated. */
+        Uint32        iFirstFree;  /*!< Index of the first free node. */
+    } ENG_Grid;
+
+    void   ENG_Grid_Init    (ENG_Grid *pGrid);
+    Uint32 ENG_Grid_Insert  (ENG_Grid *pGrid, const SDL_Rect *pBounds, void *pItem, const Uint32 iIndex);
+    void   ENG_Grid_Move    (ENG_Grid *pGrid, const Uint32 iNode, const SDL_Rect *pBounds);
+    void   ENG_Grid_SetIndex(ENG_Grid *pGrid, const Uint32 iNode, const Uint32 iIndex);
+    void   ENG_Grid_Remove  (ENG_Grid *pGrid, const Uint32 iNode);
+    void   ENG_Grid_Query   (const ENG_Grid *pGrid, const SDL_Rect *pRect, ENG_GridCallback pCallback, void *pData);
+    void   ENG_Grid_Free    (ENG_Grid *pGrid);
+
+#endif // __ENG_GRID_H__
+
+/* ========================================================================= */
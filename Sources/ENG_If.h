@@ -17,10 +17,13 @@
 
     #include "ENG_Decal.h"
     #include "ENG_Effect.h"
+    #include "ENG_Grid.h"
     #include "ENG_Layer.h"
     #include "ENG_Linker.h"
     #include "ENG_Scheduler.h"
     #include "ENG_Shared.h"
+    #include "ENG_Slab.h"
+    #include "ENG_Tile.h"
     #include "ENG_View.h"
 
 #endif // __ENG_IF_H__
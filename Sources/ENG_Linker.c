@@ -10,6 +10,10 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 04/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add a slab for each effect registered.               */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Add ENG_Linker_GetNbDecals.                          */
+/* Nyuu    | 18/10/26 | Release the sprites of the decals.                   */
 /* ========================================================================= */
 
 #include "ENG_Scheduler.h"
@@ -34,6 +38,7 @@ typedef struct
 typedef struct
 {
     const ENG_EffectInfo *pInfo; /*!< Pointer to the effect info. */
+    ENG_Slab             *pSlab; /*!< Pointer to the slab of the effect. */
 } ENG_EffectLink;
 
 /*!
@@ -108,18 +113,29 @@ void ENG_Linker_RegisterDecal(const ENG_DecalInfo * const pDclInfo)
 void ENG_Linker_RegisterEffect(const ENG_EffectInfo * const pEffInfo)
 {
     ENG_EffectLink *pEffectLink = NULL;
+    ENG_Slab       *pSlab       = NULL;
     Uint32          iNewSize    = 0;
 
-    iNewSize = sizeof(ENG_EffectLink) * (ENG_linker.iNbEffects + 1);
-    ENG_linker.pArrEffects = (ENG_EffectLink *) UTIL_Realloc(ENG_linker.pArrEffects, iNewSize);
+    pSlab = ENG_Slab_Alloc(ENG_Effect_GetSlotSize(pEffInfo->iPrivDataSize));
 
-    if (ENG_linker.pArrDecals)
+    if (pSlab)
     {
-        pEffectLink        = &(ENG_linker.pArrEffects[ENG_linker.iNbEffects]);
-        pEffectLink->pInfo = pEffInfo;
+        iNewSize = sizeof(ENG_EffectLink) * (ENG_linker.iNbEffects + 1);
+        ENG_linker.pArrEffects = (ENG_EffectLink *) UTIL_Realloc(ENG_linker.pArrEffects, iNewSize);
 
-        COM_Log_Print(COM_LOG_INFO, "Register effect: \"%s\".", pEffInfo->szName);
-        ENG_linker.iNbEffects++;
+        if (ENG_linker.pArrEffects)
+        {
+            pEffectLink        = &(ENG_linker.pArrEffects[ENG_linker.iNbEffects]);
+            pEffectLink->pInfo = pEffInfo;
+            pEffectLink->pSlab = pSlab;
+
+            COM_Log_Print(COM_LOG_INFO, "Register effect: \"%s\".", pEffInfo->szName);
+            ENG_linker.iNbEffects++;
+        }
+        else
+        {
+            ENG_Slab_Free(&pSlab);
+        }
     }
 }
 
@@ -129,35 +145,26 @@ void ENG_Linker_RegisterEffect(const ENG_EffectInfo * const pEffInfo)
  * \param  iDclIdx Index of the decal.
  * \param  pOrigin Pointer to the decal origin.
  * \param  iLayer  Index of the decal layer.
- * \return A pointer to the allocated decal, or NULL if error.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The oldest decal of the layer is recycled when the layer is full.
  */
-ENG_Decal *ENG_Linker_SpawnDecal(Uint32 iDclIdx, const SDL_Point *pOrigin, const Uint32 iLayer)
+SDL_bool ENG_Linker_SpawnDecal(Uint32 iDclIdx, const SDL_Point *pOrigin, const Uint32 iLayer)
 {
     ENG_DecalLink *pDecalLink = NULL;
-    ENG_Decal     *pDecal     = NULL;
+    SDL_bool       bSpawned   = SDL_FALSE;
 
     if (iDclIdx < ENG_linker.iNbDecals)
     {
-        pDecal = ENG_Decal_Alloc( );
-
-        if (pDecal)
-        {
-            pDecalLink = &(ENG_linker.pArrDecals[iDclIdx]);
-
-            ENG_Decal_SetOrigin(pDecal, pOrigin);
-            ENG_Decal_SetLayer (pDecal, iLayer);
-            ENG_Decal_SetSprite(pDecal, pDecalLink->pSprite);
-            ENG_Decal_SetFrame (pDecal, pDecalLink->pInfo->iFrame);
-
-            ENG_Scheduler_AddDecal(pDecal);
-        }
+        pDecalLink = &(ENG_linker.pArrDecals[iDclIdx]);
+        bSpawned   = ENG_Scheduler_AddDecal(iLayer, pOrigin, pDecalLink->pSprite, pDecalLink->pInfo->iFrame);
     }
     else
     {
         COM_Log_Print(COM_LOG_WARNING, "Invalid decal index: %d ( Max: %d ) !", iDclIdx, ENG_linker.iNbDecals);
     }
 
-    return pDecal;
+    return bSpawned;
 }
 
 /*!
@@ -176,7 +183,7 @@ ENG_Effect *ENG_Linker_SpawnEffect(Uint32 iEffIdx, const SDL_Point *pOrigin, con
     if (iEffIdx < ENG_linker.iNbEffects)
     {
         pEffectLink = &(ENG_linker.pArrEffects[iEffIdx]);
-        pEffect     = ENG_Effect_Alloc(pEffectLink->pInfo->iPrivDataSize);
+        pEffect     = ENG_Effect_Alloc(pEffectLink->pSlab, pEffectLink->pInfo->iPrivDataSize);
 
         if (pEffect)
         {
@@ -195,13 +202,65 @@ ENG_Effect *ENG_Linker_SpawnEffect(Uint32 iEffIdx, const SDL_Point *pOrigin, con
     return pEffect;
 }
 
+/*!
+ * \brief  Function to get the slab statistics of an effect.
+ *
+ * \param  iEffIdx Index of the effect.
+ * \param  pStats  Pointer to retrieve the statistics.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+SDL_bool ENG_Linker_GetEffectStats(Uint32 iEffIdx, ENG_SlabStats *pStats)
+{
+    if (iEffIdx < ENG_linker.iNbEffects)
+    {
+        ENG_Slab_GetStats(ENG_linker.pArrEffects[iEffIdx].pSlab, pStats);
+
+        return SDL_TRUE;
+    }
+
+    return SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to get the number of decals registered.
+ *
+ * \return The number of decals (The indexes go from 0 to this number - 1).
+ */
+Uint32 ENG_Linker_GetNbDecals(void)
+{
+    return ENG_linker.iNbDecals;
+}
+
 /*!
  * \brief  Function to free the linker.
  *
  * \return None.
+ *
+ * \remark The scheduler must be freed before the linker, and the linker
+ *         before the precache (The sprites of the decals are released).
  */
 void ENG_Linker_Free(void)
 {
+    ENG_EffectLink *pEffectLink = NULL;
+    ENG_SlabStats   sStats;
+    Uint32          i;
+
+    for (i = 0 ; i < ENG_linker.iNbDecals ; ++i)
+    {
+        SDL_Precache_Release(SDL_PRECACHE_SPRITE, ENG_linker.pArrDecals[i].pInfo->szSprName);
+    }
+
+    for (i = 0 ; i < ENG_linker.iNbEffects ; ++i)
+    {
+        pEffectLink = &(ENG_linker.pArrEffects[i]);
+        ENG_Slab_GetStats(pEffectLink->pSlab, &sStats);
+
+        COM_Log_Print(COM_LOG_INFO, "Effect \"%s\": %d slots (Peak: %d ; Leaked: %d).",
+                                    pEffectLink->pInfo->szName, sStats.iNbSlots, sStats.iHighWater, sStats.iNbUsed);
+
+        ENG_Slab_Free(&pEffectLink->pSlab);
+    }
+
     ENG_linker.iNbDecals  = 0;
     ENG_linker.iNbEffects = 0;
 
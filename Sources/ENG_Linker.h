@@ -10,6 +10,9 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 04/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add a slab for each effect registered.               */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Add ENG_Linker_GetNbDecals.                          */
 /* ========================================================================= */
 
 #ifndef __ENG_LINKER_H__
@@ -43,8 +46,10 @@
     void        ENG_Linker_Init          (void);
     void        ENG_Linker_RegisterDecal (const ENG_DecalInfo  * const pDclInfo);
     void        ENG_Linker_RegisterEffect(const ENG_EffectInfo * const pEffInfo);
-    ENG_Decal  *ENG_Linker_SpawnDecal    (Uint32 iDclIdx, const SDL_Point *pOrigin, const Uint32 iLayer);
+    SDL_bool    ENG_Linker_SpawnDecal    (Uint32 iDclIdx, const SDL_Point *pOrigin, const Uint32 iLayer);
     ENG_Effect *ENG_Linker_SpawnEffect   (Uint32 iEffIdx, const SDL_Point *pOrigin, const Uint32 iLayer);
+    SDL_bool    ENG_Linker_GetEffectStats(Uint32 iEffIdx, ENG_SlabStats *pStats);
+    Uint32      ENG_Linker_GetNbDecals   (void);
     void        ENG_Linker_Free          (void);
 
 #endif // __ENG_LINKER_H__
@@ -10,49 +10,580 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 28/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Bucket the decals and effects by layer.              */
+/* Nyuu    | 18/10/26 | Add the think queue and the kill list.               */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Cull the decals and effects outside the view.        */
+/* Nyuu    | 18/10/26 | Add the area queries on the decals and effects.      */
+/* Nyuu    | 18/10/26 | Bake the decals into cached tiles for each layer.    */
+/* Nyuu    | 18/10/26 | Add the profiler zones of the update and the draw.   */
+/* Nyuu    | 18/10/26 | Drop the tiles when the render targets are lost.     */
+/* Nyuu    | 18/10/26 | Poll the effects when the think queue can't grow.    */
+/* Nyuu    | 18/10/26 | Check the allocation of the layers.                  */
 /* ========================================================================= */
 
 #include "ENG_Layer.h"
+#include "ENG_Tile.h"
+#include "ENG_View.h"
 #include "ENG_Scheduler.h"
 
 /* ========================================================================= */
 
+/*! Minimum number of elements allocated for a queue of the scheduler. */
+#define ENG_SCHEDULER_QUEUE_MIN 64
+
+/* ========================================================================= */
+
+/*!
+ * \struct ENG_SchedulerLayer
+ * \brief  Structure to handle the entities of a layer.
+ */
+typedef struct
+{
+    ENG_DecalPool  sDecals;      /*!< Pool of the decals of the layer. */
+    ENG_TileMap    sTiles;       /*!< Tiles of the baked decals of the layer. */
+    ENG_Effect    *pFirstEffect; /*!< Pointer to the first effect of the layer. */
+} ENG_SchedulerLayer;
+
 /*!
  * \struct ENG_Scheduler
  * \brief  Structure to handle the scheduler.
  */
 typedef struct
 {
-    ENG_Decal  *pFirstDecal;  /*!< Pointer to the first decal. */
-    ENG_Effect *pFirstEffect; /*!< Pointer to the first effect. */
+    ENG_SchedulerLayer *pArrLayers;   /*!< Array of layers (The last one is never drawn and has no decal). */
+    Uint32              iNbLayers;    /*!< Number of layers drawn. */
+
+    ENG_Effect         *pFirstEffect; /*!< Pointer to the first effect. */
+    ENG_Effect         *pFirstKill;   /*!< Pointer to the first effect to kill. */
+
+    ENG_Effect        **pArrThinks;   /*!< Binary heap of the effects waiting to think. */
+    Uint32              iNbThinks;    /*!< Number of effects waiting to think. */
+    Uint32              iMaxThinks;   /*!< Number of effects allocated in the heap. */
+    Uint32              iNbPolled;    /*!< Number of effects polled (The heap could not grow). */
+
+    ENG_Effect        **pArrDue;      /*!< Array of the effects which must think this frame. */
+    Uint32              iMaxDue;      /*!< Number of effects allocated in the array. */
+
+    ENG_Grid            sDecalGrid;   /*!< Grid indexing the decals of every layer. */
+    ENG_Grid            sEffectGrid;  /*!< Grid indexing the effects with a bounding box. */
+
+    ENG_TileCache       sTiles;       /*!< Cache of the tiles of every layer. */
+    Uint32              iNbResets;    /*!< Number of losses of the render targets at the last draw. */
 } ENG_Scheduler;
 
+/*!
+ * \struct ENG_SchedulerQuery
+ * \brief  Structure to handle an area query in progress.
+ */
+typedef struct
+{
+    ENG_SchedulerQueryFn  pCallback; /*!< Function called for each entity found. */
+    void                 *pData;     /*!< Pointer given to the callback. */
+} ENG_SchedulerQuery;
+
 /*! Global variable to handle the scheduler. */
 static ENG_Scheduler ENG_scheduler;
 
 /* ========================================================================= */
 
+/*!
+ * \brief  Function to get the layer of the scheduler.
+ *
+ * \param  iLayer Index of the layer.
+ * \return A pointer to the layer, or NULL if the layers are not allocated.
+ *
+ * \remark An invalid index returns the hidden layer.
+ */
+static ENG_SchedulerLayer *ENG_Scheduler_GetLayer(const Uint32 iLayer)
+{
+    if (!ENG_scheduler.pArrLayers)
+    {
+        return NULL;
+    }
+
+    return &ENG_scheduler.pArrLayers[COM_Math_Min(iLayer, ENG_scheduler.iNbLayers)];
+}
+
+/*!
+ * \brief  Function to link an effect to its layer.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void ENG_Scheduler_LinkEffect(ENG_Effect *pEffect)
+{
+    ENG_SchedulerLayer *pLayer = ENG_Scheduler_GetLayer(pEffect->iLayer);
+
+    pEffect->pLayerPrev = NULL;
+    pEffect->pLayerNext = NULL;
+
+    if (!pLayer)
+    {
+        return;
+    }
+
+    pEffect->pLayerNext = pLayer->pFirstEffect;
+
+    if (pLayer->pFirstEffect)
+    {
+        pLayer->pFirstEffect->pLayerPrev = pEffect;
+    }
+
+    pLayer->pFirstEffect = pEffect;
+}
+
+/*!
+ * \brief  Function to unlink an effect from its layer.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void ENG_Scheduler_UnlinkEffect(ENG_Effect *pEffect)
+{
+    ENG_SchedulerLayer *pLayer = ENG_Scheduler_GetLayer(pEffect->iLayer);
+
+    if (!pLayer)
+    {
+        return;
+    }
+
+    if (pEffect->pLayerPrev)
+    {
+        pEffect->pLayerPrev->pLayerNext = pEffect->pLayerNext;
+    }
+    else
+    {
+        pLayer->pFirstEffect = pEffect->pLayerNext;
+    }
+
+    if (pEffect->pLayerNext)
+    {
+        pEffect->pLayerNext->pLayerPrev = pEffect->pLayerPrev;
+    }
+
+    pEffect->pLayerPrev = NULL;
+    pEffect->pLayerNext = NULL;
+}
+
+/*!
+ * \brief  Function to place an effect in the think queue.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  iIdx    Index of the effect in the queue.
+ * \return None.
+ */
+static void ENG_Scheduler_SetThink(ENG_Effect *pEffect, const Uint32 iIdx)
+{
+    ENG_scheduler.pArrThinks[iIdx] = pEffect;
+    pEffect->iThinkIdx             = iIdx + 1;
+}
+
+/*!
+ * \brief  Function to move up an effect in the think queue.
+ *
+ * \param  iIdx Index of the effect in the queue.
+ * \return None.
+ */
+static void ENG_Scheduler_SiftUpThink(Uint32 iIdx)
+{
+    ENG_Effect *pEffect = ENG_scheduler.pArrThinks[iIdx];
+    Uint32      iParent = 0;
+
+    while (iIdx > 0)
+    {
+        iParent = ((iIdx - 1) >> 1);
+
+        if (ENG_scheduler.pArrThinks[iParent]->iNextThink <= pEffect->iNextThink)
+        {
+            break;
+        }
+
+        ENG_Scheduler_SetThink(ENG_scheduler.pArrThinks[iParent], iIdx);
+        iIdx = iParent;
+    }
+
+    ENG_Scheduler_SetThink(pEffect, iIdx);
+}
+
+/*!
+ * \brief  Function to move down an effect in the think queue.
+ *
+ * \param  iIdx Index of the effect in the queue.
+ * \return None.
+ */
+static void ENG_Scheduler_SiftDownThink(Uint32 iIdx)
+{
+    ENG_Effect *pEffect = ENG_scheduler.pArrThinks[iIdx];
+    Uint32      iChild  = 0;
+
+    while ((iChild = (iIdx << 1) + 1) < ENG_scheduler.iNbThinks)
+    {
+        if ((iChild + 1 < ENG_scheduler.iNbThinks) &&
+            (ENG_scheduler.pArrThinks[iChild + 1]->iNextThink < ENG_scheduler.pArrThinks[iChild]->iNextThink))
+        {
+            iChild++;
+        }
+
+        if (pEffect->iNextThink <= ENG_scheduler.pArrThinks[iChild]->iNextThink)
+        {
+            break;
+        }
+
+        ENG_Scheduler_SetThink(ENG_scheduler.pArrThinks[iChild], iIdx);
+        iIdx = iChild;
+    }
+
+    ENG_Scheduler_SetThink(pEffect, iIdx);
+}
+
+/*!
+ * \brief  Function to poll an effect, or to stop polling it.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  bPolled SDL_TRUE to poll the effect, else SDL_FALSE.
+ * \return None.
+ */
+static void ENG_Scheduler_PollThink(ENG_Effect *pEffect, const SDL_bool bPolled)
+{
+    if (pEffect->bPolled != bPolled)
+    {
+        pEffect->bPolled = bPolled;
+
+        if (bPolled)
+        {
+            ENG_scheduler.iNbPolled++;
+        }
+        else
+        {
+            ENG_scheduler.iNbPolled--;
+        }
+    }
+}
+
+/*!
+ * \brief  Function to insert an effect in the think queue.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ *
+ * \remark The effect is polled by the update if the queue can't grow.
+ */
+static void ENG_Scheduler_InsertThink(ENG_Effect *pEffect)
+{
+    ENG_Effect **pArrThinks = NULL;
+    Uint32       iNewMax    = 0;
+
+    if (ENG_scheduler.iNbThinks == ENG_scheduler.iMaxThinks)
+    {
+        iNewMax    = COM_Math_Max(ENG_scheduler.iMaxThinks << 1, ENG_SCHEDULER_QUEUE_MIN);
+        pArrThinks = (ENG_Effect **) UTIL_Realloc(ENG_scheduler.pArrThinks, sizeof(ENG_Effect *) * iNewMax);
+
+        if (pArrThinks == NULL)
+        {
+            if (!pEffect->bPolled)
+            {
+                COM_Log_Print(COM_LOG_ERROR, "Can't grow the think queue to %d effects, the effect is polled !", iNewMax);
+                ENG_Scheduler_PollThink(pEffect, SDL_TRUE);
+            }
+
+            return;
+        }
+
+        ENG_scheduler.pArrThinks = pArrThinks;
+        ENG_scheduler.iMaxThinks = iNewMax;
+    }
+
+    ENG_Scheduler_PollThink(pEffect, SDL_FALSE);
+
+    ENG_scheduler.pArrThinks[ENG_scheduler.iNbThinks] = pEffect;
+    ENG_Scheduler_SiftUpThink(ENG_scheduler.iNbThinks++);
+}
+
+/*!
+ * \brief  Function to update the effects polled.
+ *
+ * \param  iTime Current time (In ms).
+ * \return None.
+ *
+ * \remark Visits every effect, so only used while some effects are polled.
+ */
+static void ENG_Scheduler_UpdatePolled(const Uint32 iTime)
+{
+    ENG_Effect *pCurrentEffect = NULL;
+
+    /* ~~~ The spawned effects are added first, so they are not visited ~~~ */
+    for (pCurrentEffect = ENG_scheduler.pFirstEffect ; pCurrentEffect && ENG_scheduler.iNbPolled ; pCurrentEffect = pCurrentEffect->pNext)
+    {
+        if (!pCurrentEffect->bPolled)
+        {
+            continue;
+        }
+
+        if (pCurrentEffect->bKillMe || !pCurrentEffect->iNextThink)
+        {
+            ENG_Scheduler_PollThink(pCurrentEffect, SDL_FALSE);
+        }
+        else if (pCurrentEffect->iNextThink < iTime)
+        {
+            /* ~~~ A think may poll the effect again ~~~ */
+            ENG_Scheduler_PollThink(pCurrentEffect, SDL_FALSE);
+            ENG_Effect_Think(pCurrentEffect, iTime);
+        }
+    }
+}
+
+/*!
+ * \brief  Function to remove an effect from the think queue.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void ENG_Scheduler_RemoveThink(ENG_Effect *pEffect)
+{
+    Uint32      iIdx  = pEffect->iThinkIdx - 1;
+    ENG_Effect *pLast = ENG_scheduler.pArrThinks[--ENG_scheduler.iNbThinks];
+
+    pEffect->iThinkIdx = 0;
+
+    if (pLast != pEffect)
+    {
+        ENG_Scheduler_SetThink(pLast, iIdx);
+        ENG_Scheduler_SiftUpThink(iIdx);
+        ENG_Scheduler_SiftDownThink(pLast->iThinkIdx - 1);
+    }
+}
+
+/*!
+ * \brief  Function to remove an effect from the scheduler and free it.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void ENG_Scheduler_DestroyEffect(ENG_Effect *pEffect)
+{
+    if (pEffect->iThinkIdx)
+    {
+        ENG_Scheduler_RemoveThink(pEffect);
+    }
+
+    ENG_Scheduler_PollThink(pEffect, SDL_FALSE);
+
+    if (pEffect->iGridIdx)
+    {
+        ENG_Grid_Remove(&ENG_scheduler.sEffectGrid, pEffect->iGridIdx - 1);
+    }
+
+    ENG_Scheduler_UnlinkEffect(pEffect);
+
+    if (pEffect->pPrev)
+    {
+        pEffect->pPrev->pNext = pEffect->pNext;
+    }
+    else
+    {
+        ENG_scheduler.pFirstEffect = pEffect->pNext;
+    }
+
+    if (pEffect->pNext)
+    {
+        pEffect->pNext->pPrev = pEffect->pPrev;
+    }
+
+    ENG_Effect_Free(&pEffect);
+}
+
+/*!
+ * \brief  Function to report a decal found by an area query.
+ *
+ * \param  pNode Pointer to the node of the decal.
+ * \param  pData Pointer to the query.
+ * \return None.
+ */
+static void ENG_Scheduler_QueryDecal(const ENG_GridNode *pNode, void *pData)
+{
+    ENG_SchedulerQuery  *pQuery = (ENG_SchedulerQuery *) pData;
+    const ENG_DecalPool *pPool  = (const ENG_DecalPool *) pNode->pItem;
+    ENG_SchedulerHit     sHit;
+
+    sHit.iLayer  = pPool->iLayer;
+    sHit.sBounds = pNode->sBounds;
+    sHit.pEffect = NULL;
+    sHit.pSprite = pPool->pArrSprite[pNode->iIndex];
+    sHit.iFrame  = pPool->pArrFrame[pNode->iIndex];
+
+    pQuery->pCallback(&sHit, pQuery->pData);
+}
+
+/*!
+ * \brief  Function to report an effect found by an area query.
+ *
+ * \param  pNode Pointer to the node of the effect.
+ * \param  pData Pointer to the query.
+ * \return None.
+ */
+static void ENG_Scheduler_QueryEffect(const ENG_GridNode *pNode, void *pData)
+{
+    ENG_SchedulerQuery *pQuery  = (ENG_SchedulerQuery *) pData;
+    ENG_Effect         *pEffect = (ENG_Effect *) pNode->pItem;
+    ENG_SchedulerHit    sHit;
+
+    /* ~~~ The dying effects stay in the grid until the next update ~~~ */
+    if (pEffect->bKillMe)
+    {
+        return;
+    }
+
+    sHit.iLayer  = pEffect->iLayer;
+    sHit.sBounds = pNode->sBounds;
+    sHit.pEffect = pEffect;
+    sHit.pSprite = NULL;
+    sHit.iFrame  = 0;
+
+    pQuery->pCallback(&sHit, pQuery->pData);
+}
+
+/* ========================================================================= */
+
 /*!
  * \brief  Function to init the scheduler.
  *
  * \return None.
+ *
+ * \remark The layers must be initialized before the scheduler.
  */
 void ENG_Scheduler_Init(void)
 {
-    ENG_scheduler.pFirstDecal  = NULL;
+    Uint32 iNewSize = 0;
+    Uint32 i        = 0;
+
+    ENG_scheduler.iNbLayers    = ENG_Layer_GetMax( );
     ENG_scheduler.pFirstEffect = NULL;
+    ENG_scheduler.pFirstKill   = NULL;
+
+    ENG_scheduler.pArrThinks   = NULL;
+    ENG_scheduler.iNbThinks    = 0;
+    ENG_scheduler.iMaxThinks   = 0;
+    ENG_scheduler.iNbPolled    = 0;
+
+    ENG_scheduler.pArrDue      = NULL;
+    ENG_scheduler.iMaxDue      = 0;
+
+    ENG_Grid_Init(&ENG_scheduler.sDecalGrid);
+    ENG_Grid_Init(&ENG_scheduler.sEffectGrid);
+
+    ENG_Tile_InitCache(&ENG_scheduler.sTiles, ENG_TILE_DEFAULT_BUDGET);
+    ENG_scheduler.iNbResets = SDL_Render_GetResetCount( );
+
+    iNewSize                 = sizeof(ENG_SchedulerLayer) * (ENG_scheduler.iNbLayers + 1);
+    ENG_scheduler.pArrLayers = (ENG_SchedulerLayer *) UTIL_Malloc(iNewSize);
+
+    if (ENG_scheduler.pArrLayers)
+    {
+        memset(ENG_scheduler.pArrLayers, 0, iNewSize);
+
+        for (i = 0 ; i < ENG_scheduler.iNbLayers ; ++i)
+        {
+            ENG_Decal_Init(&ENG_scheduler.pArrLayers[i].sDecals, i, ENG_DECAL_DEFAULT_MAX, &ENG_scheduler.sDecalGrid);
+            ENG_Tile_InitMap(&ENG_scheduler.pArrLayers[i].sTiles);
+        }
+    }
+    else
+    {
+        /* ~~~ The effects still think, but nothing is drawn ~~~ */
+        COM_Log_Print(COM_LOG_CRITICAL, ">> Not enough memory for the %d layers of the scheduler", ENG_scheduler.iNbLayers);
+        ENG_scheduler.iNbLayers = 0;
+    }
 }
 
 /*!
- * \brief  Function to add a decal to the scheduler.
+ * \brief  Function to set the maximum number of decals of a layer.
  *
- * \param  pDecal Pointer to an allocated decal.
+ * \param  iLayer     Index of the layer.
+ * \param  iMaxDecals Maximum number of decals before recycling the oldest.
  * \return None.
  */
-void ENG_Scheduler_AddDecal(ENG_Decal *pDecal)
+void ENG_Scheduler_SetDecalMax(const Uint32 iLayer, const Uint32 iMaxDecals)
 {
-    pDecal->pNext             = ENG_scheduler.pFirstDecal;
-    ENG_scheduler.pFirstDecal = pDecal;
+    if (iLayer < ENG_scheduler.iNbLayers)
+    {
+        ENG_Decal_SetMax(&ENG_scheduler.pArrLayers[iLayer].sDecals, iMaxDecals);
+        ENG_Tile_ResetMap(&ENG_scheduler.sTiles, &ENG_scheduler.pArrLayers[iLayer].sTiles);
+    }
+}
+
+/*!
+ * \brief  Function to enable or disable the baking of the decals of a layer.
+ *
+ * \param  iLayer   Index of the layer.
+ * \param  bEnabled SDL_TRUE to bake the decals into tiles, else SDL_FALSE.
+ * \return None.
+ *
+ * \remark The baking suits the layers of static decals which are rarely
+ *         recycled, as a recycled decal bakes its tiles again.
+ */
+void ENG_Scheduler_SetBaking(const Uint32 iLayer, const SDL_bool bEnabled)
+{
+    ENG_SchedulerLayer *pLayer = NULL;
+
+    if (iLayer < ENG_scheduler.iNbLayers)
+    {
+        pLayer = &ENG_scheduler.pArrLayers[iLayer];
+
+        ENG_Tile_EnableMap(&ENG_scheduler.sTiles, &pLayer->sTiles, &pLayer->sDecals, bEnabled);
+    }
+}
+
+/*!
+ * \brief  Function to set the memory budget of the tiles of every layer.
+ *
+ * \param  iBudget Memory budget of the tiles (In bytes).
+ * \return None.
+ */
+void ENG_Scheduler_SetTileBudget(const Uint32 iBudget)
+{
+    ENG_Tile_SetBudget(&ENG_scheduler.sTiles, iBudget);
+}
+
+/*!
+ * \brief  Function to drop the tiles of every layer.
+ *
+ * \return None.
+ *
+ * \remark Called by the draw when the render targets are lost (SDL_RENDER_TARGETS_RESET).
+ *         The tiles are in origin coordinates, so a move of the view keeps them.
+ */
+void ENG_Scheduler_ResetTiles(void)
+{
+    Uint32 iLayer = 0;
+
+    for (iLayer = 0 ; iLayer < ENG_scheduler.iNbLayers ; ++iLayer)
+    {
+        ENG_Tile_ResetMap(&ENG_scheduler.sTiles, &ENG_scheduler.pArrLayers[iLayer].sTiles);
+    }
+}
+
+/*!
+ * \brief  Function to add a decal to the scheduler.
+ *
+ * \param  iLayer  Index of the decal layer.
+ * \param  pOrigin Pointer to the decal origin.
+ * \param  pSprite Pointer to the sprite to draw.
+ * \param  iFrame  Index of the frame to draw.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The decal is dropped if the layer is not drawn.
+ */
+SDL_bool ENG_Scheduler_AddDecal(const Uint32 iLayer, const SDL_Point *pOrigin, SDL_Sprite *pSprite, const Uint32 iFrame)
+{
+    Uint32 iIdx = ENG_DECAL_INVALID;
+
+    if (iLayer < ENG_scheduler.iNbLayers)
+    {
+        iIdx = ENG_Decal_Add(&ENG_scheduler.pArrLayers[iLayer].sDecals, pOrigin, pSprite, iFrame);
+    }
+
+    return (iIdx != ENG_DECAL_INVALID) ? SDL_TRUE : SDL_FALSE;
 }
 
 /*!
@@ -63,50 +594,218 @@ void ENG_Scheduler_AddDecal(ENG_Decal *pDecal)
  */
 void ENG_Scheduler_AddEffect(ENG_Effect *pEffect)
 {
-    pEffect->pNext             = ENG_scheduler.pFirstEffect;
+    pEffect->pPrev = NULL;
+    pEffect->pNext = ENG_scheduler.pFirstEffect;
+
+    if (ENG_scheduler.pFirstEffect)
+    {
+        ENG_scheduler.pFirstEffect->pPrev = pEffect;
+    }
+
     ENG_scheduler.pFirstEffect = pEffect;
+
+    ENG_Scheduler_LinkEffect(pEffect);
+
+    pEffect->bLinked = SDL_TRUE;
+
+    if (pEffect->bHasBounds)
+    {
+        ENG_Scheduler_BoundEffect(pEffect);
+    }
+
+    /* ~~~ The effect may have been set up during its spawn ~~~ */
+    if (pEffect->bKillMe)
+    {
+        ENG_Scheduler_KillEffect(pEffect);
+    }
+    else if (pEffect->iNextThink)
+    {
+        ENG_Scheduler_InsertThink(pEffect);
+    }
+}
+
+/*!
+ * \brief  Function to move an effect to another layer.
+ *
+ * \param  pEffect Pointer to a scheduled effect.
+ * \param  iLayer  Index of the new layer.
+ * \return None.
+ */
+void ENG_Scheduler_MoveEffect(ENG_Effect *pEffect, const Uint32 iLayer)
+{
+    ENG_Scheduler_UnlinkEffect(pEffect);
+    pEffect->iLayer = iLayer;
+    ENG_Scheduler_LinkEffect(pEffect);
+}
+
+/*!
+ * \brief  Function to update the think queue after a change of the next think.
+ *
+ * \param  pEffect Pointer to a scheduled effect.
+ * \return None.
+ */
+void ENG_Scheduler_ThinkEffect(ENG_Effect *pEffect)
+{
+    if (pEffect->iThinkIdx)
+    {
+        if (pEffect->iNextThink)
+        {
+            ENG_Scheduler_SiftUpThink(pEffect->iThinkIdx - 1);
+            ENG_Scheduler_SiftDownThink(pEffect->iThinkIdx - 1);
+        }
+        else
+        {
+            ENG_Scheduler_RemoveThink(pEffect);
+        }
+    }
+    else if (pEffect->iNextThink && !pEffect->bKillMe)
+    {
+        ENG_Scheduler_InsertThink(pEffect);
+    }
+}
+
+/*!
+ * \brief  Function to update the grid after a change of the bounding box.
+ *
+ * \param  pEffect Pointer to a scheduled effect.
+ * \return None.
+ */
+void ENG_Scheduler_BoundEffect(ENG_Effect *pEffect)
+{
+    Uint32 iNode = ENG_GRID_INVALID;
+
+    if (pEffect->iGridIdx)
+    {
+        if (pEffect->bHasBounds)
+        {
+            ENG_Grid_Move(&ENG_scheduler.sEffectGrid, pEffect->iGridIdx - 1, &pEffect->sBounds);
+        }
+        else
+        {
+            ENG_Grid_Remove(&ENG_scheduler.sEffectGrid, pEffect->iGridIdx - 1);
+            pEffect->iGridIdx = 0;
+        }
+    }
+    else if (pEffect->bHasBounds)
+    {
+        iNode = ENG_Grid_Insert(&ENG_scheduler.sEffectGrid, &pEffect->sBounds, pEffect, 0);
+
+        if (iNode != ENG_GRID_INVALID)
+        {
+            pEffect->iGridIdx = iNode + 1;
+        }
+    }
+}
+
+/*!
+ * \brief  Function to add an effect to the kill list.
+ *
+ * \param  pEffect Pointer to a scheduled effect.
+ * \return None.
+ *
+ * \remark The effect is removed during the next update.
+ */
+void ENG_Scheduler_KillEffect(ENG_Effect *pEffect)
+{
+    pEffect->pNextKill       = ENG_scheduler.pFirstKill;
+    ENG_scheduler.pFirstKill = pEffect;
+}
+
+/*!
+ * \brief  Function to find the decals and effects overlapping a rectangle.
+ *
+ * \param  pRect     Pointer to the rectangle (In origin coordinates).
+ * \param  pCallback Function called for each entity found.
+ * \param  pData     Pointer given to the callback.
+ * \return None.
+ *
+ * \remark Only the effects with a bounding box are found. The callback may
+ *         kill effects, but must not add decals or change bounding boxes.
+ */
+void ENG_Scheduler_QueryRect(const SDL_Rect *pRect, ENG_SchedulerQueryFn pCallback, void *pData)
+{
+    ENG_SchedulerQuery sQuery;
+
+    sQuery.pCallback = pCallback;
+    sQuery.pData     = pData;
+
+    ENG_Grid_Query(&ENG_scheduler.sDecalGrid,  pRect, ENG_Scheduler_QueryDecal,  &sQuery);
+    ENG_Grid_Query(&ENG_scheduler.sEffectGrid, pRect, ENG_Scheduler_QueryEffect, &sQuery);
 }
 
 /*!
  * \brief  Function to update the scheduler.
  *
  * \return None.
+ *
+ * \remark Only the effects which must think or die are visited.
  */
 void ENG_Scheduler_Update(void)
 {
-    ENG_Effect *pLastEffect    = NULL;
-    ENG_Effect *pCurrentEffect = ENG_scheduler.pFirstEffect;
-    Uint32      iTime          = SDL_GetTicks( );
+    ENG_Effect **pArrDue        = NULL;
+    ENG_Effect  *pCurrentEffect = NULL;
+    Uint32       iNbDue         = 0;
+    Uint32       iNewMax        = 0;
+    Uint32       i              = 0;
+    Uint32       iTime          = SDL_GetTicks( );
 
-    /* ~~~ Update the effects ~~~ */
-    while (pCurrentEffect)
+    COM_PROF_BEGIN("ENG_Scheduler_Update");
+
+    /* ~~~ Pop the effects which must think ~~~ */
+    if (ENG_scheduler.iMaxDue < ENG_scheduler.iNbThinks)
     {
-        ENG_Effect_Think(pCurrentEffect, iTime);
+        iNewMax = COM_Math_Max(ENG_scheduler.iMaxThinks, ENG_SCHEDULER_QUEUE_MIN);
+        pArrDue = (ENG_Effect **) UTIL_Realloc(ENG_scheduler.pArrDue, sizeof(ENG_Effect *) * iNewMax);
 
-        /* ~~~ Should be removed ? ~~~ */
-        if (pCurrentEffect->bKillMe)
+        if (pArrDue)
         {
-            ENG_Effect_Die(pCurrentEffect);
-
-            if (pLastEffect)
-            {
-                pLastEffect->pNext = pCurrentEffect->pNext;
-                ENG_Effect_Free(&pCurrentEffect);
-                pCurrentEffect = pLastEffect->pNext;
-            }
-            else
-            {
-                ENG_scheduler.pFirstEffect = ENG_scheduler.pFirstEffect->pNext;
-                ENG_Effect_Free(&pCurrentEffect);
-                pCurrentEffect = ENG_scheduler.pFirstEffect;
-            }
+            ENG_scheduler.pArrDue = pArrDue;
+            ENG_scheduler.iMaxDue = iNewMax;
         }
         else
         {
-            pLastEffect    = pCurrentEffect;
-            pCurrentEffect = pCurrentEffect->pNext;
+            /* ~~~ The effects left in the queue think in the next frames ~~~ */
+            COM_Log_Print(COM_LOG_ERROR, "Can't grow the due array to %d effects, the thinks are delayed !", iNewMax);
         }
     }
+
+    while ((ENG_scheduler.iNbThinks > 0) && (iNbDue < ENG_scheduler.iMaxDue) &&
+           (ENG_scheduler.pArrThinks[0]->iNextThink < iTime))
+    {
+        pCurrentEffect = ENG_scheduler.pArrThinks[0];
+        ENG_Scheduler_RemoveThink(pCurrentEffect);
+
+        ENG_scheduler.pArrDue[iNbDue++] = pCurrentEffect;
+    }
+
+    /* ~~~ Update the effects (A think may queue the effect again) ~~~ */
+    for (i = 0 ; i < iNbDue ; ++i)
+    {
+        pCurrentEffect = ENG_scheduler.pArrDue[i];
+
+        if (!pCurrentEffect->bKillMe)
+        {
+            ENG_Effect_Think(pCurrentEffect, iTime);
+        }
+    }
+
+    /* ~~~ Update the effects out of the queue (Not enough memory) ~~~ */
+    if (ENG_scheduler.iNbPolled)
+    {
+        ENG_Scheduler_UpdatePolled(iTime);
+    }
+
+    /* ~~~ Remove the killed effects (A death may kill other effects) ~~~ */
+    while (ENG_scheduler.pFirstKill)
+    {
+        pCurrentEffect           = ENG_scheduler.pFirstKill;
+        ENG_scheduler.pFirstKill = pCurrentEffect->pNextKill;
+
+        ENG_Effect_Die(pCurrentEffect);
+        ENG_Scheduler_DestroyEffect(pCurrentEffect);
+    }
+
+    COM_PROF_END( );
 }
 
 /*!
@@ -116,31 +815,49 @@ void ENG_Scheduler_Update(void)
  */
 void ENG_Scheduler_Draw(void)
 {
-    ENG_Decal  *pCurrentDecal  = NULL;
-    ENG_Effect *pCurrentEffect = NULL;
-    Uint32      iLayer         = 0;
-    Uint32      iMaxLayer      = ENG_Layer_GetMax( );
+    ENG_SchedulerLayer *pLayer         = NULL;
+    ENG_Effect         *pCurrentEffect = NULL;
+    Uint32              iLayer         = 0;
+    Uint32              iNbResets      = SDL_Render_GetResetCount( );
+    SDL_Rect            sView;
+
+    COM_PROF_BEGIN("ENG_Scheduler_Draw");
+
+    /* ~~~ The baked tiles are lost with the render targets ~~~ */
+    if (iNbResets != ENG_scheduler.iNbResets)
+    {
+        ENG_scheduler.iNbResets = iNbResets;
+        ENG_Scheduler_ResetTiles( );
+    }
+
+    ENG_View_GetRect(&sView);
+    ENG_Tile_BeginFrame(&ENG_scheduler.sTiles);
 
     /* ~~~ Draw for each layer (0 => Ground ; MaxLayer => Sky) ~~~ */
-    for (iLayer = 0 ; iLayer < iMaxLayer ; ++iLayer)
+    for (iLayer = 0 ; iLayer < ENG_scheduler.iNbLayers ; ++iLayer)
     {
-        pCurrentDecal  = ENG_scheduler.pFirstDecal;
-        pCurrentEffect = ENG_scheduler.pFirstEffect;
+        pLayer = &ENG_scheduler.pArrLayers[iLayer];
 
-        /* ~~~ Draw the decals ~~~ */
-        while (pCurrentDecal)
+        /* ~~~ Skip the empty layers ~~~ */
+        if (!pLayer->sDecals.iNbDecals && !pLayer->pFirstEffect)
         {
-            ENG_Decal_Draw(pCurrentDecal, iLayer);
-            pCurrentDecal = pCurrentDecal->pNext;
+            continue;
         }
 
+        /* ~~~ Draw the decals ~~~ */
+        ENG_Tile_DrawMap(&ENG_scheduler.sTiles, &pLayer->sTiles, &pLayer->sDecals, &sView);
+
         /* ~~~ Draw the effects ~~~ */
-        while (pCurrentEffect)
+        for (pCurrentEffect = pLayer->pFirstEffect ; pCurrentEffect ; pCurrentEffect = pCurrentEffect->pLayerNext)
         {
-            ENG_Effect_Draw(pCurrentEffect, iLayer);
-            pCurrentEffect = pCurrentEffect->pNext;
+            if (ENG_Effect_IsVisible(pCurrentEffect, &sView))
+            {
+                ENG_Effect_Draw(pCurrentEffect);
+            }
         }
     }
+
+    COM_PROF_END( );
 }
 
 /*!
@@ -150,15 +867,23 @@ void ENG_Scheduler_Draw(void)
  */
 void ENG_Scheduler_Free(void)
 {
-    ENG_Decal  *pCurrentDecal  = ENG_scheduler.pFirstDecal;
-    ENG_Effect *pCurrentEffect = ENG_scheduler.pFirstEffect;
+    ENG_SchedulerLayer *pLayer         = NULL;
+    ENG_Effect         *pCurrentEffect = ENG_scheduler.pFirstEffect;
+    Uint32              iLayer         = 0;
 
     /* ~~~ Free the decals ~~~ */
-    while (pCurrentDecal)
+    if (ENG_scheduler.pArrLayers)
     {
-        ENG_scheduler.pFirstDecal = ENG_scheduler.pFirstDecal->pNext;
-        ENG_Decal_Free(&pCurrentDecal);
-        pCurrentDecal = ENG_scheduler.pFirstDecal;
+        for (iLayer = 0 ; iLayer <= ENG_scheduler.iNbLayers ; ++iLayer)
+        {
+            pLayer = &ENG_scheduler.pArrLayers[iLayer];
+
+            ENG_Tile_ResetMap(&ENG_scheduler.sTiles, &pLayer->sTiles);
+            ENG_Decal_Free(&pLayer->sDecals);
+            pLayer->pFirstEffect = NULL;
+        }
+
+        UTIL_Free(ENG_scheduler.pArrLayers);
     }
 
     /* ~~~ Free the effects ~~~ */
@@ -168,6 +893,21 @@ void ENG_Scheduler_Free(void)
         ENG_Effect_Free(&pCurrentEffect);
         pCurrentEffect = ENG_scheduler.pFirstEffect;
     }
+
+    /* ~~~ Free the queues ~~~ */
+    UTIL_Free(ENG_scheduler.pArrThinks);
+    UTIL_Free(ENG_scheduler.pArrDue);
+
+    ENG_Grid_Free(&ENG_scheduler.sDecalGrid);
+    ENG_Grid_Free(&ENG_scheduler.sEffectGrid);
+
+    ENG_Tile_FreeCache(&ENG_scheduler.sTiles);
+
+    ENG_scheduler.pFirstKill = NULL;
+    ENG_scheduler.iNbThinks  = 0;
+    ENG_scheduler.iMaxThinks = 0;
+    ENG_scheduler.iMaxDue    = 0;
+    ENG_scheduler.iNbLayers  = 0;
 }
 
 /* ========================================================================= */
@@ -10,6 +10,11 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 28/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Bucket the decals and effects by layer.              */
+/* Nyuu    | 18/10/26 | Add the think queue and the kill list.               */
+/* Nyuu    | 18/10/26 | Decals are stored in a bounded pool for each layer.  */
+/* Nyuu    | 18/10/26 | Add the area queries on the decals and effects.      */
+/* Nyuu    | 18/10/26 | Bake the decals into cached tiles for each layer.    */
 /* ========================================================================= */
 
 #ifndef __ENG_SCHEDULER_H__
@@ -18,12 +23,37 @@
     #include "ENG_Decal.h"
     #include "ENG_Effect.h"
 
-    void ENG_Scheduler_Init     (void);
-    void ENG_Scheduler_AddDecal (ENG_Decal *pDecal);
-    void ENG_Scheduler_AddEffect(ENG_Effect *pEffect);
-    void ENG_Scheduler_Update   (void);
-    void ENG_Scheduler_Draw     (void);
-    void ENG_Scheduler_Free     (void);
+    /*!
+     * \struct ENG_SchedulerHit
+     * \brief  Structure to handle an entity found by an area query.
+     */
+    typedef struct
+    {
+        Uint32      iLayer;  /*!< Index of the layer of the entity. */
+        SDL_Rect    sBounds; /*!< Bounding box of the entity (In origin coordinates). */
+        ENG_Effect *pEffect; /*!< Pointer to the effect (NULL for a decal). */
+        SDL_Sprite *pSprite; /*!< Pointer to the sprite of the decal (NULL for an effect). */
+        Uint32      iFrame;  /*!< Index of the frame of the decal. */
+    } ENG_SchedulerHit;
+
+    /*! Callback called for each entity found by an area query. */
+    typedef void (*ENG_SchedulerQueryFn)(const ENG_SchedulerHit *pHit, void *pData);
+
+    void     ENG_Scheduler_Init         (void);
+    void     ENG_Scheduler_SetDecalMax  (const Uint32 iLayer, const Uint32 iMaxDecals);
+    void     ENG_Scheduler_SetBaking    (const Uint32 iLayer, const SDL_bool bEnabled);
+    void     ENG_Scheduler_SetTileBudget(const Uint32 iBudget);
+    void     ENG_Scheduler_ResetTiles   (void);
+    SDL_bool ENG_Scheduler_AddDecal     (const Uint32 iLayer, const SDL_Point *pOrigin, SDL_Sprite *pSprite, const Uint32 iFrame);
+    void     ENG_Scheduler_AddEffect    (ENG_Effect *pEffect);
+    void     ENG_Scheduler_MoveEffect   (ENG_Effect *pEffect, const Uint32 iLayer);
+    void     ENG_Scheduler_ThinkEffect  (ENG_Effect *pEffect);
+    void     ENG_Scheduler_BoundEffect  (ENG_Effect *pEffect);
+    void     ENG_Scheduler_KillEffect   (ENG_Effect *pEffect);
+    void     ENG_Scheduler_QueryRect    (const SDL_Rect *pRect, ENG_SchedulerQueryFn pCallback, void *pData);
+    void     ENG_Scheduler_Update       (void);
+    void     ENG_Scheduler_Draw         (void);
+    void     ENG_Scheduler_Free         (void);
 
 #endif // __ENG_SCHEDULER_H__
 
@@ -0,0 +1,175 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Slab.c
+ * \brief   File to handle the slabs.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "ENG_Slab.h"
+
+/* ========================================================================= */
+
+/*! Number of slots of the first chunk of a slab. */
+#define ENG_SLAB_CHUNK_MIN   32
+/*! Maximum number of slots of a chunk of a slab. */
+#define ENG_SLAB_CHUNK_MAX 4096
+
+/*!
+ * \struct ENG_SlabChunk
+ * \brief  Structure to handle a chunk of slots (The slots follow the header).
+ */
+struct ENG_SlabChunk
+{
+    ENG_SlabChunk *pNext; /*!< Pointer to the next chunk. */
+};
+
+/*! Size of the header of a chunk (The first slot stays aligned). */
+#define ENG_SLAB_CHUNK_HEADER ENG_Slab_AlignSize(sizeof(ENG_SlabChunk))
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to add a chunk of free slots to a slab.
+ *
+ * \param  pSlab Pointer to the slab.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool ENG_Slab_Grow(ENG_Slab *pSlab)
+{
+    ENG_SlabChunk *pChunk = NULL;
+    Uint8         *pSlot  = NULL;
+    Uint32         i      = 0;
+
+    pChunk = (ENG_SlabChunk *) UTIL_Malloc(ENG_SLAB_CHUNK_HEADER + (size_t) pSlab->iSlotSize * pSlab->iChunkSlots);
+
+    if (pChunk == NULL)
+    {
+        return SDL_FALSE;
+    }
+
+    pChunk->pNext      = pSlab->pFirstChunk;
+    pSlab->pFirstChunk = pChunk;
+
+    /* ~~~ Thread the new slots in the free list (Lowest address first) ~~~ */
+    pSlot = (Uint8 *) pChunk + ENG_SLAB_CHUNK_HEADER + (size_t) pSlab->iSlotSize * pSlab->iChunkSlots;
+
+    for (i = 0 ; i < pSlab->iChunkSlots ; ++i)
+    {
+        pSlot            -= pSlab->iSlotSize;
+        *(void **) pSlot  = pSlab->pFirstFree;
+        pSlab->pFirstFree = pSlot;
+    }
+
+    pSlab->sStats.iNbSlots += pSlab->iChunkSlots;
+    pSlab->iChunkSlots      = COM_Math_Min(pSlab->iChunkSlots << 1, ENG_SLAB_CHUNK_MAX);
+
+    return SDL_TRUE;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to allocate a slab.
+ *
+ * \param  iSlotSize Size of a slot in bytes.
+ * \return A pointer to the allocated slab, or NULL if error.
+ *
+ * \remark No slot is allocated until the first take.
+ */
+ENG_Slab *ENG_Slab_Alloc(Uint32 iSlotSize)
+{
+    ENG_Slab *pSlab = (ENG_Slab *) UTIL_Malloc(sizeof(ENG_Slab));
+
+    if (pSlab)
+    {
+        memset(pSlab, 0, sizeof(ENG_Slab));
+
+        pSlab->iSlotSize   = ENG_Slab_AlignSize(COM_Math_Max(iSlotSize, sizeof(void *)));
+        pSlab->iChunkSlots = ENG_SLAB_CHUNK_MIN;
+    }
+
+    return pSlab;
+}
+
+/*!
+ * \brief  Function to take a slot from a slab.
+ *
+ * \param  pSlab Pointer to the slab.
+ * \return A pointer to the slot, or NULL if error.
+ */
+void *ENG_Slab_Take(ENG_Slab *pSlab)
+{
+    void *pSlot = NULL;
+
+    if (pSlab->pFirstFree || ENG_Slab_Grow(pSlab))
+    {
+        pSlot             = pSlab->pFirstFree;
+        pSlab->pFirstFree = *(void **) pSlot;
+
+        pSlab->sStats.iNbUsed++;
+        pSlab->sStats.iHighWater = COM_Math_Max(pSlab->sStats.iHighWater, pSlab->sStats.iNbUsed);
+    }
+
+    return pSlot;
+}
+
+/*!
+ * \brief  Function to give back a slot to a slab.
+ *
+ * \param  pSlab Pointer to the slab.
+ * \param  pSlot Pointer to a slot taken from this slab.
+ * \return None.
+ */
+void ENG_Slab_Give(ENG_Slab *pSlab, void *pSlot)
+{
+    *(void **) pSlot  = pSlab->pFirstFree;
+    pSlab->pFirstFree = pSlot;
+
+    pSlab->sStats.iNbUsed--;
+}
+
+/*!
+ * \brief  Function to get the statistics of a slab.
+ *
+ * \param  pSlab  Pointer to the slab.
+ * \param  pStats Pointer to retrieve the statistics.
+ * \return None.
+ */
+void ENG_Slab_GetStats(const ENG_Slab *pSlab, ENG_SlabStats *pStats)
+{
+    memcpy(pStats, &pSlab->sStats, sizeof(ENG_SlabStats));
+}
+
+/*!
+ * \brief  Function to free a slab.
+ *
+ * \param  ppSlab Pointer to pointer to the slab.
+ * \return None.
+ *
+ * \remark Every slot is released, even those still in use.
+ */
+void ENG_Slab_Free(ENG_Slab **ppSlab)
+{
+    ENG_SlabChunk *pChunk = NULL;
+
+    if (*ppSlab)
+    {
+        while ((*ppSlab)->pFirstChunk)
+        {
+            pChunk                 = (*ppSlab)->pFirstChunk;
+            (*ppSlab)->pFirstChunk = pChunk->pNext;
+            UTIL_Free(pChunk);
+        }
+
+        UTIL_Free(*ppSlab);
+    }
+}
+
+/* ========================================================================= */
@@ -0,0 +1,63 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Slab.h
+ * \brief   File to interface with the slabs.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#ifndef __ENG_SLAB_H__
+#define __ENG_SLAB_H__
+
+    #include "ENG_Shared.h"
+
+    /*! Alignment of the slots of a slab (in bytes). */
+    #define ENG_SLAB_ALIGN 16
+
+    /*! Macro to align a size on the slots alignment. */
+    #define ENG_Slab_AlignSize(x) (((x) + (ENG_SLAB_ALIGN - 1)) & ~(ENG_SLAB_ALIGN - 1))
+
+    /*! Typedef to handle a chunk of slots. */
+    typedef struct ENG_SlabChunk ENG_SlabChunk;
+
+    /*!
+     * \struct ENG_SlabStats
+     * \brief  Structure to handle the statistics of a slab.
+     */
+    typedef struct
+    {
+        Uint32 iNbUsed;    /*!< Number of slots in use. */
+        Uint32 iNbSlots;   /*!< Number of slots allocated. */
+        Uint32 iHighWater; /*!< Maximum number of slots used at the same time. */
+    } ENG_SlabStats;
+
+    /*!
+     * \struct ENG_Slab
+     * \brief  Structure to handle a slab (Fixed-size slots with a free list).
+     */
+    typedef struct
+    {
+        Uint32         iSlotSize;   /*!< Size of a slot in bytes. */
+        Uint32         iChunkSlots; /*!< Number of slots of the next chunk. */
+
+        void          *pFirstFree;  /*!< Pointer to the first free slot. */
+        ENG_SlabChunk *pFirstChunk; /*!< Pointer to the first chunk. */
+
+        ENG_SlabStats  sStats;      /*!< Statistics of the slab. */
+    } ENG_Slab;
+
+    ENG_Slab *ENG_Slab_Alloc   (Uint32 iSlotSize);
+    void     *ENG_Slab_Take    (ENG_Slab *pSlab);
+    void      ENG_Slab_Give    (ENG_Slab *pSlab, void *pSlot);
+    void      ENG_Slab_GetStats(const ENG_Slab *pSlab, ENG_SlabStats *pStats);
+    void      ENG_Slab_Free    (ENG_Slab **ppSlab);
+
+#endif // __ENG_SLAB_H__
+
+/* ========================================================================= */
@@ -0,0 +1,549 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Tile.c
+ * \brief   File to handle the tiles of baked decals.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Bake only the decals found in the tile.              */
+/* ========================================================================= */
+
+#include "ENG_Tile.h"
+
+/* ========================================================================= */
+
+/*! Size of a tile in pixels. */
+#define ENG_TILE_SIZE  (1 << ENG_TILE_SHIFT)
+/*! Size of the texture of a tile in bytes. */
+#define ENG_TILE_BYTES (ENG_TILE_SIZE * ENG_TILE_SIZE * 4)
+
+/*!
+ * \struct ENG_Tile
+ * \brief  Structure to handle a tile (A render target with the decals baked).
+ */
+struct ENG_Tile
+{
+    Sint32       iTileX;    /*!< Position of the tile on x (In tiles). */
+    Sint32       iTileY;    /*!< Position of the tile on y (In tiles). */
+    SDL_Texture *pTexture;  /*!< Pointer to the texture of the tile. */
+    SDL_bool     bDirty;    /*!< Flag set if the tile must be baked again. */
+    Uint32       iFrame;    /*!< Index of the last frame using the tile. */
+
+    ENG_TileMap *pMap;      /*!< Pointer to the map of the tile. */
+    ENG_Tile    *pNextHash; /*!< Pointer to the next tile of the bucket. */
+    ENG_Tile    *pPrevUsed; /*!< Pointer to the tile used more recently. */
+    ENG_Tile    *pNextUsed; /*!< Pointer to the tile used less recently. */
+};
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the tile of a coordinate.
+ *
+ * \param  iCoord Coordinate (In origin coordinates).
+ * \return The tile containing the coordinate (Rounded down).
+ */
+static Sint32 ENG_Tile_GetCoord(const Sint32 iCoord)
+{
+    return (iCoord >= 0) ? (iCoord >> ENG_TILE_SHIFT) : (-((-(iCoord + 1)) >> ENG_TILE_SHIFT) - 1);
+}
+
+/*!
+ * \brief  Function to get the bucket of a tile.
+ *
+ * \param  iTileX Position of the tile on x.
+ * \param  iTileY Position of the tile on y.
+ * \return The index of the bucket.
+ */
+static Uint32 ENG_Tile_GetBucket(const Sint32 iTileX, const Sint32 iTileY)
+{
+    return (((Uint32) iTileX * 73856093U) ^ ((Uint32) iTileY * 19349663U)) & (ENG_TILE_NB_BUCKETS - 1);
+}
+
+/*!
+ * \brief  Function to get the rectangle of a tile.
+ *
+ * \param  pTile Pointer to the tile.
+ * \param  pRect Pointer to retrieve the rectangle (In origin coordinates).
+ * \return None.
+ */
+static void ENG_Tile_GetRect(const ENG_Tile *pTile, SDL_Rect *pRect)
+{
+    pRect->x = pTile->iTileX * ENG_TILE_SIZE;
+    pRect->y = pTile->iTileY * ENG_TILE_SIZE;
+    pRect->w = ENG_TILE_SIZE;
+    pRect->h = ENG_TILE_SIZE;
+}
+
+/*!
+ * \brief  Function to find a resident tile.
+ *
+ * \param  pMap   Pointer to the map.
+ * \param  iTileX Position of the tile on x.
+ * \param  iTileY Position of the tile on y.
+ * \return A pointer to the tile, or NULL if not resident.
+ */
+static ENG_Tile *ENG_Tile_Find(const ENG_TileMap *pMap, const Sint32 iTileX, const Sint32 iTileY)
+{
+    ENG_Tile *pTile = pMap->arrBuckets[ENG_Tile_GetBucket(iTileX, iTileY)];
+
+    while (pTile && ((pTile->iTileX != iTileX) || (pTile->iTileY != iTileY)))
+    {
+        pTile = pTile->pNextHash;
+    }
+
+    return pTile;
+}
+
+/*!
+ * \brief  Function to mark a tile as the most recently used.
+ *
+ * \param  pCache Pointer to the cache.
+ * \param  pTile  Pointer to the tile.
+ * \return None.
+ */
+static void ENG_Tile_Touch(ENG_TileCache *pCache, ENG_Tile *pTile)
+{
+    pTile->iFrame = pCache->iFrame;
+
+    if (pCache->pFirstUsed == pTile)
+    {
+        return;
+    }
+
+    /* ~~~ Unlink ~~~ */
+    if (pTile->pPrevUsed)
+    {
+        pTile->pPrevUsed->pNextUsed = pTile->pNextUsed;
+    }
+
+    if (pTile->pNextUsed)
+    {
+        pTile->pNextUsed->pPrevUsed = pTile->pPrevUsed;
+    }
+    else if (pCache->pLastUsed == pTile)
+    {
+        pCache->pLastUsed = pTile->pPrevUsed;
+    }
+
+    /* ~~~ Link in first ~~~ */
+    pTile->pPrevUsed = NULL;
+    pTile->pNextUsed = pCache->pFirstUsed;
+
+    if (pCache->pFirstUsed)
+    {
+        pCache->pFirstUsed->pPrevUsed = pTile;
+    }
+    else
+    {
+        pCache->pLastUsed = pTile;
+    }
+
+    pCache->pFirstUsed = pTile;
+}
+
+/*!
+ * \brief  Function to destroy a resident tile.
+ *
+ * \param  pCache Pointer to the cache.
+ * \param  pTile  Pointer to the tile.
+ * \return None.
+ */
+static void ENG_Tile_Destroy(ENG_TileCache *pCache, ENG_Tile *pTile)
+{
+    ENG_Tile **ppTile = &pTile->pMap->arrBuckets[ENG_Tile_GetBucket(pTile->iTileX, pTile->iTileY)];
+
+    while (*ppTile != pTile)
+    {
+        ppTile = &(*ppTile)->pNextHash;
+    }
+
+    *ppTile = pTile->pNextHash;
+
+    if (pTile->pPrevUsed)
+    {
+        pTile->pPrevUsed->pNextUsed = pTile->pNextUsed;
+    }
+    else
+    {
+        pCache->pFirstUsed = pTile->pNextUsed;
+    }
+
+    if (pTile->pNextUsed)
+    {
+        pTile->pNextUsed->pPrevUsed = pTile->pPrevUsed;
+    }
+    else
+    {
+        pCache->pLastUsed = pTile->pPrevUsed;
+    }
+
+    UTIL_TextureFree(&pTile->pTexture);
+    UTIL_Free(pTile);
+
+    pCache->iNbTiles--;
+}
+
+/*!
+ * \brief  Function to bake the decals of a pool into a tile.
+ *
+ * \param  pTile Pointer to the tile.
+ * \param  pPool Pointer to the pool.
+ * \param  iAge  Age of the first decal to bake (0 => Oldest, and clear the tile).
+ * \return None.
+ *
+ * \remark The tile stays the render target.
+ */
+static void ENG_Tile_Bake(ENG_Tile *pTile, ENG_DecalPool *pPool, const Uint32 iAge)
+{
+    SDL_Rect sRect;
+
+    ENG_Tile_GetRect(pTile, &sRect);
+    SDL_Render_SetTarget(pTile->pTexture);
+
+    if (iAge == 0)
+    {
+        SDL_Render_ClearTarget( );
+    }
+
+    ENG_Decal_DrawArea(pPool, iAge, &sRect);
+
+    pTile->bDirty = SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to get a resident tile, creating and baking it if needed.
+ *
+ * \param  pCache Pointer to the cache.
+ * \param  pMap   Pointer to the map.
+ * \param  pPool  Pointer to the pool.
+ * \param  iTileX Position of the tile on x.
+ * \param  iTileY Position of the tile on y.
+ * \return A pointer to the tile, or NULL if the budget is exhausted.
+ *
+ * \remark The least recently used tile is evicted if it is not used during
+ *         the current frame.
+ */
+static ENG_Tile *ENG_Tile_Acquire(ENG_TileCache *pCache, ENG_TileMap *pMap, ENG_DecalPool *pPool, const Sint32 iTileX, const Sint32 iTileY)
+{
+    ENG_Tile *pTile   = ENG_Tile_Find(pMap, iTileX, iTileY);
+    Uint32    iBucket = 0;
+
+    if (!pTile)
+    {
+        if (pCache->iNbTiles >= pCache->iMaxTiles)
+        {
+            if (!pCache->pLastUsed || (pCache->pLastUsed->iFrame == pCache->iFrame))
+            {
+                return NULL;
+            }
+
+            ENG_Tile_Destroy(pCache, pCache->pLastUsed);
+        }
+
+        pTile = (ENG_Tile *) UTIL_Malloc(sizeof(ENG_Tile));
+
+        if (!pTile)
+        {
+            return NULL;
+        }
+
+        pTile->pTexture = SDL_Render_CreateTargetTexture(ENG_TILE_SIZE, ENG_TILE_SIZE);
+
+        if (!pTile->pTexture)
+        {
+            UTIL_Free(pTile);
+            return NULL;
+        }
+
+        iBucket           = ENG_Tile_GetBucket(iTileX, iTileY);
+        pTile->iTileX     = iTileX;
+        pTile->iTileY     = iTileY;
+        pTile->bDirty     = SDL_TRUE;
+        pTile->pMap       = pMap;
+        pTile->pNextHash  = pMap->arrBuckets[iBucket];
+        pTile->pPrevUsed  = NULL;
+        pTile->pNextUsed  = NULL;
+
+        pMap->arrBuckets[iBucket] = pTile;
+        pCache->iNbTiles++;
+
+        /* ~~~ Link it as the least recently used, the touch moves it ~~~ */
+        if (pCache->pLastUsed)
+        {
+            pCache->pLastUsed->pNextUsed = pTile;
+            pTile->pPrevUsed             = pCache->pLastUsed;
+        }
+        else
+        {
+            pCache->pFirstUsed = pTile;
+        }
+
+        pCache->pLastUsed = pTile;
+    }
+
+    ENG_Tile_Touch(pCache, pTile);
+
+    if (pTile->bDirty)
+    {
+        ENG_Tile_Bake(pTile, pPool, 0);
+    }
+
+    return pTile;
+}
+
+/*!
+ * \brief  Function to update the resident tiles of a map with the changes of the pool.
+ *
+ * \param  pMap  Pointer to the map.
+ * \param  pPool Pointer to the pool.
+ * \return SDL_TRUE if a tile became the render target, else SDL_FALSE.
+ *
+ * \remark The new decals are baked into the resident tiles, the tiles
+ *         under the recycled decals are baked again when next drawn.
+ */
+static SDL_bool ENG_Tile_Update(ENG_TileMap *pMap, ENG_DecalPool *pPool)
+{
+    ENG_Tile *pTile   = NULL;
+    Uint32    iNbNew  = pPool->iNbAdded - pMap->iNbBaked;
+    SDL_bool  bTarget = SDL_FALSE;
+    SDL_Rect  sRect;
+    Uint32    i       = 0;
+
+    for (i = 0 ; i < ENG_TILE_NB_BUCKETS ; ++i)
+    {
+        for (pTile = pMap->arrBuckets[i] ; pTile ; pTile = pTile->pNextHash)
+        {
+            ENG_Tile_GetRect(pTile, &sRect);
+
+            if ((pPool->bRecycled && SDL_HasIntersection(&sRect, &pPool->sRecycled)) || (iNbNew >= pPool->iNbDecals))
+            {
+                pTile->bDirty = SDL_TRUE;
+            }
+            else if (iNbNew && !pTile->bDirty)
+            {
+                ENG_Tile_Bake(pTile, pPool, pPool->iNbDecals - iNbNew);
+                bTarget = SDL_TRUE;
+            }
+        }
+    }
+
+    pPool->bRecycled = SDL_FALSE;
+    pMap->iNbBaked   = pPool->iNbAdded;
+
+    return bTarget;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to init the cache of the tiles.
+ *
+ * \param  pCache  Pointer to the cache.
+ * \param  iBudget Memory budget of the tiles (In bytes).
+ * \return None.
+ */
+void ENG_Tile_InitCache(ENG_TileCache *pCache, Uint32 iBudget)
+{
+    memset(pCache, 0, sizeof(ENG_TileCache));
+
+    pCache->iMaxTiles = iBudget / ENG_TILE_BYTES;
+}
+
+/*!
+ * \brief  Function to set the memory budget of the tiles.
+ *
+ * \param  pCache  Pointer to the cache.
+ * \param  iBudget Memory budget of the tiles (In bytes).
+ * \return None.
+ *
+ * \remark The least recently used tiles are evicted to fit the budget.
+ */
+void ENG_Tile_SetBudget(ENG_TileCache *pCache, Uint32 iBudget)
+{
+    pCache->iMaxTiles = iBudget / ENG_TILE_BYTES;
+
+    while (pCache->iNbTiles > pCache->iMaxTiles)
+    {
+        ENG_Tile_Destroy(pCache, pCache->pLastUsed);
+    }
+}
+
+/*!
+ * \brief  Function to start a new frame (The tiles used before may be evicted).
+ *
+ * \param  pCache Pointer to the cache.
+ * \return None.
+ */
+void ENG_Tile_BeginFrame(ENG_TileCache *pCache)
+{
+    pCache->iFrame++;
+}
+
+/*!
+ * \brief  Function to free the cache of the tiles.
+ *
+ * \param  pCache Pointer to the cache.
+ * \return None.
+ *
+ * \remark The maps must be reset before.
+ */
+void ENG_Tile_FreeCache(ENG_TileCache *pCache)
+{
+    while (pCache->pLastUsed)
+    {
+        ENG_Tile_Destroy(pCache, pCache->pLastUsed);
+    }
+
+    pCache->iFrame = 0;
+}
+
+/*!
+ * \brief  Function to init the tiles of a layer.
+ *
+ * \param  pMap Pointer to the map.
+ * \return None.
+ *
+ * \remark The baking is disabled by default.
+ */
+void ENG_Tile_InitMap(ENG_TileMap *pMap)
+{
+    memset(pMap, 0, sizeof(ENG_TileMap));
+}
+
+/*!
+ * \brief  Function to enable or disable the baking of the decals of a layer.
+ *
+ * \param  pCache   Pointer to the cache.
+ * \param  pMap     Pointer to the map.
+ * \param  pPool    Pointer to the pool of the layer.
+ * \param  bEnabled SDL_TRUE to bake the decals, else SDL_FALSE.
+ * \return None.
+ *
+ * \remark The baking stays disabled if the renderer has no render target.
+ */
+void ENG_Tile_EnableMap(ENG_TileCache *pCache, ENG_TileMap *pMap, ENG_DecalPool *pPool, SDL_bool bEnabled)
+{
+    ENG_Tile_ResetMap(pCache, pMap);
+
+    if (bEnabled && !SDL_Render_HasTargets( ))
+    {
+        COM_Log_Print(COM_LOG_WARNING, "Decals baking disabled: the renderer has no render target !");
+        bEnabled = SDL_FALSE;
+    }
+
+    pMap->bEnabled   = bEnabled;
+    pMap->iNbBaked   = pPool->iNbAdded;
+    pPool->bRecycled = SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to drop the resident tiles of a layer.
+ *
+ * \param  pCache Pointer to the cache.
+ * \param  pMap   Pointer to the map.
+ * \return None.
+ *
+ * \remark The tiles are baked again from the pool when next drawn.
+ */
+void ENG_Tile_ResetMap(ENG_TileCache *pCache, ENG_TileMap *pMap)
+{
+    Uint32 i = 0;
+
+    for (i = 0 ; i < ENG_TILE_NB_BUCKETS ; ++i)
+    {
+        while (pMap->arrBuckets[i])
+        {
+            ENG_Tile_Destroy(pCache, pMap->arrBuckets[i]);
+        }
+    }
+}
+
+/*!
+ * \brief  Function to draw the decals of a layer.
+ *
+ * \param  pCache Pointer to the cache.
+ * \param  pMap   Pointer to the map.
+ * \param  pPool  Pointer to the pool of the layer.
+ * \param  pView  Pointer to the rectangle of the view (In origin coordinates).
+ * \return None.
+ *
+ * \remark With the baking, one texture is drawn for each visible tile. The
+ *         decals are drawn one by one if the budget can not hold the view.
+ */
+void ENG_Tile_DrawMap(ENG_TileCache *pCache, ENG_TileMap *pMap, ENG_DecalPool *pPool, const SDL_Rect *pView)
+{
+    ENG_Tile *pTile   = NULL;
+    SDL_bool  bTarget = SDL_FALSE;
+    SDL_bool  bFailed = SDL_FALSE;
+    Sint32    iMinX   = ENG_Tile_GetCoord(pView->x);
+    Sint32    iMinY   = ENG_Tile_GetCoord(pView->y);
+    Sint32    iMaxX   = ENG_Tile_GetCoord(pView->x + pView->w - 1);
+    Sint32    iMaxY   = ENG_Tile_GetCoord(pView->y + pView->h - 1);
+    Sint32    iTileX  = 0;
+    Sint32    iTileY  = 0;
+    SDL_Rect  sPos;
+
+    if (!pMap->bEnabled)
+    {
+        ENG_Decal_Draw(pPool, pView);
+        return;
+    }
+
+    if (!pPool->iNbDecals)
+    {
+        return;
+    }
+
+    bTarget = ENG_Tile_Update(pMap, pPool);
+
+    /* ~~~ Make every visible tile resident first ~~~ */
+    if ((Uint32) ((iMaxX - iMinX + 1) * (iMaxY - iMinY + 1)) > pCache->iMaxTiles)
+    {
+        bFailed = SDL_TRUE;
+    }
+
+    for (iTileY = iMinY ; (iTileY <= iMaxY) && !bFailed ; ++iTileY)
+    {
+        for (iTileX = iMinX ; (iTileX <= iMaxX) && !bFailed ; ++iTileX)
+        {
+            pTile   = ENG_Tile_Find(pMap, iTileX, iTileY);
+            bTarget = (bTarget || !pTile || pTile->bDirty) ? SDL_TRUE : SDL_FALSE;
+            bFailed = ENG_Tile_Acquire(pCache, pMap, pPool, iTileX, iTileY) ? SDL_FALSE : SDL_TRUE;
+        }
+    }
+
+    if (bTarget)
+    {
+        SDL_Render_SetTarget(NULL);
+    }
+
+    if (bFailed)
+    {
+        ENG_Decal_Draw(pPool, pView);
+        return;
+    }
+
+    /* ~~~ One blit for each visible tile ~~~ */
+    sPos.w = ENG_TILE_SIZE;
+    sPos.h = ENG_TILE_SIZE;
+
+    for (iTileY = iMinY ; iTileY <= iMaxY ; ++iTileY)
+    {
+        for (iTileX = iMinX ; iTileX <= iMaxX ; ++iTileX)
+        {
+            pTile  = ENG_Tile_Find(pMap, iTileX, iTileY);
+            sPos.x = (iTileX * ENG_TILE_SIZE) - pView->x;
+            sPos.y = (iTileY * ENG_TILE_SIZE) - pView->y;
+
+            SDL_Render_DrawTexture(pTile->pTexture, NULL, &sPos);
+        }
+    }
+}
+
+/* ========================================================================= */
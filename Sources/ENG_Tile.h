@@ -0,0 +1,68 @@
+/* ========================================================================= */
+/*!
+ * \file    ENG_Tile.h
+ * \brief   File to interface with the tiles of baked decals.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#ifndef __ENG_TILE_H__
+#define __ENG_TILE_H__
+
+    #include "ENG_Decal.h"
+
+    /*! Size of a tile (1 << ENG_TILE_SHIFT pixels). */
+    #define ENG_TILE_SHIFT          9
+    /*! Number of buckets of the tiles hash table of a map (Power of two). */
+    #define ENG_TILE_NB_BUCKETS     64
+    /*! Default memory budget of the tiles (In bytes). */
+    #define ENG_TILE_DEFAULT_BUDGET (64 * 1024 * 1024)
+
+    /*! Typedef to handle a tile. */
+    typedef struct ENG_Tile ENG_Tile;
+
+    /*!
+     * \struct ENG_TileMap
+     * \brief  Structure to handle the tiles of a layer.
+     */
+    typedef struct
+    {
+        ENG_Tile *arrBuckets[ENG_TILE_NB_BUCKETS]; /*!< Hash table of the resident tiles. */
+        Uint32    iNbBaked;                        /*!< Value of the added counter of the pool at the last bake. */
+        SDL_bool  bEnabled;                        /*!< Flag set if the decals of the layer are baked. */
+    } ENG_TileMap;
+
+    /*!
+     * \struct ENG_TileCache
+     * \brief  Structure to handle the tiles shared by all the layers.
+     */
+    typedef struct
+    {
+        ENG_Tile *pFirstUsed; /*!< Pointer to the tile used the most recently. */
+        ENG_Tile *pLastUsed;  /*!< Pointer to the tile used the least recently. */
+        Uint32    iNbTiles;   /*!< Number of resident tiles. */
+        Uint32    iMaxTiles;  /*!< Maximum number of resident tiles (From the budget). */
+        Uint32    iFrame;     /*!< Index of the current frame. */
+    } ENG_TileCache;
+
+    /* ----- Use ONLY by the scheduler ----- */
+    void ENG_Tile_InitCache (ENG_TileCache *pCache, Uint32 iBudget);
+    void ENG_Tile_SetBudget (ENG_TileCache *pCache, Uint32 iBudget);
+    void ENG_Tile_BeginFrame(ENG_TileCache *pCache);
+    void ENG_Tile_FreeCache (ENG_TileCache *pCache);
+
+    void ENG_Tile_InitMap   (ENG_TileMap *pMap);
+    void ENG_Tile_EnableMap (ENG_TileCache *pCache, ENG_TileMap *pMap, ENG_DecalPool *pPool, SDL_bool bEnabled);
+    void ENG_Tile_ResetMap  (ENG_TileCache *pCache, ENG_TileMap *pMap);
+    void ENG_Tile_DrawMap   (ENG_TileCache *pCache, ENG_TileMap *pMap, ENG_DecalPool *pPool, const SDL_Rect *pView);
+    /* ------------------------------------- */
+
+#endif // __ENG_TILE_H__
+
+/* ========================================================================= */
@@ -10,6 +10,7 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 28/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add ENG_View_GetRect for the culling.                */
 /* ========================================================================= */
 
 #include "ENG_View.h"
@@ -73,4 +74,18 @@ void ENG_View_ConvOrigin(const SDL_Point *pOrigin, SDL_Point *pPos)
     pPos->y = (pOrigin->y - ENG_view.y);
 }
 
+/*!
+ * \brief  Function to get the rectangle of the view.
+ *
+ * \param  pRect Pointer to retrieve the rectangle (In origin coordinates).
+ * \return None.
+ */
+void ENG_View_GetRect(SDL_Rect *pRect)
+{
+    pRect->x = ENG_view.x;
+    pRect->y = ENG_view.y;
+    pRect->w = ENG_view.w;
+    pRect->h = ENG_view.h;
+}
+
 /* ========================================================================= */
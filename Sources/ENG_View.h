@@ -10,6 +10,7 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 28/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add ENG_View_GetRect for the culling.                */
 /* ========================================================================= */
 
 #ifndef __ENG_VIEW_H__
@@ -21,6 +22,7 @@
     void ENG_View_SetOrigin(const SDL_Point *pOrigin);
     void ENG_View_CenterOrigin(const SDL_Point *pOrigin);
     void ENG_View_ConvOrigin(const SDL_Point *pOrigin, SDL_Point *pPos);
+    void ENG_View_GetRect(SDL_Rect *pRect);
 
 #endif // __ENG_VIEW_H__
 
@@ -10,6 +10,10 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Orlyn   | 28/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add the profiler zones of the update and the draw.   */
+/* Nyuu    | 18/10/26 | Precache the assets of the menus in bulk.            */
+/* Nyuu    | 18/10/26 | Release the bulk references and the menu sprites.    */
+/* Nyuu    | 18/10/26 | Release only the references taken by the bulk.       */
 /* ========================================================================= */
 
 #include "HUI_Menu.h"
@@ -26,6 +30,22 @@ static HUI_MenuStack HUI_stack;
 static HUI_ID iNextID;
 static TTF_Font *pFont;
 
+/*! Name of the font of the menus, with its size. */
+#define HUI_MENU_FONT "codenewroman:30"
+
+/*! Assets of the menus, precached in bulk by the init. */
+static const SDL_PrecacheAsset HUI_menuAssets[ ] =
+{
+    { SDL_PRECACHE_FONT,   HUI_MENU_FONT },
+    { SDL_PRECACHE_SPRITE, "menuPause"   },
+    { SDL_PRECACHE_SPRITE, "menuStats"   },
+    { SDL_PRECACHE_SPRITE, "steam"       },
+    { SDL_PRECACHE_SPRITE, "button"      },
+    { SDL_PRECACHE_SPRITE, "button2"     },
+    { SDL_PRECACHE_SPRITE, "swOn"        },
+    { SDL_PRECACHE_SPRITE, "swOff"       }
+};
+
 
 static HUI_Menu *pMenuPause;
 static HUI_Menu *pMenuStats;
@@ -295,6 +315,25 @@ static void HUI_MenuButton_Init(HUI_Menu *pMenu, Uint32 iNbLinks, ...)
     va_end(list);
 }
 
+/*!
+* \brief Function to free the array of sprite of a menu.
+*
+* \param pMenu    Pointer to menu.
+* \return None.
+*/
+static void HUI_MenuSprites_Free(HUI_Menu *pMenu)
+{
+    Uint32 i = 0;
+    if (pMenu->arrSprite)
+    {
+        for (i = 0; pMenu->arrSprite[i].pSprite; ++i)
+        {
+            SDL_Precache_Release(SDL_PRECACHE_SPRITE, SDL_Sprite_GetName(pMenu->arrSprite[i].pSprite));
+        }
+        UTIL_Free(pMenu->arrSprite);
+    }
+}
+
 /*!
 * \brief Function to free the array of links of a menu.
 *
@@ -308,6 +347,14 @@ static void HUI_MenuButton_Free(HUI_Menu *pMenu)
     {
         while (pMenu->pArrButtons[i])
         {
+            if (pMenu->pArrButtons[i]->eType == HUI_MENU_SWITCH)
+            {
+                HUI_Switch_Free(&pMenu->pArrButtons[i]->sSwitch);
+            }
+            else if (pMenu->pArrButtons[i]->pSprite)
+            {
+                SDL_Precache_Release(SDL_PRECACHE_SPRITE, SDL_Sprite_GetName(pMenu->pArrButtons[i]->pSprite));
+            }
             UTIL_Free(pMenu->pArrButtons[i]);
             ++i;
         }
@@ -576,14 +623,21 @@ static void HUI_Menu_InitMap(void)
 */
 void HUI_Menu_Init(void)
 {
+    SDL_Font *pMenuFont = NULL;
+    SDL_bool  arrTaken[UTIL_ArraySize(HUI_menuAssets)];
+
     HUI_Menu_InitStack();
-    pFont = TTF_OpenFont("fonts/codenewroman.ttf", 30);
+    SDL_Precache_Bulk(HUI_menuAssets, UTIL_ArraySize(HUI_menuAssets), arrTaken);
+    pMenuFont = SDL_Precache_Font(HUI_MENU_FONT);
+    pFont     = pMenuFont ? SDL_Font_GetTTF(pMenuFont) : NULL;
     if (pFont)
     {
         HUI_Menu_InitPause();
         HUI_Menu_InitStats();
         HUI_Menu_InitMap();
     }
+    /* The menus hold their own references */
+    SDL_Precache_ReleaseBulk(HUI_menuAssets, UTIL_ArraySize(HUI_menuAssets), arrTaken);
 }
 
 /*!
@@ -639,6 +693,7 @@ void HUI_Menu_Update(HUI_Input *pInput)
 {
     HUI_Menu *pMenu = NULL;
     Uint32 i = 0;
+    COM_PROF_BEGIN("HUI_Menu_Update");
     pMenu = HUI_Menu_GetMenu(HUI_Menu_GetID());
     if (pMenu)
     {
@@ -662,6 +717,7 @@ void HUI_Menu_Update(HUI_Input *pInput)
         }
         HUI_Menu_Quit(pInput);
     }
+    COM_PROF_END();
 }
 
 /*!
@@ -674,6 +730,7 @@ void HUI_Menu_Draw(void)
 {
     HUI_Menu *pMenu = NULL;
     Uint32 i = 0;
+    COM_PROF_BEGIN("HUI_Menu_Draw");
     pMenu = HUI_Menu_GetMenu(HUI_Menu_GetID());
     if (pMenu)
     {
@@ -721,6 +778,7 @@ void HUI_Menu_Draw(void)
             }
         }
     }
+    COM_PROF_END();
 }
 
 /*!
@@ -788,12 +846,16 @@ void HUI_Menu_Free(void)
             HUI_MenuText_Free(pMenu);
             HUI_MenuTextBox_Free(pMenu);
             HUI_MenuButton_Free(pMenu);
-            UTIL_Free(pMenu->arrSprite);
+            HUI_MenuSprites_Free(pMenu);
             UTIL_Free(pMenu);
         }
     }
     UTIL_Free(HUI_stack.pID);
-    TTF_CloseFont(pFont);
+    if (pFont)
+    {
+        SDL_Precache_Release(SDL_PRECACHE_FONT, HUI_MENU_FONT);
+        pFont = NULL;
+    }
 }
 
 /* ========================================================================= */
\ No newline at end of file
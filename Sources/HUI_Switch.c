@@ -10,6 +10,7 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Orlyn   | 13/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add HUI_Switch_Free (Release of the sprites).        */
 /* ========================================================================= */
 
 #include "HUI_Switch.h"
@@ -257,4 +258,25 @@ HUI_SwitchState HUI_Switch_GetState(const HUI_Switch *pSwitch)
 {
     return pSwitch->iState;
 }
+
+/*!
+* \brief  Function to free a switch.
+*
+* \param  pSwitch Pointer to the switch.
+* \return None.
+*/
+void HUI_Switch_Free(HUI_Switch *pSwitch)
+{
+    if (pSwitch->pSpriteEnable)
+    {
+        SDL_Precache_Release(SDL_PRECACHE_SPRITE, SDL_Sprite_GetName(pSwitch->pSpriteEnable));
+        pSwitch->pSpriteEnable = NULL;
+    }
+
+    if (pSwitch->pSpriteDisable)
+    {
+        SDL_Precache_Release(SDL_PRECACHE_SPRITE, SDL_Sprite_GetName(pSwitch->pSpriteDisable));
+        pSwitch->pSpriteDisable = NULL;
+    }
+}
 /* ========================================================================= */
\ No newline at end of file
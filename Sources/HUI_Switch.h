@@ -10,6 +10,7 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Orlyn   | 13/07/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add HUI_Switch_Free (Release of the sprites).        */
 /* ========================================================================= */
 
 #ifndef __HUI_SWITCH_H__
@@ -59,6 +60,7 @@
     void            HUI_Switch_SetPosition(HUI_Switch *pSwitch, Sint32 x, Sint32 y);
     void            HUI_Switch_GetPosition(const HUI_Switch *pSwitch, SDL_Point *pPos);
     HUI_SwitchState HUI_Switch_GetState(const HUI_Switch *pSwitch);
+    void            HUI_Switch_Free(HUI_Switch *pSwitch);
 
 #endif // __HUI_SWITCH_H__
 /* ========================================================================= */
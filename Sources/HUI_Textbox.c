@@ -16,6 +16,7 @@
 /* Orlyn   | 18/06/15 | Clean and add repeat key support                     */
 /* Orlyn   | 19/06/15 | Clean                                                */
 /* Red     | 26/06/15 | Updated due to the HUI_Text update                   */
+/* Nyuu    | 18/10/26 | Cursor rendered once instead of at each blink.       */
 /* ========================================================================= */
 
 #include "HUI_Textbox.h"
@@ -128,18 +129,14 @@ static void HUI_Textbox_Add(HUI_Textbox *pTextBox)
 */
 static void HUI_Textbox_DrawCursor(HUI_Textbox *pTextBox)
 {
-    SDL_Color colorCursor = { 0, 0, 0, 255 };
-    HUI_Text  sCursor;
     SDL_Point sCursorPt;
     if (HUI_Textbox_IsActive(pTextBox))
     {
         if (SDL_GetTicks() - pTextBox->iCursorTime >= 500)
         {
             HUI_Textbox_UpdateCursor(pTextBox, &sCursorPt);
-            HUI_Text_Init(&sCursor, pTextBox->pFont, &colorCursor, &sCursorPt);
-            HUI_Text_SetText(&sCursor, "|", 0);
-            HUI_Text_Draw(&sCursor);
-            HUI_Text_Free(&sCursor);
+            HUI_Text_SetPosition(&pTextBox->sCursor, &sCursorPt);
+            HUI_Text_Draw(&pTextBox->sCursor);
 
             if (SDL_GetTicks() - pTextBox->iCursorTime >= 1000)
             {
@@ -289,8 +286,9 @@ static void HUI_Textbox_CheckActive(HUI_Textbox *pTextBox, const HUI_Input *pInp
  */
 void HUI_Textbox_Init(HUI_Textbox *pTextBox, TTF_Font *pFont, SDL_Color *pColor, SDL_Rect *pDest, Uint16 iLength, char* szText)
 {
-    Sint32 iW = 0;
-    Sint32 iH = 0;
+    SDL_Color colorCursor = { 0, 0, 0, 255 };
+    Sint32    iW          = 0;
+    Sint32    iH          = 0;
 
     TTF_SizeText(pFont, " ", &iW, NULL);
     TTF_SizeText(pFont, "|", NULL, &iH);
@@ -327,6 +325,9 @@ void HUI_Textbox_Init(HUI_Textbox *pTextBox, TTF_Font *pFont, SDL_Color *pColor,
     pTextBox->pText          = (HUI_Text*) UTIL_Malloc(sizeof(HUI_Text));
     HUI_Text_Init(pTextBox->pText, pTextBox->pFont, pColor, &pTextBox->sPointCursor);
     HUI_Text_SetText(pTextBox->pText, pTextBox->szText, 0);
+    /*Init the cursor, drawn at each blink*/
+    HUI_Text_Init(&pTextBox->sCursor, pTextBox->pFont, &colorCursor, &pTextBox->sPointCursor);
+    HUI_Text_SetText(&pTextBox->sCursor, "|", 0);
     /*Init time*/
     pTextBox->iLastTime      = SDL_GetTicks();
     pTextBox->iCursorTime    = SDL_GetTicks();
@@ -510,6 +511,7 @@ char *HUI_Textbox_GetText(HUI_Textbox *pTextBox)
 void HUI_Textbox_Free(HUI_Textbox *pTextBox)
 {
     HUI_Text_Free(pTextBox->pText);
+    HUI_Text_Free(&pTextBox->sCursor);
     UTIL_Free(pTextBox->pText);
     UTIL_Free(pTextBox->szText);
 }
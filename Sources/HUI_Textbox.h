@@ -16,6 +16,7 @@
 /* Orlyn   | 18/06/15 | Clean and add repeat key support                     */
 /* Orlyn   | 19/06/15 | Clean                                                */
 /* Red     | 27/06/15 | Remove the param pColorFont from the structure       */
+/* Nyuu    | 18/10/26 | Cursor rendered once instead of at each blink.       */
 /* ========================================================================= */
 
 #ifndef __HUI_TEXTBOX_H__
@@ -49,6 +50,7 @@
         SDL_Point    sPointCursor;        /*!< Offset for the cursor. */
 
         HUI_Text    *pText;               /*!< Pointer to the text structure. */
+        HUI_Text     sCursor;             /*!< Text of the cursor (Rendered once). */
         TTF_Font    *pFont;               /*!< Pointer to the text font. */
         SDL_Rect     rDest;               /*!< Rect of the text box. */
     } HUI_Textbox;
@@ -0,0 +1,536 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Atlas.c
+ * \brief   File to handle the texture atlas.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Skip the conversion of the images in the page format.*/
+/* Nyuu    | 18/10/26 | Clear the pages evicted by the precache.             */
+/* Nyuu    | 18/10/26 | Upload the images without padding directly.          */
+/* ========================================================================= */
+
+#include "SDL_Render.h"
+#include "SDL_Util.h"
+#include "SDL_Atlas.h"
+
+/* ========================================================================= */
+
+/*!
+ * \struct SDL_AtlasNode
+ * \brief  Structure to handle a segment of the skyline of a page.
+ */
+typedef struct
+{
+    Sint32 x; /*!< Start of the segment. */
+    Sint32 y; /*!< Height of the skyline on the segment. */
+    Sint32 w; /*!< Width of the segment. */
+} SDL_AtlasNode;
+
+/*!
+ * \struct SDL_AtlasPage
+ * \brief  Structure to handle a page of the atlas.
+ */
+typedef struct
+{
+    SDL_Texture    *pTexture;  /*!< Pointer to the texture of the page (NULL => Cleared). */
+    SDL_AtlasNode  *pArrNodes; /*!< Array of the segments of the skyline (From left to right). */
+    Uint32          iNbNodes;  /*!< Number of segments of the skyline. */
+    SDL_AtlasStats  sStats;    /*!< Occupancy of the page. */
+} SDL_AtlasPage;
+
+/*!
+ * \struct SDL_Atlas
+ * \brief  Structure to handle the atlas.
+ */
+typedef struct
+{
+    SDL_AtlasPage *pArrPages; /*!< Array of the pages. */
+    Uint32         iNbPages;  /*!< Number of pages. */
+} SDL_Atlas;
+
+/*! Global variable to handle the atlas. */
+static SDL_Atlas SDL_atlas;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the height of the skyline under a rectangle.
+ *
+ * \param  pPage Pointer to the page.
+ * \param  iNode Index of the first segment under the rectangle.
+ * \param  w     Width of the rectangle.
+ * \return The position on y of the rectangle, or -1 if it does not fit on x.
+ */
+static Sint32 SDL_Atlas_GetFit(const SDL_AtlasPage *pPage, Uint32 iNode, const Sint32 w)
+{
+    Sint32 iLeft = w;
+    Sint32 y     = 0;
+
+    if (pPage->pArrNodes[iNode].x + w > SDL_ATLAS_PAGE_SIZE)
+    {
+        return -1;
+    }
+
+    for ( ; iLeft > 0 ; ++iNode)
+    {
+        y      = COM_Math_Max(y, pPage->pArrNodes[iNode].y);
+        iLeft -= pPage->pArrNodes[iNode].w;
+    }
+
+    return y;
+}
+
+/*!
+ * \brief  Function to find the place of a rectangle in a page (Bottom left).
+ *
+ * \param  pPage  Pointer to the page.
+ * \param  w      Width of the rectangle.
+ * \param  h      Height of the rectangle.
+ * \param  pPos   Pointer to retrieve the position of the rectangle.
+ * \return The index of the first segment under the rectangle, or -1 if it does not fit.
+ */
+static Sint32 SDL_Atlas_Find(const SDL_AtlasPage *pPage, const Sint32 w, const Sint32 h, SDL_Point *pPos)
+{
+    Sint32 iBest    = -1;
+    Sint32 iBestTop = SDL_ATLAS_PAGE_SIZE + 1;
+    Sint32 y        = 0;
+    Uint32 i        = 0;
+
+    for (i = 0 ; i < pPage->iNbNodes ; ++i)
+    {
+        y = SDL_Atlas_GetFit(pPage, i, w);
+
+        if ((y >= 0) && (y + h <= SDL_ATLAS_PAGE_SIZE) && (y + h < iBestTop))
+        {
+            iBest    = (Sint32) i;
+            iBestTop = y + h;
+            pPos->x  = pPage->pArrNodes[i].x;
+            pPos->y  = y;
+        }
+    }
+
+    return iBest;
+}
+
+/*!
+ * \brief  Function to raise the skyline of a page under a placed rectangle.
+ *
+ * \param  pPage Pointer to the page.
+ * \param  iNode Index of the first segment under the rectangle.
+ * \param  pRect Pointer to the rectangle placed.
+ * \return None.
+ */
+static void SDL_Atlas_Place(SDL_AtlasPage *pPage, const Uint32 iNode, const SDL_Rect *pRect)
+{
+    SDL_AtlasNode *pArrNodes = pPage->pArrNodes;
+    Sint32         iEnd      = pRect->x + pRect->w;
+    Uint32         iNext     = iNode + 1;
+    Uint32         i         = 0;
+
+    /* ~~~ Insert the new segment, the old one starts after it ~~~ */
+    memmove(&pArrNodes[iNode + 1], &pArrNodes[iNode], sizeof(SDL_AtlasNode) * (pPage->iNbNodes - iNode));
+    pPage->iNbNodes++;
+
+    pArrNodes[iNode].x = pRect->x;
+    pArrNodes[iNode].y = pRect->y + pRect->h;
+    pArrNodes[iNode].w = pRect->w;
+
+    /* ~~~ Cut the segments covered by the new one ~~~ */
+    while ((iNext < pPage->iNbNodes) && (pArrNodes[iNext].x < iEnd))
+    {
+        if (pArrNodes[iNext].x + pArrNodes[iNext].w <= iEnd)
+        {
+            memmove(&pArrNodes[iNext], &pArrNodes[iNext + 1], sizeof(SDL_AtlasNode) * (pPage->iNbNodes - iNext - 1));
+            pPage->iNbNodes--;
+        }
+        else
+        {
+            pArrNodes[iNext].w -= iEnd - pArrNodes[iNext].x;
+            pArrNodes[iNext].x  = iEnd;
+        }
+    }
+
+    /* ~~~ Merge the neighbours at the same height ~~~ */
+    for (i = 0 ; i + 1 < pPage->iNbNodes ; )
+    {
+        if (pArrNodes[i].y == pArrNodes[i + 1].y)
+        {
+            pArrNodes[i].w += pArrNodes[i + 1].w;
+            memmove(&pArrNodes[i + 1], &pArrNodes[i + 2], sizeof(SDL_AtlasNode) * (pPage->iNbNodes - i - 2));
+            pPage->iNbNodes--;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    /* ~~~ Statistics ~~~ */
+    pPage->sStats.iNbImages++;
+    pPage->sStats.iUsedArea += (Uint32) (pRect->w * pRect->h);
+    pPage->sStats.iTopArea   = 0;
+
+    for (i = 0 ; i < pPage->iNbNodes ; ++i)
+    {
+        pPage->sStats.iTopArea += (Uint32) (pArrNodes[i].y * pArrNodes[i].w);
+    }
+}
+
+/*!
+ * \brief  Function to add a new empty page to the atlas.
+ *
+ * \return A pointer to the page, or NULL if error.
+ */
+static SDL_AtlasPage *SDL_Atlas_AddPage(void)
+{
+    SDL_AtlasPage *pArrPages = NULL;
+    SDL_AtlasPage *pPage     = NULL;
+
+    pArrPages = (SDL_AtlasPage *) UTIL_Realloc(SDL_atlas.pArrPages, sizeof(SDL_AtlasPage) * (SDL_atlas.iNbPages + 1));
+
+    if (!pArrPages)
+    {
+        return NULL;
+    }
+
+    SDL_atlas.pArrPages = pArrPages;
+    pPage               = &pArrPages[SDL_atlas.iNbPages];
+
+    memset(pPage, 0, sizeof(SDL_AtlasPage));
+
+    /* ~~~ A skyline has at most one segment for each column ~~~ */
+    pPage->pArrNodes = (SDL_AtlasNode *) UTIL_Malloc(sizeof(SDL_AtlasNode) * (SDL_ATLAS_PAGE_SIZE + 1));
+    pPage->pTexture  = SDL_Render_CreateStaticTexture(SDL_ATLAS_PAGE_SIZE, SDL_ATLAS_PAGE_SIZE);
+
+    if (!pPage->pArrNodes || !pPage->pTexture) // Error: must free...
+    {
+        UTIL_Free(pPage->pArrNodes);
+        UTIL_TextureFree(&pPage->pTexture);
+
+        return NULL;
+    }
+
+    pPage->pArrNodes[0].x = 0;
+    pPage->pArrNodes[0].y = 0;
+    pPage->pArrNodes[0].w = SDL_ATLAS_PAGE_SIZE;
+    pPage->iNbNodes       = 1;
+
+    SDL_atlas.iNbPages++;
+
+    COM_Log_Print(COM_LOG_INFO, "Atlas page %d created (%dx%d).", SDL_atlas.iNbPages - 1, SDL_ATLAS_PAGE_SIZE, SDL_ATLAS_PAGE_SIZE);
+
+    return pPage;
+}
+
+/*!
+ * \brief  Function to upload an image with its padding into a page.
+ *
+ * \param  pPage    Pointer to the page.
+ * \param  pSurface Pointer to the image.
+ * \param  pRect    Pointer to the rectangle of the image, padding included.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The padding repeats the edges of the image, so the filtering
+ *         never reads the neighbours. An image already in the format of the
+ *         pages (Cooked sprite) is not converted, but its pixels are copied
+ *         with the padding. Without padding, they are uploaded directly.
+ */
+static SDL_bool SDL_Atlas_Upload(SDL_AtlasPage *pPage, SDL_Surface *pSurface, const SDL_Rect *pRect)
+{
+    SDL_Surface  *pImage   = pSurface;
+    Uint32       *pPixels  = NULL;
+    const Uint32 *pSrcLine = NULL;
+    Sint32        iSrcX    = 0;
+    Sint32        iSrcY    = 0;
+    Sint32        x        = 0;
+    Sint32        y        = 0;
+    SDL_bool      bRet     = SDL_FALSE;
+
+    if (pSurface->format->format != SDL_ATLAS_FORMAT)
+    {
+        pImage = SDL_ConvertSurfaceFormat(pSurface, SDL_ATLAS_FORMAT, 0);
+    }
+
+    if (pImage && (SDL_ATLAS_PADDING == 0))
+    {
+        /* ~~~ Nothing to repeat, the rows of the image are uploaded as is ~~~ */
+        if (SDL_LockSurface(pImage) == 0)
+        {
+            bRet = (SDL_UpdateTexture(pPage->pTexture, pRect, pImage->pixels, pImage->pitch) == 0) ? SDL_TRUE : SDL_FALSE;
+
+            SDL_UnlockSurface(pImage);
+        }
+
+        if (pImage != pSurface)
+        {
+            SDL_FreeSurface(pImage);
+        }
+    }
+    else if (pImage)
+    {
+        pPixels = (Uint32 *) UTIL_Malloc(sizeof(Uint32) * pRect->w * pRect->h);
+
+        if (pPixels && (SDL_LockSurface(pImage) == 0))
+        {
+            for (y = 0 ; y < pRect->h ; ++y)
+            {
+                iSrcY    = COM_Math_Min(COM_Math_Max(y - SDL_ATLAS_PADDING, 0), pImage->h - 1);
+                pSrcLine = (const Uint32 *) ((const Uint8 *) pImage->pixels + iSrcY * pImage->pitch);
+
+                for (x = 0 ; x < pRect->w ; ++x)
+                {
+                    iSrcX = COM_Math_Min(COM_Math_Max(x - SDL_ATLAS_PADDING, 0), pImage->w - 1);
+
+                    pPixels[y * pRect->w + x] = pSrcLine[iSrcX];
+                }
+            }
+
+            SDL_UnlockSurface(pImage);
+
+            bRet = (SDL_UpdateTexture(pPage->pTexture, pRect, pPixels, pRect->w * sizeof(Uint32)) == 0) ? SDL_TRUE : SDL_FALSE;
+        }
+
+        UTIL_Free(pPixels);
+
+        if (pImage != pSurface)
+        {
+            SDL_FreeSurface(pImage);
+        }
+    }
+
+    return bRet;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to init the atlas.
+ *
+ * \return None.
+ */
+void SDL_Atlas_Init(void)
+{
+    SDL_atlas.pArrPages = NULL;
+    SDL_atlas.iNbPages  = 0;
+}
+
+/*!
+ * \brief  Function to pack an image in the atlas.
+ *
+ * \param  pSurface  Pointer to the image.
+ * \param  ppTexture Pointer to retrieve the texture of the page.
+ * \param  pRect     Pointer to retrieve the rectangle of the image in the page.
+ * \return SDL_TRUE on success, else SDL_FALSE (The image must use its own texture).
+ *
+ * \remark The pages in memory are tried first, then the cleared ones (Their
+ *         texture is created again). A new page is created when the image
+ *         fits in none of them.
+ */
+SDL_bool SDL_Atlas_Add(SDL_Surface *pSurface, SDL_Texture **ppTexture, SDL_Rect *pRect)
+{
+    SDL_AtlasPage *pPage    = NULL;
+    Sint32         iNode    = -1;
+    Uint32         iCleared = 0;
+    Uint32         i        = 0;
+    SDL_Point      sPos;
+    SDL_Rect       sRect;
+
+    sRect.w = pSurface->w + (SDL_ATLAS_PADDING << 1);
+    sRect.h = pSurface->h + (SDL_ATLAS_PADDING << 1);
+
+    if ((sRect.w > SDL_ATLAS_PAGE_SIZE) || (sRect.h > SDL_ATLAS_PAGE_SIZE))
+    {
+        return SDL_FALSE;
+    }
+
+    /* ~~~ First pass: pages in memory, second pass: cleared pages ~~~ */
+    for (iCleared = 0 ; (iCleared < 2) && (iNode < 0) ; ++iCleared)
+    {
+        for (i = 0 ; (i < SDL_atlas.iNbPages) && (iNode < 0) ; ++i)
+        {
+            pPage = &SDL_atlas.pArrPages[i];
+
+            if ((pPage->pTexture ? 0U : 1U) == iCleared)
+            {
+                iNode = SDL_Atlas_Find(pPage, sRect.w, sRect.h, &sPos);
+            }
+        }
+    }
+
+    if ((iNode >= 0) && !pPage->pTexture)
+    {
+        pPage->pTexture = SDL_Render_CreateStaticTexture(SDL_ATLAS_PAGE_SIZE, SDL_ATLAS_PAGE_SIZE);
+
+        if (!pPage->pTexture)
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    if (iNode < 0)
+    {
+        pPage = SDL_Atlas_AddPage( );
+
+        if (!pPage)
+        {
+            return SDL_FALSE;
+        }
+
+        iNode = SDL_Atlas_Find(pPage, sRect.w, sRect.h, &sPos);
+    }
+
+    sRect.x = sPos.x;
+    sRect.y = sPos.y;
+
+    if (!SDL_Atlas_Upload(pPage, pSurface, &sRect))
+    {
+        return SDL_FALSE;
+    }
+
+    SDL_Atlas_Place(pPage, (Uint32) iNode, &sRect);
+
+    *ppTexture = pPage->pTexture;
+    pRect->x   = sRect.x + SDL_ATLAS_PADDING;
+    pRect->y   = sRect.y + SDL_ATLAS_PADDING;
+    pRect->w   = pSurface->w;
+    pRect->h   = pSurface->h;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to get the number of pages of the atlas.
+ *
+ * \return The number of pages.
+ */
+Uint32 SDL_Atlas_GetPages(void)
+{
+    return SDL_atlas.iNbPages;
+}
+
+/*!
+ * \brief  Function to get the occupancy of a page of the atlas.
+ *
+ * \param  iPage  Index of the page.
+ * \param  pStats Pointer to retrieve the occupancy.
+ * \return SDL_TRUE on success, else SDL_FALSE if the page does not exist.
+ */
+SDL_bool SDL_Atlas_GetStats(const Uint32 iPage, SDL_AtlasStats *pStats)
+{
+    if (iPage >= SDL_atlas.iNbPages)
+    {
+        return SDL_FALSE;
+    }
+
+    *pStats = SDL_atlas.pArrPages[iPage].sStats;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to get the texture of a page of the atlas.
+ *
+ * \param  iPage Index of the page.
+ * \return A pointer to the texture, or NULL if the page is cleared or does not exist.
+ */
+SDL_Texture *SDL_Atlas_GetTexture(const Uint32 iPage)
+{
+    return (iPage < SDL_atlas.iNbPages) ? SDL_atlas.pArrPages[iPage].pTexture : NULL;
+}
+
+/*!
+ * \brief  Function to get the memory used by the textures of the atlas.
+ *
+ * \return The memory used by the pages not cleared (In bytes).
+ */
+Uint64 SDL_Atlas_GetBytes(void)
+{
+    Uint64 iBytes = 0;
+    Uint32 iPage  = 0;
+
+    for (iPage = 0 ; iPage < SDL_atlas.iNbPages ; ++iPage)
+    {
+        iBytes += SDL_atlas.pArrPages[iPage].pTexture ? SDL_ATLAS_PAGE_BYTES : 0;
+    }
+
+    return iBytes;
+}
+
+/*!
+ * \brief  Function to clear a page of the atlas.
+ *
+ * \param  iPage Index of the page.
+ * \return None.
+ *
+ * \remark The texture is freed and the whole page is free again. The sprites
+ *         packed in the page must be evicted before.
+ */
+void SDL_Atlas_Clear(const Uint32 iPage)
+{
+    SDL_AtlasPage *pPage = NULL;
+
+    if (iPage < SDL_atlas.iNbPages)
+    {
+        pPage = &SDL_atlas.pArrPages[iPage];
+
+        UTIL_TextureFree(&pPage->pTexture);
+        memset(&pPage->sStats, 0, sizeof(SDL_AtlasStats));
+
+        pPage->pArrNodes[0].x = 0;
+        pPage->pArrNodes[0].y = 0;
+        pPage->pArrNodes[0].w = SDL_ATLAS_PAGE_SIZE;
+        pPage->iNbNodes       = 1;
+
+        COM_Log_Print(COM_LOG_INFO, "Atlas page %d cleared.", iPage);
+    }
+}
+
+/*!
+ * \brief  Function to log the occupancy of the atlas.
+ *
+ * \return None.
+ */
+void SDL_Atlas_Report(void)
+{
+    const SDL_AtlasStats *pStats = NULL;
+    Uint32                iPage  = 0;
+
+    for (iPage = 0 ; iPage < SDL_atlas.iNbPages ; ++iPage)
+    {
+        pStats = &SDL_atlas.pArrPages[iPage].sStats;
+
+        COM_Log_Print(COM_LOG_INFO, "Atlas page %d: %d images, %d%% used (%d%% under the skyline).",
+                      iPage, pStats->iNbImages,
+                      (int) ((Uint64) pStats->iUsedArea * 100 / (SDL_ATLAS_PAGE_SIZE * SDL_ATLAS_PAGE_SIZE)),
+                      (int) ((Uint64) pStats->iTopArea  * 100 / (SDL_ATLAS_PAGE_SIZE * SDL_ATLAS_PAGE_SIZE)));
+    }
+}
+
+/*!
+ * \brief  Function to free the atlas.
+ *
+ * \return None.
+ *
+ * \remark The sprites using the atlas must be freed before.
+ */
+void SDL_Atlas_Free(void)
+{
+    Uint32 iPage = 0;
+
+    for (iPage = 0 ; iPage < SDL_atlas.iNbPages ; ++iPage)
+    {
+        UTIL_TextureFree(&SDL_atlas.pArrPages[iPage].pTexture);
+        UTIL_Free(SDL_atlas.pArrPages[iPage].pArrNodes);
+    }
+
+    UTIL_Free(SDL_atlas.pArrPages);
+    SDL_atlas.iNbPages = 0;
+}
+
+/* ========================================================================= */
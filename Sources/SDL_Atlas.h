@@ -0,0 +1,56 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Atlas.h
+ * \brief   File to interface with the texture atlas.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add the pixel format of the pages.                   */
+/* Nyuu    | 18/10/26 | Clear the pages evicted by the precache.             */
+/* ========================================================================= */
+
+#ifndef __SDL_ATLAS_H__
+#define __SDL_ATLAS_H__
+
+    #include "SDL_Shared.h"
+
+    /*! Size of a page of the atlas (In pixels). */
+    #define SDL_ATLAS_PAGE_SIZE 2048
+    /*! Border around each image, filled with its edges (In pixels). */
+    #define SDL_ATLAS_PADDING   1
+    /*! Pixel format of the pages (The cooked sprites are stored in it). */
+    #define SDL_ATLAS_FORMAT    SDL_PIXELFORMAT_RGBA32
+    /*! Memory used by the texture of a page (In bytes). */
+    #define SDL_ATLAS_PAGE_BYTES ((Uint64) SDL_ATLAS_PAGE_SIZE * SDL_ATLAS_PAGE_SIZE * 4)
+
+    /*!
+     * \struct SDL_AtlasStats
+     * \brief  Structure to handle the occupancy of a page of the atlas.
+     */
+    typedef struct
+    {
+        Uint32 iNbImages; /*!< Number of images packed in the page. */
+        Uint32 iUsedArea; /*!< Area used by the images, padding included (In pixels). */
+        Uint32 iTopArea;  /*!< Area under the skyline, holes included (In pixels). */
+    } SDL_AtlasStats;
+
+    void     SDL_Atlas_Init    (void);
+    SDL_bool SDL_Atlas_Add     (SDL_Surface *pSurface, SDL_Texture **ppTexture, SDL_Rect *pRect);
+    Uint32   SDL_Atlas_GetPages(void);
+    SDL_bool SDL_Atlas_GetStats(const Uint32 iPage, SDL_AtlasStats *pStats);
+
+    SDL_Texture *SDL_Atlas_GetTexture(const Uint32 iPage);
+    Uint64       SDL_Atlas_GetBytes  (void);
+    void         SDL_Atlas_Clear     (const Uint32 iPage);
+
+    void     SDL_Atlas_Report  (void);
+    void     SDL_Atlas_Free    (void);
+
+#endif // __SDL_ATLAS_H__
+
+/* ========================================================================= */
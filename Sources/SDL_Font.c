@@ -0,0 +1,166 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Font.c
+ * \brief   File to handle the fonts.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Open the fonts of the pack with no copy.             */
+/* Nyuu    | 18/10/26 | Read the font files with UTIL_RWRead.                */
+/* ========================================================================= */
+
+#include "SDL_Util.h"
+#include "SDL_Font.h"
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to build the path of a font.
+ *
+ * \param  szFontName Name of the font, with its size ("codenewroman:30").
+ * \return The path of the font file (Must be freed), or NULL if error.
+ */
+char *SDL_Font_GetPath(const char *szFontName)
+{
+    char *szFontPath = NULL;
+    char *szFile     = UTIL_StrCopy(szFontName);
+    char *pSeparator = NULL;
+
+    if (szFile)
+    {
+        pSeparator = strrchr(szFile, SDL_FONT_SEPARATOR);
+
+        if (pSeparator)
+        {
+            *pSeparator = '\0';
+        }
+
+        szFontPath = UTIL_StrBuild("fonts/", szFile, ".ttf", NULL);
+        UTIL_Free(szFile);
+    }
+
+    return szFontPath;
+}
+
+/*!
+ * \brief  Function to open a font from the data of its file.
+ *
+ * \param  szFontName Name of the font, with its size ("codenewroman:30").
+ * \param  pFileData  Data of the font file (Owned by the font, even if error).
+ * \param  iDataSize  Size of the data (In bytes).
+ * \param  bMapped    Flag set if the data is mapped from the pack.
+ * \return A pointer to the opened font, or NULL if error.
+ */
+SDL_Font *SDL_Font_Open(const char *szFontName, void *pFileData, Uint32 iDataSize, SDL_bool bMapped)
+{
+    SDL_Font   *pFont      = (SDL_Font *) UTIL_Malloc(sizeof(SDL_Font));
+    const char *pSeparator = strrchr(szFontName, SDL_FONT_SEPARATOR);
+    int         iPtSize    = pSeparator ? atoi(pSeparator + 1) : 0;
+
+    if (!pFont)
+    {
+        if (!bMapped)
+        {
+            SDL_free(pFileData);
+        }
+
+        return NULL;
+    }
+
+    pFont->pFileData = pFileData;
+    pFont->bMapped   = bMapped;
+    pFont->szName    = UTIL_StrCopy(szFontName);
+    pFont->pTTFFont  = TTF_OpenFontRW(SDL_RWFromConstMem(pFileData, (int) iDataSize), 1, iPtSize);
+
+    if (!pFont->pTTFFont)
+    {
+        COM_Log_Print(COM_LOG_ERROR, "Can't open the font \"%s\" !", szFontName);
+    }
+
+    if (!pFont->pTTFFont || !pFont->szName) // Error: must free...
+    {
+        SDL_Font_Free(&pFont);
+    }
+
+    return pFont;
+}
+
+/*!
+ * \brief  Function to load a font.
+ *
+ * \param  szFontName Name of the font, with its size ("codenewroman:30").
+ * \return A pointer to the loaded font, or NULL if error.
+ */
+SDL_Font *SDL_Font_Alloc(const char *szFontName)
+{
+    SDL_Font *pFont      = NULL;
+    char     *szFontPath = SDL_Font_GetPath(szFontName);
+    void     *pFileData  = NULL;
+    Uint32    iDataSize  = 0;
+    SDL_bool  bMapped    = SDL_FALSE;
+
+    if (szFontPath)
+    {
+        pFileData = UTIL_RWRead(szFontPath, &iDataSize, &bMapped);
+
+        if (pFileData)
+        {
+            pFont = SDL_Font_Open(szFontName, pFileData, iDataSize, bMapped);
+        }
+
+        UTIL_Free(szFontPath);
+    }
+
+    return pFont;
+}
+
+/*!
+ * \brief  Function to get the name of a font.
+ *
+ * \param  pFont Pointer to the font.
+ * \return The name of the font, with its size.
+ */
+const char *SDL_Font_GetName(const SDL_Font *pFont)
+{
+    return pFont->szName;
+}
+
+/*!
+ * \brief  Function to get the TTF font of a font.
+ *
+ * \param  pFont Pointer to the font.
+ * \return A pointer to the TTF font.
+ */
+TTF_Font *SDL_Font_GetTTF(const SDL_Font *pFont)
+{
+    return pFont->pTTFFont;
+}
+
+/*!
+ * \brief  Function to free a font.
+ *
+ * \param  ppFont Pointer to pointer to the font to free.
+ * \return None.
+ */
+void SDL_Font_Free(SDL_Font **ppFont)
+{
+    if ((*ppFont)->pTTFFont)
+    {
+        TTF_CloseFont((*ppFont)->pTTFFont);
+    }
+
+    if (!(*ppFont)->bMapped)
+    {
+        SDL_free((*ppFont)->pFileData);
+    }
+
+    UTIL_Free((*ppFont)->szName);
+    UTIL_Free(*ppFont);
+}
+
+/* ========================================================================= */
@@ -0,0 +1,48 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Font.h
+ * \brief   File to interface with the fonts.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Open the fonts of the pack with no copy.             */
+/* Nyuu    | 18/10/26 | Read the font files with UTIL_RWRead.                */
+/* ========================================================================= */
+
+#ifndef __SDL_FONT_H__
+#define __SDL_FONT_H__
+
+    #include "SDL_Shared.h"
+
+    /*! Separator of the name and the size of a font ("codenewroman:30"). */
+    #define SDL_FONT_SEPARATOR ':'
+
+    /*!
+     * \struct SDL_Font
+     * \brief  Structure to handle a font.
+     */
+    typedef struct
+    {
+        char     *szName;    /*!< Name of the font, with its size. */
+        TTF_Font *pTTFFont;  /*!< Pointer to the font. */
+        void     *pFileData; /*!< Data of the font file (Read by the font while it is opened). */
+        SDL_bool  bMapped;   /*!< Flag set if the data is mapped from the pack (Not freed). */
+    } SDL_Font;
+
+    char       *SDL_Font_GetPath(const char *szFontName);
+    SDL_Font   *SDL_Font_Open(const char *szFontName, void *pFileData, Uint32 iDataSize, SDL_bool bMapped);
+    SDL_Font   *SDL_Font_Alloc(const char *szFontName);
+
+    const char *SDL_Font_GetName(const SDL_Font *pFont);
+    TTF_Font   *SDL_Font_GetTTF(const SDL_Font *pFont);
+
+    void        SDL_Font_Free(SDL_Font **ppFont);
+
+#endif // __SDL_FONT_H__
+
+/* ========================================================================= */
@@ -10,20 +10,27 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 09/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add the fonts.                                       */
+/* Nyuu    | 18/10/26 | Add the pack of the assets.                          */
+/* Nyuu    | 18/10/26 | Add the voices of the sounds.                        */
 /* ========================================================================= */
 
 #ifndef __SDL_IF_H__
 #define __SDL_IF_H__
 
     #include "SDL_Anim.h"
+    #include "SDL_Atlas.h"
+    #include "SDL_Font.h"
     #include "SDL_Model.h"
     #include "SDL_Music.h"
+    #include "SDL_Pack.h"
     #include "SDL_Precache.h"
     #include "SDL_Render.h"
     #include "SDL_Shared.h"
     #include "SDL_Sound.h"
     #include "SDL_Sprite.h"
     #include "SDL_Util.h"
+    #include "SDL_Voice.h"
 
 #endif // __SDL_IF_H__
 
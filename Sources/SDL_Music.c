@@ -11,8 +11,10 @@
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 13/06/15 | Creation.                                            */
 /* Red     | 13/06/15 | Add Alloc.                                           */
+/* Nyuu    | 18/10/26 | Paths built in the frame arena.                      */
 /* ========================================================================= */
 
+#include "COM_Arena.h"
 #include "SDL_Util.h"
 #include "SDL_Music.h"
 
@@ -31,10 +33,13 @@ static Uint32 SDL_Music_volume = 100;
  */
 SDL_Music *SDL_Music_Alloc(const char *szMscName)
 {
-    SDL_Music *pMusic      = NULL;
-    char      *szMusicPath = NULL;
+    SDL_Music    *pMusic      = NULL;
+    char         *szMusicPath = NULL;
+    COM_ArenaMark sMark;
 
-    szMusicPath = UTIL_StrBuild("musics/", szMscName, ".mp3", NULL);
+    COM_Arena_Mark(&sMark);
+
+    szMusicPath = COM_Arena_StrBuild("musics/", szMscName, ".mp3", NULL);
 
     if (szMusicPath)
     {
@@ -52,10 +57,10 @@ SDL_Music *SDL_Music_Alloc(const char *szMscName)
                 UTIL_Free(pMusic);
             }
         }
-
-        UTIL_Free(szMusicPath);
     }
 
+    COM_Arena_Rewind(&sMark);
+
     return pMusic;
 }
 
@@ -0,0 +1,444 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Pack.c
+ * \brief   File to handle the pack of the assets.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Build the loose paths on the stack (Workers).        */
+/* ========================================================================= */
+
+#include "SDL_Pack.h"
+#include "SDL_Util.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/* ========================================================================= */
+
+/*! Maximum length of the path of a loose file (Override folder included). */
+#define SDL_PACK_MAX_PATH 1024
+
+/*!
+ * \struct SDL_Pack
+ * \brief  Structure to handle the pack mounted.
+ */
+typedef struct
+{
+    const Uint8         *pMap;        /*!< Pointer to the pack mapped (NULL => No pack). */
+    size_t               iMapSize;    /*!< Size of the pack mapped (In bytes). */
+    const SDL_PackEntry *pArrEntries; /*!< Array of the files, in the map. */
+    const char          *pPaths;      /*!< Paths of the files, in the map. */
+    Uint32               iNbEntries;  /*!< Number of files. */
+    char                *szOverride;  /*!< Folder of the loose files read first (NULL => None). */
+#ifdef _WIN32
+    HANDLE               hFile;       /*!< Handle of the pack file. */
+    HANDLE               hMapping;    /*!< Handle of the mapping. */
+#endif
+} SDL_Pack;
+
+/*! Global variable to handle the pack. */
+static SDL_Pack SDL_pack;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to map a file in memory (Read only).
+ *
+ * \param  szPath Path of the file.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool SDL_Pack_MapFile(const char *szPath)
+{
+#ifdef _WIN32
+    LARGE_INTEGER iSize;
+
+    SDL_pack.hFile = CreateFileA(szPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (SDL_pack.hFile == INVALID_HANDLE_VALUE)
+    {
+        return SDL_FALSE;
+    }
+
+    if (GetFileSizeEx(SDL_pack.hFile, &iSize) && iSize.QuadPart)
+    {
+        SDL_pack.hMapping = CreateFileMappingA(SDL_pack.hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (SDL_pack.hMapping)
+        {
+            SDL_pack.pMap     = (const Uint8 *) MapViewOfFile(SDL_pack.hMapping, FILE_MAP_READ, 0, 0, 0);
+            SDL_pack.iMapSize = (size_t) iSize.QuadPart;
+        }
+    }
+
+    if (!SDL_pack.pMap)
+    {
+        if (SDL_pack.hMapping)
+        {
+            CloseHandle(SDL_pack.hMapping);
+        }
+
+        CloseHandle(SDL_pack.hFile);
+        SDL_pack.hMapping = NULL;
+        SDL_pack.hFile    = INVALID_HANDLE_VALUE;
+    }
+#else
+    struct stat sStat;
+    void       *pMap  = MAP_FAILED;
+    int         iFile = open(szPath, O_RDONLY);
+
+    if (iFile < 0)
+    {
+        return SDL_FALSE;
+    }
+
+    if ((fstat(iFile, &sStat) == 0) && (sStat.st_size > 0))
+    {
+        pMap = mmap(NULL, (size_t) sStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+    }
+
+    /* ~~~ The mapping stays valid without the descriptor ~~~ */
+    close(iFile);
+
+    if (pMap != MAP_FAILED)
+    {
+        SDL_pack.pMap     = (const Uint8 *) pMap;
+        SDL_pack.iMapSize = (size_t) sStat.st_size;
+    }
+#endif
+
+    return SDL_pack.pMap ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to unmap the pack.
+ *
+ * \return None.
+ */
+static void SDL_Pack_UnmapFile(void)
+{
+    if (SDL_pack.pMap)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(SDL_pack.pMap);
+        CloseHandle(SDL_pack.hMapping);
+        CloseHandle(SDL_pack.hFile);
+
+        SDL_pack.hMapping = NULL;
+        SDL_pack.hFile    = INVALID_HANDLE_VALUE;
+#else
+        munmap((void *) SDL_pack.pMap, SDL_pack.iMapSize);
+#endif
+    }
+
+    SDL_pack.pMap        = NULL;
+    SDL_pack.iMapSize    = 0;
+    SDL_pack.pArrEntries = NULL;
+    SDL_pack.pPaths      = NULL;
+    SDL_pack.iNbEntries  = 0;
+}
+
+/*!
+ * \brief  Function to check the index of the pack mapped.
+ *
+ * \return SDL_TRUE if the index is valid, else SDL_FALSE.
+ *
+ * \remark Every path and every file must be inside the map, so the lookups
+ *         never read out of it.
+ */
+static SDL_bool SDL_Pack_CheckIndex(void)
+{
+    const SDL_PackHeader *pHeader = (const SDL_PackHeader *) SDL_pack.pMap;
+    const SDL_PackEntry  *pEntry  = NULL;
+    size_t                iIndex  = 0;
+    Uint32                i       = 0;
+
+    if ((SDL_pack.iMapSize < sizeof(SDL_PackHeader)) ||
+        (memcmp(pHeader->arrMagic, SDL_PACK_MAGIC, sizeof(pHeader->arrMagic)) != 0) ||
+        (pHeader->iVersion != SDL_PACK_VERSION))
+    {
+        return SDL_FALSE;
+    }
+
+    iIndex = sizeof(SDL_PackHeader) + (size_t) pHeader->iNbEntries * sizeof(SDL_PackEntry);
+
+    if ((iIndex + pHeader->iPathsSize > SDL_pack.iMapSize) ||
+        (pHeader->iPathsSize && (SDL_pack.pMap[iIndex + pHeader->iPathsSize - 1] != '\0')))
+    {
+        return SDL_FALSE;
+    }
+
+    SDL_pack.pArrEntries = (const SDL_PackEntry *) (SDL_pack.pMap + sizeof(SDL_PackHeader));
+    SDL_pack.pPaths      = (const char *) (SDL_pack.pMap + iIndex);
+    SDL_pack.iNbEntries  = pHeader->iNbEntries;
+
+    for (i = 0 ; i < SDL_pack.iNbEntries ; ++i)
+    {
+        pEntry = &SDL_pack.pArrEntries[i];
+
+        if ((pEntry->iPath >= pHeader->iPathsSize) ||
+            ((size_t) pEntry->iOffset + pEntry->iSize > SDL_pack.iMapSize))
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to find a file in the pack.
+ *
+ * \param  szPath Path of the file.
+ * \return A pointer to the file, or NULL if it is not in the pack.
+ */
+static const SDL_PackEntry *SDL_Pack_Find(const char *szPath)
+{
+    const SDL_PackEntry *pEntry = NULL;
+    Uint32               iHash  = SDL_Pack_Hash(szPath);
+    Uint32               iLow   = 0;
+    Uint32               iHigh  = SDL_pack.iNbEntries;
+    Uint32               iMid   = 0;
+    int                  iCmp   = 0;
+
+    while (iLow < iHigh)
+    {
+        iMid   = iLow + ((iHigh - iLow) >> 1);
+        pEntry = &SDL_pack.pArrEntries[iMid];
+        iCmp   = SDL_Pack_Compare(iHash, szPath, pEntry->iHash, SDL_pack.pPaths + pEntry->iPath);
+
+        if (iCmp == 0)
+        {
+            return pEntry;
+        }
+
+        if (iCmp < 0)
+        {
+            iHigh = iMid;
+        }
+        else
+        {
+            iLow = iMid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief  Function to open a loose file of the override folder.
+ *
+ * \param  szPath Path of the file.
+ * \return A pointer to the opened file, or NULL if it is not overridden.
+ *
+ * \remark The path is built on the stack: the workers call it.
+ */
+static SDL_RWops *SDL_Pack_OpenOverride(const char *szPath)
+{
+    SDL_RWops *pRw = NULL;
+    char       szLoose[SDL_PACK_MAX_PATH];
+
+    if (SDL_pack.szOverride &&
+        ((size_t) SDL_snprintf(szLoose, sizeof(szLoose), "%s/%s", SDL_pack.szOverride, szPath) < sizeof(szLoose)))
+    {
+        pRw = SDL_RWFromFile(szLoose, "rb");
+    }
+
+    return pRw;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to hash the path of a file (FNV-1a).
+ *
+ * \param  szPath Path of the file.
+ * \return The hash of the path.
+ */
+Uint32 SDL_Pack_Hash(const char *szPath)
+{
+    Uint32 iHash = 2166136261U;
+
+    while (*szPath)
+    {
+        iHash ^= (Uint8) *szPath++;
+        iHash *= 16777619U;
+    }
+
+    return iHash;
+}
+
+/*!
+ * \brief  Function to compare two files, in the order of the index.
+ *
+ * \param  iHash1  Hash of the path of the first file.
+ * \param  szPath1 Path of the first file.
+ * \param  iHash2  Hash of the path of the second file.
+ * \param  szPath2 Path of the second file.
+ * \return Less than 0, 0 or more than 0 as the first file is before, same
+ *         or after the second.
+ */
+int SDL_Pack_Compare(Uint32 iHash1, const char *szPath1, Uint32 iHash2, const char *szPath2)
+{
+    if (iHash1 != iHash2)
+    {
+        return (iHash1 < iHash2) ? -1 : 1;
+    }
+
+    return strcmp(szPath1, szPath2);
+}
+
+/*!
+ * \brief  Function to mount a pack.
+ *
+ * \param  szPackPath Path of the pack.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The pack replaces the one mounted before. Once mounted, the reads
+ *         of UTIL_RWOpen are served from the pack, with no copy.
+ */
+SDL_bool SDL_Pack_Mount(const char *szPackPath)
+{
+    SDL_Pack_UnmapFile( );
+
+    if (!SDL_Pack_MapFile(szPackPath))
+    {
+        COM_Log_Print(COM_LOG_ERROR, "Can't map the pack \"%s\" !", szPackPath);
+        return SDL_FALSE;
+    }
+
+    if (!SDL_Pack_CheckIndex( ))
+    {
+        COM_Log_Print(COM_LOG_ERROR, "The pack \"%s\" is corrupted !", szPackPath);
+
+        SDL_Pack_UnmapFile( );
+        return SDL_FALSE;
+    }
+
+    COM_Log_Print(COM_LOG_INFO, "Pack mounted: \"%s\" (%d files, %d KB).",
+                  szPackPath, SDL_pack.iNbEntries, (Uint32) (SDL_pack.iMapSize >> 10));
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to set the folder of the loose files read before the pack.
+ *
+ * \param  szDir Path of the folder (NULL => No override).
+ * \return None.
+ *
+ * \remark Made for the development: a file edited in the folder is used
+ *         without building the pack again. Each read tries the folder first.
+ */
+void SDL_Pack_SetOverride(const char *szDir)
+{
+    UTIL_Free(SDL_pack.szOverride);
+
+    if (szDir)
+    {
+        SDL_pack.szOverride = UTIL_StrCopy(szDir);
+    }
+}
+
+/*!
+ * \brief  Function to check if a pack is mounted.
+ *
+ * \return SDL_TRUE if a pack is mounted, else SDL_FALSE.
+ */
+SDL_bool SDL_Pack_IsMounted(void)
+{
+    return SDL_pack.pMap ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to get the data of a file of the pack.
+ *
+ * \param  szPath Path of the file.
+ * \param  pSize  Pointer to retrieve the size of the data (In bytes).
+ * \return A pointer to the data in the map, or NULL if the file is not in
+ *         the pack or is overridden.
+ *
+ * \remark The data is valid until the pack is unmounted.
+ */
+const void *SDL_Pack_Map(const char *szPath, Uint32 *pSize)
+{
+    const SDL_PackEntry *pEntry = NULL;
+    SDL_RWops           *pRw    = NULL;
+
+    if (!SDL_pack.pMap)
+    {
+        return NULL;
+    }
+
+    pRw = SDL_Pack_OpenOverride(szPath);
+
+    if (pRw)
+    {
+        UTIL_RWClose(&pRw);
+        return NULL;
+    }
+
+    pEntry = SDL_Pack_Find(szPath);
+
+    if (!pEntry)
+    {
+        return NULL;
+    }
+
+    *pSize = pEntry->iSize;
+
+    return SDL_pack.pMap + pEntry->iOffset;
+}
+
+/*!
+ * \brief  Function to open a file of the pack.
+ *
+ * \param  szPath Path of the file.
+ * \return A pointer to the opened file, or NULL if it is not in the pack.
+ *
+ * \remark The file is read from the override folder first, if any, else from
+ *         the range of the pack mapped (No copy). Thread safe.
+ */
+SDL_RWops *SDL_Pack_Open(const char *szPath)
+{
+    const SDL_PackEntry *pEntry = NULL;
+    SDL_RWops           *pRw    = SDL_Pack_OpenOverride(szPath);
+
+    if (!pRw && SDL_pack.pMap)
+    {
+        pEntry = SDL_Pack_Find(szPath);
+
+        if (pEntry)
+        {
+            pRw = SDL_RWFromConstMem(SDL_pack.pMap + pEntry->iOffset, (int) pEntry->iSize);
+        }
+    }
+
+    return pRw;
+}
+
+/*!
+ * \brief  Function to unmount the pack and its override folder.
+ *
+ * \return None.
+ *
+ * \remark Every asset read from the pack must be freed before.
+ */
+void SDL_Pack_Unmount(void)
+{
+    SDL_Pack_UnmapFile( );
+    UTIL_Free(SDL_pack.szOverride);
+}
+
+/* ========================================================================= */
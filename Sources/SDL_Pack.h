@@ -0,0 +1,75 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Pack.h
+ * \brief   File to interface with the pack of the assets.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#ifndef __SDL_PACK_H__
+#define __SDL_PACK_H__
+
+    #include "SDL_Shared.h"
+
+    /*
+     * A pack is a single file holding the assets, mapped in memory at once.
+     * All the values are little endian:
+     *
+     *     SDL_PackHeader
+     *     SDL_PackEntry[iNbEntries]  (Sorted by hash, then by path)
+     *     Paths                      (iPathsSize bytes, '\0' terminated)
+     *     Data                       (Each file aligned on SDL_PACK_ALIGN)
+     *
+     * The paths are relative to the data folder, with '/' ("sprites/steam.spr").
+     */
+
+    /*! Magic number of a pack. */
+    #define SDL_PACK_MAGIC   "NPAK"
+    /*! Version of the format of a pack. */
+    #define SDL_PACK_VERSION 1
+    /*! Alignment of the files in a pack (In bytes). */
+    #define SDL_PACK_ALIGN   16
+
+    /*!
+     * \struct SDL_PackHeader
+     * \brief  Structure to handle the header of a pack.
+     */
+    typedef struct
+    {
+        char   arrMagic[4]; /*!< Magic number (SDL_PACK_MAGIC). */
+        Uint32 iVersion;    /*!< Version of the format (SDL_PACK_VERSION). */
+        Uint32 iNbEntries;  /*!< Number of files. */
+        Uint32 iPathsSize;  /*!< Size of the paths (In bytes). */
+    } SDL_PackHeader;
+
+    /*!
+     * \struct SDL_PackEntry
+     * \brief  Structure to handle a file of a pack.
+     */
+    typedef struct
+    {
+        Uint32 iHash;   /*!< Hash of the path (See SDL_Pack_Hash). */
+        Uint32 iPath;   /*!< Offset of the path in the paths. */
+        Uint32 iOffset; /*!< Offset of the data in the pack. */
+        Uint32 iSize;   /*!< Size of the data (In bytes). */
+    } SDL_PackEntry;
+
+    Uint32      SDL_Pack_Hash(const char *szPath);
+    int         SDL_Pack_Compare(Uint32 iHash1, const char *szPath1, Uint32 iHash2, const char *szPath2);
+
+    SDL_bool    SDL_Pack_Mount(const char *szPackPath);
+    void        SDL_Pack_SetOverride(const char *szDir);
+    SDL_bool    SDL_Pack_IsMounted(void);
+    const void *SDL_Pack_Map(const char *szPath, Uint32 *pSize);
+    SDL_RWops  *SDL_Pack_Open(const char *szPath);
+    void        SDL_Pack_Unmount(void);
+
+#endif // __SDL_PACK_H__
+
+/* ========================================================================= */
@@ -11,28 +11,1148 @@
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 15/06/15 | Creation.                                            */
 /* Red     | 16/06/15 | Dev basics functions                                 */
+/* Nyuu    | 18/10/26 | Pack the precached sprites in the atlas.             */
+/* Nyuu    | 18/10/26 | Add the profiler zone of the sprites precache.       */
+/* Nyuu    | 18/10/26 | Hash index of the assets, refcounts & release.       */
+/* Nyuu    | 18/10/26 | Stream the sprites with a worker and upload them.    */
+/* Nyuu    | 18/10/26 | Add the fonts and the bulk precache on a worker pool.*/
+/* Nyuu    | 18/10/26 | Open the fonts of the pack with no copy.             */
+/* Nyuu    | 18/10/26 | Keep the trimmed frames of the cooked sprites.       */
+/* Nyuu    | 18/10/26 | Memory budget with LRU eviction of the assets.       */
+/* Nyuu    | 18/10/26 | Release the references of a bulk precache.           */
+/* Nyuu    | 18/10/26 | Release only the references taken by the bulk.       */
 /* ========================================================================= */
  
+#include "SDL_Atlas.h"
 #include "SDL_Precache.h"
+#include "SDL_Util.h"
 
 /* ========================================================================= */
 
+/*! Minimum number of slots of the index (Power of two). */
+#define SDL_PRECACHE_SLOTS_MIN 64
+/*! Value of an empty slot of the index. */
+#define SDL_PRECACHE_INVALID   0xFFFFFFFF
+
+/* ========================================================================= */
+
+/*! Typedef to handle a function waiting for a sprite streamed. */
+typedef struct SDL_PrecacheWaiter SDL_PrecacheWaiter;
+
+/*!
+ * \struct SDL_PrecacheWaiter
+ * \brief  Structure to handle a function waiting for a sprite streamed.
+ */
+struct SDL_PrecacheWaiter
+{
+    SDL_PrecacheCallback  pCallback; /*!< Function to call when the sprite is ready. */
+    void                 *pData;     /*!< Data given to the function. */
+    SDL_PrecacheWaiter   *pNext;     /*!< Pointer to the next waiter. */
+};
+
+/*! Typedef to handle a sprite streamed. */
+typedef struct SDL_PrecacheJob SDL_PrecacheJob;
+
+/*!
+ * \struct SDL_PrecacheJob
+ * \brief  Structure to handle a sprite streamed.
+ */
+struct SDL_PrecacheJob
+{
+    SDL_Sprite         *pSprite;      /*!< Pointer to the pending sprite. */
+    char               *szPath;       /*!< Path of the sprite file. */
+    SDL_Surface        *pSurface;     /*!< Sheet decoded by the worker (NULL => Error). */
+    SDL_SpriteLayout    sLayout;      /*!< Frames of the sheet, read by the worker. */
+    SDL_bool            bDecoded;     /*!< Flag set by the worker when the sheet is decoded. */
+    SDL_bool            bCancelled;   /*!< Flag set if the sprite was released before its upload. */
+    SDL_PrecacheWaiter *pFirstWaiter; /*!< Pointer to the first function waiting for the sprite. */
+    SDL_PrecacheJob    *pNext;        /*!< Pointer to the next job of the queue. */
+};
+
+/*!
+ * \struct SDL_PrecacheQueue
+ * \brief  Structure to handle a queue of sprites streamed.
+ */
+typedef struct
+{
+    SDL_PrecacheJob *pFirst; /*!< Pointer to the first job. */
+    SDL_PrecacheJob *pLast;  /*!< Pointer to the last job. */
+} SDL_PrecacheQueue;
+
+/*!
+ * \struct SDL_PrecacheItem
+ * \brief  Structure to handle an asset of a bulk precache.
+ */
+typedef struct
+{
+    SDL_PrecacheType  iType;        /*!< Type of the asset. */
+    const char       *szName;       /*!< Name of the asset. */
+    char             *szPath;       /*!< Path of the file (NULL => Not decoded). */
+    Uint32            iHash;        /*!< Hash of the key of the asset. */
+    SDL_bool          bDuplicate;   /*!< Flag set if the asset is already in the list. */
+
+    void             *pData;        /*!< Surface, chunk or font file decoded (NULL => Error). */
+    SDL_SpriteLayout  sLayout;      /*!< Frames of the sheet (Sprite). */
+    Uint32            iDataSize;    /*!< Size of the font file (Font). */
+    SDL_bool          bMapped;      /*!< Flag set if the font file is mapped from the pack (Font). */
+
+    Uint64            iDecodeTicks; /*!< Time spent to decode the asset (Performance counter). */
+    Uint64            iUploadTicks; /*!< Time spent to upload the asset (Performance counter). */
+} SDL_PrecacheItem;
+
+/*!
+ * \struct SDL_PrecacheBulk
+ * \brief  Structure to share a bulk precache between its threads.
+ */
+typedef struct
+{
+    SDL_PrecacheItem *pArrItems; /*!< Array of the assets. */
+    Uint32            iNbItems;  /*!< Number of assets. */
+    SDL_atomic_t      iNext;     /*!< Index of the next asset to decode. */
+} SDL_PrecacheBulk;
+
+/*!
+ * \struct SDL_PrecacheEntry
+ * \brief  Structure to handle an asset precached.
+ */
+typedef struct
+{
+    void             *pAsset; /*!< Pointer to the asset (NULL => Empty slot). */
+    const char       *szName; /*!< Name of the asset (Owned by the asset). */
+    Uint32            iHash;  /*!< Hash of the type and the name. */
+    Uint32            iRefs;  /*!< Number of references to the asset. */
+    Uint32            iBytes; /*!< Memory of the own texture or the chunk of the asset (In bytes). */
+    SDL_PrecacheType  iType;  /*!< Type of the asset. */
+    SDL_PrecacheJob  *pJob;   /*!< Pointer to the streaming of the asset (NULL => Loaded). */
+} SDL_PrecacheEntry;
+
+/*!
+ * \struct SDL_PrecacheVictim
+ * \brief  Structure to handle an asset which can be evicted.
+ */
+typedef struct
+{
+    Uint32 iLastUse; /*!< Clock of the last use (The last use of its sprites for a page). */
+    Uint32 iSlot;    /*!< Index of the slot of the asset (SDL_PRECACHE_INVALID => Atlas page). */
+    Uint32 iPage;    /*!< Index of the atlas page. */
+    Uint32 iBytes;   /*!< Memory freed by the eviction (In bytes). */
+} SDL_PrecacheVictim;
+
 /*!
  * \struct SDL_Precache
  * \brief  Structure to handle the precache.
  */
 typedef struct
 {
-    SDL_Sprite **pArrSprites; /*!< Array of sprites precached. */
-    SDL_Sound  **pArrSounds;  /*!< Array of sounds precached. */
- 
-    Uint32       iNbSprites;  /*!< Number of sprites precached. */
-    Uint32       iNbSounds;   /*!< Number of sounds precached. */
+    SDL_PrecacheEntry  *pArrSlots;                     /*!< Index of the assets (Open addressing, linear probing). */
+    Uint32              iNbSlots;                      /*!< Number of slots of the index (Power of two). */
+    Uint32              iNbEntries;                    /*!< Number of assets precached. */
+    Uint32              arrNbAssets[SDL_PRECACHE_MAX]; /*!< Number of assets precached for each type. */
+
+    SDL_Thread         *pThread;                       /*!< Pointer to the worker decoding the sprites streamed. */
+    SDL_mutex          *pMutex;                        /*!< Lock of the queues and of the decoded jobs. */
+    SDL_cond           *pCondTodo;                     /*!< Condition signaled when a job is queued. */
+    SDL_cond           *pCondDone;                     /*!< Condition signaled when a job is decoded. */
+    SDL_PrecacheQueue   sTodo;                         /*!< Jobs waiting for the worker. */
+    SDL_PrecacheQueue   sDone;                         /*!< Jobs waiting for their upload. */
+    SDL_bool            bQuit;                         /*!< Flag set to stop the worker. */
+
+    Uint32              iNbQueued;                     /*!< Number of sprites streamed since the precache was idle. */
+    Uint32              iNbFinished;                   /*!< Number of those sprites uploaded or dropped. */
+
+    SDL_PrecacheStats   sStats;                        /*!< Budget and statistics of the memory. */
+    Uint64              iAssetBytes;                   /*!< Memory of the own textures and the chunks indexed (In bytes). */
+    Uint32              iClock;                        /*!< Clock of the updates, stamped on the assets used. */
+    SDL_bool            bOverBudget;                   /*!< Flag set when the budget can't be met (Logged once). */
+    SDL_PrecacheVictim *pArrVictims;                   /*!< Assets which can be evicted (Kept between the updates). */
+    Uint32              iMaxVictims;                   /*!< Size of the array of the victims. */
 } SDL_Precache;
  
 /*! Global variable to handle the precache. */
 static SDL_Precache SDL_precache;
+
+/*! Names of the types of assets (For the logs). */
+static const char *SDL_precacheTypes[SDL_PRECACHE_MAX] = { "sprite", "sound", "font" };
  
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to hash the key of an asset (FNV-1a).
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return The hash of the key.
+ */
+static Uint32 SDL_Precache_Hash(SDL_PrecacheType iType, const char *szName)
+{
+    Uint32 iHash = 2166136261U ^ (Uint32) iType;
+
+    while (*szName)
+    {
+        iHash ^= (Uint8) *szName++;
+        iHash *= 16777619U;
+    }
+
+    return iHash;
+}
+
+/*!
+ * \brief  Function to find the slot of an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \param  iHash  Hash of the key of the asset.
+ * \return The index of the slot of the asset, or SDL_PRECACHE_INVALID.
+ */
+static Uint32 SDL_Precache_Find(SDL_PrecacheType iType, const char *szName, Uint32 iHash)
+{
+    SDL_PrecacheEntry *pEntry = NULL;
+    Uint32             iMask  = SDL_precache.iNbSlots - 1;
+    Uint32             iSlot  = 0;
+
+    if (!SDL_precache.iNbSlots)
+    {
+        return SDL_PRECACHE_INVALID;
+    }
+
+    for (iSlot = iHash & iMask ; SDL_precache.pArrSlots[iSlot].pAsset ; iSlot = (iSlot + 1) & iMask)
+    {
+        pEntry = &SDL_precache.pArrSlots[iSlot];
+
+        if ((pEntry->iHash == iHash) && (pEntry->iType == iType) && (strcmp(pEntry->szName, szName) == 0))
+        {
+            return iSlot;
+        }
+    }
+
+    return SDL_PRECACHE_INVALID;
+}
+
+/*!
+ * \brief  Function to put an entry in the first free slot of its chain.
+ *
+ * \param  pArrSlots Pointer to the slots.
+ * \param  iNbSlots  Number of slots (Power of two).
+ * \param  pEntry    Pointer to the entry.
+ * \return None.
+ */
+static void SDL_Precache_Place(SDL_PrecacheEntry *pArrSlots, Uint32 iNbSlots, const SDL_PrecacheEntry *pEntry)
+{
+    Uint32 iSlot = pEntry->iHash & (iNbSlots - 1);
+
+    while (pArrSlots[iSlot].pAsset)
+    {
+        iSlot = (iSlot + 1) & (iNbSlots - 1);
+    }
+
+    pArrSlots[iSlot] = *pEntry;
+}
+
+/*!
+ * \brief  Function to add an asset in the index.
+ *
+ * \param  pEntry Pointer to the entry of the asset.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The index doubles when it is half full.
+ */
+static SDL_bool SDL_Precache_Insert(const SDL_PrecacheEntry *pEntry)
+{
+    SDL_PrecacheEntry *pArrSlots = NULL;
+    Uint32             iNbSlots  = 0;
+    Uint32             i         = 0;
+
+    if ((SDL_precache.iNbEntries + 1) * 2 > SDL_precache.iNbSlots)
+    {
+        iNbSlots  = COM_Math_Max(SDL_precache.iNbSlots * 2, SDL_PRECACHE_SLOTS_MIN);
+        pArrSlots = (SDL_PrecacheEntry *) UTIL_Malloc(sizeof(SDL_PrecacheEntry) * iNbSlots);
+
+        if (!pArrSlots)
+        {
+            return SDL_FALSE;
+        }
+
+        memset(pArrSlots, 0, sizeof(SDL_PrecacheEntry) * iNbSlots);
+
+        for (i = 0 ; i < SDL_precache.iNbSlots ; ++i)
+        {
+            if (SDL_precache.pArrSlots[i].pAsset)
+            {
+                SDL_Precache_Place(pArrSlots, iNbSlots, &SDL_precache.pArrSlots[i]);
+            }
+        }
+
+        UTIL_Free(SDL_precache.pArrSlots);
+        SDL_precache.pArrSlots = pArrSlots;
+        SDL_precache.iNbSlots  = iNbSlots;
+    }
+
+    SDL_Precache_Place(SDL_precache.pArrSlots, SDL_precache.iNbSlots, pEntry);
+    SDL_precache.iNbEntries++;
+    SDL_precache.arrNbAssets[pEntry->iType]++;
+    SDL_precache.iAssetBytes += pEntry->iBytes;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to remove an asset from the index.
+ *
+ * \param  iSlot Index of the slot of the asset.
+ * \return None.
+ *
+ * \remark The next entries of the chain are shifted back, so the index
+ *         never holds tombstones.
+ */
+static void SDL_Precache_Remove(Uint32 iSlot)
+{
+    SDL_PrecacheEntry *pArrSlots = SDL_precache.pArrSlots;
+    Uint32             iMask     = SDL_precache.iNbSlots - 1;
+    Uint32             iNext     = iSlot;
+    Uint32             iHome     = 0;
+
+    SDL_precache.iNbEntries--;
+    SDL_precache.arrNbAssets[pArrSlots[iSlot].iType]--;
+    SDL_precache.iAssetBytes -= pArrSlots[iSlot].iBytes;
+
+    for (;;)
+    {
+        pArrSlots[iSlot].pAsset = NULL;
+
+        do
+        {
+            iNext = (iNext + 1) & iMask;
+
+            if (!pArrSlots[iNext].pAsset)
+            {
+                return;
+            }
+
+            iHome = pArrSlots[iNext].iHash & iMask;
+        }
+        /* ~~~ Keep the entries whose home is between the hole and them ~~~ */
+        while (((iSlot <= iNext) && (iSlot < iHome) && (iHome <= iNext)) ||
+               ((iSlot >  iNext) && ((iSlot < iHome) || (iHome <= iNext))));
+
+        pArrSlots[iSlot] = pArrSlots[iNext];
+        iSlot            = iNext;
+    }
+}
+
+/*!
+ * \brief  Function to free an asset.
+ *
+ * \param  pEntry Pointer to the entry of the asset.
+ * \return None.
+ */
+static void SDL_Precache_FreeAsset(SDL_PrecacheEntry *pEntry)
+{
+    SDL_Sprite *pSprite = NULL;
+    SDL_Sound  *pSound  = NULL;
+    SDL_Font   *pFont   = NULL;
+
+    switch (pEntry->iType)
+    {
+        case SDL_PRECACHE_SPRITE:
+            pSprite = (SDL_Sprite *) pEntry->pAsset;
+            SDL_Sprite_Free(&pSprite);
+            break;
+
+        case SDL_PRECACHE_SOUND:
+            pSound = (SDL_Sound *) pEntry->pAsset;
+            SDL_Sound_Free(&pSound);
+            break;
+
+        default:
+            pFont = (SDL_Font *) pEntry->pAsset;
+            SDL_Font_Free(&pFont);
+            break;
+    }
+}
+
+/*!
+ * \brief  Function to load an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return A pointer to the loaded asset, or NULL if error.
+ */
+static void *SDL_Precache_Load(SDL_PrecacheType iType, const char *szName)
+{
+    switch (iType)
+    {
+        case SDL_PRECACHE_SPRITE: return SDL_Sprite_Alloc(szName);
+        case SDL_PRECACHE_SOUND:  return SDL_Sound_Alloc(szName);
+        default:                  return SDL_Font_Alloc(szName);
+    }
+}
+
+/*!
+ * \brief  Function to get the name of an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  pAsset Pointer to the asset.
+ * \return The name of the asset (Owned by the asset).
+ */
+static const char *SDL_Precache_GetName(SDL_PrecacheType iType, const void *pAsset)
+{
+    switch (iType)
+    {
+        case SDL_PRECACHE_SPRITE: return SDL_Sprite_GetName((const SDL_Sprite *) pAsset);
+        case SDL_PRECACHE_SOUND:  return SDL_Sound_GetName((const SDL_Sound *) pAsset);
+        default:                  return SDL_Font_GetName((const SDL_Font *) pAsset);
+    }
+}
+
+/*!
+ * \brief  Function to get the memory of the own texture or the chunk of an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  pAsset Pointer to the asset.
+ * \return The memory (In bytes), 0 for a sheet packed in the atlas or a font.
+ */
+static Uint32 SDL_Precache_GetBytes(SDL_PrecacheType iType, const void *pAsset)
+{
+    switch (iType)
+    {
+        case SDL_PRECACHE_SPRITE: return SDL_Sprite_GetBytes((const SDL_Sprite *) pAsset);
+        case SDL_PRECACHE_SOUND:  return SDL_Sound_GetBytes((const SDL_Sound *) pAsset);
+        default:                  return 0;
+    }
+}
+
+/*!
+ * \brief  Function to update the memory of an asset indexed.
+ *
+ * \param  pEntry Pointer to the entry of the asset.
+ * \return None.
+ */
+static void SDL_Precache_Account(SDL_PrecacheEntry *pEntry)
+{
+    SDL_precache.iAssetBytes -= pEntry->iBytes;
+    pEntry->iBytes            = SDL_Precache_GetBytes(pEntry->iType, pEntry->pAsset);
+    SDL_precache.iAssetBytes += pEntry->iBytes;
+}
+
+/*!
+ * \brief  Function to build the path of the file of an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return The path of the file (Must be freed), or NULL if error.
+ */
+static char *SDL_Precache_GetPath(SDL_PrecacheType iType, const char *szName)
+{
+    switch (iType)
+    {
+        case SDL_PRECACHE_SPRITE: return UTIL_StrBuild("sprites/", szName, ".spr", NULL);
+        case SDL_PRECACHE_SOUND:  return UTIL_StrBuild("sounds/",  szName, ".wav", NULL);
+        default:                  return SDL_Font_GetPath(szName);
+    }
+}
+
+/*!
+ * \brief  Function to add a job at the end of a queue.
+ *
+ * \param  pQueue Pointer to the queue.
+ * \param  pJob   Pointer to the job.
+ * \return None.
+ */
+static void SDL_Precache_Push(SDL_PrecacheQueue *pQueue, SDL_PrecacheJob *pJob)
+{
+    pJob->pNext = NULL;
+
+    if (pQueue->pLast)
+    {
+        pQueue->pLast->pNext = pJob;
+    }
+    else
+    {
+        pQueue->pFirst = pJob;
+    }
+
+    pQueue->pLast = pJob;
+}
+
+/*!
+ * \brief  Function to take a job out of a queue.
+ *
+ * \param  pQueue Pointer to the queue.
+ * \param  pJob   Pointer to the job (NULL => First job).
+ * \return A pointer to the job, or NULL if it is not in the queue.
+ */
+static SDL_PrecacheJob *SDL_Precache_Pop(SDL_PrecacheQueue *pQueue, SDL_PrecacheJob *pJob)
+{
+    SDL_PrecacheJob *pPrev = NULL;
+    SDL_PrecacheJob *pCurr = pQueue->pFirst;
+
+    while (pCurr && pJob && (pCurr != pJob))
+    {
+        pPrev = pCurr;
+        pCurr = pCurr->pNext;
+    }
+
+    if (pCurr)
+    {
+        if (pPrev)
+        {
+            pPrev->pNext = pCurr->pNext;
+        }
+        else
+        {
+            pQueue->pFirst = pCurr->pNext;
+        }
+
+        if (pQueue->pLast == pCurr)
+        {
+            pQueue->pLast = pPrev;
+        }
+    }
+
+    return pCurr;
+}
+
+/*!
+ * \brief  Function to free a job (The sprite is kept).
+ *
+ * \param  pJob Pointer to the job.
+ * \return None.
+ */
+static void SDL_Precache_FreeJob(SDL_PrecacheJob *pJob)
+{
+    SDL_PrecacheWaiter *pWaiter = NULL;
+
+    while (pJob->pFirstWaiter)
+    {
+        pWaiter            = pJob->pFirstWaiter;
+        pJob->pFirstWaiter = pWaiter->pNext;
+
+        UTIL_Free(pWaiter);
+    }
+
+    if (pJob->pSurface)
+    {
+        SDL_FreeSurface(pJob->pSurface);
+    }
+
+    /* ~~~ Not given to the sprite if the job was cancelled ~~~ */
+    SDL_free(pJob->sLayout.pArrFrames);
+
+    UTIL_Free(pJob->szPath);
+    UTIL_Free(pJob);
+}
+
+/*!
+ * \brief  Function to add a function waiting for a sprite streamed.
+ *
+ * \param  pJob      Pointer to the job of the sprite.
+ * \param  pCallback Function to call when the sprite is ready (Can be NULL).
+ * \param  pData     Data given to the function.
+ * \return None.
+ */
+static void SDL_Precache_AddWaiter(SDL_PrecacheJob *pJob, SDL_PrecacheCallback pCallback, void *pData)
+{
+    SDL_PrecacheWaiter *pWaiter = NULL;
+
+    if (pCallback)
+    {
+        pWaiter = (SDL_PrecacheWaiter *) UTIL_Malloc(sizeof(SDL_PrecacheWaiter));
+
+        if (pWaiter)
+        {
+            pWaiter->pCallback = pCallback;
+            pWaiter->pData     = pData;
+            pWaiter->pNext     = pJob->pFirstWaiter;
+            pJob->pFirstWaiter = pWaiter;
+        }
+    }
+}
+
+/*!
+ * \brief  Function to decode the sprites streamed (Worker thread).
+ *
+ * \param  pData Unused.
+ * \return Always 0.
+ */
+static int SDL_Precache_Worker(void *pData)
+{
+    SDL_PrecacheJob *pJob     = NULL;
+    SDL_Surface     *pSurface = NULL;
+    SDL_SpriteLayout sLayout;
+
+    (void) pData;
+
+    SDL_LockMutex(SDL_precache.pMutex);
+
+    for (;;)
+    {
+        while (!SDL_precache.bQuit && !SDL_precache.sTodo.pFirst)
+        {
+            SDL_CondWait(SDL_precache.pCondTodo, SDL_precache.pMutex);
+        }
+
+        if (SDL_precache.bQuit)
+        {
+            break;
+        }
+
+        pJob = SDL_Precache_Pop(&SDL_precache.sTodo, NULL);
+
+        /* ~~~ The file I/O and the PNG decoding are done unlocked ~~~ */
+        SDL_UnlockMutex(SDL_precache.pMutex);
+
+        pSurface = SDL_Sprite_Decode(pJob->szPath, &sLayout);
+
+        SDL_LockMutex(SDL_precache.pMutex);
+
+        pJob->pSurface = pSurface;
+        pJob->sLayout  = sLayout;
+        pJob->bDecoded = SDL_TRUE;
+
+        SDL_Precache_Push(&SDL_precache.sDone, pJob);
+        SDL_CondBroadcast(SDL_precache.pCondDone);
+    }
+
+    SDL_UnlockMutex(SDL_precache.pMutex);
+
+    return 0;
+}
+
+/*!
+ * \brief  Function to start the worker decoding the sprites streamed.
+ *
+ * \return SDL_TRUE if the worker runs, else SDL_FALSE.
+ */
+static SDL_bool SDL_Precache_StartWorker(void)
+{
+    if (!SDL_precache.pThread)
+    {
+        SDL_precache.bQuit     = SDL_FALSE;
+        SDL_precache.pMutex    = SDL_CreateMutex( );
+        SDL_precache.pCondTodo = SDL_CreateCond( );
+        SDL_precache.pCondDone = SDL_CreateCond( );
+
+        if (SDL_precache.pMutex && SDL_precache.pCondTodo && SDL_precache.pCondDone)
+        {
+            SDL_precache.pThread = SDL_CreateThread(SDL_Precache_Worker, "precache", NULL);
+        }
+
+        if (!SDL_precache.pThread)
+        {
+            COM_Log_Print(COM_LOG_ERROR, "Can't start the streaming of the sprites: %s", SDL_GetError( ));
+
+            SDL_DestroyCond(SDL_precache.pCondDone);
+            SDL_DestroyCond(SDL_precache.pCondTodo);
+            SDL_DestroyMutex(SDL_precache.pMutex);
+
+            SDL_precache.pCondDone = NULL;
+            SDL_precache.pCondTodo = NULL;
+            SDL_precache.pMutex    = NULL;
+        }
+    }
+
+    return SDL_precache.pThread ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to upload a sprite decoded and call its waiters.
+ *
+ * \param  pJob Pointer to the job of the sprite (Out of the queues).
+ * \return None.
+ */
+static void SDL_Precache_Finish(SDL_PrecacheJob *pJob)
+{
+    SDL_PrecacheWaiter *pWaiter = NULL;
+    SDL_bool            bLoaded = SDL_FALSE;
+    const char         *szName  = SDL_Sprite_GetName(pJob->pSprite);
+    Uint32              iSlot   = 0;
+
+    if (pJob->bCancelled)
+    {
+        SDL_Sprite_Free(&pJob->pSprite);
+    }
+    else
+    {
+        iSlot = SDL_Precache_Find(SDL_PRECACHE_SPRITE, szName, SDL_Precache_Hash(SDL_PRECACHE_SPRITE, szName));
+        SDL_precache.pArrSlots[iSlot].pJob = NULL;
+
+        bLoaded = pJob->pSurface ? SDL_Sprite_Upload(pJob->pSprite, pJob->pSurface, &pJob->sLayout) : SDL_FALSE;
+
+        SDL_Precache_Account(&SDL_precache.pArrSlots[iSlot]);
+
+        if (bLoaded)
+        {
+            COM_Log_Print(COM_LOG_INFO, "Precache sprite: \"%s\" (Streamed).", szName);
+        }
+        else
+        {
+            COM_Log_Print(COM_LOG_ERROR, "Can't stream the sprite \"%s\" !", szName);
+        }
+
+        for (pWaiter = pJob->pFirstWaiter ; pWaiter ; pWaiter = pWaiter->pNext)
+        {
+            pWaiter->pCallback(pJob->pSprite, bLoaded, pWaiter->pData);
+        }
+    }
+
+    SDL_Precache_FreeJob(pJob);
+    SDL_precache.iNbFinished++;
+}
+
+/*!
+ * \brief  Function to finish a sprite streamed at once.
+ *
+ * \param  pJob Pointer to the job of the sprite.
+ * \return None.
+ */
+static void SDL_Precache_Wait(SDL_PrecacheJob *pJob)
+{
+    SDL_LockMutex(SDL_precache.pMutex);
+
+    if (SDL_Precache_Pop(&SDL_precache.sTodo, pJob))
+    {
+        /* ~~~ Not started by the worker: decode it here ~~~ */
+        SDL_UnlockMutex(SDL_precache.pMutex);
+
+        pJob->pSurface = SDL_Sprite_Decode(pJob->szPath, &pJob->sLayout);
+    }
+    else
+    {
+        while (!pJob->bDecoded)
+        {
+            SDL_CondWait(SDL_precache.pCondDone, SDL_precache.pMutex);
+        }
+
+        SDL_Precache_Pop(&SDL_precache.sDone, pJob);
+        SDL_UnlockMutex(SDL_precache.pMutex);
+    }
+
+    SDL_Precache_Finish(pJob);
+}
+
+/*!
+ * \brief  Function to decode the assets of a bulk precache (Any thread).
+ *
+ * \param  pData Pointer to the bulk precache.
+ * \return Always 0.
+ *
+ * \remark Each thread takes the next asset not decoded, until the end of
+ *         the list. Nothing is indexed nor uploaded here.
+ */
+static int SDL_Precache_BulkWorker(void *pData)
+{
+    SDL_PrecacheBulk *pBulk  = (SDL_PrecacheBulk *) pData;
+    SDL_PrecacheItem *pItem  = NULL;
+    Uint64            iStart = 0;
+    Uint32            i      = 0;
+
+    while ((i = (Uint32) SDL_AtomicAdd(&pBulk->iNext, 1)) < pBulk->iNbItems)
+    {
+        pItem = &pBulk->pArrItems[i];
+
+        if (pItem->szPath)
+        {
+            iStart = SDL_GetPerformanceCounter( );
+
+            switch (pItem->iType)
+            {
+                case SDL_PRECACHE_SPRITE:
+                    pItem->pData = SDL_Sprite_Decode(pItem->szPath, &pItem->sLayout);
+                    break;
+
+                case SDL_PRECACHE_SOUND:
+                    pItem->pData = UTIL_ChunkLoad(pItem->szPath);
+                    break;
+
+                default:
+                    pItem->pData = UTIL_RWRead(pItem->szPath, &pItem->iDataSize, &pItem->bMapped);
+                    break;
+            }
+
+            pItem->iDecodeTicks = SDL_GetPerformanceCounter( ) - iStart;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief  Function to create an asset decoded by a bulk precache.
+ *
+ * \param  pItem Pointer to the asset decoded (Its data is given to the asset).
+ * \return A pointer to the asset, or NULL if error.
+ */
+static void *SDL_Precache_BulkUpload(SDL_PrecacheItem *pItem)
+{
+    SDL_Sprite *pSprite = NULL;
+    void       *pAsset  = NULL;
+
+    if (pItem->pData)
+    {
+        switch (pItem->iType)
+        {
+            case SDL_PRECACHE_SPRITE:
+                pSprite = SDL_Sprite_AllocPending(pItem->szName);
+
+                if (pSprite && !SDL_Sprite_Upload(pSprite, (SDL_Surface *) pItem->pData, &pItem->sLayout))
+                {
+                    SDL_Sprite_Free(&pSprite);
+                }
+
+                SDL_free(pItem->sLayout.pArrFrames);
+                SDL_FreeSurface((SDL_Surface *) pItem->pData);
+                pAsset = pSprite;
+                break;
+
+            case SDL_PRECACHE_SOUND:
+                pAsset = SDL_Sound_AllocFromChunk(pItem->szName, (Mix_Chunk *) pItem->pData);
+                break;
+
+            default:
+                pAsset = SDL_Font_Open(pItem->szName, pItem->pData, pItem->iDataSize, pItem->bMapped);
+                break;
+        }
+
+        pItem->pData = NULL;
+    }
+
+    return pAsset;
+}
+
+/*!
+ * \brief  Function to add a reference to an asset already precached.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \param  iHash  Hash of the key of the asset.
+ * \return A pointer to the asset, or NULL if it is not precached.
+ *
+ * \remark A sprite being streamed is finished at once.
+ */
+static void *SDL_Precache_AddRef(SDL_PrecacheType iType, const char *szName, Uint32 iHash)
+{
+    Uint32 iSlot = SDL_Precache_Find(iType, szName, iHash);
+
+    /* ~~~ Being streamed: finish it now ~~~ */
+    if ((iSlot != SDL_PRECACHE_INVALID) && SDL_precache.pArrSlots[iSlot].pJob)
+    {
+        SDL_Precache_Wait(SDL_precache.pArrSlots[iSlot].pJob);
+        iSlot = SDL_Precache_Find(iType, szName, iHash);
+    }
+
+    if (iSlot == SDL_PRECACHE_INVALID)
+    {
+        return NULL;
+    }
+
+    SDL_precache.pArrSlots[iSlot].iRefs++;
+
+    return SDL_precache.pArrSlots[iSlot].pAsset;
+}
+
+/*!
+ * \brief  Function to add an asset loaded in the index.
+ *
+ * \param  iType  Type of the asset.
+ * \param  pAsset Pointer to the asset (Can be NULL, freed if error).
+ * \param  iHash  Hash of the key of the asset.
+ * \return A pointer to the asset, or NULL if error.
+ */
+static void *SDL_Precache_AddAsset(SDL_PrecacheType iType, void *pAsset, Uint32 iHash)
+{
+    SDL_PrecacheEntry sEntry;
+
+    sEntry.iType  = iType;
+    sEntry.iHash  = iHash;
+    sEntry.iRefs  = 1;
+    sEntry.pJob   = NULL;
+    sEntry.pAsset = pAsset;
+
+    if (sEntry.pAsset)
+    {
+        sEntry.szName = SDL_Precache_GetName(iType, pAsset);
+        sEntry.iBytes = SDL_Precache_GetBytes(iType, pAsset);
+
+        if (SDL_Precache_Insert(&sEntry))
+        {
+            COM_Log_Print(COM_LOG_INFO, "Precache %s: \"%s\".", SDL_precacheTypes[iType], sEntry.szName);
+        }
+        else
+        {
+            SDL_Precache_FreeAsset(&sEntry);
+            sEntry.pAsset = NULL;
+        }
+    }
+
+    return sEntry.pAsset;
+}
+
+/*!
+ * \brief  Function to get an asset, loading it if needed.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return A pointer to the asset, or NULL if error.
+ */
+static void *SDL_Precache_Get(SDL_PrecacheType iType, const char *szName)
+{
+    Uint32  iHash  = SDL_Precache_Hash(iType, szName);
+    void   *pAsset = SDL_Precache_AddRef(iType, szName, iHash);
+
+    if (!pAsset)
+    {
+        pAsset = SDL_Precache_AddAsset(iType, SDL_Precache_Load(iType, szName), iHash);
+    }
+
+    return pAsset;
+}
+
+/*!
+ * \brief  Function to account an asset loaded again after its eviction.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return None.
+ */
+static void SDL_Precache_Reloaded(SDL_PrecacheType iType, const char *szName)
+{
+    Uint32 iSlot = SDL_Precache_Find(iType, szName, SDL_Precache_Hash(iType, szName));
+
+    if (iSlot != SDL_PRECACHE_INVALID)
+    {
+        SDL_Precache_Account(&SDL_precache.pArrSlots[iSlot]);
+    }
+
+    SDL_precache.sStats.iNbReloads++;
+
+    COM_Log_Print(COM_LOG_INFO, "Reload %s: \"%s\".", SDL_precacheTypes[iType], szName);
+}
+
+/*!
+ * \brief  Function called when the sheet of an evicted sprite is loaded again.
+ *
+ * \param  pSprite Pointer to the sprite.
+ * \return None.
+ */
+static void SDL_Precache_SpriteReloaded(SDL_Sprite *pSprite)
+{
+    SDL_Precache_Reloaded(SDL_PRECACHE_SPRITE, SDL_Sprite_GetName(pSprite));
+}
+
+/*!
+ * \brief  Function called when the chunk of an evicted sound is loaded again.
+ *
+ * \param  pSound Pointer to the sound.
+ * \return None.
+ */
+static void SDL_Precache_SoundReloaded(SDL_Sound *pSound)
+{
+    SDL_Precache_Reloaded(SDL_PRECACHE_SOUND, SDL_Sound_GetName(pSound));
+}
+
+/*!
+ * \brief  Function to compare two victims by their last use (For qsort).
+ *
+ * \param  pA Pointer to the first victim.
+ * \param  pB Pointer to the second victim.
+ * \return A negative value if the first one was used before the second one.
+ */
+static int SDL_Precache_CompareVictims(const void *pA, const void *pB)
+{
+    Uint32 iA = ((const SDL_PrecacheVictim *) pA)->iLastUse;
+    Uint32 iB = ((const SDL_PrecacheVictim *) pB)->iLastUse;
+
+    return (iA > iB) - (iA < iB);
+}
+
+/*!
+ * \brief  Function to evict a page of the atlas with all its sprites.
+ *
+ * \param  iPage Index of the page.
+ * \return None.
+ */
+static void SDL_Precache_EvictPage(Uint32 iPage)
+{
+    SDL_Texture       *pTexture   = SDL_Atlas_GetTexture(iPage);
+    SDL_PrecacheEntry *pEntry     = NULL;
+    Uint32             iNbSprites = 0;
+    Uint32             i          = 0;
+
+    for (i = 0 ; i < SDL_precache.iNbSlots ; ++i)
+    {
+        pEntry = &SDL_precache.pArrSlots[i];
+
+        if (pEntry->pAsset && (pEntry->iType == SDL_PRECACHE_SPRITE) &&
+            (SDL_Sprite_GetPage((SDL_Sprite *) pEntry->pAsset) == pTexture))
+        {
+            SDL_Sprite_Evict((SDL_Sprite *) pEntry->pAsset);
+            iNbSprites++;
+        }
+    }
+
+    SDL_Atlas_Clear(iPage);
+
+    COM_Log_Print(COM_LOG_INFO, "Evict atlas page %d (%d sprites).", iPage, iNbSprites);
+}
+
+/*!
+ * \brief  Function to evict the own texture or the chunk of an asset.
+ *
+ * \param  pEntry Pointer to the entry of the asset.
+ * \return SDL_TRUE if the asset is evicted, else SDL_FALSE (Sound played).
+ */
+static SDL_bool SDL_Precache_EvictAsset(SDL_PrecacheEntry *pEntry)
+{
+    if (pEntry->iType == SDL_PRECACHE_SPRITE)
+    {
+        SDL_Sprite_Evict((SDL_Sprite *) pEntry->pAsset);
+    }
+    else if (!SDL_Sound_Evict((SDL_Sound *) pEntry->pAsset))
+    {
+        return SDL_FALSE;
+    }
+
+    COM_Log_Print(COM_LOG_INFO, "Evict %s: \"%s\" (%d KB).", SDL_precacheTypes[pEntry->iType], pEntry->szName, pEntry->iBytes >> 10);
+
+    SDL_Precache_Account(pEntry);
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to evict the assets used the longest time ago, until the
+ *         memory fits in the budget.
+ *
+ * \return None.
+ *
+ * \remark The sheets packed in the atlas are evicted by page, a page being
+ *         as old as its sprite used last. The fonts, the sprites streamed
+ *         and the assets used by the last frame are never evicted.
+ */
+static void SDL_Precache_Evict(void)
+{
+    SDL_PrecacheVictim *pArrVictims = NULL;
+    SDL_PrecacheVictim *pVictim     = NULL;
+    SDL_PrecacheEntry  *pEntry      = NULL;
+    SDL_Texture        *pPage       = NULL;
+    Uint64              iResident   = SDL_precache.iAssetBytes + SDL_Atlas_GetBytes( );
+    Uint32              iNbPages    = SDL_Atlas_GetPages( );
+    Uint32              iNbVictims  = 0;
+    Uint32              iLastUse    = 0;
+    Uint32              i           = 0;
+    Uint32              j           = 0;
+
+    if (!SDL_precache.sStats.iBudget || (iResident <= SDL_precache.sStats.iBudget))
+    {
+        SDL_precache.bOverBudget = SDL_FALSE;
+        return;
+    }
+
+    /* ~~~ The pages first (At their index), then the own textures and the chunks ~~~ */
+    if (iNbPages + SDL_precache.iNbEntries > SDL_precache.iMaxVictims)
+    {
+        pArrVictims = (SDL_PrecacheVictim *) UTIL_Realloc(SDL_precache.pArrVictims, sizeof(SDL_PrecacheVictim) * (iNbPages + SDL_precache.iNbEntries));
+
+        if (!pArrVictims)
+        {
+            return;
+        }
+
+        SDL_precache.pArrVictims = pArrVictims;
+        SDL_precache.iMaxVictims = iNbPages + SDL_precache.iNbEntries;
+    }
+
+    pArrVictims = SDL_precache.pArrVictims;
+
+    for (i = 0 ; i < iNbPages ; ++i)
+    {
+        pArrVictims[i].iLastUse = 0;
+        pArrVictims[i].iSlot    = SDL_PRECACHE_INVALID;
+        pArrVictims[i].iPage    = i;
+        pArrVictims[i].iBytes   = SDL_Atlas_GetTexture(i) ? (Uint32) SDL_ATLAS_PAGE_BYTES : 0;
+    }
+
+    iNbVictims = iNbPages;
+
+    for (i = 0 ; i < SDL_precache.iNbSlots ; ++i)
+    {
+        pEntry = &SDL_precache.pArrSlots[i];
+
+        if (!pEntry->pAsset || pEntry->pJob || (pEntry->iType == SDL_PRECACHE_FONT))
+        {
+            continue;
+        }
+
+        if (pEntry->iType == SDL_PRECACHE_SPRITE)
+        {
+            iLastUse = SDL_Sprite_GetLastUse((const SDL_Sprite *) pEntry->pAsset);
+            pPage    = SDL_Sprite_GetPage((const SDL_Sprite *) pEntry->pAsset);
+        }
+        else
+        {
+            iLastUse = SDL_Sound_GetLastUse((const SDL_Sound *) pEntry->pAsset);
+            pPage    = NULL;
+        }
+
+        if (pPage)
+        {
+            for (j = 0 ; (j < iNbPages) && (SDL_Atlas_GetTexture(j) != pPage) ; ++j);
+
+            if (j < iNbPages)
+            {
+                pArrVictims[j].iLastUse = COM_Math_Max(pArrVictims[j].iLastUse, iLastUse);
+            }
+        }
+        else if (pEntry->iBytes)
+        {
+            pVictim           = &pArrVictims[iNbVictims++];
+            pVictim->iLastUse = iLastUse;
+            pVictim->iSlot    = i;
+            pVictim->iPage    = 0;
+            pVictim->iBytes   = pEntry->iBytes;
+        }
+    }
+
+    SDL_qsort(pArrVictims, iNbVictims, sizeof(SDL_PrecacheVictim), SDL_Precache_CompareVictims);
+
+    /* ~~~ Sorted: the first asset used by the last frame ends the search ~~~ */
+    for (i = 0 ; (i < iNbVictims) && (iResident > SDL_precache.sStats.iBudget) ; ++i)
+    {
+        pVictim = &pArrVictims[i];
+
+        if (pVictim->iLastUse + 1 >= SDL_precache.iClock)
+        {
+            break;
+        }
+
+        if (!pVictim->iBytes)
+        {
+            continue;
+        }
+
+        if (pVictim->iSlot == SDL_PRECACHE_INVALID)
+        {
+            SDL_Precache_EvictPage(pVictim->iPage);
+        }
+        else if (!SDL_Precache_EvictAsset(&SDL_precache.pArrSlots[pVictim->iSlot]))
+        {
+            continue;
+        }
+
+        iResident                    -= pVictim->iBytes;
+        SDL_precache.sStats.iEvicted += pVictim->iBytes;
+        SDL_precache.sStats.iNbEvictions++;
+    }
+
+    if ((iResident > SDL_precache.sStats.iBudget) && !SDL_precache.bOverBudget)
+    {
+        COM_Log_Print(COM_LOG_WARNING, "Precache over budget: %d MB still loaded, %d MB allowed !",
+                      (int) (iResident >> 20), (int) (SDL_precache.sStats.iBudget >> 20));
+    }
+
+    SDL_precache.bOverBudget = (iResident > SDL_precache.sStats.iBudget) ? SDL_TRUE : SDL_FALSE;
+}
+
 /* ========================================================================= */
  
 /*!
@@ -42,11 +1162,38 @@ static SDL_Precache SDL_precache;
  */
 void SDL_Precache_Init(void)
 {
-    SDL_precache.iNbSprites  = 0;
-    SDL_precache.iNbSounds   = 0;
+    SDL_precache.pArrSlots  = NULL;
+    SDL_precache.iNbSlots   = 0;
+    SDL_precache.iNbEntries = 0;
+
+    memset(SDL_precache.arrNbAssets, 0, sizeof(SDL_precache.arrNbAssets));
+
+    SDL_precache.pThread      = NULL;
+    SDL_precache.pMutex       = NULL;
+    SDL_precache.pCondTodo    = NULL;
+    SDL_precache.pCondDone    = NULL;
+    SDL_precache.sTodo.pFirst = NULL;
+    SDL_precache.sTodo.pLast  = NULL;
+    SDL_precache.sDone.pFirst = NULL;
+    SDL_precache.sDone.pLast  = NULL;
+    SDL_precache.bQuit        = SDL_FALSE;
+    SDL_precache.iNbQueued    = 0;
+    SDL_precache.iNbFinished  = 0;
 
-    SDL_precache.pArrSprites = NULL;
-    SDL_precache.pArrSounds  = NULL;
+    memset(&SDL_precache.sStats, 0, sizeof(SDL_PrecacheStats));
+
+    SDL_precache.iAssetBytes = 0;
+    SDL_precache.iClock      = 1;
+    SDL_precache.bOverBudget = SDL_FALSE;
+    SDL_precache.pArrVictims = NULL;
+    SDL_precache.iMaxVictims = 0;
+
+    SDL_Sprite_SetClock(SDL_precache.iClock);
+    SDL_Sound_SetClock(SDL_precache.iClock);
+    SDL_Sprite_SetReloadHook(SDL_Precache_SpriteReloaded);
+    SDL_Sound_SetReloadHook(SDL_Precache_SoundReloaded);
+
+    SDL_Atlas_Init( );
 }
 
 /*!
@@ -54,93 +1201,461 @@ void SDL_Precache_Init(void)
  *
  * \param  szSprName Name of the sprite.
  * \return A pointer to the loaded sprite, or NULL if error.
+ *
+ * \remark Each call adds a reference to the sprite (See SDL_Precache_Release).
  */
 SDL_Sprite *SDL_Precache_Sprite(const char *szSprName)
 {
-    const char *pSprName   = NULL;
-    SDL_Sprite *pSprite    = NULL;
-    Uint32      iNumSprite = 0;
-    Uint32      iNewSize   = 0;
+    SDL_Sprite *pSprite = NULL;
+
+    COM_PROF_BEGIN("SDL_Precache_Sprite");
+
+    pSprite = (SDL_Sprite *) SDL_Precache_Get(SDL_PRECACHE_SPRITE, szSprName);
+
+    COM_PROF_END( );
+    
+    return pSprite;
+}
  
-    /* Check if the sprite has already been precached */
-    for (iNumSprite = 0 ; iNumSprite < SDL_precache.iNbSprites ; ++iNumSprite)
+/*!
+ * \brief  Function to precache a sound.
+ *
+ * \param  szSndName Name of the sound.
+ * \return A pointer to the loaded sound, or NULL if error.
+ *
+ * \remark Each call adds a reference to the sound (See SDL_Precache_Release).
+ */
+SDL_Sound *SDL_Precache_Sound(const char *szSndName)
+{
+    return (SDL_Sound *) SDL_Precache_Get(SDL_PRECACHE_SOUND, szSndName);
+}
+
+/*!
+ * \brief  Function to precache a font.
+ *
+ * \param  szFontName Name of the font, with its size ("codenewroman:30").
+ * \return A pointer to the loaded font, or NULL if error.
+ *
+ * \remark Each call adds a reference to the font (See SDL_Precache_Release).
+ */
+SDL_Font *SDL_Precache_Font(const char *szFontName)
+{
+    return (SDL_Font *) SDL_Precache_Get(SDL_PRECACHE_FONT, szFontName);
+}
+
+/*!
+ * \brief  Function to precache a list of assets at once.
+ *
+ * \param  pArrAssets Array of the assets.
+ * \param  iNbAssets  Number of assets.
+ * \param  pArrTaken  Array to retrieve if each asset got a reference (Can be NULL).
+ * \return The number of assets precached.
+ *
+ * \remark The files are read and decoded in parallel, by a pool of threads
+ *         sized on the cores, then all the textures are uploaded in one pass
+ *         by the caller (The thread of the renderer). The cost of each asset
+ *         is logged. Each asset of the list gets one reference, as with
+ *         SDL_Precache_Sprite, SDL_Precache_Sound or SDL_Precache_Font
+ *         (See SDL_Precache_ReleaseBulk).
+ */
+Uint32 SDL_Precache_Bulk(const SDL_PrecacheAsset *pArrAssets, Uint32 iNbAssets, SDL_bool *pArrTaken)
+{
+    SDL_Thread       *arrThreads[SDL_PRECACHE_BULK_THREADS];
+    SDL_PrecacheBulk  sBulk;
+    SDL_PrecacheItem *pItem      = NULL;
+    Uint64            iStart     = SDL_GetPerformanceCounter( );
+    Uint64            iItemStart = 0;
+    Uint64            iDecoded   = 0;
+    Uint64            iUploaded  = 0;
+    Uint64            iSerial    = 0;
+    double            dToMs      = 1000.0 / (double) SDL_GetPerformanceFrequency( );
+    Uint32            iNbDecodes = 0;
+    Uint32            iNbThreads = 0;
+    Uint32            iNbLoaded  = 0;
+    SDL_bool          bTaken     = SDL_FALSE;
+    Uint32            i          = 0;
+    Uint32            j          = 0;
+
+    if (pArrTaken)
+    {
+        memset(pArrTaken, 0, sizeof(SDL_bool) * iNbAssets);
+    }
+
+    sBulk.pArrItems = (SDL_PrecacheItem *) UTIL_Malloc(sizeof(SDL_PrecacheItem) * COM_Math_Max(iNbAssets, 1));
+    sBulk.iNbItems  = iNbAssets;
+
+    if (!sBulk.pArrItems)
+    {
+        return 0;
+    }
+
+    SDL_AtomicSet(&sBulk.iNext, 0);
+    memset(sBulk.pArrItems, 0, sizeof(SDL_PrecacheItem) * iNbAssets);
+
+    /* ~~~ Only the assets not precached yet are decoded, once ~~~ */
+    for (i = 0 ; i < iNbAssets ; ++i)
     {
-        pSprName = SDL_Sprite_GetName(SDL_precache.pArrSprites[iNumSprite]);
+        pItem         = &sBulk.pArrItems[i];
+        pItem->iType  = pArrAssets[i].iType;
+        pItem->szName = pArrAssets[i].szName;
+        pItem->iHash  = SDL_Precache_Hash(pItem->iType, pItem->szName);
+
+        for (j = 0 ; (j < i) && !pItem->bDuplicate ; ++j)
+        {
+            pItem->bDuplicate = ((sBulk.pArrItems[j].iHash == pItem->iHash) &&
+                                 (sBulk.pArrItems[j].iType == pItem->iType) &&
+                                 (strcmp(sBulk.pArrItems[j].szName, pItem->szName) == 0)) ? SDL_TRUE : SDL_FALSE;
+        }
 
-        if (strcmp(pSprName, szSprName) == 0)
+        if (!pItem->bDuplicate && (SDL_Precache_Find(pItem->iType, pItem->szName, pItem->iHash) == SDL_PRECACHE_INVALID))
         {
-            pSprite = SDL_precache.pArrSprites[iNumSprite];
-        }        
+            pItem->szPath = SDL_Precache_GetPath(pItem->iType, pItem->szName);
+            iNbDecodes   += pItem->szPath ? 1 : 0;
+        }
     }
-    
-    /* If the sprite is not in the precache */
-    if (pSprite == NULL)
+
+    /* ~~~ Decode: the caller works with the pool ~~~ */
+    iNbThreads = COM_Math_Min((Uint32) COM_Math_Max(SDL_GetCPUCount( ), 1), COM_Math_Max(iNbDecodes, 1));
+    iNbThreads = COM_Math_Min(iNbThreads, SDL_PRECACHE_BULK_THREADS);
+
+    for (i = 1 ; i < iNbThreads ; ++i)
+    {
+        arrThreads[i] = SDL_CreateThread(SDL_Precache_BulkWorker, "precache_bulk", &sBulk);
+    }
+
+    SDL_Precache_BulkWorker(&sBulk);
+
+    for (i = 1 ; i < iNbThreads ; ++i)
+    {
+        if (arrThreads[i])
+        {
+            SDL_WaitThread(arrThreads[i], NULL);
+        }
+    }
+
+    iDecoded = SDL_GetPerformanceCounter( );
+
+    /* ~~~ Upload and index, in the order of the list ~~~ */
+    for (i = 0 ; i < iNbAssets ; ++i)
+    {
+        pItem = &sBulk.pArrItems[i];
+
+        if (pItem->szPath)
+        {
+            iItemStart          = SDL_GetPerformanceCounter( );
+            bTaken              = SDL_Precache_AddAsset(pItem->iType, SDL_Precache_BulkUpload(pItem), pItem->iHash) ? SDL_TRUE : SDL_FALSE;
+            pItem->iUploadTicks = SDL_GetPerformanceCounter( ) - iItemStart;
+            iSerial            += pItem->iDecodeTicks;
+
+            COM_Log_Print(COM_LOG_INFO, ">> %-6s %-24s decode %8.3f ms, upload %8.3f ms.",
+                          SDL_precacheTypes[pItem->iType], pItem->szName,
+                          (double) pItem->iDecodeTicks * dToMs, (double) pItem->iUploadTicks * dToMs);
+
+            UTIL_Free(pItem->szPath);
+        }
+        else
+        {
+            bTaken = SDL_Precache_AddRef(pItem->iType, pItem->szName, pItem->iHash) ? SDL_TRUE : SDL_FALSE;
+        }
+
+        iNbLoaded += bTaken ? 1 : 0;
+
+        if (pArrTaken)
+        {
+            pArrTaken[i] = bTaken;
+        }
+    }
+
+    iUploaded = SDL_GetPerformanceCounter( );
+
+    COM_Log_Print(COM_LOG_INFO, "Bulk precache: %d/%d assets, %d decoded by %d threads in %.3f ms (%.3f ms serial), uploaded in %.3f ms.",
+                  iNbLoaded, iNbAssets, iNbDecodes, iNbThreads,
+                  (double) (iDecoded - iStart) * dToMs, (double) iSerial * dToMs, (double) (iUploaded - iDecoded) * dToMs);
+
+    UTIL_Free(sBulk.pArrItems);
+
+    return iNbLoaded;
+}
+
+/*!
+ * \brief  Function to precache a sprite in the background.
+ *
+ * \param  szSprName Name of the sprite.
+ * \param  pCallback Function to call when the sprite is ready (Can be NULL).
+ * \param  pData     Data given to the function.
+ * \return A pointer to the sprite, pending until its upload, or NULL if error.
+ *
+ * \remark The file is read and decoded by a worker, then the sheet is uploaded
+ *         by SDL_Precache_Update. A pending sprite draws nothing. The callback
+ *         is called at once if the sprite is already loaded, and must not
+ *         release the sprite. Each call adds a reference to the sprite.
+ */
+SDL_Sprite *SDL_Precache_SpriteAsync(const char *szSprName, SDL_PrecacheCallback pCallback, void *pData)
+{
+    SDL_PrecacheEntry *pEntry  = NULL;
+    SDL_PrecacheJob   *pJob    = NULL;
+    SDL_Sprite        *pSprite = NULL;
+    SDL_PrecacheEntry  sEntry;
+    Uint32             iHash   = SDL_Precache_Hash(SDL_PRECACHE_SPRITE, szSprName);
+    Uint32             iSlot   = SDL_Precache_Find(SDL_PRECACHE_SPRITE, szSprName, iHash);
+
+    /* ~~~ Already precached or being streamed ~~~ */
+    if (iSlot != SDL_PRECACHE_INVALID)
+    {
+        pEntry = &SDL_precache.pArrSlots[iSlot];
+        pEntry->iRefs++;
+
+        if (pEntry->pJob)
+        {
+            SDL_Precache_AddWaiter(pEntry->pJob, pCallback, pData);
+        }
+        else if (pCallback)
+        {
+            pCallback((SDL_Sprite *) pEntry->pAsset, SDL_Sprite_IsLoaded((SDL_Sprite *) pEntry->pAsset), pData);
+        }
+
+        return (SDL_Sprite *) pEntry->pAsset;
+    }
+
+    /* ~~~ No worker: load it now ~~~ */
+    if (!SDL_Precache_StartWorker( ))
+    {
+        pSprite = SDL_Precache_Sprite(szSprName);
+
+        if (pSprite && pCallback)
+        {
+            pCallback(pSprite, SDL_TRUE, pData);
+        }
+
+        return pSprite;
+    }
+
+    pJob = (SDL_PrecacheJob *) UTIL_Malloc(sizeof(SDL_PrecacheJob));
+
+    if (pJob)
     {
-        pSprite = SDL_Sprite_Alloc(szSprName);
-        
-        if (pSprite)
+        memset(pJob, 0, sizeof(SDL_PrecacheJob));
+
+        pJob->szPath  = SDL_Precache_GetPath(SDL_PRECACHE_SPRITE, szSprName);
+        pJob->pSprite = SDL_Sprite_AllocPending(szSprName);
+
+        sEntry.pAsset = pJob->pSprite;
+        sEntry.szName = pJob->pSprite ? SDL_Sprite_GetName(pJob->pSprite) : NULL;
+        sEntry.iHash  = iHash;
+        sEntry.iRefs  = 1;
+        sEntry.iBytes = 0;
+        sEntry.iType  = SDL_PRECACHE_SPRITE;
+        sEntry.pJob   = pJob;
+
+        if (pJob->szPath && pJob->pSprite && SDL_Precache_Insert(&sEntry))
         {
-            iNewSize                 = sizeof(SDL_Sprite *) * (SDL_precache.iNbSprites + 1);
-            SDL_precache.pArrSprites = (SDL_Sprite **) UTIL_Realloc(SDL_precache.pArrSprites, iNewSize);
-            
-            if (SDL_precache.pArrSprites)
+            SDL_Precache_AddWaiter(pJob, pCallback, pData);
+            pSprite = pJob->pSprite;
+
+            /* ~~~ A new load screen starts when the previous one is over ~~~ */
+            if (SDL_precache.iNbFinished == SDL_precache.iNbQueued)
             {
-                SDL_precache.pArrSprites[SDL_precache.iNbSprites] = pSprite;
-                SDL_precache.iNbSprites++;
+                SDL_precache.iNbQueued   = 0;
+                SDL_precache.iNbFinished = 0;
+            }
+
+            SDL_precache.iNbQueued++;
 
-                COM_Log_Print(COM_LOG_INFO, "Precache sprite: \"%s\".", szSprName);
+            SDL_LockMutex(SDL_precache.pMutex);
+            SDL_Precache_Push(&SDL_precache.sTodo, pJob);
+            SDL_CondSignal(SDL_precache.pCondTodo);
+            SDL_UnlockMutex(SDL_precache.pMutex);
+        }
+        else // Error: must free...
+        {
+            if (pJob->pSprite)
+            {
+                SDL_Sprite_Free(&pJob->pSprite);
             }
+
+            SDL_Precache_FreeJob(pJob);
         }
     }
-    
+
     return pSprite;
 }
- 
+
 /*!
- * \brief  Function to precache a sound.
+ * \brief  Function to upload the sprites decoded by the worker.
  *
- * \param  szSndName Name of the sound.
- * \return A pointer to the loaded sound, or NULL if error.
+ * \param  iMaxUploads Maximum number of sheets uploaded (See SDL_PRECACHE_UPLOADS).
+ * \return None.
+ *
+ * \remark Called once per frame by the thread of the renderer, it bounds the
+ *         time spent creating the textures. The callbacks are called here.
+ *
+ * \remark Each update starts a new frame for the last use of the assets,
+ *         then evicts the assets used the longest time ago if the memory is
+ *         over the budget (See SDL_Precache_SetBudget).
  */
-SDL_Sound *SDL_Precache_Sound(const char *szSndName)
+void SDL_Precache_Update(Uint32 iMaxUploads)
 {
-    const char *pSndName  = NULL;
-    SDL_Sound  *pSound    = NULL;
-    Uint32      iNumSound = 0;
-    Uint32      iNewSize  = 0;
- 
-    /* Check if the sound has already been precached */
-    for (iNumSound = 0 ; iNumSound < SDL_precache.iNbSounds ; ++iNumSound)
+    SDL_PrecacheJob *pJob      = NULL;
+    Uint64           iResident = 0;
+    Uint32           i         = 0;
+
+    COM_PROF_BEGIN("SDL_Precache_Update");
+
+    for (i = 0 ; SDL_precache.pThread && (i < iMaxUploads) ; ++i)
     {
-        pSndName = SDL_Sound_GetName(SDL_precache.pArrSounds[iNumSound]);
+        SDL_LockMutex(SDL_precache.pMutex);
+        pJob = SDL_Precache_Pop(&SDL_precache.sDone, NULL);
+        SDL_UnlockMutex(SDL_precache.pMutex);
 
-        if (strcmp(pSndName, szSndName) == 0)
+        if (!pJob)
         {
-            pSound = SDL_precache.pArrSounds[iNumSound];
+            break;
         }
+
+        SDL_Precache_Finish(pJob);
     }
-    
-    /* If the sound is not in the precache */
-    if (pSound == NULL)
+
+    iResident                 = SDL_precache.iAssetBytes + SDL_Atlas_GetBytes( );
+    SDL_precache.sStats.iPeak = COM_Math_Max(SDL_precache.sStats.iPeak, iResident);
+
+    SDL_precache.iClock++;
+    SDL_Sprite_SetClock(SDL_precache.iClock);
+    SDL_Sound_SetClock(SDL_precache.iClock);
+
+    SDL_Precache_Evict( );
+
+    COM_PROF_END( );
+}
+
+/*!
+ * \brief  Function to get the progress of the sprites streamed.
+ *
+ * \param  pNbDone  Pointer to retrieve the number of sprites ready (Can be NULL).
+ * \param  pNbTotal Pointer to retrieve the number of sprites streamed (Can be NULL).
+ * \return The progress, from 0.0 to 1.0 (1.0 if nothing is streamed).
+ *
+ * \remark The counts start again from zero with the first sprite streamed
+ *         after all the previous ones are ready.
+ */
+float SDL_Precache_GetProgress(Uint32 *pNbDone, Uint32 *pNbTotal)
+{
+    if (pNbDone)
     {
-        pSound = SDL_Sound_Alloc(szSndName);
- 
-        if (pSound)
+        *pNbDone = SDL_precache.iNbFinished;
+    }
+
+    if (pNbTotal)
+    {
+        *pNbTotal = SDL_precache.iNbQueued;
+    }
+
+    return SDL_precache.iNbQueued ? ((float) SDL_precache.iNbFinished / (float) SDL_precache.iNbQueued) : 1.0f;
+}
+
+/*!
+ * \brief  Function to release a reference to an asset.
+ *
+ * \param  iType  Type of the asset.
+ * \param  szName Name of the asset.
+ * \return None.
+ *
+ * \remark The asset is freed with its last reference. The space of a sprite
+ *         in the atlas is given back when its page is evicted (See
+ *         SDL_Precache_SetBudget), or by SDL_Precache_Free.
+ */
+void SDL_Precache_Release(SDL_PrecacheType iType, const char *szName)
+{
+    SDL_PrecacheEntry sEntry;
+    Uint32            iSlot = SDL_Precache_Find(iType, szName, SDL_Precache_Hash(iType, szName));
+
+    if (iSlot == SDL_PRECACHE_INVALID)
+    {
+        COM_Log_Print(COM_LOG_WARNING, "Release of a %s not precached: \"%s\" !", SDL_precacheTypes[iType], szName);
+        return;
+    }
+
+    if (--SDL_precache.pArrSlots[iSlot].iRefs == 0)
+    {
+        sEntry = SDL_precache.pArrSlots[iSlot];
+        SDL_Precache_Remove(iSlot);
+
+        COM_Log_Print(COM_LOG_INFO, "Unload %s: \"%s\".", SDL_precacheTypes[iType], szName);
+
+        if (!sEntry.pJob)
         {
-            iNewSize                = sizeof(SDL_Sound *) * (SDL_precache.iNbSounds + 1);
-            SDL_precache.pArrSounds = (SDL_Sound **) UTIL_Realloc(SDL_precache.pArrSounds, iNewSize);
-            
-            if (SDL_precache.pArrSounds)
+            SDL_Precache_FreeAsset(&sEntry);
+        }
+        else
+        {
+            /* ~~~ Still streamed: dropped now if not started, else at its upload ~~~ */
+            SDL_LockMutex(SDL_precache.pMutex);
+            sEntry.pJob->bCancelled = SDL_TRUE;
+
+            if (SDL_Precache_Pop(&SDL_precache.sTodo, sEntry.pJob))
             {
-                SDL_precache.pArrSounds[SDL_precache.iNbSounds] = pSound;
-                SDL_precache.iNbSounds++;
-                
-                COM_Log_Print(COM_LOG_INFO, "Precache sound: \"%s\".", szSndName);
+                SDL_Precache_Push(&SDL_precache.sDone, sEntry.pJob);
             }
+
+            SDL_UnlockMutex(SDL_precache.pMutex);
         }
     }
- 
-    return pSound;
+}
+
+/*!
+ * \brief  Function to release the references of a bulk precache.
+ *
+ * \param  pArrAssets Array of the assets (The one given to SDL_Precache_Bulk).
+ * \param  iNbAssets  Number of assets.
+ * \param  pArrTaken  Array of the references taken (Filled by SDL_Precache_Bulk).
+ * \return None.
+ *
+ * \remark Only the references taken by the bulk are released, so an asset
+ *         which failed then was loaded by another caller keeps its references.
+ *         A caller which takes its own reference on each asset used (A warm
+ *         up) releases the bulk references once it holds them.
+ */
+void SDL_Precache_ReleaseBulk(const SDL_PrecacheAsset *pArrAssets, Uint32 iNbAssets, const SDL_bool *pArrTaken)
+{
+    Uint32 i = 0;
+
+    for (i = 0 ; i < iNbAssets ; ++i)
+    {
+        if (pArrTaken[i])
+        {
+            SDL_Precache_Release(pArrAssets[i].iType, pArrAssets[i].szName);
+        }
+    }
+}
+
+/*!
+ * \brief  Function to set the memory budget of the assets.
+ *
+ * \param  iBytes Memory allowed for the textures and the chunks (0 => No budget, in bytes).
+ * \return None.
+ *
+ * \remark The memory is estimated from the size of the textures (4 bytes a
+ *         pixel, a whole page for the atlas) and of the samples. Over the
+ *         budget, SDL_Precache_Update evicts the assets used the longest time
+ *         ago, and an evicted asset is loaded again by its next draw or play.
+ */
+void SDL_Precache_SetBudget(Uint64 iBytes)
+{
+    SDL_precache.sStats.iBudget = iBytes;
+    SDL_precache.bOverBudget    = SDL_FALSE;
+
+    COM_Log_Print(COM_LOG_INFO, "Precache budget: %d MB.", (int) (iBytes >> 20));
+}
+
+/*!
+ * \brief  Function to get the memory of the assets precached.
+ *
+ * \param  pStats Pointer to retrieve the budget and the statistics.
+ * \return None.
+ */
+void SDL_Precache_GetStats(SDL_PrecacheStats *pStats)
+{
+    *pStats           = SDL_precache.sStats;
+    pStats->iResident = SDL_precache.iAssetBytes + SDL_Atlas_GetBytes( );
 }
  
 /*!
@@ -150,30 +1665,71 @@ SDL_Sound *SDL_Precache_Sound(const char *szSndName)
  */
 void SDL_Precache_Free(void)
 {
-    Uint32 iNumSprite = 0;
-    Uint32 iNumSound  = 0;
-    
-    if (SDL_precache.pArrSprites)
+    SDL_PrecacheJob *pJob = NULL;
+    Uint32           i    = 0;
+
+    /* ~~~ Stop the worker, then drop the sprites not uploaded ~~~ */
+    if (SDL_precache.pThread)
     {
-        for (iNumSprite = 0 ; iNumSprite < SDL_precache.iNbSprites ; ++iNumSprite)
+        SDL_LockMutex(SDL_precache.pMutex);
+        SDL_precache.bQuit = SDL_TRUE;
+        SDL_CondSignal(SDL_precache.pCondTodo);
+        SDL_UnlockMutex(SDL_precache.pMutex);
+
+        SDL_WaitThread(SDL_precache.pThread, NULL);
+
+        while ((pJob = SDL_Precache_Pop(&SDL_precache.sTodo, NULL)) || (pJob = SDL_Precache_Pop(&SDL_precache.sDone, NULL)))
         {
-            SDL_Sprite_Free(&SDL_precache.pArrSprites[iNumSprite]);
+            /* ~~~ A pending sprite still indexed is freed with the index ~~~ */
+            if (pJob->bCancelled)
+            {
+                SDL_Sprite_Free(&pJob->pSprite);
+            }
+
+            SDL_Precache_FreeJob(pJob);
         }
-        
-        SDL_precache.iNbSprites = 0;
-        UTIL_Free(SDL_precache.pArrSprites);
+
+        SDL_DestroyCond(SDL_precache.pCondDone);
+        SDL_DestroyCond(SDL_precache.pCondTodo);
+        SDL_DestroyMutex(SDL_precache.pMutex);
+
+        SDL_precache.pThread   = NULL;
+        SDL_precache.pCondDone = NULL;
+        SDL_precache.pCondTodo = NULL;
+        SDL_precache.pMutex    = NULL;
     }
- 
-    if (SDL_precache.pArrSounds)
+
+    COM_Log_Print(COM_LOG_INFO, "Precache: %d sprites, %d sounds and %d fonts still loaded.",
+                  SDL_precache.arrNbAssets[SDL_PRECACHE_SPRITE], SDL_precache.arrNbAssets[SDL_PRECACHE_SOUND],
+                  SDL_precache.arrNbAssets[SDL_PRECACHE_FONT]);
+
+    COM_Log_Print(COM_LOG_INFO, "Precache memory: peak %d MB, %d evictions (%d MB), %d reloads.",
+                  (int) (SDL_precache.sStats.iPeak >> 20), SDL_precache.sStats.iNbEvictions,
+                  (int) (SDL_precache.sStats.iEvicted >> 20), SDL_precache.sStats.iNbReloads);
+
+    SDL_Sprite_SetReloadHook(NULL);
+    SDL_Sound_SetReloadHook(NULL);
+
+    for (i = 0 ; i < SDL_precache.iNbSlots ; ++i)
     {
-        for (iNumSound = 0 ; iNumSound < SDL_precache.iNbSounds ; ++iNumSound)
+        if (SDL_precache.pArrSlots[i].pAsset)
         {
-            SDL_Sound_Free(&SDL_precache.pArrSounds[iNumSound]);
+            SDL_Precache_FreeAsset(&SDL_precache.pArrSlots[i]);
         }
- 
-        SDL_precache.iNbSounds = 0;
-        UTIL_Free(SDL_precache.pArrSounds);
     }
+
+    UTIL_Free(SDL_precache.pArrSlots);
+    UTIL_Free(SDL_precache.pArrVictims);
+    SDL_precache.iNbSlots    = 0;
+    SDL_precache.iNbEntries  = 0;
+    SDL_precache.iMaxVictims = 0;
+    SDL_precache.iAssetBytes = 0;
+
+    memset(SDL_precache.arrNbAssets, 0, sizeof(SDL_precache.arrNbAssets));
+
+    /* ~~~ The sprites do not use the atlas anymore ~~~ */
+    SDL_Atlas_Report( );
+    SDL_Atlas_Free( );
 }
 
 /* ========================================================================= */
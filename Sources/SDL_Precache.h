@@ -11,17 +11,78 @@
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 15/06/15 | Creation.                                            */
 /* Red     | 16/06/15 | Dev basics functions                                 */
+/* Nyuu    | 18/10/26 | Hash index of the assets, refcounts & release.       */
+/* Nyuu    | 18/10/26 | Stream the sprites with a worker and upload them.    */
+/* Nyuu    | 18/10/26 | Add the fonts and the bulk precache.                 */
+/* Nyuu    | 18/10/26 | Memory budget with LRU eviction of the assets.       */
+/* Nyuu    | 18/10/26 | Release the references of a bulk precache.           */
+/* Nyuu    | 18/10/26 | Release only the references taken by the bulk.       */
 /* ========================================================================= */
  
 #ifndef __SDL_PRECACHE_H__
 #define __SDL_PRECACHE_H__
  
+    #include "SDL_Font.h"
     #include "SDL_Sprite.h"
     #include "SDL_Sound.h"
+
+    /*!
+     * \enum  SDL_PrecacheType
+     * \brief Enumeration of the types of assets precached.
+     */
+    typedef enum
+    {
+        SDL_PRECACHE_SPRITE = 0, /*!< Sprite. */
+        SDL_PRECACHE_SOUND,      /*!< Sound. */
+        SDL_PRECACHE_FONT,       /*!< Font (Named with its size, "codenewroman:30"). */
+        SDL_PRECACHE_MAX         /*!< Number of types. */
+    } SDL_PrecacheType;
+
+    /*!
+     * \struct SDL_PrecacheAsset
+     * \brief  Structure to name an asset to precache in bulk.
+     */
+    typedef struct
+    {
+        SDL_PrecacheType  iType;  /*!< Type of the asset. */
+        const char       *szName; /*!< Name of the asset. */
+    } SDL_PrecacheAsset;
+
+    /*! Maximum number of threads decoding a bulk precache (The caller included). */
+    #define SDL_PRECACHE_BULK_THREADS 16
+
+    /*! Default number of sheets uploaded by each update of the precache. */
+    #define SDL_PRECACHE_UPLOADS 4
+
+    /*!
+     * \struct SDL_PrecacheStats
+     * \brief  Structure to handle the memory of the assets precached.
+     */
+    typedef struct
+    {
+        Uint64 iBudget;      /*!< Budget of the textures and the chunks (0 => None, in bytes). */
+        Uint64 iResident;    /*!< Memory of the textures and the chunks loaded (In bytes). */
+        Uint64 iPeak;        /*!< Highest memory loaded at the end of an update (In bytes). */
+        Uint64 iEvicted;     /*!< Memory freed by the evictions (In bytes). */
+        Uint32 iNbEvictions; /*!< Number of assets (Or atlas pages) evicted. */
+        Uint32 iNbReloads;   /*!< Number of assets loaded again after their eviction. */
+    } SDL_PrecacheStats;
+
+    /*! Callback called when a sprite streamed is ready (Loaded or not). */
+    typedef void (*SDL_PrecacheCallback)(SDL_Sprite *pSprite, SDL_bool bLoaded, void *pData);
     
     void        SDL_Precache_Init(void);
     SDL_Sprite *SDL_Precache_Sprite(const char *szSprName);
     SDL_Sound  *SDL_Precache_Sound(const char *szSndName);
+    SDL_Font   *SDL_Precache_Font(const char *szFontName);
+    Uint32      SDL_Precache_Bulk(const SDL_PrecacheAsset *pArrAssets, Uint32 iNbAssets, SDL_bool *pArrTaken);
+    SDL_Sprite *SDL_Precache_SpriteAsync(const char *szSprName, SDL_PrecacheCallback pCallback, void *pData);
+    void        SDL_Precache_Update(Uint32 iMaxUploads);
+    float       SDL_Precache_GetProgress(Uint32 *pNbDone, Uint32 *pNbTotal);
+    void        SDL_Precache_Release(SDL_PrecacheType iType, const char *szName);
+    void        SDL_Precache_ReleaseBulk(const SDL_PrecacheAsset *pArrAssets, Uint32 iNbAssets, const SDL_bool *pArrTaken);
+    void        SDL_Precache_SetBudget(Uint64 iBytes);
+    void        SDL_Precache_GetStats(SDL_PrecacheStats *pStats);
     void        SDL_Precache_Free(void);
 
 #endif // __SDL_PRECACHE_H__
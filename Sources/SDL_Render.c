@@ -10,20 +10,124 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 26/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add the render target textures.                      */
+/* Nyuu    | 18/10/26 | Batch the textured quads with SDL_RenderGeometry.    */
+/* Nyuu    | 18/10/26 | Add the static textures for the atlas.               */
+/* Nyuu    | 18/10/26 | Count the draw calls submitted to the renderer.      */
+/* Nyuu    | 18/10/26 | Add the statistics of the frames.                    */
+/* Nyuu    | 18/10/26 | Queue the primitives and track the draw color.       */
+/* Nyuu    | 18/10/26 | Add the profiler zone of the present.                */
+/* Nyuu    | 18/10/26 | Count the textures created in the frame loop.        */
+/* Nyuu    | 18/10/26 | Count the losses of the render targets.              */
+/* Nyuu    | 18/10/26 | Flush the primitives before a direct texture copy.   */
+/* Nyuu    | 18/10/26 | Check the modulation of the textures for each quad.  */
+/* Nyuu    | 18/10/26 | Draw the waiting lines in one geometry call.         */
 /* ========================================================================= */
 
 #include "SDL_Render.h"
 
 /* ========================================================================= */
 
+#if SDL_VERSION_ATLEAST(2,0,18)
+    /*! Flag set if the textured quads are batched (SDL_RenderGeometry). */
+    #define SDL_RENDER_BATCH 1
+#else
+    /*! Flag set if the textured quads are batched (SDL_RenderGeometry). */
+    #define SDL_RENDER_BATCH 0
+#endif
+
+/*! Maximum number of quads in a batch. */
+#define SDL_RENDER_BATCH_QUADS 1024
+
+/*! Maximum number of points, polylines or rectangles waiting to be drawn. */
+#define SDL_RENDER_PRIMS_MAX    1024
+
+/*! Number of frames of the rolling averages of the statistics. */
+#define SDL_RENDER_STATS_FRAMES 60
+
+/*! Factor to convert degrees to radians. */
+#define SDL_RENDER_DEG_TO_RAD  0.017453292519943295
+
+/* ========================================================================= */
+
+#if SDL_RENDER_BATCH
+/*!
+ * \struct SDL_RenderBatch
+ * \brief  Structure to handle the quads waiting to be drawn with the same texture.
+ */
+typedef struct
+{
+    SDL_bool     bEnabled;                                     /*!< Flag set if the renderer draws the geometry. */
+    SDL_Texture *pTexture;                                     /*!< Pointer to the texture of the quads. */
+    float        fInvW;                                        /*!< Inverse of the texture width. */
+    float        fInvH;                                        /*!< Inverse of the texture height. */
+    Uint32       iNbQuads;                                     /*!< Number of quads waiting. */
+    SDL_Vertex   arrVertices[SDL_RENDER_BATCH_QUADS * 4];      /*!< Vertices of the quads. */
+    int          arrIndices[SDL_RENDER_BATCH_QUADS * 6];       /*!< Indices of the quads (Two triangles each). */
+} SDL_RenderBatch;
+#endif
+
+/*!
+ * \enum  SDL_RenderPrimType
+ * \brief Enumeration of the types of primitives waiting to be drawn.
+ */
+typedef enum
+{
+    SDL_RENDER_PRIM_NONE        = 0, /*!< Value 'No primitive waiting'. */
+    SDL_RENDER_PRIM_POINTS      = 1, /*!< Value 'Points'. */
+    SDL_RENDER_PRIM_LINES       = 2, /*!< Value 'Polylines'. */
+    SDL_RENDER_PRIM_FULL_RECTS  = 3, /*!< Value 'Full rectangles'. */
+    SDL_RENDER_PRIM_EMPTY_RECTS = 4, /*!< Value 'Empty rectangles'. */
+} SDL_RenderPrimType;
+
+/*!
+ * \struct SDL_RenderPrims
+ * \brief  Structure to handle the primitives waiting to be drawn with the same type and color.
+ */
+typedef struct
+{
+    SDL_RenderPrimType iType;                           /*!< Type of the primitives. */
+    SDL_Color          sColor;                          /*!< Color of the primitives. */
+    Uint32             iNbPoints;                       /*!< Number of points waiting. */
+    Uint32             iNbRuns;                         /*!< Number of polylines waiting. */
+    Uint32             iNbRects;                        /*!< Number of rectangles waiting. */
+    SDL_Point          arrPoints[SDL_RENDER_PRIMS_MAX]; /*!< Points (Of the polylines for the lines). */
+    Uint32             arrRuns[SDL_RENDER_PRIMS_MAX];   /*!< Number of points of each polyline. */
+    SDL_Rect           arrRects[SDL_RENDER_PRIMS_MAX];  /*!< Rectangles. */
+} SDL_RenderPrims;
+
+/*!
+ * \struct SDL_RenderHistory
+ * \brief  Structure to handle the statistics of the last frames.
+ */
+typedef struct
+{
+    SDL_RenderStats arrFrames[SDL_RENDER_STATS_FRAMES]; /*!< Statistics of the last frames (Ring). */
+    SDL_RenderStats sSum;                               /*!< Sum of the statistics of the ring. */
+    Uint32          iNext;                              /*!< Index of the next frame in the ring. */
+    Uint32          iNbFrames;                          /*!< Number of frames in the ring. */
+} SDL_RenderHistory;
+
 /*!
  * \struct SDL_Render
  * \brief  Structure to handle the render.
  */
 typedef struct
 {
-    SDL_Renderer *pRenderer;  /*!< Pointer to the renderer. */ 
-    SDL_Color     sColor;     /*!< Color of the renderer. */
+    SDL_Renderer      *pRenderer;    /*!< Pointer to the renderer. */ 
+    SDL_Color          sColor;       /*!< Color of the renderer. */
+    SDL_Rect           sViewport;    /*!< Viewport of the window (Lost when the target changes). */
+    SDL_bool           bViewport;    /*!< Flag set if a viewport is set on the window. */
+    SDL_Texture       *pLastTexture; /*!< Pointer to the last texture drawn. */
+    SDL_Color          sDrawColor;   /*!< Color of the renderer for the primitives. */
+    SDL_bool           bDrawColor;   /*!< Flag set if the color of the renderer is known. */
+    SDL_RenderPrims    sPrims;       /*!< Primitives waiting to be drawn. */
+    SDL_RenderStats    sFrame;       /*!< Statistics of the current frame. */
+    SDL_RenderHistory  sHistory;     /*!< Statistics of the last frames. */
+    SDL_atomic_t       iNbResets;    /*!< Number of times the render targets were lost. */
+#if SDL_RENDER_BATCH
+    SDL_RenderBatch    sBatch;       /*!< Batch of the textured quads. */
+#endif
 } SDL_Render;
 
 /*! Global variable to handle the render. */
@@ -31,6 +135,557 @@ static SDL_Render SDL_render;
 
 /* ========================================================================= */
 
+/*!
+ * \brief Function to count the losses of the render targets.
+ *
+ * \param pData  Unused.
+ * \param pEvent Pointer to the event.
+ * \return 0 (Ignored by a watch).
+ *
+ * \remark Called by the thread which pushes the event.
+ */
+static int SDLCALL SDL_Render_WatchEvent(void *pData, SDL_Event *pEvent)
+{
+    (void) pData;
+
+    if ((pEvent->type == SDL_RENDER_TARGETS_RESET) || (pEvent->type == SDL_RENDER_DEVICE_RESET))
+    {
+        SDL_AtomicAdd(&SDL_render.iNbResets, 1);
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Function to set the color of the primitives.
+ *
+ * \param pColor Pointer to the color.
+ * \return None.
+ *
+ * \remark The color of the renderer is tracked, so setting the same color
+ *         again does nothing.
+ */
+static void SDL_Render_SetDrawColor(const SDL_Color *pColor)
+{
+    SDL_Color *pDrawColor = &SDL_render.sDrawColor;
+
+    if (SDL_render.bDrawColor && (pDrawColor->r == pColor->r) && (pDrawColor->g == pColor->g) &&
+                                 (pDrawColor->b == pColor->b) && (pDrawColor->a == pColor->a))
+    {
+        return;
+    }
+
+    SDL_render.sFrame.iColorChanges++;
+    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
+
+    *pDrawColor           = *pColor;
+    SDL_render.bDrawColor = SDL_TRUE;
+}
+
+/*!
+ * \brief Function to count a texture drawn in the statistics.
+ *
+ * \param pTexture Pointer to the texture.
+ * \param pPos     Pointer to the rectangle of the texture (NULL => The viewport).
+ * \return None.
+ */
+static void SDL_Render_CountTexture(SDL_Texture *pTexture, const SDL_Rect *pPos)
+{
+    SDL_Rect sViewport;
+
+    if (pTexture != SDL_render.pLastTexture)
+    {
+        SDL_render.sFrame.iTextureSwitches++;
+        SDL_render.pLastTexture = pTexture;
+    }
+
+    if (!pPos)
+    {
+        SDL_RenderGetViewport(SDL_render.pRenderer, &sViewport);
+        pPos = &sViewport;
+    }
+
+    SDL_render.sFrame.iPixels += (Uint64) pPos->w * (Uint64) pPos->h;
+}
+
+/*!
+ * \brief Function to get the pixels covered by a rectangle.
+ *
+ * \param pRect Pointer to the rectangle (NULL => The viewport).
+ * \param bFull SDL_TRUE for a full rectangle, SDL_FALSE for its outline.
+ * \return The number of pixels.
+ */
+static Uint64 SDL_Render_GetRectArea(const SDL_Rect *pRect, SDL_bool bFull)
+{
+    SDL_Rect sViewport;
+
+    if (!pRect)
+    {
+        SDL_RenderGetViewport(SDL_render.pRenderer, &sViewport);
+        pRect = &sViewport;
+    }
+
+    if ((pRect->w <= 0) || (pRect->h <= 0))
+    {
+        return 0;
+    }
+
+    if (bFull || (pRect->w <= 2) || (pRect->h <= 2))
+    {
+        return (Uint64) pRect->w * (Uint64) pRect->h;
+    }
+
+    return (Uint64) (2 * (pRect->w + pRect->h) - 4);
+}
+
+/*!
+ * \brief Function to get the pixels covered by rectangles.
+ *
+ * \param arrRect  Pointer to an array of rectangles.
+ * \param iNbRects Number of rectangles.
+ * \param bFull    SDL_TRUE for full rectangles, SDL_FALSE for their outlines.
+ * \return The number of pixels.
+ */
+static Uint64 SDL_Render_GetRectsArea(const SDL_Rect *arrRect, Uint32 iNbRects, SDL_bool bFull)
+{
+    Uint64 iPixels = 0;
+    Uint32 i       = 0;
+
+    for (i = 0 ; i < iNbRects ; ++i)
+    {
+        iPixels += SDL_Render_GetRectArea(&arrRect[i], bFull);
+    }
+
+    return iPixels;
+}
+
+/*!
+ * \brief Function to add the statistics of a frame to the history.
+ *
+ * \param pFrame Pointer to the statistics of the frame.
+ * \return None.
+ */
+static void SDL_Render_PushStats(const SDL_RenderStats *pFrame)
+{
+    SDL_RenderHistory *pHistory = &SDL_render.sHistory;
+    SDL_RenderStats   *pOldest  = &pHistory->arrFrames[pHistory->iNext];
+
+    if (pHistory->iNbFrames == SDL_RENDER_STATS_FRAMES)
+    {
+        pHistory->sSum.iDrawCalls       -= pOldest->iDrawCalls;
+        pHistory->sSum.iTextureSwitches -= pOldest->iTextureSwitches;
+        pHistory->sSum.iColorChanges    -= pOldest->iColorChanges;
+        pHistory->sSum.iTexturesCreated -= pOldest->iTexturesCreated;
+        pHistory->sSum.iPixels          -= pOldest->iPixels;
+    }
+    else
+    {
+        pHistory->iNbFrames++;
+    }
+
+    *pOldest = *pFrame;
+
+    pHistory->sSum.iDrawCalls       += pFrame->iDrawCalls;
+    pHistory->sSum.iTextureSwitches += pFrame->iTextureSwitches;
+    pHistory->sSum.iColorChanges    += pFrame->iColorChanges;
+    pHistory->sSum.iTexturesCreated += pFrame->iTexturesCreated;
+    pHistory->sSum.iPixels          += pFrame->iPixels;
+
+    pHistory->iNext = (pHistory->iNext + 1) % SDL_RENDER_STATS_FRAMES;
+}
+
+/*!
+ * \brief Function to draw the quads waiting in the batch.
+ *
+ * \return None
+ */
+static void SDL_Render_FlushQuads(void)
+{
+#if SDL_RENDER_BATCH
+    SDL_RenderBatch *pBatch = &SDL_render.sBatch;
+
+    if (pBatch->iNbQuads)
+    {
+        SDL_render.sFrame.iDrawCalls++;
+
+        if (SDL_RenderGeometry(SDL_render.pRenderer, pBatch->pTexture, pBatch->arrVertices, pBatch->iNbQuads * 4, pBatch->arrIndices, pBatch->iNbQuads * 6) != 0)
+        {
+            COM_Log_Print(COM_LOG_WARNING, "Unable to draw the geometry, sprite batching disabled: %s", SDL_GetError( ));
+            pBatch->bEnabled = SDL_FALSE;
+        }
+
+        pBatch->iNbQuads = 0;
+    }
+
+    pBatch->pTexture = NULL;
+#endif
+}
+
+#if SDL_RENDER_BATCH
+/*!
+ * \brief Function to draw the polylines waiting as thin quads.
+ *
+ * \return SDL_TRUE if the lines are drawn, else SDL_FALSE.
+ *
+ * \remark One call draws every segment, joined or not. The quads cover one
+ *         pixel across the major axis, like the pixels of a line. The
+ *         vertices of the batch are free, as it is flushed before queuing
+ *         (SDL_RENDER_PRIMS_MAX points give less than SDL_RENDER_BATCH_QUADS).
+ */
+static SDL_bool SDL_Render_FlushLines(void)
+{
+    SDL_RenderBatch *pBatch   = &SDL_render.sBatch;
+    SDL_RenderPrims *pPrims   = &SDL_render.sPrims;
+    SDL_Vertex      *pVertex  = pBatch->arrVertices;
+    const SDL_Point *pStart   = NULL;
+    const SDL_Point *pEnd     = NULL;
+    Uint32           iNbQuads = 0;
+    Uint32           iFirst   = 0;
+    Uint32           i        = 0;
+    Uint32           j        = 0;
+    Uint32           k        = 0;
+    float            fX1      = 0.0f;
+    float            fY1      = 0.0f;
+    float            fX2      = 0.0f;
+    float            fY2      = 0.0f;
+    float            fAcrossX = 0.0f;
+    float            fAcrossY = 0.0f;
+
+    if (!pBatch->bEnabled)
+    {
+        return SDL_FALSE;
+    }
+
+    for (i = 0 ; i < pPrims->iNbRuns ; ++i)
+    {
+        for (j = iFirst + 1 ; j < iFirst + pPrims->arrRuns[i] ; ++j)
+        {
+            pStart = &pPrims->arrPoints[j - 1];
+            pEnd   = &pPrims->arrPoints[j];
+
+            /* ~~~ Centers of the end pixels, extended by half a pixel along the major axis ~~~ */
+            fX1 = (float) pStart->x + 0.5f;
+            fY1 = (float) pStart->y + 0.5f;
+            fX2 = (float) pEnd->x   + 0.5f;
+            fY2 = (float) pEnd->y   + 0.5f;
+
+            if (abs(pEnd->x - pStart->x) >= abs(pEnd->y - pStart->y))
+            {
+                fX1     -= (pEnd->x >= pStart->x) ? 0.5f : -0.5f;
+                fX2     += (pEnd->x >= pStart->x) ? 0.5f : -0.5f;
+                fAcrossX = 0.0f;
+                fAcrossY = 0.5f;
+            }
+            else
+            {
+                fY1     -= (pEnd->y >= pStart->y) ? 0.5f : -0.5f;
+                fY2     += (pEnd->y >= pStart->y) ? 0.5f : -0.5f;
+                fAcrossX = 0.5f;
+                fAcrossY = 0.0f;
+            }
+
+            pVertex[0].position.x = fX1 - fAcrossX;
+            pVertex[0].position.y = fY1 - fAcrossY;
+            pVertex[1].position.x = fX2 - fAcrossX;
+            pVertex[1].position.y = fY2 - fAcrossY;
+            pVertex[2].position.x = fX2 + fAcrossX;
+            pVertex[2].position.y = fY2 + fAcrossY;
+            pVertex[3].position.x = fX1 + fAcrossX;
+            pVertex[3].position.y = fY1 + fAcrossY;
+
+            for (k = 0 ; k < 4 ; ++k)
+            {
+                pVertex[k].color       = pPrims->sColor;
+                pVertex[k].tex_coord.x = 0.0f;
+                pVertex[k].tex_coord.y = 0.0f;
+            }
+
+            pVertex += 4;
+            iNbQuads++;
+        }
+
+        iFirst += pPrims->arrRuns[i];
+    }
+
+    SDL_render.sFrame.iDrawCalls++;
+
+    if (SDL_RenderGeometry(SDL_render.pRenderer, NULL, pBatch->arrVertices, iNbQuads * 4, pBatch->arrIndices, iNbQuads * 6) != 0)
+    {
+        COM_Log_Print(COM_LOG_WARNING, "Unable to draw the geometry, sprite batching disabled: %s", SDL_GetError( ));
+        pBatch->bEnabled = SDL_FALSE;
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+#endif
+
+/*!
+ * \brief Function to draw the primitives waiting.
+ *
+ * \return None
+ */
+static void SDL_Render_FlushPrims(void)
+{
+    SDL_RenderPrims *pPrims = &SDL_render.sPrims;
+    Uint32           iFirst = 0;
+    Uint32           i      = 0;
+
+    if (pPrims->iType == SDL_RENDER_PRIM_NONE)
+    {
+        return;
+    }
+
+    SDL_Render_SetDrawColor(&pPrims->sColor);
+
+    switch (pPrims->iType)
+    {
+        case SDL_RENDER_PRIM_POINTS:
+            SDL_render.sFrame.iDrawCalls++;
+            SDL_RenderDrawPoints(SDL_render.pRenderer, pPrims->arrPoints, pPrims->iNbPoints);
+            break;
+
+        case SDL_RENDER_PRIM_LINES:
+#if SDL_RENDER_BATCH
+            if (SDL_Render_FlushLines( ))
+            {
+                break;
+            }
+#endif
+            for (i = 0 ; i < pPrims->iNbRuns ; ++i)
+            {
+                SDL_render.sFrame.iDrawCalls++;
+                SDL_RenderDrawLines(SDL_render.pRenderer, &pPrims->arrPoints[iFirst], pPrims->arrRuns[i]);
+                iFirst += pPrims->arrRuns[i];
+            }
+            break;
+
+        case SDL_RENDER_PRIM_FULL_RECTS:
+            SDL_render.sFrame.iDrawCalls++;
+            SDL_RenderFillRects(SDL_render.pRenderer, pPrims->arrRects, pPrims->iNbRects);
+            break;
+
+        case SDL_RENDER_PRIM_EMPTY_RECTS:
+            SDL_render.sFrame.iDrawCalls++;
+            SDL_RenderDrawRects(SDL_render.pRenderer, pPrims->arrRects, pPrims->iNbRects);
+            break;
+
+        default:
+            break;
+    }
+
+    pPrims->iType     = SDL_RENDER_PRIM_NONE;
+    pPrims->iNbPoints = 0;
+    pPrims->iNbRuns   = 0;
+    pPrims->iNbRects  = 0;
+}
+
+/*!
+ * \brief Function to prepare the queue to receive primitives.
+ *
+ * \param iType    Type of the primitives.
+ * \param pColor   Pointer to the color of the primitives.
+ * \param iNbItems Number of points (Or rectangles) to add.
+ * \param iNbRuns  Number of polylines to add.
+ * \return SDL_TRUE if the primitives can be queued, else SDL_FALSE.
+ *
+ * \remark The queue is flushed when the type or the color changes, and the
+ *         primitives too big for the queue must be drawn directly.
+ */
+static SDL_bool SDL_Render_BeginPrims(SDL_RenderPrimType iType, const SDL_Color *pColor, Uint32 iNbItems, Uint32 iNbRuns)
+{
+    SDL_RenderPrims *pPrims  = &SDL_render.sPrims;
+    SDL_bool         bRects  = (iType == SDL_RENDER_PRIM_FULL_RECTS) || (iType == SDL_RENDER_PRIM_EMPTY_RECTS);
+    Uint32           iNbUsed = bRects ? pPrims->iNbRects : pPrims->iNbPoints;
+
+    /* ~~~ Keep the order of the draws ~~~ */
+    SDL_Render_FlushQuads( );
+
+    if ((iType != pPrims->iType) ||
+        (pColor->r != pPrims->sColor.r) || (pColor->g != pPrims->sColor.g) ||
+        (pColor->b != pPrims->sColor.b) || (pColor->a != pPrims->sColor.a) ||
+        (iNbUsed + iNbItems > SDL_RENDER_PRIMS_MAX) || (pPrims->iNbRuns + iNbRuns > SDL_RENDER_PRIMS_MAX))
+    {
+        SDL_Render_FlushPrims( );
+    }
+
+    if (iNbItems > SDL_RENDER_PRIMS_MAX)
+    {
+        return SDL_FALSE;
+    }
+
+    pPrims->iType  = iType;
+    pPrims->sColor = *pColor;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief Function to draw rectangles with the queue.
+ *
+ * \param iType    Type of the rectangles (Full or empty).
+ * \param arrRect  Pointer to an array of rectangles (NULL => The viewport).
+ * \param iNbRects Number of rectangles.
+ * \param pColor   Pointer to the color of the rectangles.
+ * \return None.
+ */
+static void SDL_Render_PushRects(SDL_RenderPrimType iType, const SDL_Rect *arrRect, Uint32 iNbRects, const SDL_Color *pColor)
+{
+    SDL_RenderPrims *pPrims = &SDL_render.sPrims;
+    SDL_bool         bFull  = (iType == SDL_RENDER_PRIM_FULL_RECTS) ? SDL_TRUE : SDL_FALSE;
+    SDL_Rect         sViewport;
+
+    if (!arrRect)
+    {
+        SDL_RenderGetViewport(SDL_render.pRenderer, &sViewport);
+        sViewport.x = 0;
+        sViewport.y = 0;
+        arrRect     = &sViewport;
+        iNbRects    = 1;
+    }
+
+    SDL_render.sFrame.iPixels += SDL_Render_GetRectsArea(arrRect, iNbRects, bFull);
+
+    if (SDL_Render_BeginPrims(iType, pColor, iNbRects, 0))
+    {
+        memcpy(&pPrims->arrRects[pPrims->iNbRects], arrRect, sizeof(SDL_Rect) * iNbRects);
+        pPrims->iNbRects += iNbRects;
+    }
+    else
+    {
+        SDL_Render_SetDrawColor(pColor);
+        SDL_render.sFrame.iDrawCalls++;
+
+        if (bFull)
+        {
+            SDL_RenderFillRects(SDL_render.pRenderer, arrRect, iNbRects);
+        }
+        else
+        {
+            SDL_RenderDrawRects(SDL_render.pRenderer, arrRect, iNbRects);
+        }
+    }
+}
+
+/* ========================================================================= */
+
+#if SDL_RENDER_BATCH
+/*!
+ * \brief Function to prepare the batch to receive a quad.
+ *
+ * \param pTexture Pointer to the texture of the quad.
+ * \return SDL_TRUE if the quad can be batched, else SDL_FALSE.
+ *
+ * \remark The batch is flushed when the texture changes (The blend mode
+ *         belongs to the texture). The textures with a color or alpha
+ *         modulation are not batched, and the modulation is checked for
+ *         each quad (See SDL_Render_SetTextureMod).
+ */
+static SDL_bool SDL_Render_BeginQuad(SDL_Texture *pTexture)
+{
+    SDL_RenderBatch *pBatch = &SDL_render.sBatch;
+    Uint8            r      = 0;
+    Uint8            g      = 0;
+    Uint8            b      = 0;
+    Uint8            a      = 0;
+    int              w      = 0;
+    int              h      = 0;
+
+    if (!pBatch->bEnabled)
+    {
+        return SDL_FALSE;
+    }
+
+    /* ~~~ Keep the order of the draws ~~~ */
+    SDL_Render_FlushPrims( );
+
+    if (pBatch->iNbQuads == SDL_RENDER_BATCH_QUADS)
+    {
+        SDL_Render_FlushQuads( );
+    }
+
+    if (pTexture != pBatch->pTexture)
+    {
+        SDL_Render_FlushQuads( );
+
+        if ((SDL_QueryTexture(pTexture, NULL, NULL, &w, &h) != 0) || (w <= 0) || (h <= 0))
+        {
+            return SDL_FALSE;
+        }
+
+        pBatch->pTexture = pTexture;
+        pBatch->fInvW    = 1.0f / (float) w;
+        pBatch->fInvH    = 1.0f / (float) h;
+    }
+
+    /* ~~~ The modulation may have changed since the last quad ~~~ */
+    if ((SDL_GetTextureColorMod(pTexture, &r, &g, &b) != 0) || (SDL_GetTextureAlphaMod(pTexture, &a) != 0) ||
+        ((r & g & b & a) != 0xFF))
+    {
+        SDL_Render_FlushQuads( );
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief Function to add a quad to the batch.
+ *
+ * \param arrCorner Array of the corners (Top left, top right, bottom right, bottom left).
+ * \param pClip     Pointer to a rectangle to clip the texture (Can be NULL).
+ * \param iFlip     Flag to flip the texture.
+ * \return None.
+ */
+static void SDL_Render_PushQuad(const SDL_FPoint arrCorner[4], const SDL_Rect *pClip, SDL_RendererFlip iFlip)
+{
+    SDL_RenderBatch *pBatch    = &SDL_render.sBatch;
+    SDL_Vertex      *pVertex   = &pBatch->arrVertices[pBatch->iNbQuads * 4];
+    float            fU0       = 0.0f;
+    float            fV0       = 0.0f;
+    float            fU1       = 1.0f;
+    float            fV1       = 1.0f;
+    float            fSwap     = 0.0f;
+    Uint32           i         = 0;
+
+    if (pClip)
+    {
+        fU0 = (float) pClip->x * pBatch->fInvW;
+        fV0 = (float) pClip->y * pBatch->fInvH;
+        fU1 = (float) (pClip->x + pClip->w) * pBatch->fInvW;
+        fV1 = (float) (pClip->y + pClip->h) * pBatch->fInvH;
+    }
+
+    if (iFlip & SDL_FLIP_HORIZONTAL)
+    {
+        fSwap = fU0; fU0 = fU1; fU1 = fSwap;
+    }
+
+    if (iFlip & SDL_FLIP_VERTICAL)
+    {
+        fSwap = fV0; fV0 = fV1; fV1 = fSwap;
+    }
+
+    for (i = 0 ; i < 4 ; ++i)
+    {
+        pVertex[i].position = arrCorner[i];
+        pVertex[i].color.r  = 0xFF;
+        pVertex[i].color.g  = 0xFF;
+        pVertex[i].color.b  = 0xFF;
+        pVertex[i].color.a  = 0xFF;
+    }
+
+    pVertex[0].tex_coord.x = fU0; pVertex[0].tex_coord.y = fV0;
+    pVertex[1].tex_coord.x = fU1; pVertex[1].tex_coord.y = fV0;
+    pVertex[2].tex_coord.x = fU1; pVertex[2].tex_coord.y = fV1;
+    pVertex[3].tex_coord.x = fU0; pVertex[3].tex_coord.y = fV1;
+
+    pBatch->iNbQuads++;
+}
+#endif
+
+/* ========================================================================= */
+
 /*!
  * \brief Function to init the renderer.
  *
@@ -40,11 +695,47 @@ static SDL_Render SDL_render;
  */
 void SDL_Render_Init(SDL_Renderer *pRenderer, const SDL_Color *pColor)
 {
-    SDL_render.pRenderer = pRenderer;
-    SDL_render.sColor.r  = pColor->r;
-    SDL_render.sColor.g  = pColor->g;
-    SDL_render.sColor.b  = pColor->b;
-    SDL_render.sColor.a  = pColor->a;
+    SDL_render.pRenderer  = pRenderer;
+    SDL_render.sColor.r   = pColor->r;
+    SDL_render.sColor.g   = pColor->g;
+    SDL_render.sColor.b   = pColor->b;
+    SDL_render.sColor.a   = pColor->a;
+    SDL_render.bViewport  = SDL_FALSE;
+
+    SDL_zero(SDL_render.sFrame);
+    SDL_zero(SDL_render.sHistory);
+    SDL_render.pLastTexture = NULL;
+    SDL_render.bDrawColor   = SDL_FALSE;
+
+    SDL_render.sPrims.iType     = SDL_RENDER_PRIM_NONE;
+    SDL_render.sPrims.iNbPoints = 0;
+    SDL_render.sPrims.iNbRuns   = 0;
+    SDL_render.sPrims.iNbRects  = 0;
+
+    /* ~~~ The watch is added once, even if the render is init again ~~~ */
+    SDL_DelEventWatch(SDL_Render_WatchEvent, NULL);
+    SDL_AddEventWatch(SDL_Render_WatchEvent, NULL);
+
+#if SDL_RENDER_BATCH
+    {
+        SDL_RenderBatch *pBatch = &SDL_render.sBatch;
+        Uint32           i      = 0;
+
+        pBatch->bEnabled = SDL_TRUE;
+        pBatch->pTexture = NULL;
+        pBatch->iNbQuads = 0;
+
+        for (i = 0 ; i < SDL_RENDER_BATCH_QUADS ; ++i)
+        {
+            pBatch->arrIndices[i * 6 + 0] = i * 4 + 0;
+            pBatch->arrIndices[i * 6 + 1] = i * 4 + 1;
+            pBatch->arrIndices[i * 6 + 2] = i * 4 + 2;
+            pBatch->arrIndices[i * 6 + 3] = i * 4 + 2;
+            pBatch->arrIndices[i * 6 + 4] = i * 4 + 3;
+            pBatch->arrIndices[i * 6 + 5] = i * 4 + 0;
+        }
+    }
+#endif
 }
 
 /*!
@@ -55,7 +746,163 @@ void SDL_Render_Init(SDL_Renderer *pRenderer, const SDL_Color *pColor)
  */
 SDL_Texture *SDL_Render_CreateTextureFromSurface(SDL_Surface *pSurface)
 {
-    return SDL_CreateTextureFromSurface(SDL_render.pRenderer, pSurface);
+    SDL_Texture *pTexture = SDL_CreateTextureFromSurface(SDL_render.pRenderer, pSurface);
+
+    if (pTexture)
+    {
+        SDL_render.sFrame.iTexturesCreated++;
+        UTIL_FrameCount(UTIL_FRAME_TEXTURE);
+    }
+
+    return pTexture;
+}
+
+/*!
+ * \brief Function to create a texture to render into.
+ *
+ * \param iWidth  Width of the texture.
+ * \param iHeight Height of the texture.
+ * \return A pointer to the texture created, or NULL if error.
+ *
+ * \remark The texture is cleared to transparent, and stores premultiplied
+ *         colors when the blended textures are drawn into it.
+ */
+SDL_Texture *SDL_Render_CreateTargetTexture(Sint32 iWidth, Sint32 iHeight)
+{
+    SDL_Texture *pTexture = SDL_CreateTexture(SDL_render.pRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, iWidth, iHeight);
+
+    if (pTexture)
+    {
+        SDL_render.sFrame.iTexturesCreated++;
+        UTIL_FrameCount(UTIL_FRAME_TEXTURE);
+
+#if SDL_VERSION_ATLEAST(2,0,6)
+        SDL_SetTextureBlendMode(pTexture, SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                                     SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+#else
+        SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+#endif
+
+        if (SDL_Render_SetTarget(pTexture) == 0)
+        {
+            SDL_Render_ClearTarget( );
+        }
+
+        SDL_Render_SetTarget(NULL);
+    }
+
+    return pTexture;
+}
+
+/*!
+ * \brief Function to create a texture updated with RGBA pixels.
+ *
+ * \param iWidth  Width of the texture.
+ * \param iHeight Height of the texture.
+ * \return A pointer to the texture created, or NULL if error.
+ *
+ * \remark The content of the texture is undefined until updated.
+ */
+SDL_Texture *SDL_Render_CreateStaticTexture(Sint32 iWidth, Sint32 iHeight)
+{
+    SDL_Texture *pTexture = SDL_CreateTexture(SDL_render.pRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, iWidth, iHeight);
+
+    if (pTexture)
+    {
+        SDL_render.sFrame.iTexturesCreated++;
+        UTIL_FrameCount(UTIL_FRAME_TEXTURE);
+
+        SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    }
+
+    return pTexture;
+}
+
+/*!
+ * \brief Function to check if the renderer can render into textures.
+ *
+ * \return SDL_TRUE if the render targets are supported, else SDL_FALSE.
+ */
+SDL_bool SDL_Render_HasTargets(void)
+{
+    return SDL_RenderTargetSupported(SDL_render.pRenderer);
+}
+
+/*!
+ * \brief Function to get the number of losses of the render targets.
+ *
+ * \return The number of SDL_RENDER_TARGETS_RESET and SDL_RENDER_DEVICE_RESET received.
+ *
+ * \remark The content of the target textures is undefined after a loss.
+ */
+Uint32 SDL_Render_GetResetCount(void)
+{
+    return (Uint32) SDL_AtomicGet(&SDL_render.iNbResets);
+}
+
+/*!
+ * \brief Function to set the color and alpha modulation of a texture.
+ *
+ * \param pTexture Pointer to the texture.
+ * \param pColor   Pointer to the modulation (White and opaque => None).
+ * \return 0 on success, else -1 if error.
+ *
+ * \remark The quads of the texture waiting in the batch are drawn first, as
+ *         they are drawn with the modulation set when the batch is flushed.
+ */
+int SDL_Render_SetTextureMod(SDL_Texture *pTexture, const SDL_Color *pColor)
+{
+#if SDL_RENDER_BATCH
+    if (pTexture == SDL_render.sBatch.pTexture)
+    {
+        SDL_Render_FlushQuads( );
+    }
+#endif
+
+    if (SDL_SetTextureColorMod(pTexture, pColor->r, pColor->g, pColor->b) != 0)
+    {
+        return -1;
+    }
+
+    return SDL_SetTextureAlphaMod(pTexture, pColor->a);
+}
+
+/*!
+ * \brief Function to set the texture to render into.
+ *
+ * \param pTexture Pointer to a target texture (NULL => The window).
+ * \return 0 on success, else -1 if error.
+ *
+ * \remark The viewport of the window is restored with the window.
+ */
+int SDL_Render_SetTarget(SDL_Texture *pTexture)
+{
+    int iRet = 0;
+
+    SDL_Render_Flush( );
+
+    iRet = SDL_SetRenderTarget(SDL_render.pRenderer, pTexture);
+
+    if (!pTexture && SDL_render.bViewport)
+    {
+        SDL_RenderSetViewport(SDL_render.pRenderer, &SDL_render.sViewport);
+    }
+
+    return iRet;
+}
+
+/*!
+ * \brief Function to clear the target texture to transparent.
+ *
+ * \return None
+ */
+void SDL_Render_ClearTarget(void)
+{
+    static const SDL_Color sTransparent = { 0, 0, 0, 0 };
+
+    SDL_Render_Flush( );
+    SDL_Render_SetDrawColor(&sTransparent);
+    SDL_RenderClear(SDL_render.pRenderer);
 }
 
 /*!
@@ -65,7 +912,8 @@ SDL_Texture *SDL_Render_CreateTextureFromSurface(SDL_Surface *pSurface)
  */
 void SDL_Render_Clear(void)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Render_Flush( );
+    SDL_Render_SetDrawColor(&SDL_render.sColor);
     SDL_RenderClear(SDL_render.pRenderer);
 }
 
@@ -77,6 +925,18 @@ void SDL_Render_Clear(void)
  */
 void SDL_Render_SetViewport(const SDL_Rect *pViewport)
 {
+    SDL_Render_Flush( );
+
+    if (pViewport)
+    {
+        SDL_render.sViewport.x = pViewport->x;
+        SDL_render.sViewport.y = pViewport->y;
+        SDL_render.sViewport.w = pViewport->w;
+        SDL_render.sViewport.h = pViewport->h;
+    }
+
+    SDL_render.bViewport = pViewport ? SDL_TRUE : SDL_FALSE;
+
     SDL_RenderSetViewport(SDL_render.pRenderer, pViewport);
 }
 
@@ -90,6 +950,34 @@ void SDL_Render_SetViewport(const SDL_Rect *pViewport)
  */
 int SDL_Render_DrawTexture(SDL_Texture *pTexture, const SDL_Rect *pClip, const SDL_Rect *pPos)
 {
+#if SDL_RENDER_BATCH
+    SDL_FPoint arrCorner[4];
+#endif
+
+    SDL_Render_CountTexture(pTexture, pPos);
+
+#if SDL_RENDER_BATCH
+    if (pPos && SDL_Render_BeginQuad(pTexture))
+    {
+        arrCorner[0].x = (float) pPos->x;
+        arrCorner[0].y = (float) pPos->y;
+        arrCorner[1].x = (float) (pPos->x + pPos->w);
+        arrCorner[1].y = (float) pPos->y;
+        arrCorner[2].x = (float) (pPos->x + pPos->w);
+        arrCorner[2].y = (float) (pPos->y + pPos->h);
+        arrCorner[3].x = (float) pPos->x;
+        arrCorner[3].y = (float) (pPos->y + pPos->h);
+
+        SDL_Render_PushQuad(arrCorner, pClip, SDL_FLIP_NONE);
+        return 0;
+    }
+#endif
+
+    /* ~~~ Keep the order of the draws ~~~ */
+    SDL_Render_Flush( );
+
+    SDL_render.sFrame.iDrawCalls++;
+
     return SDL_RenderCopy(SDL_render.pRenderer, pTexture, pClip, pPos);
 }
 
@@ -106,6 +994,59 @@ int SDL_Render_DrawTexture(SDL_Texture *pTexture, const SDL_Rect *pClip, const S
  */
 int SDL_Render_DrawTextureEx(SDL_Texture *pTexture, const SDL_Rect *pClip, const SDL_Rect *pPos, double dAngle, const SDL_Point *pCenter, SDL_RendererFlip iFlip)
 {
+#if SDL_RENDER_BATCH
+    SDL_FPoint arrCorner[4];
+    float      fCenterX = 0.0f;
+    float      fCenterY = 0.0f;
+    float      fCos     = 1.0f;
+    float      fSin     = 0.0f;
+    float      fX       = 0.0f;
+    float      fY       = 0.0f;
+    Uint32     i        = 0;
+#endif
+
+    SDL_Render_CountTexture(pTexture, pPos);
+
+#if SDL_RENDER_BATCH
+    if (pPos && SDL_Render_BeginQuad(pTexture))
+    {
+        fCenterX = pCenter ? (float) pCenter->x : (float) pPos->w * 0.5f;
+        fCenterY = pCenter ? (float) pCenter->y : (float) pPos->h * 0.5f;
+
+        if (dAngle != 0.0)
+        {
+            fCos = (float) SDL_cos(dAngle * SDL_RENDER_DEG_TO_RAD);
+            fSin = (float) SDL_sin(dAngle * SDL_RENDER_DEG_TO_RAD);
+        }
+
+        /* ~~~ Corners around the center, rotated clockwise ~~~ */
+        arrCorner[0].x = -fCenterX;
+        arrCorner[0].y = -fCenterY;
+        arrCorner[1].x = (float) pPos->w - fCenterX;
+        arrCorner[1].y = -fCenterY;
+        arrCorner[2].x = (float) pPos->w - fCenterX;
+        arrCorner[2].y = (float) pPos->h - fCenterY;
+        arrCorner[3].x = -fCenterX;
+        arrCorner[3].y = (float) pPos->h - fCenterY;
+
+        for (i = 0 ; i < 4 ; ++i)
+        {
+            fX             = arrCorner[i].x;
+            fY             = arrCorner[i].y;
+            arrCorner[i].x = (fX * fCos - fY * fSin) + (float) pPos->x + fCenterX;
+            arrCorner[i].y = (fX * fSin + fY * fCos) + (float) pPos->y + fCenterY;
+        }
+
+        SDL_Render_PushQuad(arrCorner, pClip, iFlip);
+        return 0;
+    }
+#endif
+
+    /* ~~~ Keep the order of the draws ~~~ */
+    SDL_Render_Flush( );
+
+    SDL_render.sFrame.iDrawCalls++;
+
     return SDL_RenderCopyEx(SDL_render.pRenderer, pTexture, pClip, pPos, dAngle, pCenter, iFlip);
 }
 
@@ -119,9 +1060,12 @@ int SDL_Render_DrawTextureEx(SDL_Texture *pTexture, const SDL_Rect *pClip, const
  */
 void SDL_Render_DrawPoint(Sint32 x, Sint32 y, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderDrawPoint(SDL_render.pRenderer, x, y);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Point sPoint;
+
+    sPoint.x = x;
+    sPoint.y = y;
+
+    SDL_Render_DrawPoints(&sPoint, 1, pColor);
 }
 
 /*!
@@ -134,9 +1078,21 @@ void SDL_Render_DrawPoint(Sint32 x, Sint32 y, const SDL_Color *pColor)
  */
 void SDL_Render_DrawPoints(const SDL_Point *arrPoint, Uint32 iNbPoints, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderDrawPoints(SDL_render.pRenderer, arrPoint, iNbPoints);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_RenderPrims *pPrims = &SDL_render.sPrims;
+
+    SDL_render.sFrame.iPixels += iNbPoints;
+
+    if (SDL_Render_BeginPrims(SDL_RENDER_PRIM_POINTS, pColor, iNbPoints, 0))
+    {
+        memcpy(&pPrims->arrPoints[pPrims->iNbPoints], arrPoint, sizeof(SDL_Point) * iNbPoints);
+        pPrims->iNbPoints += iNbPoints;
+    }
+    else
+    {
+        SDL_Render_SetDrawColor(pColor);
+        SDL_render.sFrame.iDrawCalls++;
+        SDL_RenderDrawPoints(SDL_render.pRenderer, arrPoint, iNbPoints);
+    }
 }
 
 /*!
@@ -148,12 +1104,34 @@ void SDL_Render_DrawPoints(const SDL_Point *arrPoint, Uint32 iNbPoints, const SD
  * \param y2     Position on y to end.
  * \param pColor Pointer to the color to use.
  * \return None.
+ *
+ * \remark A line starting at the end of the previous one extends its
+ *         polyline, else a new polyline is started. With SDL_RenderGeometry,
+ *         the polylines waiting are drawn in one call.
  */
 void SDL_Render_DrawLine(Sint32 x1, Sint32 y1, Sint32 x2, Sint32 y2, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderDrawLine(SDL_render.pRenderer, x1, y1, x2, y2);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_RenderPrims *pPrims = &SDL_render.sPrims;
+    SDL_Point       *pLast  = NULL;
+
+    SDL_render.sFrame.iPixels += COM_Math_Max(abs(x2 - x1), abs(y2 - y1)) + 1;
+
+    SDL_Render_BeginPrims(SDL_RENDER_PRIM_LINES, pColor, 2, 1);
+
+    pLast = pPrims->iNbPoints ? &pPrims->arrPoints[pPrims->iNbPoints - 1] : NULL;
+
+    if (!pLast || (pLast->x != x1) || (pLast->y != y1))
+    {
+        pPrims->arrRuns[pPrims->iNbRuns++]     = 1;
+        pPrims->arrPoints[pPrims->iNbPoints].x = x1;
+        pPrims->arrPoints[pPrims->iNbPoints].y = y1;
+        pPrims->iNbPoints++;
+    }
+
+    pPrims->arrRuns[pPrims->iNbRuns - 1]++;
+    pPrims->arrPoints[pPrims->iNbPoints].x = x2;
+    pPrims->arrPoints[pPrims->iNbPoints].y = y2;
+    pPrims->iNbPoints++;
 }
 
 /*!
@@ -165,9 +1143,7 @@ void SDL_Render_DrawLine(Sint32 x1, Sint32 y1, Sint32 x2, Sint32 y2, const SDL_C
  */
 void SDL_Render_DrawFullRect(const SDL_Rect *pRect, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderFillRect(SDL_render.pRenderer, pRect);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Render_PushRects(SDL_RENDER_PRIM_FULL_RECTS, pRect, 1, pColor);
 }
 
 /*!
@@ -180,9 +1156,7 @@ void SDL_Render_DrawFullRect(const SDL_Rect *pRect, const SDL_Color *pColor)
  */
 void SDL_Render_DrawFullRects(const SDL_Rect *arrRect, Uint32 iNbRects, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderFillRects(SDL_render.pRenderer, arrRect, iNbRects);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Render_PushRects(SDL_RENDER_PRIM_FULL_RECTS, arrRect, iNbRects, pColor);
 }
 
 /*!
@@ -194,9 +1168,7 @@ void SDL_Render_DrawFullRects(const SDL_Rect *arrRect, Uint32 iNbRects, const SD
  */
 void SDL_Render_DrawEmptyRect(const SDL_Rect *pRect, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderDrawRect(SDL_render.pRenderer, pRect);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Render_PushRects(SDL_RENDER_PRIM_EMPTY_RECTS, pRect, 1, pColor);
 }
 
 /*!
@@ -209,9 +1181,21 @@ void SDL_Render_DrawEmptyRect(const SDL_Rect *pRect, const SDL_Color *pColor)
  */
 void SDL_Render_DrawEmptyRects(const SDL_Rect *arrRect, Uint32 iNbRects, const SDL_Color *pColor)
 {
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, pColor->r, pColor->g, pColor->b, pColor->a);
-    SDL_RenderDrawRects(SDL_render.pRenderer, arrRect, iNbRects);
-    SDL_SetRenderDrawColor(SDL_render.pRenderer, SDL_render.sColor.r, SDL_render.sColor.g, SDL_render.sColor.b, SDL_render.sColor.a);
+    SDL_Render_PushRects(SDL_RENDER_PRIM_EMPTY_RECTS, arrRect, iNbRects, pColor);
+}
+
+/*!
+ * \brief Function to draw the quads and the primitives waiting.
+ *
+ * \return None
+ *
+ * \remark Must be called before using the renderer directly, or before
+ *         changing a texture waiting in the batch.
+ */
+void SDL_Render_Flush(void)
+{
+    SDL_Render_FlushQuads( );
+    SDL_Render_FlushPrims( );
 }
 
 /*!
@@ -221,7 +1205,54 @@ void SDL_Render_DrawEmptyRects(const SDL_Rect *arrRect, Uint32 iNbRects, const S
  */
 void SDL_Render_Present(void)
 {
+    COM_PROF_BEGIN("SDL_Render_Present");
+
+    SDL_Render_Flush( );
     SDL_RenderPresent(SDL_render.pRenderer);
+
+    /* ~~~ The frame ends ~~~ */
+    SDL_Render_PushStats(&SDL_render.sFrame);
+    SDL_zero(SDL_render.sFrame);
+
+    COM_PROF_END( );
+}
+
+/*!
+ * \brief Function to get the statistics of the render.
+ *
+ * \param pFrame   Pointer to retrieve the statistics of the last frame presented (Can be NULL).
+ * \param pAverage Pointer to retrieve the averages of the last frames presented (Can be NULL).
+ * \return None.
+ *
+ * \remark A batch of quads counts as one draw call. The textures created
+ *         while loading are counted in the first frame presented after.
+ */
+void SDL_Render_GetStats(SDL_RenderStats *pFrame, SDL_RenderAverage *pAverage)
+{
+    SDL_RenderHistory *pHistory = &SDL_render.sHistory;
+    double             dNbFrames = (double) COM_Math_Max(pHistory->iNbFrames, 1);
+
+    if (pFrame)
+    {
+        if (pHistory->iNbFrames)
+        {
+            *pFrame = pHistory->arrFrames[(pHistory->iNext + SDL_RENDER_STATS_FRAMES - 1) % SDL_RENDER_STATS_FRAMES];
+        }
+        else
+        {
+            SDL_zerop(pFrame);
+        }
+    }
+
+    if (pAverage)
+    {
+        pAverage->dDrawCalls       = (double) pHistory->sSum.iDrawCalls       / dNbFrames;
+        pAverage->dTextureSwitches = (double) pHistory->sSum.iTextureSwitches / dNbFrames;
+        pAverage->dColorChanges    = (double) pHistory->sSum.iColorChanges    / dNbFrames;
+        pAverage->dTexturesCreated = (double) pHistory->sSum.iTexturesCreated / dNbFrames;
+        pAverage->dPixels          = (double) pHistory->sSum.iPixels          / dNbFrames;
+        pAverage->iNbFrames        = pHistory->iNbFrames;
+    }
 }
 
 /* ========================================================================= */
@@ -10,16 +10,58 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 26/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add the render target textures.                      */
+/* Nyuu    | 18/10/26 | Batch the textured quads with SDL_RenderGeometry.    */
+/* Nyuu    | 18/10/26 | Add the static textures for the atlas.               */
+/* Nyuu    | 18/10/26 | Count the draw calls submitted to the renderer.      */
+/* Nyuu    | 18/10/26 | Add the statistics of the frames.                    */
+/* Nyuu    | 18/10/26 | Count the losses of the render targets.              */
+/* Nyuu    | 18/10/26 | Add the modulation of the textures.                  */
 /* ========================================================================= */
 
 #ifndef __SDL_RENDER_H__
 #define __SDL_RENDER_H__
 
     #include "SDL_Shared.h"
+
+    /*!
+     * \struct SDL_RenderStats
+     * \brief  Structure to handle the statistics of a frame.
+     */
+    typedef struct
+    {
+        Uint32 iDrawCalls;       /*!< Number of draw calls submitted to the renderer. */
+        Uint32 iTextureSwitches; /*!< Number of times the texture drawn changed. */
+        Uint32 iColorChanges;    /*!< Number of times the draw color changed. */
+        Uint32 iTexturesCreated; /*!< Number of textures created. */
+        Uint64 iPixels;          /*!< Number of pixels covered by the draws. */
+    } SDL_RenderStats;
+
+    /*!
+     * \struct SDL_RenderAverage
+     * \brief  Structure to handle the averages of the statistics of the last frames.
+     */
+    typedef struct
+    {
+        double dDrawCalls;       /*!< Average number of draw calls. */
+        double dTextureSwitches; /*!< Average number of texture switches. */
+        double dColorChanges;    /*!< Average number of color changes. */
+        double dTexturesCreated; /*!< Average number of textures created. */
+        double dPixels;          /*!< Average number of pixels covered. */
+        Uint32 iNbFrames;        /*!< Number of frames averaged. */
+    } SDL_RenderAverage;
     
     void SDL_Render_Init(SDL_Renderer *pRenderer, const SDL_Color *pColor);
 
     SDL_Texture *SDL_Render_CreateTextureFromSurface(SDL_Surface *pSurface);
+    SDL_Texture *SDL_Render_CreateTargetTexture(Sint32 iWidth, Sint32 iHeight);
+    SDL_Texture *SDL_Render_CreateStaticTexture(Sint32 iWidth, Sint32 iHeight);
+    int          SDL_Render_SetTextureMod(SDL_Texture *pTexture, const SDL_Color *pColor);
+
+    SDL_bool SDL_Render_HasTargets(void);
+    Uint32   SDL_Render_GetResetCount(void);
+    int      SDL_Render_SetTarget(SDL_Texture *pTexture);
+    void     SDL_Render_ClearTarget(void);
 
     void SDL_Render_Clear(void);
     void SDL_Render_SetViewport(const SDL_Rect *pViewport);
@@ -32,8 +74,11 @@
     void SDL_Render_DrawFullRects(const SDL_Rect *arrRect, Uint32 iNbRects, const SDL_Color *pColor);
     void SDL_Render_DrawEmptyRect(const SDL_Rect *pRect, const SDL_Color *pColor);
     void SDL_Render_DrawEmptyRects(const SDL_Rect *arrRect, Uint32 iNbRects, const SDL_Color *pColor);
+    void SDL_Render_Flush(void);
     void SDL_Render_Present(void);
 
+    void SDL_Render_GetStats(SDL_RenderStats *pFrame, SDL_RenderAverage *pAverage);
+
 #endif // __SDL_RENDER_H__
 
 /* ========================================================================= */
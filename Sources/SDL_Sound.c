@@ -11,8 +11,14 @@
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 13/06/15 | Creation.                                            */
 /* Red     | 13/06/15 | Add Alloc.                                           */
+/* Nyuu    | 18/10/26 | Add SDL_Sound_AllocFromChunk for the bulk precache.  */
+/* Nyuu    | 18/10/26 | Evict the chunks and reload them at the next play.   */
+/* Nyuu    | 18/10/26 | Set the volume of the channel, not of the chunk.     */
+/* Nyuu    | 18/10/26 | Paths built in the frame arena.                      */
+/* Nyuu    | 18/10/26 | Set the volume of the first free channel only.       */
 /* ========================================================================= */
 
+#include "COM_Arena.h"
 #include "SDL_Util.h"
 #include "SDL_Sound.h"
 
@@ -21,8 +27,49 @@
 /*! Global variable to handle the volume of the sounds (0 - 100)% */
 static Uint32 SDL_Sound_volume = 100;
 
+/*! Global variable to handle the clock stamped on the sounds played. */
+static Uint32 SDL_Sound_clock = 0;
+
+/*! Global variable to handle the callback called when a chunk is loaded again. */
+static SDL_SoundHook SDL_Sound_reloadHook = NULL;
+
 /* ========================================================================= */
 
+/*!
+ * \brief  Function to create a sound from a chunk already loaded.
+ *
+ * \param  szSndName Name of the sound.
+ * \param  pChunk    Pointer to the chunk (Owned by the sound, even if error).
+ * \return A pointer to the sound, or NULL if error.
+ *
+ * \remark The chunk can be loaded by any thread with UTIL_ChunkLoad.
+ */
+SDL_Sound *SDL_Sound_AllocFromChunk(const char *szSndName, Mix_Chunk *pChunk)
+{
+    SDL_Sound *pSound = (SDL_Sound *) UTIL_Malloc(sizeof(SDL_Sound));
+
+    if (pSound)
+    {
+        pSound->pMixChunk = pChunk;
+        pSound->szName    = UTIL_StrCopy(szSndName);
+        pSound->bEvicted  = SDL_FALSE;
+        pSound->iLastUse  = SDL_Sound_clock;
+
+        if (!pSound->pMixChunk || !pSound->szName) // Error: must free...
+        {
+            UTIL_ChunkFree(&pSound->pMixChunk);
+            UTIL_Free(pSound->szName);
+            UTIL_Free(pSound);
+        }
+    }
+    else
+    {
+        UTIL_ChunkFree(&pChunk);
+    }
+
+    return pSound;
+}
+
 /*!
  * \brief  Function to load a sound.
  *
@@ -31,34 +78,60 @@ static Uint32 SDL_Sound_volume = 100;
  */
 SDL_Sound *SDL_Sound_Alloc(const char *szSndName)
 {
-    SDL_Sound *pSound      = NULL;
-    char      *szSoundPath = NULL;
+    SDL_Sound    *pSound      = NULL;
+    char         *szSoundPath = NULL;
+    COM_ArenaMark sMark;
+
+    COM_Arena_Mark(&sMark);
 
-    szSoundPath = UTIL_StrBuild("sounds/", szSndName, ".wav", NULL);
+    szSoundPath = COM_Arena_StrBuild("sounds/", szSndName, ".wav", NULL);
 
     if (szSoundPath)
     {
-        pSound = (SDL_Sound *) UTIL_Malloc(sizeof(SDL_Sound));
-
-        if (pSound)
-        {         
-            pSound->pMixChunk = UTIL_ChunkLoad(szSoundPath);
-            pSound->szName    = UTIL_StrCopy(szSndName);
-
-            if (!pSound->pMixChunk || !pSound->szName) // Error: must free...
-            {
-                UTIL_ChunkFree(&pSound->pMixChunk);
-                UTIL_Free(pSound->szName);
-                UTIL_Free(pSound);
-            }
-        }
-
-        UTIL_Free(szSoundPath);
+        pSound = SDL_Sound_AllocFromChunk(szSndName, UTIL_ChunkLoad(szSoundPath));
     }
 
+    COM_Arena_Rewind(&sMark);
+
     return pSound;
 }
 
+/*!
+ * \brief  Function to load the chunk of an evicted sound again.
+ *
+ * \param  pSound Pointer to the evicted sound.
+ * \return None.
+ *
+ * \remark A sound which can't be loaded again plays nothing.
+ */
+static void SDL_Sound_Reload(SDL_Sound *pSound)
+{
+    char         *szSoundPath = NULL;
+    COM_ArenaMark sMark;
+
+    COM_Arena_Mark(&sMark);
+
+    szSoundPath      = COM_Arena_StrBuild("sounds/", pSound->szName, ".wav", NULL);
+    pSound->bEvicted = SDL_FALSE;
+
+    if (szSoundPath)
+    {
+        pSound->pMixChunk = UTIL_ChunkLoad(szSoundPath);
+    }
+
+    COM_Arena_Rewind(&sMark);
+
+    if (!pSound->pMixChunk)
+    {
+        COM_Log_Print(COM_LOG_ERROR, "Can't reload the sound \"%s\" !", pSound->szName);
+    }
+
+    if (SDL_Sound_reloadHook)
+    {
+        SDL_Sound_reloadHook(pSound);
+    }
+}
+
 /*!
  * \brief  Function to get the name of a sound.
  *
@@ -74,17 +147,49 @@ const char *SDL_Sound_GetName(const SDL_Sound *pSound)
  * \brief  Function to play a sound.
  *
  * \param  pSound   Pointer to a loaded sound.
- * \param  iChannel Channel to play the sound.
+ * \param  iChannel Channel to play the sound ((Uint32) -1 => First free channel).
  * \param  iVolume  Volume to play the sound (0 - 128).
  * \param  iLoops   Number of times the sound must be looped.
- * \return None.
+ * \return The channel playing the sound, or -1 if error.
+ *
+ * \remark The volume is set on the channel, so the other plays of the sound
+ *         keep their own (See SDL_Voice_Play to choose the channel). With
+ *         the first free channel, it is set once the channel is known (-1
+ *         would set the volume of all the channels).
  */
-void SDL_Sound_Play(SDL_Sound *pSound, Uint32 iChannel, Uint32 iVolume, Sint32 iLoops)
+Sint32 SDL_Sound_Play(SDL_Sound *pSound, Uint32 iChannel, Uint32 iVolume, Sint32 iLoops)
 {
+    Sint32 iPlayed = -1;
+
     iVolume = ((iVolume * SDL_Sound_volume) / 100);
 
-    Mix_VolumeChunk(pSound->pMixChunk, iVolume);
-    Mix_PlayChannel(iChannel, pSound->pMixChunk, iLoops);
+    pSound->iLastUse = SDL_Sound_clock;
+
+    if (pSound->bEvicted)
+    {
+        SDL_Sound_Reload(pSound);
+    }
+
+    if (!pSound->pMixChunk)
+    {
+        return -1;
+    }
+
+    if ((int) iChannel < 0)
+    {
+        iPlayed = Mix_PlayChannel(-1, pSound->pMixChunk, iLoops);
+
+        if (iPlayed >= 0)
+        {
+            Mix_Volume(iPlayed, (int) iVolume);
+        }
+
+        return iPlayed;
+    }
+
+    Mix_Volume((int) iChannel, (int) iVolume);
+
+    return Mix_PlayChannel((int) iChannel, pSound->pMixChunk, iLoops);
 }
 
 /*!
@@ -100,6 +205,78 @@ void SDL_Sound_Free(SDL_Sound **ppSound)
     UTIL_Free(*ppSound);
 }
 
+/*!
+ * \brief  Function to set the clock stamped on the sounds played.
+ *
+ * \param  iClock Value of the clock (Usually the number of the frame).
+ * \return None.
+ */
+void SDL_Sound_SetClock(Uint32 iClock)
+{
+    SDL_Sound_clock = iClock;
+}
+
+/*!
+ * \brief  Function to set the callback called when a chunk is loaded again.
+ *
+ * \param  pHook Function to call (NULL => None).
+ * \return None.
+ */
+void SDL_Sound_SetReloadHook(SDL_SoundHook pHook)
+{
+    SDL_Sound_reloadHook = pHook;
+}
+
+/*!
+ * \brief  Function to get the clock of the last play of a sound.
+ *
+ * \param  pSound Pointer to the sound.
+ * \return The clock of the last play (Or of the load if never played).
+ */
+Uint32 SDL_Sound_GetLastUse(const SDL_Sound *pSound)
+{
+    return pSound->iLastUse;
+}
+
+/*!
+ * \brief  Function to get the memory used by the chunk of a sound.
+ *
+ * \param  pSound Pointer to the sound.
+ * \return The memory of the samples (In bytes), 0 if the chunk is not loaded.
+ */
+Uint32 SDL_Sound_GetBytes(const SDL_Sound *pSound)
+{
+    return pSound->pMixChunk ? (pSound->pMixChunk->alen + (Uint32) sizeof(Mix_Chunk)) : 0;
+}
+
+/*!
+ * \brief  Function to evict the chunk of a sound.
+ *
+ * \param  pSound Pointer to the loaded sound.
+ * \return SDL_TRUE if the chunk is freed, else SDL_FALSE (Still played by a channel).
+ *
+ * \remark The sound stays valid, and its chunk is loaded again by its next
+ *         play.
+ */
+SDL_bool SDL_Sound_Evict(SDL_Sound *pSound)
+{
+    Sint32 iNbChannels = Mix_AllocateChannels(-1);
+    Sint32 iChannel    = 0;
+
+    for (iChannel = 0 ; iChannel < iNbChannels ; ++iChannel)
+    {
+        if (Mix_Playing(iChannel) && (Mix_GetChunk(iChannel) == pSound->pMixChunk))
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    UTIL_ChunkFree(&pSound->pMixChunk);
+    pSound->bEvicted = SDL_TRUE;
+
+    return SDL_TRUE;
+}
+
 /* ========================================================================= */
 
 /*!
@@ -10,6 +10,9 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 13/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add SDL_Sound_AllocFromChunk for the bulk precache.  */
+/* Nyuu    | 18/10/26 | Evict the chunks and reload them at the next play.   */
+/* Nyuu    | 18/10/26 | Set the volume of the channel, not of the chunk.     */
 /* ========================================================================= */
 
 #ifndef __SDL_SOUND_H__
@@ -25,13 +28,25 @@
     {
         char      *szName;    /*!< Name of the sound */
         Mix_Chunk *pMixChunk; /*!< Pointer to the sound */
+        SDL_bool   bEvicted;  /*!< Flag set if the chunk was evicted (Loaded again by the next play). */
+        Uint32     iLastUse;  /*!< Clock of the last play (See SDL_Sound_SetClock). */
     } SDL_Sound;
 
+    /*! Callback called when the chunk of an evicted sound is loaded again. */
+    typedef void (*SDL_SoundHook)(SDL_Sound *pSound);
+
+    SDL_Sound  *SDL_Sound_AllocFromChunk(const char *szSndName, Mix_Chunk *pChunk);
     SDL_Sound  *SDL_Sound_Alloc(const char *szSndName);
     const char *SDL_Sound_GetName(const SDL_Sound *pSound);
-    void        SDL_Sound_Play(SDL_Sound *pSound, Uint32 iChannel, Uint32 iVolume, Sint32 iLoops);
+    Sint32      SDL_Sound_Play(SDL_Sound *pSound, Uint32 iChannel, Uint32 iVolume, Sint32 iLoops);
     void        SDL_Sound_Free(SDL_Sound **ppSound);
 
+    void        SDL_Sound_SetClock(Uint32 iClock);
+    void        SDL_Sound_SetReloadHook(SDL_SoundHook pHook);
+    Uint32      SDL_Sound_GetLastUse(const SDL_Sound *pSound);
+    Uint32      SDL_Sound_GetBytes(const SDL_Sound *pSound);
+    SDL_bool    SDL_Sound_Evict(SDL_Sound *pSound);
+
     void        SDL_Sound_SetGlobalVolume(Uint32 iVolume);
     Uint32      SDL_Sound_GetGlobalVolume(void);
 
@@ -10,84 +10,352 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 09/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | The sheets are packed in the atlas.                  */
+/* Nyuu    | 18/10/26 | Split the decoding and the upload of the sheets.     */
+/* Nyuu    | 18/10/26 | Load the cooked sprites (Trimmed frames).            */
+/* Nyuu    | 18/10/26 | Evict the sheets and reload them at the next draw.   */
+/* Nyuu    | 18/10/26 | Paths built in the frame arena.                      */
 /* ========================================================================= */
 
+#include "COM_Arena.h"
+#include "COM_Lz4.h"
+#include "SDL_Atlas.h"
 #include "SDL_Util.h"
 #include "SDL_Render.h"
 #include "SDL_Sprite.h"
 
 /* ========================================================================= */
 
+/*! Global variable to handle the clock stamped on the sprites drawn. */
+static Uint32 SDL_Sprite_clock = 0;
+
+/*! Global variable to handle the callback called when a sheet is loaded again. */
+static SDL_SpriteHook SDL_Sprite_reloadHook = NULL;
+
+/* ========================================================================= */
+
 /*!
- * \brief  Function to load a sprite.
+ * \brief  Function to allocate a sprite, without its sheet.
  *
  * \param  szSprName Name of the sprite.
- * \return A pointer to the loaded sprite, or NULL if error.
+ * \return A pointer to the pending sprite, or NULL if error.
+ *
+ * \remark A pending sprite has no frame, so drawing it does nothing until
+ *         SDL_Sprite_Upload gives it its sheet.
  */
-SDL_Sprite *SDL_Sprite_Alloc(const char *szSprName)
+SDL_Sprite *SDL_Sprite_AllocPending(const char *szSprName)
 {
-    SDL_RWops  *pSprRw    = NULL;
-    SDL_Sprite *pSprite   = NULL;
-    char       *szSprPath = NULL;
-    SDL_Rect    rTextureSize;
-    Uint32      iFrameWidth;
-    Uint32      iFrameHeight;
+    SDL_Sprite *pSprite = (SDL_Sprite *) UTIL_Malloc(sizeof(SDL_Sprite));
 
-    szSprPath = UTIL_StrBuild("sprites/", szSprName, ".spr", NULL);
+    if (pSprite)
+    {
+        memset(pSprite, 0, sizeof(SDL_Sprite));
 
-    if (szSprPath)
+        pSprite->bAtlas = SDL_FALSE;
+        pSprite->szName = UTIL_StrCopy(szSprName);
+
+        if (!pSprite->szName)
+        {
+            UTIL_Free(pSprite);
+        }
+    }
+
+    return pSprite;
+}
+
+/*!
+ * \brief  Function to decode the sheet of a cooked sprite.
+ *
+ * \param  szSprPath Path of the sprite file (Only useful for logs).
+ * \param  pData     Data of the sprite file.
+ * \param  iDataSize Size of the data (In bytes).
+ * \param  pLayout   Pointer to retrieve the frames of the sheet.
+ * \return A pointer to the decoded sheet, or NULL if error.
+ *
+ * \remark The pixels are already in the format of the atlas, so they are
+ *         only copied (Or decompressed) into the sheet.
+ */
+static SDL_Surface *SDL_Sprite_DecodeCooked(const char *szSprPath, const Uint8 *pData, Uint32 iDataSize, SDL_SpriteLayout *pLayout)
+{
+    SDL_SpriteCooked       sHeader;
+    const SDL_SpriteFrame *pFrame      = NULL;
+    SDL_Surface           *pSurface    = NULL;
+    size_t                 iFramesSize = 0;
+    size_t                 iSheetSize  = 0;
+    Uint32                 i           = 0;
+    SDL_bool               bValid      = SDL_FALSE;
+
+    memcpy(&sHeader, pData, sizeof(SDL_SpriteCooked));
+
+    iFramesSize = (size_t) sHeader.iNbFrames * sizeof(SDL_SpriteFrame);
+    iSheetSize  = (size_t) sHeader.iSheetW * sHeader.iSheetH * sizeof(Uint32);
+    bValid      = ((sHeader.iVersion == SDL_SPRITE_COOKED_VERSION) && (sHeader.iFormat == SDL_ATLAS_FORMAT) &&
+                   (sHeader.iNbFrames) && (sHeader.iNbFrames <= iDataSize) && (iSheetSize) &&
+                   (sizeof(SDL_SpriteCooked) + iFramesSize + sHeader.iDataSize <= iDataSize) &&
+                   ((sHeader.iFlags & SDL_SPRITE_COOKED_LZ4) || (sHeader.iDataSize == iSheetSize))) ? SDL_TRUE : SDL_FALSE;
+
+    /* ~~~ Every frame must be in the sheet ~~~ */
+    pFrame = (const SDL_SpriteFrame *) (pData + sizeof(SDL_SpriteCooked));
+
+    for (i = 0 ; bValid && (i < sHeader.iNbFrames) ; ++i)
     {
-        pSprRw = UTIL_RWOpen(szSprPath, "rb");
+        bValid = (((Uint32) pFrame[i].iX + pFrame[i].iW <= sHeader.iSheetW) &&
+                  ((Uint32) pFrame[i].iY + pFrame[i].iH <= sHeader.iSheetH)) ? SDL_TRUE : SDL_FALSE;
+    }
 
-        if (pSprRw)
+    if (bValid)
+    {
+        pLayout->pArrFrames = (SDL_SpriteFrame *) SDL_malloc(iFramesSize);
+        pSurface            = SDL_CreateRGBSurfaceWithFormat(0, sHeader.iSheetW, sHeader.iSheetH, 32, SDL_ATLAS_FORMAT);
+        bValid              = (pLayout->pArrFrames && pSurface && ((size_t) pSurface->pitch * pSurface->h == iSheetSize)) ? SDL_TRUE : SDL_FALSE;
+    }
+
+    if (bValid)
+    {
+        memcpy(pLayout->pArrFrames, pFrame, iFramesSize);
+
+        pLayout->iFrameW   = sHeader.iFrameW;
+        pLayout->iFrameH   = sHeader.iFrameH;
+        pLayout->iNbFrames = sHeader.iNbFrames;
+
+        pData += sizeof(SDL_SpriteCooked) + iFramesSize;
+
+        if (sHeader.iFlags & SDL_SPRITE_COOKED_LZ4)
+        {
+            bValid = (COM_Lz4_Decompress(pData, sHeader.iDataSize, pSurface->pixels, iSheetSize) == iSheetSize) ? SDL_TRUE : SDL_FALSE;
+        }
+        else
+        {
+            memcpy(pSurface->pixels, pData, iSheetSize);
+        }
+    }
+
+    if (!bValid)
+    {
+        COM_Log_Print(COM_LOG_ERROR, "Can't load the cooked sprite ( Corrupted data ? ) !");
+        COM_Log_Print(COM_LOG_ERROR, ">> Path \"%s\".\n", szSprPath);
+
+        if (pSurface)
         {
-            pSprite = (SDL_Sprite *) UTIL_Malloc(sizeof(SDL_Sprite));
+            SDL_FreeSurface(pSurface);
+            pSurface = NULL;
+        }
+
+        SDL_free(pLayout->pArrFrames);
+        pLayout->pArrFrames = NULL;
+        pLayout->iNbFrames  = 0;
+    }
+
+    return pSurface;
+}
+
+/*!
+ * \brief  Function to decode the sheet of a sprite.
+ *
+ * \param  szSprPath Path of the sprite file.
+ * \param  pLayout   Pointer to retrieve the frames of the sheet.
+ * \return A pointer to the decoded sheet, or NULL if error.
+ *
+ * \remark The file is read in one call (Or mapped from the pack), then
+ *         decoded as a cooked sprite if it starts with its magic, else as a
+ *         frame size followed by a PNG. The trimmed frames of the layout are
+ *         allocated by SDL (See SDL_Sprite_Upload).
+ *
+ * \remark Neither the renderer nor the memory counters are used, so the
+ *         sheet can be decoded by any thread.
+ */
+SDL_Surface *SDL_Sprite_Decode(const char *szSprPath, SDL_SpriteLayout *pLayout)
+{
+    SDL_RWops   *pPngRw    = NULL;
+    SDL_Surface *pSurface  = NULL;
+    Uint8       *pData     = NULL;
+    Uint32       iDataSize = 0;
+    SDL_bool     bMapped   = SDL_FALSE;
+
+    memset(pLayout, 0, sizeof(SDL_SpriteLayout));
+
+    pData = (Uint8 *) UTIL_RWRead(szSprPath, &iDataSize, &bMapped);
 
-            if (pSprite)
+    if (pData)
+    {
+        if ((iDataSize >= sizeof(SDL_SpriteCooked)) && (memcmp(pData, SDL_SPRITE_COOKED_MAGIC, 4) == 0))
+        {
+            pSurface = SDL_Sprite_DecodeCooked(szSprPath, pData, iDataSize, pLayout);
+        }
+        else if (iDataSize > 2 * sizeof(Sint32))
+        {
+            /* ~~~ Read the data... ~~~ */
+            memcpy(&pLayout->iFrameW, pData, sizeof(Sint32));
+            memcpy(&pLayout->iFrameH, pData + sizeof(Sint32), sizeof(Sint32));
+
+            /* ~~~ Read the PNG... ~~~ */
+            pPngRw = SDL_RWFromConstMem(pData + 2 * sizeof(Sint32), (int) (iDataSize - 2 * sizeof(Sint32)));
+
+            if (pPngRw)
             {
-                /* ~~~ Read the data... ~~~ */
-                SDL_RWread(pSprRw, &iFrameWidth,  sizeof( Sint32 ), 1);
-                SDL_RWread(pSprRw, &iFrameHeight, sizeof( Sint32 ), 1);
-
-                /* ~~~ Read the PNG... ~~~ */
-                pSprite->pTexture = UTIL_TextureLoadRW(szSprPath, pSprRw, &rTextureSize);
-                pSprite->szName   = UTIL_StrCopy(szSprName);
-
-                if (!pSprite->pTexture || !pSprite->szName) // Error: must free...
-                {
-                    UTIL_Free(pSprite->szName);
-                    UTIL_TextureFree(&pSprite->pTexture);
-                    UTIL_Free(pSprite);
-                }
-                else
-                {
-                    if ((!iFrameWidth) || (!iFrameHeight))
-                    {
-                        iFrameWidth  = rTextureSize.w;
-                        iFrameHeight = rTextureSize.h;
-                    }
-
-                    pSprite->iNbFrameW = rTextureSize.w / iFrameWidth;
-                    pSprite->iNbFrameH = rTextureSize.h / iFrameHeight;
-                    pSprite->iFrameMax = pSprite->iNbFrameW * pSprite->iNbFrameH;
-
-                    pSprite->sFrameClip.x     = 0;
-                    pSprite->sFrameClip.y     = 0;
-                    pSprite->sFrameClip.w     = iFrameWidth;
-                    pSprite->sFrameClip.h     = iFrameHeight;
-                    pSprite->sFramePosition.x = 0;
-                    pSprite->sFramePosition.y = 0;
-                    pSprite->sFramePosition.w = iFrameWidth;
-                    pSprite->sFramePosition.h = iFrameHeight;
-                    pSprite->sFrameCenter.x   = (iFrameWidth >> 1);
-                    pSprite->sFrameCenter.y   = (iFrameHeight >> 1);
-                }
+                pSurface = UTIL_SurfaceLoadRW(szSprPath, pPngRw);
+                UTIL_RWClose(&pPngRw);
             }
+        }
+
+        if (!bMapped)
+        {
+            SDL_free(pData);
+        }
+    }
+
+    return pSurface;
+}
+
+/*!
+ * \brief  Function to give its sheet to a pending sprite.
+ *
+ * \param  pSprite  Pointer to the pending sprite.
+ * \param  pSurface Pointer to the decoded sheet (Not freed).
+ * \param  pLayout  Pointer to the frames of the sheet.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark The sheet is packed in the atlas if possible, else it gets its
+ *         own texture. Must be called by the thread of the renderer.
+ *
+ * \remark The trimmed frames of the layout are given to the sprite, even if
+ *         error.
+ */
+SDL_bool SDL_Sprite_Upload(SDL_Sprite *pSprite, SDL_Surface *pSurface, SDL_SpriteLayout *pLayout)
+{
+    Uint32 iFrameWidth  = pLayout->iFrameW;
+    Uint32 iFrameHeight = pLayout->iFrameH;
+
+    pSprite->pArrFrames = pLayout->pArrFrames;
+    pLayout->pArrFrames = NULL;
+    pSprite->iLastUse   = SDL_Sprite_clock;
+
+    pSprite->bAtlas = SDL_Atlas_Add(pSurface, &pSprite->pTexture, &pSprite->sSheet);
+
+    if (!pSprite->bAtlas)
+    {
+        pSprite->pTexture = SDL_Render_CreateTextureFromSurface(pSurface);
+        pSprite->sSheet.x = 0;
+        pSprite->sSheet.y = 0;
+        pSprite->sSheet.w = pSurface->w;
+        pSprite->sSheet.h = pSurface->h;
+
+        if (!pSprite->pTexture)
+        {
+            COM_Log_Print(COM_LOG_CRITICAL, "Can't create a texture from the image !");
+            COM_Log_Print(COM_LOG_CRITICAL, ">> Sprite \"%s\".\n", pSprite->szName);
+
+            return SDL_FALSE;
+        }
+    }
+
+    if ((!iFrameWidth) || (!iFrameHeight))
+    {
+        iFrameWidth  = pSprite->sSheet.w;
+        iFrameHeight = pSprite->sSheet.h;
+    }
+
+    if (pSprite->pArrFrames)
+    {
+        pSprite->iNbFrameW = pLayout->iNbFrames;
+        pSprite->iNbFrameH = 1;
+    }
+    else
+    {
+        pSprite->iNbFrameW = pSprite->sSheet.w / iFrameWidth;
+        pSprite->iNbFrameH = pSprite->sSheet.h / iFrameHeight;
+    }
+
+    pSprite->iFrameMax = pSprite->iNbFrameW * pSprite->iNbFrameH;
+
+    pSprite->sFrameClip.x     = 0;
+    pSprite->sFrameClip.y     = 0;
+    pSprite->sFrameClip.w     = iFrameWidth;
+    pSprite->sFrameClip.h     = iFrameHeight;
+    pSprite->sFramePosition.x = 0;
+    pSprite->sFramePosition.y = 0;
+    pSprite->sFramePosition.w = iFrameWidth;
+    pSprite->sFramePosition.h = iFrameHeight;
+    pSprite->sFrameCenter.x   = (iFrameWidth >> 1);
+    pSprite->sFrameCenter.y   = (iFrameHeight >> 1);
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to load the sheet of a sprite.
+ *
+ * \param  pSprite Pointer to the pending sprite.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool SDL_Sprite_Load(SDL_Sprite *pSprite)
+{
+    SDL_Surface     *pSurface  = NULL;
+    char            *szSprPath = NULL;
+    SDL_bool         bRet      = SDL_FALSE;
+    SDL_SpriteLayout sLayout;
+    COM_ArenaMark    sMark;
+
+    COM_Arena_Mark(&sMark);
+
+    szSprPath = COM_Arena_StrBuild("sprites/", pSprite->szName, ".spr", NULL);
+
+    if (szSprPath)
+    {
+        pSurface = SDL_Sprite_Decode(szSprPath, &sLayout);
+
+        if (pSurface)
+        {
+            bRet = SDL_Sprite_Upload(pSprite, pSurface, &sLayout);
 
-            UTIL_RWClose(&pSprRw);
+            SDL_free(sLayout.pArrFrames);
+            SDL_FreeSurface(pSurface);
         }
+    }
+
+    COM_Arena_Rewind(&sMark);
+
+    return bRet;
+}
+
+/*!
+ * \brief  Function to load the sheet of an evicted sprite again.
+ *
+ * \param  pSprite Pointer to the evicted sprite.
+ * \return None.
+ *
+ * \remark A sprite which can't be loaded again draws nothing.
+ */
+static void SDL_Sprite_Reload(SDL_Sprite *pSprite)
+{
+    pSprite->bEvicted = SDL_FALSE;
 
-        UTIL_Free(szSprPath);
+    if (!SDL_Sprite_Load(pSprite))
+    {
+        pSprite->iFrameMax = 0;
+
+        COM_Log_Print(COM_LOG_ERROR, "Can't reload the sprite \"%s\" !", pSprite->szName);
+    }
+
+    if (SDL_Sprite_reloadHook)
+    {
+        SDL_Sprite_reloadHook(pSprite);
+    }
+}
+
+/*!
+ * \brief  Function to load a sprite.
+ *
+ * \param  szSprName Name of the sprite.
+ * \return A pointer to the loaded sprite, or NULL if error.
+ */
+SDL_Sprite *SDL_Sprite_Alloc(const char *szSprName)
+{
+    SDL_Sprite *pSprite = SDL_Sprite_AllocPending(szSprName);
+
+    if (pSprite && !SDL_Sprite_Load(pSprite)) // Error: must free...
+    {
+        SDL_Sprite_Free(&pSprite);
     }
 
     return pSprite;
@@ -104,6 +372,19 @@ const char *SDL_Sprite_GetName(const SDL_Sprite *pSprite)
     return pSprite->szName;
 }
 
+/*!
+ * \brief  Function to check if a sprite has its sheet.
+ *
+ * \param  pSprite Pointer to the sprite.
+ * \return SDL_TRUE if the sprite is loaded, else SDL_FALSE (Pending).
+ *
+ * \remark An evicted sprite is loaded (Its sheet comes back at the next draw).
+ */
+SDL_bool SDL_Sprite_IsLoaded(const SDL_Sprite *pSprite)
+{
+    return (pSprite->pTexture || pSprite->bEvicted) ? SDL_TRUE : SDL_FALSE;
+}
+
 /*!
  * \brief  Function to get the maximum frame of a sprite.
  *
@@ -128,6 +409,149 @@ void SDL_Sprite_GetFrameSize(const SDL_Sprite *pSprite, SDL_Rect *pSize)
     pSize->h = pSprite->sFrameClip.h;
 }
 
+/*!
+ * \brief  Function to set the clock stamped on the sprites drawn.
+ *
+ * \param  iClock Value of the clock (Usually the number of the frame).
+ * \return None.
+ */
+void SDL_Sprite_SetClock(Uint32 iClock)
+{
+    SDL_Sprite_clock = iClock;
+}
+
+/*!
+ * \brief  Function to set the callback called when a sheet is loaded again.
+ *
+ * \param  pHook Function to call (NULL => None).
+ * \return None.
+ */
+void SDL_Sprite_SetReloadHook(SDL_SpriteHook pHook)
+{
+    SDL_Sprite_reloadHook = pHook;
+}
+
+/*!
+ * \brief  Function to get the clock of the last draw of a sprite.
+ *
+ * \param  pSprite Pointer to the sprite.
+ * \return The clock of the last draw (Or of the upload if never drawn).
+ */
+Uint32 SDL_Sprite_GetLastUse(const SDL_Sprite *pSprite)
+{
+    return pSprite->iLastUse;
+}
+
+/*!
+ * \brief  Function to get the memory used by the own texture of a sprite.
+ *
+ * \param  pSprite Pointer to the sprite.
+ * \return The estimated memory of the texture (In bytes), 0 if the sheet is
+ *         in the atlas or not loaded.
+ */
+Uint32 SDL_Sprite_GetBytes(const SDL_Sprite *pSprite)
+{
+    if (pSprite->bAtlas || !pSprite->pTexture)
+    {
+        return 0;
+    }
+
+    return (Uint32) pSprite->sSheet.w * (Uint32) pSprite->sSheet.h * 4;
+}
+
+/*!
+ * \brief  Function to get the atlas page of a sprite.
+ *
+ * \param  pSprite Pointer to the sprite.
+ * \return A pointer to the texture of the page, or NULL if the sprite has
+ *         its own texture or is not loaded.
+ */
+SDL_Texture *SDL_Sprite_GetPage(const SDL_Sprite *pSprite)
+{
+    return pSprite->bAtlas ? pSprite->pTexture : NULL;
+}
+
+/*!
+ * \brief  Function to evict the sheet of a sprite.
+ *
+ * \param  pSprite Pointer to the loaded sprite.
+ * \return None.
+ *
+ * \remark The own texture is freed, an atlas page must be cleared by the
+ *         caller. The sprite keeps its name and its frame size, so it stays
+ *         valid, and its sheet is loaded again by its next draw.
+ */
+void SDL_Sprite_Evict(SDL_Sprite *pSprite)
+{
+    if (!pSprite->bAtlas)
+    {
+        UTIL_TextureFree(&pSprite->pTexture);
+    }
+
+    SDL_free(pSprite->pArrFrames);
+
+    pSprite->pArrFrames = NULL;
+    pSprite->pTexture   = NULL;
+    pSprite->bAtlas     = SDL_FALSE;
+    pSprite->bEvicted   = SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to get the rectangles of a frame.
+ *
+ * \param  pSprite   Pointer to the sprite.
+ * \param  pPos      Pointer to a point to position the sprite.
+ * \param  iFrame    Index of the frame (Valid).
+ * \param  iFlip     Flag to flip the sprite.
+ * \param  pClip     Rectangle to retrieve the frame in the texture.
+ * \param  pPosition Rectangle to retrieve the frame on the screen.
+ * \param  pCenter   Point to retrieve the center of the frame (Relative to the position).
+ * \return SDL_TRUE if the frame has pixels, else SDL_FALSE.
+ *
+ * \remark A trimmed frame is drawn at its offset in the frame, mirrored if
+ *         the sprite is flipped, so it lands where the full frame would.
+ */
+static SDL_bool SDL_Sprite_GetFrame(const SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame, SDL_RendererFlip iFlip,
+                                    SDL_Rect *pClip, SDL_Rect *pPosition, SDL_Point *pCenter)
+{
+    const SDL_SpriteFrame *pFrame = NULL;
+
+    if (!pSprite->pArrFrames)
+    {
+        pClip->x     = pSprite->sSheet.x + ((iFrame % pSprite->iNbFrameW) * pSprite->sFrameClip.w);
+        pClip->y     = pSprite->sSheet.y + ((iFrame / pSprite->iNbFrameW) * pSprite->sFrameClip.h);
+        pClip->w     = pSprite->sFrameClip.w;
+        pClip->h     = pSprite->sFrameClip.h;
+        pPosition->x = pPos->x;
+        pPosition->y = pPos->y;
+        pPosition->w = pSprite->sFrameClip.w;
+        pPosition->h = pSprite->sFrameClip.h;
+        *pCenter     = pSprite->sFrameCenter;
+
+        return SDL_TRUE;
+    }
+
+    pFrame = &pSprite->pArrFrames[iFrame];
+
+    if ((!pFrame->iW) || (!pFrame->iH))
+    {
+        return SDL_FALSE;
+    }
+
+    pClip->x     = pSprite->sSheet.x + pFrame->iX;
+    pClip->y     = pSprite->sSheet.y + pFrame->iY;
+    pClip->w     = pFrame->iW;
+    pClip->h     = pFrame->iH;
+    pPosition->x = pPos->x + ((iFlip & SDL_FLIP_HORIZONTAL) ? (pSprite->sFrameClip.w - pFrame->iOffsetX - pFrame->iW) : pFrame->iOffsetX);
+    pPosition->y = pPos->y + ((iFlip & SDL_FLIP_VERTICAL)   ? (pSprite->sFrameClip.h - pFrame->iOffsetY - pFrame->iH) : pFrame->iOffsetY);
+    pPosition->w = pFrame->iW;
+    pPosition->h = pFrame->iH;
+    pCenter->x   = pSprite->sFrameCenter.x - (pPosition->x - pPos->x);
+    pCenter->y   = pSprite->sFrameCenter.y - (pPosition->y - pPos->y);
+
+    return SDL_TRUE;
+}
+
 /*!
  * \brief  Function to draw a sprite.
  *
@@ -138,14 +562,20 @@ void SDL_Sprite_GetFrameSize(const SDL_Sprite *pSprite, SDL_Rect *pSize)
  */
 void SDL_Sprite_Draw(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame)
 {
-    if(iFrame < pSprite->iFrameMax)
+    SDL_Rect  sClip;
+    SDL_Rect  sPosition;
+    SDL_Point sCenter;
+
+    pSprite->iLastUse = SDL_Sprite_clock;
+
+    if (pSprite->bEvicted)
     {
-        pSprite->sFrameClip.x     = ((iFrame % pSprite->iNbFrameW) * pSprite->sFrameClip.w);
-        pSprite->sFrameClip.y     = ((iFrame / pSprite->iNbFrameW) * pSprite->sFrameClip.h);
-        pSprite->sFramePosition.x = pPos->x;
-        pSprite->sFramePosition.y = pPos->y;
+        SDL_Sprite_Reload(pSprite);
+    }
 
-        SDL_Render_DrawTexture(pSprite->pTexture, &pSprite->sFrameClip, &pSprite->sFramePosition);
+    if ((iFrame < pSprite->iFrameMax) && SDL_Sprite_GetFrame(pSprite, pPos, iFrame, SDL_FLIP_NONE, &sClip, &sPosition, &sCenter))
+    {
+        SDL_Render_DrawTexture(pSprite->pTexture, &sClip, &sPosition);
     }
 }
 
@@ -161,14 +591,20 @@ void SDL_Sprite_Draw(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame)
  */
 void SDL_Sprite_DrawEx(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame, double dAngle, SDL_RendererFlip iFlip)
 {
-    if(iFrame < pSprite->iFrameMax)
+    SDL_Rect  sClip;
+    SDL_Rect  sPosition;
+    SDL_Point sCenter;
+
+    pSprite->iLastUse = SDL_Sprite_clock;
+
+    if (pSprite->bEvicted)
     {
-        pSprite->sFrameClip.x     = ((iFrame % pSprite->iNbFrameW) * pSprite->sFrameClip.w);
-        pSprite->sFrameClip.y     = ((iFrame / pSprite->iNbFrameW) * pSprite->sFrameClip.h);
-        pSprite->sFramePosition.x = pPos->x;
-        pSprite->sFramePosition.y = pPos->y;
+        SDL_Sprite_Reload(pSprite);
+    }
 
-        SDL_Render_DrawTextureEx(pSprite->pTexture, &pSprite->sFrameClip, &pSprite->sFramePosition, dAngle, &pSprite->sFrameCenter, iFlip);
+    if ((iFrame < pSprite->iFrameMax) && SDL_Sprite_GetFrame(pSprite, pPos, iFrame, iFlip, &sClip, &sPosition, &sCenter))
+    {
+        SDL_Render_DrawTextureEx(pSprite->pTexture, &sClip, &sPosition, dAngle, &sCenter, iFlip);
     }
 }
 
@@ -181,7 +617,14 @@ void SDL_Sprite_DrawEx(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame
 void SDL_Sprite_Free(SDL_Sprite **ppSprite)
 {
     UTIL_Free((*ppSprite)->szName);
-    UTIL_TextureFree(&(*ppSprite)->pTexture);
+    SDL_free((*ppSprite)->pArrFrames);
+
+    /* ~~~ The atlas pages are freed with the atlas ~~~ */
+    if (!(*ppSprite)->bAtlas)
+    {
+        UTIL_TextureFree(&(*ppSprite)->pTexture);
+    }
+
     UTIL_Free(*ppSprite);
 }
 
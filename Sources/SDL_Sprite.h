@@ -10,13 +10,79 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 09/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | The sheets are packed in the atlas.                  */
+/* Nyuu    | 18/10/26 | Split the decoding and the upload of the sheets.     */
+/* Nyuu    | 18/10/26 | Load the cooked sprites (Trimmed frames).            */
+/* Nyuu    | 18/10/26 | Evict the sheets and reload them at the next draw.   */
 /* ========================================================================= */
 
 #ifndef __SDL_SPRITE_H__
 #define __SDL_SPRITE_H__
 
     #include "SDL_Shared.h"
-    
+
+    /*
+     * A cooked sprite (Tools/Cook) keeps the path of its source, and starts
+     * with the magic below instead of the size of a frame:
+     *
+     *     SDL_SpriteCooked, SDL_SpriteFrame[iNbFrames], pixels
+     *
+     * The pixels are the trimmed frames packed in a sheet, in the format of
+     * the atlas, compressed with LZ4 if the flag is set. The frames with the
+     * same pixels share their rectangle in the sheet.
+     */
+
+    /*! Magic number of a cooked sprite. */
+    #define SDL_SPRITE_COOKED_MAGIC   "NSPC"
+    /*! Version of the cooked sprites. */
+    #define SDL_SPRITE_COOKED_VERSION 1
+    /*! Flag set if the pixels of a cooked sprite are compressed (LZ4 block). */
+    #define SDL_SPRITE_COOKED_LZ4     0x00000001
+
+    /*!
+     * \struct SDL_SpriteCooked
+     * \brief  Structure to handle the header of a cooked sprite.
+     */
+    typedef struct
+    {
+        char   arrMagic[4]; /*!< Magic number (SDL_SPRITE_COOKED_MAGIC). */
+        Uint32 iVersion;    /*!< Version of the file (SDL_SPRITE_COOKED_VERSION). */
+        Uint32 iFlags;      /*!< Flags of the file (SDL_SPRITE_COOKED_LZ4). */
+        Uint32 iFormat;     /*!< Format of the pixels (SDL_ATLAS_FORMAT). */
+        Uint32 iFrameW;     /*!< Width of a frame, before the trim. */
+        Uint32 iFrameH;     /*!< Height of a frame, before the trim. */
+        Uint32 iNbFrames;   /*!< Number of frames. */
+        Uint32 iSheetW;     /*!< Width of the sheet of the trimmed frames. */
+        Uint32 iSheetH;     /*!< Height of the sheet of the trimmed frames. */
+        Uint32 iDataSize;   /*!< Size of the pixels stored (In bytes). */
+    } SDL_SpriteCooked;
+
+    /*!
+     * \struct SDL_SpriteFrame
+     * \brief  Structure to handle a trimmed frame.
+     */
+    typedef struct
+    {
+        Uint16 iX;       /*!< Position of the frame in the sheet (X). */
+        Uint16 iY;       /*!< Position of the frame in the sheet (Y). */
+        Uint16 iW;       /*!< Width of the opaque pixels (0 => Empty frame). */
+        Uint16 iH;       /*!< Height of the opaque pixels (0 => Empty frame). */
+        Sint16 iOffsetX; /*!< Position of the opaque pixels in the frame (X). */
+        Sint16 iOffsetY; /*!< Position of the opaque pixels in the frame (Y). */
+    } SDL_SpriteFrame;
+
+    /*!
+     * \struct SDL_SpriteLayout
+     * \brief  Structure to handle the frames of a decoded sheet.
+     */
+    typedef struct
+    {
+        Uint32           iFrameW;    /*!< Width of a frame (0 => Whole sheet). */
+        Uint32           iFrameH;    /*!< Height of a frame (0 => Whole sheet). */
+        Uint32           iNbFrames;  /*!< Number of trimmed frames. */
+        SDL_SpriteFrame *pArrFrames; /*!< Trimmed frames (NULL => Grid of frames). */
+    } SDL_SpriteLayout;
+
     /*!
      * \struct SDL_Sprite
      * \brief  Structure to handle a sprite.
@@ -24,23 +90,44 @@
     typedef struct
     {
         char        *szName;       /*!< Name of the sprite. */
-        SDL_Texture *pTexture;     /*!< Pointer to the texture. */
+        SDL_Texture *pTexture;     /*!< Pointer to the texture (Own texture or atlas page). */
+        SDL_Rect     sSheet;       /*!< Rectangle of the sheet in the texture. */
+        SDL_bool     bAtlas;       /*!< Flag set if the texture is an atlas page. */
 
         Uint32       iNbFrameW;    /*!< Number of frame (Width). */
         Uint32       iNbFrameH;    /*!< Number of frame (Height). */
         Uint32       iFrameMax;    /*!< Maximum frame. */
 
+        SDL_SpriteFrame *pArrFrames; /*!< Trimmed frames (NULL => Grid of frames). */
+
+        SDL_bool     bEvicted;     /*!< Flag set if the sheet was evicted (Loaded again by the next draw). */
+        Uint32       iLastUse;     /*!< Clock of the last draw (See SDL_Sprite_SetClock). */
+
         SDL_Rect     sFrameClip;     /*!< Frame clip. */
         SDL_Rect     sFramePosition; /*!< Frame position. */
         SDL_Point    sFrameCenter;   /*!< Frame center. */
     } SDL_Sprite;
 
-    SDL_Sprite *SDL_Sprite_Alloc(const char *szSprName);
+    /*! Callback called when the sheet of an evicted sprite is loaded again. */
+    typedef void (*SDL_SpriteHook)(SDL_Sprite *pSprite);
+
+    SDL_Sprite  *SDL_Sprite_AllocPending(const char *szSprName);
+    SDL_Surface *SDL_Sprite_Decode(const char *szSprPath, SDL_SpriteLayout *pLayout);
+    SDL_bool     SDL_Sprite_Upload(SDL_Sprite *pSprite, SDL_Surface *pSurface, SDL_SpriteLayout *pLayout);
+    SDL_Sprite  *SDL_Sprite_Alloc(const char *szSprName);
 
     const char *SDL_Sprite_GetName(const SDL_Sprite *pSprite);
+    SDL_bool    SDL_Sprite_IsLoaded(const SDL_Sprite *pSprite);
     Uint32      SDL_Sprite_GetFrameMax(const SDL_Sprite *pSprite);
     void        SDL_Sprite_GetFrameSize(const SDL_Sprite *pSprite, SDL_Rect *pSize);
 
+    void         SDL_Sprite_SetClock(Uint32 iClock);
+    void         SDL_Sprite_SetReloadHook(SDL_SpriteHook pHook);
+    Uint32       SDL_Sprite_GetLastUse(const SDL_Sprite *pSprite);
+    Uint32       SDL_Sprite_GetBytes(const SDL_Sprite *pSprite);
+    SDL_Texture *SDL_Sprite_GetPage(const SDL_Sprite *pSprite);
+    void         SDL_Sprite_Evict(SDL_Sprite *pSprite);
+
     void        SDL_Sprite_Draw(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame);
     void        SDL_Sprite_DrawEx(SDL_Sprite *pSprite, const SDL_Point *pPos, Uint32 iFrame, double dAngle, SDL_RendererFlip iFlip);
 
@@ -10,13 +10,38 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 13/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Flush the sprite batch before freeing a texture.     */
+/* Nyuu    | 18/10/26 | Add UTIL_SurfaceLoadRW for the atlas.                */
+/* Nyuu    | 18/10/26 | Read the assets through the pack when it is mounted. */
+/* Nyuu    | 18/10/26 | Add UTIL_RWRead to read a whole file.                */
 /* ========================================================================= */
 
+#include "SDL_Pack.h"
 #include "SDL_Render.h"
 #include "SDL_Util.h"
 
 /* ========================================================================= */
 
+/*!
+ * \brief  Function to load an image from a RWops.
+ *
+ * \param  szPath Path of the image (Only useful for logs).
+ * \param  pRWops Pointer to a RWops.
+ * \return A pointer to the loaded image, or NULL if error.
+ */
+SDL_Surface *UTIL_SurfaceLoadRW(const char *szPath, SDL_RWops *pRWops)
+{
+    SDL_Surface *pSurface = IMG_LoadPNG_RW(pRWops); // Only PNG are allowed.
+
+    if (pSurface == NULL)
+    {
+        COM_Log_Print(COM_LOG_ERROR, "Can't load the image ( Corrupted data ? ) !");
+        COM_Log_Print(COM_LOG_ERROR, ">> Path \"%s\".\n", szPath);
+    }
+
+    return pSurface;
+}
+
 /*!
  * \brief  Function to load a texture from a RWops.
  *
@@ -88,6 +113,7 @@ void UTIL_TextureFree(SDL_Texture **ppTexture)
 {
     if (*ppTexture != NULL)
     {
+        SDL_Render_Flush( );
         SDL_DestroyTexture(*ppTexture);
         *ppTexture = NULL;
     }
@@ -99,10 +125,21 @@ void UTIL_TextureFree(SDL_Texture **ppTexture)
  * \param szPath Path of the file to open.
  * \param szMode Mode used to open the file.
  * \return A pointer to the opened file using a RWops, or NULL if error.
+ *
+ * \remark If a pack is mounted, the files read only come from the pack.
  */
 SDL_RWops *UTIL_RWOpen(const char *szPath, const char *szMode)
 {
-    SDL_RWops *pRw = SDL_RWFromFile(szPath, szMode);
+    SDL_RWops *pRw = NULL;
+
+    if (SDL_Pack_IsMounted( ) && (strcmp(szMode, "rb") == 0))
+    {
+        pRw = SDL_Pack_Open(szPath);
+    }
+    else
+    {
+        pRw = SDL_RWFromFile(szPath, szMode);
+    }
 
     if (pRw == NULL)
     {
@@ -129,6 +166,57 @@ void UTIL_RWClose(SDL_RWops **ppRw)
     }
 }
 
+/*!
+ * \brief  Function to read a whole file.
+ *
+ * \param  szPath    Path of the file.
+ * \param  pDataSize Pointer to retrieve the size of the data (In bytes).
+ * \param  pMapped   Pointer to retrieve if the data is mapped from the pack.
+ * \return A pointer to the data (Freed by SDL_free if not mapped), or NULL if
+ *         error.
+ *
+ * \remark The data is allocated by SDL, out of the memory counters, so the
+ *         file can be read by any thread. A file of the pack is not copied.
+ */
+void *UTIL_RWRead(const char *szPath, Uint32 *pDataSize, SDL_bool *pMapped)
+{
+    SDL_RWops *pRw       = NULL;
+    void      *pFileData = (void *) SDL_Pack_Map(szPath, pDataSize);
+    Sint64     iSize     = 0;
+
+    *pMapped = pFileData ? SDL_TRUE : SDL_FALSE;
+
+    if (pFileData)
+    {
+        return pFileData;
+    }
+
+    pRw = UTIL_RWOpen(szPath, "rb");
+
+    if (pRw)
+    {
+        iSize = SDL_RWsize(pRw);
+
+        if (iSize > 0)
+        {
+            pFileData = SDL_malloc((size_t) iSize);
+
+            if (pFileData && (SDL_RWread(pRw, pFileData, (size_t) iSize, 1) != 1))
+            {
+                COM_Log_Print(COM_LOG_ERROR, "Can't read the file \"%s\" !", szPath);
+
+                SDL_free(pFileData);
+                pFileData = NULL;
+            }
+        }
+
+        *pDataSize = (Uint32) iSize;
+        UTIL_RWClose(&pRw);
+    }
+
+    return pFileData;
+}
+
 /*!
  * \brief  Function to load a music.
  *
@@ -137,9 +225,10 @@ void UTIL_RWClose(SDL_RWops **ppRw)
  */
 Mix_Music *UTIL_MusicLoad(const char *szPath)
 {
-    Mix_Music *pMusic = Mix_LoadMUS(szPath);
+    SDL_RWops *pRw    = UTIL_RWOpen(szPath, "rb");
+    Mix_Music *pMusic = pRw ? Mix_LoadMUS_RW(pRw, 1) : NULL;
 
-    if (pMusic == NULL)
+    if (pRw && (pMusic == NULL))
     {
         COM_Log_Print(COM_LOG_ERROR, "Can't load a music !");
         COM_Log_Print(COM_LOG_ERROR, ">> Path \"%s\".\n", szPath);
@@ -171,9 +260,10 @@ void UTIL_MusicFree(Mix_Music **ppMusic)
 */
 Mix_Chunk *UTIL_ChunkLoad(const char *szPath)
 {
-    Mix_Chunk *pChunk = Mix_LoadWAV(szPath);
+    SDL_RWops *pRw    = UTIL_RWOpen(szPath, "rb");
+    Mix_Chunk *pChunk = pRw ? Mix_LoadWAV_RW(pRw, 1) : NULL;
 
-    if (pChunk == NULL)
+    if (pRw && (pChunk == NULL))
     {
         COM_Log_Print(COM_LOG_ERROR, "Can't load a sound !");
         COM_Log_Print(COM_LOG_ERROR, ">> Path \"%s\".\n", szPath);
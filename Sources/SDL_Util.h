@@ -10,6 +10,8 @@
 /* Author  | Date     | Comments                                             */
 /* --------+----------+----------------------------------------------------- */
 /* Nyuu    | 13/06/15 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Add UTIL_SurfaceLoadRW for the atlas.                */
+/* Nyuu    | 18/10/26 | Add UTIL_RWRead to read a whole file.                */
 /* ========================================================================= */
 
 #ifndef __SDL_UTIL_H__
@@ -17,11 +19,13 @@
     
     #include "SDL_Shared.h"
 
+    SDL_Surface *UTIL_SurfaceLoadRW(const char *szPath, SDL_RWops *pRWops);
     SDL_Texture *UTIL_TextureLoadRW(const char *szPath, SDL_RWops *pRWops, SDL_Rect *pTextureSize);
     SDL_Texture *UTIL_TextureLoad(const char *szPath, SDL_Rect *pTextureSize);
     void         UTIL_TextureFree(SDL_Texture **ppTexture);
     SDL_RWops   *UTIL_RWOpen(const char *szPath, const char *szMode);
     void         UTIL_RWClose(SDL_RWops **pRw);
+    void        *UTIL_RWRead(const char *szPath, Uint32 *pDataSize, SDL_bool *pMapped);
     Mix_Music   *UTIL_MusicLoad(const char *szPath);
     void         UTIL_MusicFree(Mix_Music **ppMusic);
     Mix_Chunk   *UTIL_ChunkLoad(const char *szPath);
@@ -0,0 +1,358 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Voice.c
+ * \brief   File to handle the voices of the sounds.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "SDL_Util.h"
+#include "SDL_Voice.h"
+
+/* ========================================================================= */
+
+/*! Number of bits of the channel in a handle. */
+#define SDL_VOICE_CHANNEL_BITS 8
+/*! Mask of the channel in a handle. */
+#define SDL_VOICE_CHANNEL_MASK ((1 << SDL_VOICE_CHANNEL_BITS) - 1)
+/*! Mask of the number of the play in a handle. */
+#define SDL_VOICE_SERIAL_MASK  (0xFFFFFFFF >> SDL_VOICE_CHANNEL_BITS)
+
+/* ========================================================================= */
+
+/*!
+ * \struct SDL_VoiceSlot
+ * \brief  Structure to handle a voice (One mixer channel).
+ */
+typedef struct
+{
+    SDL_Sound         *pSound;    /*!< Pointer to the sound played last (NULL => Never used). */
+    SDL_VoicePriority  iPriority; /*!< Priority of the sound. */
+    Uint32             iVolume;   /*!< Volume of the sound (0 - 128). */
+    Uint32             iSerial;   /*!< Number of the play (Part of the handle). */
+    Uint32             iFrame;    /*!< Frame of the play. */
+} SDL_VoiceSlot;
+
+/*!
+ * \struct SDL_Voice
+ * \brief  Structure to handle the voices.
+ */
+typedef struct
+{
+    SDL_VoiceSlot  *pArrSlots; /*!< Array of the voices (Index => Channel). */
+    Uint32          iNbSlots;  /*!< Number of voices. */
+    Uint32          iSerial;   /*!< Number of the last play. */
+    Uint32          iFrame;    /*!< Number of the frame (See SDL_Voice_Update). */
+    SDL_VoiceStats  sStats;    /*!< Statistics of the voices. */
+} SDL_Voice;
+
+/*! Global variable to handle the voices. */
+static SDL_Voice SDL_voice;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get the voice of a handle.
+ *
+ * \param  iVoice Handle of the voice.
+ * \return A pointer to the voice, or NULL if the handle is outdated.
+ */
+static SDL_VoiceSlot *SDL_Voice_GetSlot(Uint32 iVoice)
+{
+    Uint32 iChannel = iVoice & SDL_VOICE_CHANNEL_MASK;
+
+    if ((iVoice == SDL_VOICE_NONE) || (iChannel >= SDL_voice.iNbSlots) ||
+        (SDL_voice.pArrSlots[iChannel].iSerial != (iVoice >> SDL_VOICE_CHANNEL_BITS)))
+    {
+        return NULL;
+    }
+
+    return &SDL_voice.pArrSlots[iChannel];
+}
+
+/*!
+ * \brief  Function to set the volume of a channel.
+ *
+ * \param  iChannel Channel of the voice.
+ * \param  iVolume  Volume of the sound (0 - 128), before the global volume.
+ * \return None.
+ */
+static void SDL_Voice_SetChannelVolume(Uint32 iChannel, Uint32 iVolume)
+{
+    Mix_Volume((int) iChannel, (int) ((iVolume * SDL_Sound_GetGlobalVolume( )) / 100));
+}
+
+/*!
+ * \brief  Function to find a voice for a new sound.
+ *
+ * \param  iPriority Priority of the new sound.
+ * \return The channel of the voice, or -1 if none can be used.
+ *
+ * \remark A free voice is used first. Else the voice of lowest priority,
+ *         then the oldest, is stolen if the new sound ranks higher. A voice
+ *         started in the same frame is only stolen by a higher priority, and
+ *         a critical sound is never stolen.
+ */
+static Sint32 SDL_Voice_Find(SDL_VoicePriority iPriority)
+{
+    SDL_VoiceSlot *pSlot = NULL;
+    SDL_VoiceSlot *pBest = NULL;
+    Sint32         iBest = -1;
+    Uint32         i     = 0;
+
+    for (i = 0 ; i < SDL_voice.iNbSlots ; ++i)
+    {
+        if (!Mix_Playing((int) i))
+        {
+            return (Sint32) i;
+        }
+
+        pSlot = &SDL_voice.pArrSlots[i];
+
+        if ((!pBest) || (pSlot->iPriority < pBest->iPriority) ||
+            ((pSlot->iPriority == pBest->iPriority) && ((Sint32) (pSlot->iSerial - pBest->iSerial) < 0)))
+        {
+            pBest = pSlot;
+            iBest = (Sint32) i;
+        }
+    }
+
+    if (pBest && (pBest->iPriority < SDL_VOICE_CRITICAL) &&
+        ((pBest->iPriority < iPriority) || ((pBest->iPriority == iPriority) && (pBest->iFrame != SDL_voice.iFrame))))
+    {
+        return iBest;
+    }
+
+    return -1;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to init the voices.
+ *
+ * \param  iNbVoices Number of voices (0 => SDL_VOICE_DEFAULT).
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ *
+ * \remark Each voice is a channel of the mixer, so the channels must not be
+ *         used by another module.
+ */
+SDL_bool SDL_Voice_Init(Uint32 iNbVoices)
+{
+    memset(&SDL_voice, 0, sizeof(SDL_Voice));
+
+    iNbVoices = iNbVoices ? COM_Math_Min(iNbVoices, SDL_VOICE_MAX) : SDL_VOICE_DEFAULT;
+
+    SDL_voice.pArrSlots = (SDL_VoiceSlot *) UTIL_Malloc(sizeof(SDL_VoiceSlot) * iNbVoices);
+
+    if (!SDL_voice.pArrSlots)
+    {
+        return SDL_FALSE;
+    }
+
+    memset(SDL_voice.pArrSlots, 0, sizeof(SDL_VoiceSlot) * iNbVoices);
+
+    SDL_voice.iNbSlots         = (Uint32) COM_Math_Max(Mix_AllocateChannels((int) iNbVoices), 0);
+    SDL_voice.sStats.iNbVoices = SDL_voice.iNbSlots;
+
+    COM_Log_Print(COM_LOG_INFO, "Voices: %d mixer channels.", SDL_voice.iNbSlots);
+
+    return SDL_voice.iNbSlots ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to play a sound on a voice.
+ *
+ * \param  pSound    Pointer to the sound.
+ * \param  iPriority Priority of the sound (See SDL_Voice_Find).
+ * \param  iVolume   Volume of the sound (0 - 128).
+ * \param  iLoops    Number of times the sound must be looped (-1 => Forever).
+ * \return The handle of the voice, or SDL_VOICE_NONE if the sound is dropped.
+ *
+ * \remark The same sound played again in the same frame is merged into its
+ *         first voice, which takes the loudest volume and the highest
+ *         priority. The volume is the one of the voice, so the other plays
+ *         of the sound keep their own.
+ */
+Uint32 SDL_Voice_Play(SDL_Sound *pSound, SDL_VoicePriority iPriority, Uint32 iVolume, Sint32 iLoops)
+{
+    SDL_VoiceSlot *pSlot    = NULL;
+    Sint32         iChannel = -1;
+    Uint32         i        = 0;
+
+    /* ~~~ Same trigger in the frame: one voice ~~~ */
+    for (i = 0 ; i < SDL_voice.iNbSlots ; ++i)
+    {
+        pSlot = &SDL_voice.pArrSlots[i];
+
+        if ((pSlot->pSound == pSound) && (pSlot->iFrame == SDL_voice.iFrame) && Mix_Playing((int) i))
+        {
+            if (iVolume > pSlot->iVolume)
+            {
+                pSlot->iVolume = iVolume;
+                SDL_Voice_SetChannelVolume(i, iVolume);
+            }
+
+            pSlot->iPriority = COM_Math_Max(pSlot->iPriority, iPriority);
+            SDL_voice.sStats.iNbCoalesced++;
+
+            return (pSlot->iSerial << SDL_VOICE_CHANNEL_BITS) | i;
+        }
+    }
+
+    iChannel = SDL_Voice_Find(iPriority);
+
+    if (iChannel < 0)
+    {
+        SDL_voice.sStats.iNbDropped++;
+        return SDL_VOICE_NONE;
+    }
+
+    if (Mix_Playing(iChannel))
+    {
+        Mix_HaltChannel(iChannel);
+        SDL_voice.sStats.iNbStolen++;
+    }
+
+    pSlot = &SDL_voice.pArrSlots[iChannel];
+
+    if (SDL_Sound_Play(pSound, (Uint32) iChannel, iVolume, iLoops) < 0)
+    {
+        pSlot->pSound = NULL;
+        SDL_voice.sStats.iNbDropped++;
+
+        return SDL_VOICE_NONE;
+    }
+
+    /* ~~~ The number of the play is never 0, so a handle is never SDL_VOICE_NONE ~~~ */
+    SDL_voice.iSerial = (SDL_voice.iSerial + 1) & SDL_VOICE_SERIAL_MASK;
+    SDL_voice.iSerial = SDL_voice.iSerial ? SDL_voice.iSerial : 1;
+
+    pSlot->pSound    = pSound;
+    pSlot->iPriority = iPriority;
+    pSlot->iVolume   = iVolume;
+    pSlot->iSerial   = SDL_voice.iSerial;
+    pSlot->iFrame    = SDL_voice.iFrame;
+
+    SDL_voice.sStats.iNbPlays++;
+
+    return (pSlot->iSerial << SDL_VOICE_CHANNEL_BITS) | (Uint32) iChannel;
+}
+
+/*!
+ * \brief  Function to check if a voice still plays its sound.
+ *
+ * \param  iVoice Handle of the voice.
+ * \return SDL_TRUE if the sound is playing, else SDL_FALSE (Ended or stolen).
+ */
+SDL_bool SDL_Voice_IsPlaying(Uint32 iVoice)
+{
+    return (SDL_Voice_GetSlot(iVoice) && Mix_Playing((int) (iVoice & SDL_VOICE_CHANNEL_MASK))) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to set the volume of a voice.
+ *
+ * \param  iVoice  Handle of the voice (Nothing is done if outdated).
+ * \param  iVolume Volume of the sound (0 - 128).
+ * \return None.
+ */
+void SDL_Voice_SetVolume(Uint32 iVoice, Uint32 iVolume)
+{
+    SDL_VoiceSlot *pSlot = SDL_Voice_GetSlot(iVoice);
+
+    if (pSlot)
+    {
+        pSlot->iVolume = iVolume;
+        SDL_Voice_SetChannelVolume(iVoice & SDL_VOICE_CHANNEL_MASK, iVolume);
+    }
+}
+
+/*!
+ * \brief  Function to stop a voice.
+ *
+ * \param  iVoice Handle of the voice (Nothing is done if outdated).
+ * \return None.
+ */
+void SDL_Voice_Stop(Uint32 iVoice)
+{
+    if (SDL_Voice_GetSlot(iVoice))
+    {
+        Mix_HaltChannel((int) (iVoice & SDL_VOICE_CHANNEL_MASK));
+    }
+}
+
+/*!
+ * \brief  Function to stop all the voices.
+ *
+ * \return None.
+ */
+void SDL_Voice_StopAll(void)
+{
+    Mix_HaltChannel(-1);
+}
+
+/*!
+ * \brief  Function to start a new frame of the voices.
+ *
+ * \return None.
+ *
+ * \remark Called once per frame, it ends the merge of the sounds of the
+ *         previous frame and samples the voices playing.
+ */
+void SDL_Voice_Update(void)
+{
+    SDL_VoiceStats *pStats = &SDL_voice.sStats;
+    Uint32          i      = 0;
+
+    SDL_voice.iFrame++;
+
+    pStats->iNbBusy = 0;
+
+    for (i = 0 ; i < SDL_voice.iNbSlots ; ++i)
+    {
+        pStats->iNbBusy += Mix_Playing((int) i) ? 1 : 0;
+    }
+
+    pStats->iPeakBusy  = COM_Math_Max(pStats->iPeakBusy, pStats->iNbBusy);
+    pStats->iBusySum  += pStats->iNbBusy;
+    pStats->iNbUpdates++;
+}
+
+/*!
+ * \brief  Function to get the statistics of the voices.
+ *
+ * \param  pStats Pointer to retrieve the statistics.
+ * \return None.
+ */
+void SDL_Voice_GetStats(SDL_VoiceStats *pStats)
+{
+    *pStats = SDL_voice.sStats;
+}
+
+/*!
+ * \brief  Function to free the voices.
+ *
+ * \return None.
+ */
+void SDL_Voice_Free(void)
+{
+    SDL_VoiceStats *pStats = &SDL_voice.sStats;
+
+    COM_Log_Print(COM_LOG_INFO, "Voices: %d%% used on average (Peak %d/%d), %d plays, %d coalesced, %d stolen, %d dropped.",
+                  (int) (pStats->iNbUpdates && pStats->iNbVoices ? (pStats->iBusySum * 100) / ((Uint64) pStats->iNbUpdates * pStats->iNbVoices) : 0),
+                  pStats->iPeakBusy, pStats->iNbVoices, pStats->iNbPlays, pStats->iNbCoalesced, pStats->iNbStolen, pStats->iNbDropped);
+
+    Mix_HaltChannel(-1);
+
+    UTIL_Free(SDL_voice.pArrSlots);
+    SDL_voice.iNbSlots = 0;
+}
+
+/* ========================================================================= */
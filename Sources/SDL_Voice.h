@@ -0,0 +1,77 @@
+/* ========================================================================= */
+/*!
+ * \file    SDL_Voice.h
+ * \brief   File to interface with the voices of the sounds.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Document where the pool is opened, updated and freed.*/
+/* ========================================================================= */
+
+#ifndef __SDL_VOICE_H__
+#define __SDL_VOICE_H__
+
+    #include "SDL_Sound.h"
+
+    /*
+     * The pool is opened by SDL_Voice_Init once the mixer is opened
+     * (Mix_OpenAudio), and closed by SDL_Voice_Free before Mix_CloseAudio
+     * and before the sounds are freed (SDL_Precache_Free). SDL_Voice_Update
+     * is called once at the start of each frame, before the sounds of the
+     * frame are played. See Tools/Bench.
+     */
+
+    /*! Default number of voices (Mixer channels). */
+    #define SDL_VOICE_DEFAULT 32
+    /*! Maximum number of voices (The channel is stored in 8 bits of a handle). */
+    #define SDL_VOICE_MAX     256
+    /*! Handle of no voice. */
+    #define SDL_VOICE_NONE    0
+
+    /*!
+     * \enum  SDL_VoicePriority
+     * \brief Enumeration of the priorities of the sounds played.
+     */
+    typedef enum
+    {
+        SDL_VOICE_LOW = 0,  /*!< Ambient or repeated sound (Decals, impacts...). */
+        SDL_VOICE_NORMAL,   /*!< Usual sound. */
+        SDL_VOICE_HIGH,     /*!< Important sound (Player, alerts...). */
+        SDL_VOICE_CRITICAL  /*!< Sound never stolen by another one (Interface, dialogs...). */
+    } SDL_VoicePriority;
+
+    /*!
+     * \struct SDL_VoiceStats
+     * \brief  Structure to handle the statistics of the voices.
+     */
+    typedef struct
+    {
+        Uint32 iNbVoices;    /*!< Number of voices. */
+        Uint32 iNbBusy;      /*!< Number of voices playing at the last update. */
+        Uint32 iPeakBusy;    /*!< Highest number of voices playing at an update. */
+        Uint64 iBusySum;     /*!< Sum of the voices playing at each update. */
+        Uint32 iNbUpdates;   /*!< Number of updates (Frames). */
+        Uint32 iNbPlays;     /*!< Number of sounds started. */
+        Uint32 iNbCoalesced; /*!< Number of sounds merged with the same sound of the frame. */
+        Uint32 iNbStolen;    /*!< Number of voices stopped for a sound of higher rank. */
+        Uint32 iNbDropped;   /*!< Number of sounds not played (No voice to steal). */
+    } SDL_VoiceStats;
+
+    SDL_bool SDL_Voice_Init(Uint32 iNbVoices);
+    Uint32   SDL_Voice_Play(SDL_Sound *pSound, SDL_VoicePriority iPriority, Uint32 iVolume, Sint32 iLoops);
+    SDL_bool SDL_Voice_IsPlaying(Uint32 iVoice);
+    void     SDL_Voice_SetVolume(Uint32 iVoice, Uint32 iVolume);
+    void     SDL_Voice_Stop(Uint32 iVoice);
+    void     SDL_Voice_StopAll(void);
+    void     SDL_Voice_Update(void);
+    void     SDL_Voice_GetStats(SDL_VoiceStats *pStats);
+    void     SDL_Voice_Free(void);
+
+#endif // __SDL_VOICE_H__
+
+/* ========================================================================= */
@@ -0,0 +1,816 @@
+/* ========================================================================= */
+/*!
+ * \file    BCH_Main.c
+ * \brief   File to benchmark the engine without a window.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ *
+ * Build it with the files of 'Sources' (Without the game main), and run it
+ * from 'Other/Ressources' (Or give the path with '--data'):
+ *
+ *     bench --decals 20000 --effects 2000 --frames 600 > bench.json
+ *
+ * The scene is drawn by the software renderer into a surface, so the SDL
+ * video driver is only initialized ('dummy' unless SDL_VIDEODRIVER is set).
+ * The mixer is opened on the 'dummy' audio driver, for the voices.
+ * The report is written as JSON on the standard output (Or with '--out').
+ * With '--log-binary', the logs are written in 'logs/bench.blog' (See
+ * 'Tools/Decode'). In debug, the allocations of the frames measured are
+ * reported in the logs, and '--frame-trap' stops the debugger on the first.
+ * Built with COM_PROFILE, '--trace <file>' writes the zones of the profiler
+ * in a trace for chrome://tracing or Perfetto.
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Report all the statistics of the render.             */
+/* Nyuu    | 18/10/26 | Upload the sprites streamed in the update phase.     */
+/* Nyuu    | 18/10/26 | Add the option to read the ressources from a pack.   */
+/* Nyuu    | 18/10/26 | Add the memory budget of the assets.                 */
+/* Nyuu    | 18/10/26 | Add the option to write the logs in binary mode.     */
+/* Nyuu    | 18/10/26 | Report the allocations and the leaks (Debug).        */
+/* Nyuu    | 18/10/26 | Check the allocations of the frames (Debug).         */
+/* Nyuu    | 18/10/26 | Reset the frame arena at each frame.                 */
+/* Nyuu    | 18/10/26 | Add the option to write the trace of the profiler.   */
+/* Nyuu    | 18/10/26 | Open the mixer and update the voices at each frame.  */
+/* ========================================================================= */
+
+#include "ENG_If.h"
+#include "DCL_If.h"
+#include "EFF_If.h"
+
+#ifdef _WIN32
+    #include <direct.h>
+    /*! Macro to change the working directory. */
+    #define BCH_ChangeDir(x) _chdir(x)
+#else
+    #include <unistd.h>
+    /*! Macro to change the working directory. */
+    #define BCH_ChangeDir(x) chdir(x)
+#endif
+
+/* ========================================================================= */
+
+/*! Name of the sprite of the stress effect. */
+#define BCH_EFFECT_SPRITE "blood25"
+/*! Maximum speed of the stress effect (In pixels per think). */
+#define BCH_EFFECT_SPEED  6
+/*! Index of the stress effect in the linker. */
+#define BCH_EFFECT_INDEX  0
+
+/*!
+ * \enum  BCH_Phase
+ * \brief Enumeration of the phases of a frame.
+ */
+typedef enum
+{
+    BCH_PHASE_UPDATE  = 0, /*!< Value 'ENG_Scheduler_Update'. */
+    BCH_PHASE_DRAW    = 1, /*!< Value 'ENG_Scheduler_Draw'. */
+    BCH_PHASE_PRESENT = 2, /*!< Value 'SDL_Render_Present'. */
+    BCH_PHASE_FRAME   = 3, /*!< Value whole frame. */
+    BCH_PHASE_MAX     = 4, /*!< Number of phases. */
+} BCH_Phase;
+
+/*!
+ * \struct BCH_Config
+ * \brief  Structure to handle the options of the benchmark.
+ */
+typedef struct
+{
+    Uint32      iNbDecals;    /*!< Number of decals spawned before the run. */
+    Uint32      iDecalRate;   /*!< Number of decals spawned at each frame. */
+    Uint32      iNbEffects;   /*!< Number of stress effects spawned before the run. */
+    Uint32      iNbLayers;    /*!< Number of layers. */
+    Uint32      iNbFrames;    /*!< Number of frames measured. */
+    Uint32      iNbWarmup;    /*!< Number of frames run before the measures. */
+    Sint32      iWidth;       /*!< Width of the view. */
+    Sint32      iHeight;      /*!< Height of the view. */
+    Sint32      iWorld;       /*!< Size of the world where the scene is spawned. */
+    Uint32      iSeed;        /*!< Seed of the scene. */
+    Uint32      iBudget;      /*!< Memory budget of the assets (0 => None, in MB). */
+    SDL_bool    bBake;        /*!< Flag set to bake the decals of the layers. */
+    SDL_bool    bPan;         /*!< Flag set to move the view along a circle. */
+    SDL_bool    bLogBinary;   /*!< Flag set to write the logs in binary mode. */
+    SDL_bool    bFrameTrap;   /*!< Flag set to stop on the first allocation of a frame (Debug). */
+    const char *szData;       /*!< Path of the ressources (Can be NULL). */
+    const char *szPack;       /*!< Path of the pack of the ressources (Can be NULL). */
+    const char *szOut;        /*!< Path of the report (NULL => Standard output). */
+    const char *szTrace;      /*!< Path of the trace of the profiler (Can be NULL). */
+} BCH_Config;
+
+/*!
+ * \struct BCH_Effect
+ * \brief  Structure to handle the private data of the stress effect.
+ */
+typedef struct
+{
+    SDL_Point sOrigin; /*!< Origin of the effect. */
+    Sint32    iVelX;   /*!< Velocity on x (In pixels per think). */
+    Sint32    iVelY;   /*!< Velocity on y (In pixels per think). */
+    Uint32    iFrame;  /*!< Frame of the sprite. */
+    double    dAngle;  /*!< Angle of the sprite. */
+} BCH_Effect;
+
+/*!
+ * \struct BCH_Main
+ * \brief  Structure to handle the benchmark.
+ */
+typedef struct
+{
+    BCH_Config       sConfig;                  /*!< Options of the benchmark. */
+    SDL_Surface     *pSurface;                 /*!< Pointer to the surface drawn by the renderer. */
+    SDL_Renderer    *pRenderer;                /*!< Pointer to the software renderer. */
+    SDL_Sprite      *pSprite;                  /*!< Pointer to the sprite of the stress effect. */
+    double          *pArrTimes[BCH_PHASE_MAX]; /*!< Duration of each phase at each frame (In ms). */
+    Uint32          *pArrAllocs;               /*!< Number of allocations at each frame. */
+    SDL_RenderStats *pArrRender;               /*!< Statistics of the render at each frame. */
+    SDL_bool         bAudio;                   /*!< Flag set if the mixer and the voices are opened. */
+} BCH_Main;
+
+/*! Global variable to handle the benchmark. */
+static BCH_Main BCH_main;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to get a random coordinate in the world.
+ *
+ * \return The coordinate.
+ */
+static Sint32 BCH_Main_RandCoord(void)
+{
+    return COM_Math_Rand32(0, BCH_main.sConfig.iWorld - 1);
+}
+
+/*!
+ * \brief  Function to set the bounding box of the stress effect.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  pData   Pointer to the private data of the effect.
+ * \return None.
+ */
+static void BCH_Effect_SetBounds(ENG_Effect *pEffect, const BCH_Effect *pData)
+{
+    SDL_Rect sBounds;
+
+    SDL_Sprite_GetFrameSize(BCH_main.pSprite, &sBounds);
+    sBounds.x = pData->sOrigin.x;
+    sBounds.y = pData->sOrigin.y;
+
+    ENG_Effect_SetBounds(pEffect, &sBounds);
+}
+
+/*!
+ * \brief  Function to spawn the stress effect.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \param  pOrigin Pointer to the origin of the effect.
+ * \return None.
+ */
+static void BCH_Effect_Spawn(ENG_Effect *pEffect, const SDL_Point *pOrigin)
+{
+    BCH_Effect *pData = (BCH_Effect *) ENG_Effect_GetPrivData(pEffect);
+
+    pData->sOrigin.x = pOrigin->x;
+    pData->sOrigin.y = pOrigin->y;
+    pData->iVelX     = COM_Math_Rand32(-BCH_EFFECT_SPEED, BCH_EFFECT_SPEED);
+    pData->iVelY     = COM_Math_Rand32(-BCH_EFFECT_SPEED, BCH_EFFECT_SPEED);
+    pData->iFrame    = COM_Math_Rand32(0, SDL_Sprite_GetFrameMax(BCH_main.pSprite) - 1);
+    pData->dAngle    = COM_Math_Rand32(0, 359);
+
+    BCH_Effect_SetBounds(pEffect, pData);
+
+    /* ~~~ Think at each update ~~~ */
+    ENG_Effect_SetNextThink(pEffect, 1);
+}
+
+/*!
+ * \brief  Function to move the stress effect.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void BCH_Effect_Think(ENG_Effect *pEffect)
+{
+    BCH_Effect *pData = (BCH_Effect *) ENG_Effect_GetPrivData(pEffect);
+
+    pData->sOrigin.x += pData->iVelX;
+    pData->sOrigin.y += pData->iVelY;
+    pData->dAngle    += 3.0;
+
+    if ((pData->sOrigin.x < 0) || (pData->sOrigin.x >= BCH_main.sConfig.iWorld))
+    {
+        pData->iVelX = -pData->iVelX;
+    }
+
+    if ((pData->sOrigin.y < 0) || (pData->sOrigin.y >= BCH_main.sConfig.iWorld))
+    {
+        pData->iVelY = -pData->iVelY;
+    }
+
+    BCH_Effect_SetBounds(pEffect, pData);
+    ENG_Effect_SetNextThink(pEffect, 1);
+}
+
+/*!
+ * \brief  Function to draw the stress effect.
+ *
+ * \param  pEffect Pointer to the effect.
+ * \return None.
+ */
+static void BCH_Effect_Draw(ENG_Effect *pEffect)
+{
+    BCH_Effect *pData = (BCH_Effect *) ENG_Effect_GetPrivData(pEffect);
+    SDL_Point   sPos;
+
+    ENG_View_ConvOrigin(&pData->sOrigin, &sPos);
+    SDL_Sprite_DrawEx(BCH_main.pSprite, &sPos, pData->iFrame, pData->dAngle, SDL_FLIP_NONE);
+}
+
+/*! Functions table of the stress effect. */
+static const ENG_EffectTable BCH_effectTable =
+{
+    BCH_Effect_Spawn,
+    BCH_Effect_Think,
+    BCH_Effect_Draw,
+    NULL
+};
+
+/*! Info of the stress effect. */
+static const ENG_EffectInfo BCH_effectInfo =
+{
+    "bch_stress",
+    sizeof(BCH_Effect),
+    &BCH_effectTable
+};
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to read the options of the benchmark.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool BCH_Main_ParseArgs(int argc, char *argv[])
+{
+    BCH_Config *pConfig = &BCH_main.sConfig;
+    const char *szArg   = NULL;
+    const char *szValue = NULL;
+    int         i       = 0;
+
+    pConfig->iNbDecals  = 10000;
+    pConfig->iDecalRate = 0;
+    pConfig->iNbEffects = 1000;
+    pConfig->iNbLayers  = 3;
+    pConfig->iNbFrames  = 300;
+    pConfig->iNbWarmup  = 30;
+    pConfig->iWidth     = 1280;
+    pConfig->iHeight    = 720;
+    pConfig->iWorld     = 4096;
+    pConfig->iSeed      = 1;
+    pConfig->iBudget    = 0;
+    pConfig->bBake      = SDL_FALSE;
+    pConfig->bPan       = SDL_FALSE;
+    pConfig->bLogBinary = SDL_FALSE;
+    pConfig->bFrameTrap = SDL_FALSE;
+    pConfig->szData     = NULL;
+    pConfig->szPack     = NULL;
+    pConfig->szOut      = NULL;
+    pConfig->szTrace    = NULL;
+
+    for (i = 1 ; i < argc ; ++i)
+    {
+        szArg = argv[i];
+
+        /* ~~~ Flags ~~~ */
+        if (strcmp(szArg, "--bake") == 0)
+        {
+            pConfig->bBake = SDL_TRUE;
+            continue;
+        }
+
+        if (strcmp(szArg, "--pan") == 0)
+        {
+            pConfig->bPan = SDL_TRUE;
+            continue;
+        }
+
+        if (strcmp(szArg, "--log-binary") == 0)
+        {
+            pConfig->bLogBinary = SDL_TRUE;
+            continue;
+        }
+
+        if (strcmp(szArg, "--frame-trap") == 0)
+        {
+            pConfig->bFrameTrap = SDL_TRUE;
+            continue;
+        }
+
+        /* ~~~ Options with a value ~~~ */
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "Missing value for option \"%s\".\n", szArg);
+            return SDL_FALSE;
+        }
+
+        szValue = argv[++i];
+
+        if      (strcmp(szArg, "--decals")     == 0) pConfig->iNbDecals  = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--decal-rate") == 0) pConfig->iDecalRate = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--effects")    == 0) pConfig->iNbEffects = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--layers")     == 0) pConfig->iNbLayers  = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--frames")     == 0) pConfig->iNbFrames  = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--warmup")     == 0) pConfig->iNbWarmup  = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--width")      == 0) pConfig->iWidth     = (Sint32) strtol(szValue, NULL, 10);
+        else if (strcmp(szArg, "--height")     == 0) pConfig->iHeight    = (Sint32) strtol(szValue, NULL, 10);
+        else if (strcmp(szArg, "--world")      == 0) pConfig->iWorld     = (Sint32) strtol(szValue, NULL, 10);
+        else if (strcmp(szArg, "--seed")       == 0) pConfig->iSeed      = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--budget")     == 0) pConfig->iBudget    = (Uint32) strtoul(szValue, NULL, 10);
+        else if (strcmp(szArg, "--data")       == 0) pConfig->szData     = szValue;
+        else if (strcmp(szArg, "--pack")       == 0) pConfig->szPack     = szValue;
+        else if (strcmp(szArg, "--out")        == 0) pConfig->szOut      = szValue;
+        else if (strcmp(szArg, "--trace")      == 0) pConfig->szTrace    = szValue;
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\".\n", szArg);
+            return SDL_FALSE;
+        }
+    }
+
+    if ((pConfig->iNbLayers == 0) || (pConfig->iNbFrames == 0) ||
+        (pConfig->iWidth <= 0) || (pConfig->iHeight <= 0) || (pConfig->iWorld <= 0))
+    {
+        fprintf(stderr, "Invalid options (Layers, frames and sizes must be positive).\n");
+        return SDL_FALSE;
+    }
+
+#ifndef COM_PROFILE
+    if (pConfig->szTrace)
+    {
+        fprintf(stderr, "No trace written: the bench is built without COM_PROFILE.\n");
+    }
+#endif
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to init SDL, the engine and the scene.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool BCH_Main_Init(void)
+{
+    BCH_Config *pConfig = &BCH_main.sConfig;
+    SDL_Color   sColor  = { 0, 0, 0, 255 };
+    SDL_Point   sOrigin;
+    Uint32      iNbDecalTypes = 0;
+    Uint32      i             = 0;
+
+    if (pConfig->szData && (BCH_ChangeDir(pConfig->szData) != 0))
+    {
+        fprintf(stderr, "Unable to open the ressources \"%s\".\n", pConfig->szData);
+        return SDL_FALSE;
+    }
+
+    COM_Log_SetMode(pConfig->bLogBinary ? COM_LOG_BINARY : COM_LOG_TEXT);
+    COM_Log_Init(COM_LOG_INFO, "bench");
+    COM_PROF_INIT(pConfig->szTrace);
+    COM_Math_Init( );
+    COM_Arena_Init(COM_ARENA_DEFAULT_SIZE, 0);
+    UTIL_FrameCheck(pConfig->iNbWarmup, pConfig->bFrameTrap);
+    srand(pConfig->iSeed);
+
+    if (pConfig->szPack && !SDL_Pack_Mount(pConfig->szPack))
+    {
+        fprintf(stderr, "Unable to mount the pack \"%s\".\n", pConfig->szPack);
+        return SDL_FALSE;
+    }
+
+    /* ~~~ Headless software renderer ~~~ */
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
+    if ((SDL_Init(SDL_INIT_VIDEO) != 0) || ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) == 0))
+    {
+        fprintf(stderr, "Unable to init SDL: %s\n", SDL_GetError( ));
+        return SDL_FALSE;
+    }
+
+    /* ~~~ Mixer and voices (The bench goes on without them) ~~~ */
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+
+    if ((SDL_InitSubSystem(SDL_INIT_AUDIO) == 0) && (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, 2, 1024) == 0))
+    {
+        BCH_main.bAudio = SDL_TRUE;
+        SDL_Voice_Init(SDL_VOICE_DEFAULT);
+    }
+    else
+    {
+        COM_Log_Print(COM_LOG_WARNING, "Unable to open the mixer: %s", SDL_GetError( ));
+    }
+
+    BCH_main.pSurface = SDL_CreateRGBSurfaceWithFormat(0, pConfig->iWidth, pConfig->iHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+
+    if (BCH_main.pSurface)
+    {
+        BCH_main.pRenderer = SDL_CreateSoftwareRenderer(BCH_main.pSurface);
+    }
+
+    if (!BCH_main.pRenderer)
+    {
+        fprintf(stderr, "Unable to create the software renderer: %s\n", SDL_GetError( ));
+        return SDL_FALSE;
+    }
+
+    SDL_Render_Init(BCH_main.pRenderer, &sColor);
+    SDL_Precache_Init( );
+
+    if (pConfig->iBudget)
+    {
+        SDL_Precache_SetBudget((Uint64) pConfig->iBudget << 20);
+    }
+
+    /* ~~~ Engine ~~~ */
+    ENG_Layer_Init(pConfig->iNbLayers);
+    ENG_View_Init(pConfig->iWidth, pConfig->iHeight);
+    ENG_Linker_Init( );
+    ENG_Scheduler_Init( );
+
+    BCH_main.pSprite = SDL_Precache_Sprite(BCH_EFFECT_SPRITE);
+
+    if (!BCH_main.pSprite)
+    {
+        fprintf(stderr, "Unable to load the sprite \"%s\" (See '--data').\n", BCH_EFFECT_SPRITE);
+        return SDL_FALSE;
+    }
+
+    /* ~~~ The stress effect is registered first (Index BCH_EFFECT_INDEX) ~~~ */
+    ENG_Linker_RegisterEffect(&BCH_effectInfo);
+
+    DCL_Main_Init( );
+    EFF_Main_Init( );
+
+    iNbDecalTypes = ENG_Linker_GetNbDecals( );
+
+    /* ~~~ Scene ~~~ */
+    for (i = 0 ; i < pConfig->iNbLayers ; ++i)
+    {
+        ENG_Scheduler_SetDecalMax(i, pConfig->iNbDecals / pConfig->iNbLayers + 1);
+        ENG_Scheduler_SetBaking(i, pConfig->bBake);
+    }
+
+    sOrigin.x = pConfig->iWorld >> 1;
+    sOrigin.y = pConfig->iWorld >> 1;
+    ENG_View_CenterOrigin(&sOrigin);
+
+    if (iNbDecalTypes == 0)
+    {
+        fprintf(stderr, "No decal registered (See '--data').\n");
+        return SDL_FALSE;
+    }
+
+    for (i = 0 ; i < pConfig->iNbDecals ; ++i)
+    {
+        sOrigin.x = BCH_Main_RandCoord( );
+        sOrigin.y = BCH_Main_RandCoord( );
+
+        ENG_Linker_SpawnDecal(i % iNbDecalTypes, &sOrigin, i % pConfig->iNbLayers);
+    }
+
+    for (i = 0 ; i < pConfig->iNbEffects ; ++i)
+    {
+        sOrigin.x = BCH_Main_RandCoord( );
+        sOrigin.y = BCH_Main_RandCoord( );
+
+        ENG_Linker_SpawnEffect(BCH_EFFECT_INDEX, &sOrigin, i % pConfig->iNbLayers);
+    }
+
+    /* ~~~ Samples ~~~ */
+    for (i = 0 ; i < BCH_PHASE_MAX ; ++i)
+    {
+        BCH_main.pArrTimes[i] = (double *) UTIL_Malloc(sizeof(double) * pConfig->iNbFrames);
+
+        if (!BCH_main.pArrTimes[i])
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    BCH_main.pArrAllocs = (Uint32 *) UTIL_Malloc(sizeof(Uint32) * pConfig->iNbFrames);
+    BCH_main.pArrRender = (SDL_RenderStats *) UTIL_Malloc(sizeof(SDL_RenderStats) * pConfig->iNbFrames);
+
+    return (BCH_main.pArrAllocs && BCH_main.pArrRender) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to run the frames.
+ *
+ * \return None.
+ */
+static void BCH_Main_Run(void)
+{
+    BCH_Config *pConfig  = &BCH_main.sConfig;
+    double      dToMs    = 1000.0 / (double) SDL_GetPerformanceFrequency( );
+    Uint64      arrStamp[BCH_PHASE_MAX];
+    Uint64      iStart   = 0;
+    size_t      iAllocs  = 0;
+    Uint32      iFrame   = 0;
+    Uint32      iSample  = 0;
+    Uint32      i        = 0;
+    SDL_Point   sOrigin;
+
+    for (iFrame = 0 ; iFrame < pConfig->iNbWarmup + pConfig->iNbFrames ; ++iFrame)
+    {
+        /* ~~~ Scene changes (Not measured) ~~~ */
+        for (i = 0 ; i < pConfig->iDecalRate ; ++i)
+        {
+            sOrigin.x = BCH_Main_RandCoord( );
+            sOrigin.y = BCH_Main_RandCoord( );
+
+            ENG_Linker_SpawnDecal(0, &sOrigin, i % pConfig->iNbLayers);
+        }
+
+        if (pConfig->bPan)
+        {
+            sOrigin.x = (pConfig->iWorld >> 1) + (Sint32) (SDL_cos(iFrame * 0.01) * (pConfig->iWorld >> 2));
+            sOrigin.y = (pConfig->iWorld >> 1) + (Sint32) (SDL_sin(iFrame * 0.01) * (pConfig->iWorld >> 2));
+            ENG_View_CenterOrigin(&sOrigin);
+        }
+
+        /* ~~~ Frame ~~~ */
+        iAllocs = UTIL_GetAllocCount( );
+        iStart  = SDL_GetPerformanceCounter( );
+        UTIL_FrameBegin( );
+        SDL_Voice_Update( );
+
+        SDL_Precache_Update(SDL_PRECACHE_UPLOADS);
+        ENG_Scheduler_Update( );
+        arrStamp[BCH_PHASE_UPDATE] = SDL_GetPerformanceCounter( );
+
+        SDL_Render_Clear( );
+        ENG_Scheduler_Draw( );
+        arrStamp[BCH_PHASE_DRAW] = SDL_GetPerformanceCounter( );
+
+        SDL_Render_Present( );
+        arrStamp[BCH_PHASE_PRESENT] = SDL_GetPerformanceCounter( );
+        arrStamp[BCH_PHASE_FRAME]   = arrStamp[BCH_PHASE_PRESENT];
+        UTIL_FrameEnd( );
+        COM_Arena_Reset( );
+
+        if (iFrame >= pConfig->iNbWarmup)
+        {
+            iSample = iFrame - pConfig->iNbWarmup;
+
+            BCH_main.pArrTimes[BCH_PHASE_UPDATE] [iSample] = (double) (arrStamp[BCH_PHASE_UPDATE]  - iStart)                      * dToMs;
+            BCH_main.pArrTimes[BCH_PHASE_DRAW]   [iSample] = (double) (arrStamp[BCH_PHASE_DRAW]    - arrStamp[BCH_PHASE_UPDATE]) * dToMs;
+            BCH_main.pArrTimes[BCH_PHASE_PRESENT][iSample] = (double) (arrStamp[BCH_PHASE_PRESENT] - arrStamp[BCH_PHASE_DRAW])   * dToMs;
+            BCH_main.pArrTimes[BCH_PHASE_FRAME]  [iSample] = (double) (arrStamp[BCH_PHASE_FRAME]   - iStart)                      * dToMs;
+
+            BCH_main.pArrAllocs[iSample] = (Uint32) (UTIL_GetAllocCount( ) - iAllocs);
+            SDL_Render_GetStats(&BCH_main.pArrRender[iSample], NULL);
+        }
+    }
+}
+
+/*!
+ * \brief  Function to compare two durations (For qsort).
+ *
+ * \param  pA Pointer to the first duration.
+ * \param  pB Pointer to the second duration.
+ * \return The order of the durations.
+ */
+static int BCH_Main_CompareTimes(const void *pA, const void *pB)
+{
+    const double dA = *(const double *) pA;
+    const double dB = *(const double *) pB;
+
+    return (dA > dB) - (dA < dB);
+}
+
+/*!
+ * \brief  Function to get a percentile of sorted samples (Nearest rank).
+ *
+ * \param  pArrSorted Pointer to the sorted samples.
+ * \param  iNbSamples Number of samples.
+ * \param  iPercent   Percentile to get.
+ * \return The percentile.
+ */
+static double BCH_Main_Percentile(const double *pArrSorted, Uint32 iNbSamples, Uint32 iPercent)
+{
+    Uint32 iRank = (iPercent * iNbSamples + 99) / 100;
+
+    return pArrSorted[(iRank > 0) ? (iRank - 1) : 0];
+}
+
+/*!
+ * \brief  Function to write the report.
+ *
+ * \param  pFile Pointer to the file of the report.
+ * \return None.
+ */
+static void BCH_Main_Report(FILE *pFile)
+{
+    static const char *szPhase[BCH_PHASE_MAX] = { "update", "draw", "present", "frame" };
+    BCH_Config        *pConfig   = &BCH_main.sConfig;
+    double            *pArrTimes = NULL;
+    double             dSum      = 0.0;
+    SDL_RenderStats   *pRender   = NULL;
+    SDL_RenderStats    sMax;
+    SDL_PrecacheStats  sMemory;
+    COM_ArenaStats     sArena;
+    SDL_VoiceStats     sVoices;
+    Uint64             iAllocs   = 0;
+    Uint64             arrSum[4] = { 0, 0, 0, 0 };
+    Uint32             iMaxAlloc = 0;
+    Uint32             iPhase    = 0;
+    Uint32             i         = 0;
+
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"config\": { \"decals\": %u, \"decal_rate\": %u, \"effects\": %u, \"layers\": %u, \"frames\": %u, \"warmup\": %u, "
+                   "\"width\": %d, \"height\": %d, \"world\": %d, \"seed\": %u, \"budget_mb\": %u, \"bake\": %s, \"pan\": %s, "
+                   "\"log_binary\": %s },\n",
+                   pConfig->iNbDecals, pConfig->iDecalRate, pConfig->iNbEffects, pConfig->iNbLayers, pConfig->iNbFrames, pConfig->iNbWarmup,
+                   pConfig->iWidth, pConfig->iHeight, pConfig->iWorld, pConfig->iSeed, pConfig->iBudget,
+                   pConfig->bBake ? "true" : "false", pConfig->bPan ? "true" : "false", pConfig->bLogBinary ? "true" : "false");
+
+    /* ~~~ Durations (In ms) ~~~ */
+    fprintf(pFile, "  \"phases_ms\": {\n");
+
+    for (iPhase = 0 ; iPhase < BCH_PHASE_MAX ; ++iPhase)
+    {
+        pArrTimes = BCH_main.pArrTimes[iPhase];
+        dSum      = 0.0;
+
+        for (i = 0 ; i < pConfig->iNbFrames ; ++i)
+        {
+            dSum += pArrTimes[i];
+        }
+
+        qsort(pArrTimes, pConfig->iNbFrames, sizeof(double), BCH_Main_CompareTimes);
+
+        fprintf(pFile, "    \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+                       szPhase[iPhase], dSum / pConfig->iNbFrames,
+                       BCH_Main_Percentile(pArrTimes, pConfig->iNbFrames, 50),
+                       BCH_Main_Percentile(pArrTimes, pConfig->iNbFrames, 95),
+                       BCH_Main_Percentile(pArrTimes, pConfig->iNbFrames, 99),
+                       pArrTimes[pConfig->iNbFrames - 1],
+                       (iPhase + 1 < BCH_PHASE_MAX) ? "," : "");
+    }
+
+    fprintf(pFile, "  },\n");
+
+    /* ~~~ Counters ~~~ */
+    SDL_zero(sMax);
+
+    for (i = 0 ; i < pConfig->iNbFrames ; ++i)
+    {
+        pRender   = &BCH_main.pArrRender[i];
+        iAllocs  += BCH_main.pArrAllocs[i];
+        iMaxAlloc = COM_Math_Max(iMaxAlloc, BCH_main.pArrAllocs[i]);
+
+        arrSum[0] += pRender->iDrawCalls;
+        arrSum[1] += pRender->iTextureSwitches;
+        arrSum[2] += pRender->iColorChanges;
+        arrSum[3] += pRender->iPixels;
+
+        sMax.iDrawCalls       = COM_Math_Max(sMax.iDrawCalls,       pRender->iDrawCalls);
+        sMax.iTextureSwitches = COM_Math_Max(sMax.iTextureSwitches, pRender->iTextureSwitches);
+        sMax.iColorChanges    = COM_Math_Max(sMax.iColorChanges,    pRender->iColorChanges);
+        sMax.iPixels          = COM_Math_Max(sMax.iPixels,          pRender->iPixels);
+    }
+
+    fprintf(pFile, "  \"allocations\": { \"total\": %llu, \"per_frame\": %.2f, \"max_frame\": %u },\n",
+                   (unsigned long long) iAllocs, (double) iAllocs / pConfig->iNbFrames, iMaxAlloc);
+    fprintf(pFile, "  \"draw_calls\": { \"per_frame\": %.2f, \"max_frame\": %u },\n",
+                   (double) arrSum[0] / pConfig->iNbFrames, sMax.iDrawCalls);
+    fprintf(pFile, "  \"texture_switches\": { \"per_frame\": %.2f, \"max_frame\": %u },\n",
+                   (double) arrSum[1] / pConfig->iNbFrames, sMax.iTextureSwitches);
+    fprintf(pFile, "  \"color_changes\": { \"per_frame\": %.2f, \"max_frame\": %u },\n",
+                   (double) arrSum[2] / pConfig->iNbFrames, sMax.iColorChanges);
+    fprintf(pFile, "  \"pixels\": { \"per_frame\": %.2f, \"max_frame\": %llu },\n",
+                   (double) arrSum[3] / pConfig->iNbFrames, (unsigned long long) sMax.iPixels);
+
+    /* ~~~ Memory of the assets ~~~ */
+    SDL_Precache_GetStats(&sMemory);
+
+    fprintf(pFile, "  \"assets\": { \"resident_bytes\": %llu, \"peak_bytes\": %llu, \"evicted_bytes\": %llu, \"evictions\": %u, \"reloads\": %u },\n",
+                   (unsigned long long) sMemory.iResident, (unsigned long long) sMemory.iPeak,
+                   (unsigned long long) sMemory.iEvicted, sMemory.iNbEvictions, sMemory.iNbReloads);
+
+    /* ~~~ Memory of the frames ~~~ */
+    COM_Arena_GetStats(&sArena);
+
+    fprintf(pFile, "  \"arena\": { \"capacity_bytes\": %llu, \"peak_bytes\": %llu, \"overflows\": %u, \"growths\": %u },\n",
+                   (unsigned long long) sArena.iCapacity, (unsigned long long) sArena.iPeak,
+                   sArena.iNbOverflow, sArena.iNbGrowths);
+
+    /* ~~~ Voices (Sampled at each frame) ~~~ */
+    SDL_Voice_GetStats(&sVoices);
+
+    fprintf(pFile, "  \"voices\": { \"channels\": %u, \"busy_mean\": %.2f, \"busy_peak\": %u, \"plays\": %u, \"coalesced\": %u, \"stolen\": %u, \"dropped\": %u }\n",
+                   sVoices.iNbVoices, sVoices.iNbUpdates ? (double) sVoices.iBusySum / sVoices.iNbUpdates : 0.0, sVoices.iPeakBusy,
+                   sVoices.iNbPlays, sVoices.iNbCoalesced, sVoices.iNbStolen, sVoices.iNbDropped);
+    fprintf(pFile, "}\n");
+}
+
+/*!
+ * \brief  Function to free the benchmark.
+ *
+ * \return None.
+ */
+static void BCH_Main_Free(void)
+{
+    Uint32 i = 0;
+
+    COM_Arena_Quit( );
+    UTIL_MemReport( );
+
+    for (i = 0 ; i < BCH_PHASE_MAX ; ++i)
+    {
+        UTIL_Free(BCH_main.pArrTimes[i]);
+    }
+
+    UTIL_Free(BCH_main.pArrAllocs);
+    UTIL_Free(BCH_main.pArrRender);
+
+    /* ~~~ The voices stop the channels before the sounds are freed ~~~ */
+    if (BCH_main.bAudio)
+    {
+        SDL_Voice_Free( );
+        Mix_CloseAudio( );
+        BCH_main.bAudio = SDL_FALSE;
+    }
+
+    if (BCH_main.pRenderer)
+    {
+        ENG_Scheduler_Free( );
+        ENG_Linker_Free( );
+        SDL_Precache_Free( );
+
+        SDL_DestroyRenderer(BCH_main.pRenderer);
+        BCH_main.pRenderer = NULL;
+    }
+
+    SDL_Pack_Unmount( );
+
+    /* ~~~ The workers of the precache are stopped: their zones can be freed ~~~ */
+    COM_PROF_QUIT( );
+
+    if (BCH_main.pSurface)
+    {
+        SDL_FreeSurface(BCH_main.pSurface);
+        BCH_main.pSurface = NULL;
+    }
+
+    IMG_Quit( );
+    SDL_Quit( );
+    (void) UTIL_MemLeaks( );
+    COM_Log_Quit( );
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Entry point of the benchmark.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return EXIT_SUCCESS on success, else EXIT_FAILURE.
+ */
+int main(int argc, char *argv[])
+{
+    FILE *pFile   = stdout;
+    int   iResult = EXIT_FAILURE;
+
+    if (BCH_Main_ParseArgs(argc, argv) && BCH_Main_Init( ))
+    {
+        BCH_Main_Run( );
+
+        if (BCH_main.sConfig.szOut)
+        {
+            pFile = UTIL_FileOpen(BCH_main.sConfig.szOut, "w");
+        }
+
+        if (pFile)
+        {
+            BCH_Main_Report(pFile);
+            iResult = EXIT_SUCCESS;
+
+            if (pFile != stdout)
+            {
+                UTIL_FileClose(&pFile);
+            }
+        }
+    }
+
+    BCH_Main_Free( );
+
+    return iResult;
+}
+
+/* ========================================================================= */
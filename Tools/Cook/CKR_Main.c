@@ -0,0 +1,672 @@
+/* ========================================================================= */
+/*!
+ * \file    CKR_Main.c
+ * \brief   File to cook the sprites for the runtime.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ *
+ * Build it with 'Sources/COM_Lz4.c' and the 'COM' files (SDL2 and
+ * SDL2_image are needed to decode the PNG), and run it from
+ * 'Other/Ressources' with the sprites to cook, given as arguments or as a
+ * list on the standard input ('-'):
+ *
+ *     find sprites -name "*.spr" | cook --lz4 --out ../Cooked -
+ *
+ * Each sprite is written at the same path under the output folder (The
+ * folders must exist), so the cooked ressources can be packed or used as an
+ * override. The frames are trimmed to their opaque pixels, the frames with
+ * the same pixels are stored once, and the pixels are stored in the format
+ * of the atlas (See SDL_Sprite.h for the format).
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include "COM_If.h"
+#include "COM_Lz4.h"
+#include "SDL_Atlas.h"
+#include "SDL_Sprite.h"
+
+/* ========================================================================= */
+
+/*! Maximum length of a path read on the standard input. */
+#define CKR_PATH_MAX 1024
+/*! Transparent border between the frames of a cooked sheet (In pixels). */
+#define CKR_GUTTER   1
+
+/*!
+ * \struct CKR_Frame
+ * \brief  Structure to handle a frame to cook.
+ */
+typedef struct
+{
+    SDL_SpriteFrame sFrame;  /*!< Frame stored (Position in the cooked sheet). */
+    SDL_Rect        sSource; /*!< Opaque pixels in the source sheet. */
+    Uint32          iHash;   /*!< Hash of the opaque pixels. */
+    Uint32          iOrigin; /*!< Index of the first frame with the same pixels. */
+} CKR_Frame;
+
+/*!
+ * \struct CKR_Main
+ * \brief  Structure to handle the cooker.
+ */
+typedef struct
+{
+    const char *szOut;      /*!< Folder of the cooked sprites. */
+    SDL_bool    bLz4;       /*!< Flag set to compress the pixels. */
+    CKR_Frame  *pArrFrames; /*!< Array of the frames of the current sprite. */
+    Uint32     *pArrOrder;  /*!< Array of the unique frames, in the order of the packing. */
+    Uint32      iNbCooked;  /*!< Number of sprites cooked. */
+    Uint64      iInBytes;   /*!< Size of the sprites read (In bytes). */
+    Uint64      iOutBytes;  /*!< Size of the sprites written (In bytes). */
+} CKR_Main;
+
+/*! Global variable to handle the cooker. */
+static CKR_Main CKR_main;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to read a whole file.
+ *
+ * \param  szPath Path of the file.
+ * \param  pSize  Pointer to retrieve the size of the file (In bytes).
+ * \return A pointer to the data (Must be freed), or NULL if error.
+ */
+static Uint8 *CKR_Main_ReadFile(const char *szPath, Uint32 *pSize)
+{
+    FILE  *pInput = fopen(szPath, "rb");
+    Uint8 *pData  = NULL;
+    long   iSize  = 0;
+
+    if (pInput)
+    {
+        if ((fseek(pInput, 0, SEEK_END) == 0) && ((iSize = ftell(pInput)) > 0) && (fseek(pInput, 0, SEEK_SET) == 0))
+        {
+            pData = (Uint8 *) UTIL_Malloc((size_t) iSize);
+
+            if (pData && (fread(pData, (size_t) iSize, 1, pInput) != 1))
+            {
+                UTIL_Free(pData);
+            }
+        }
+
+        fclose(pInput);
+    }
+
+    *pSize = (Uint32) iSize;
+
+    return pData;
+}
+
+/*!
+ * \brief  Function to trim a frame to its opaque pixels.
+ *
+ * \param  pSheet  Pointer to the sheet (Format of the atlas).
+ * \param  pSource Rectangle of the frame, set to its opaque pixels (Empty => 0).
+ * \return None.
+ */
+static void CKR_Main_Trim(const SDL_Surface *pSheet, SDL_Rect *pSource)
+{
+    const Uint8 *pLine = NULL;
+    Sint32       iMinX = pSource->x + pSource->w;
+    Sint32       iMinY = pSource->y + pSource->h;
+    Sint32       iMaxX = pSource->x - 1;
+    Sint32       iMaxY = pSource->y - 1;
+    Sint32       x     = 0;
+    Sint32       y     = 0;
+
+    for (y = pSource->y ; y < pSource->y + pSource->h ; ++y)
+    {
+        pLine = (const Uint8 *) pSheet->pixels + y * pSheet->pitch;
+
+        for (x = pSource->x ; x < pSource->x + pSource->w ; ++x)
+        {
+            /* ~~~ RGBA32 is R, G, B, A in memory ~~~ */
+            if (pLine[x * 4 + 3])
+            {
+                iMinX = COM_Math_Min(iMinX, x);
+                iMaxX = COM_Math_Max(iMaxX, x);
+                iMinY = COM_Math_Min(iMinY, y);
+                iMaxY = y;
+            }
+        }
+    }
+
+    if (iMaxX < iMinX)
+    {
+        pSource->w = 0;
+        pSource->h = 0;
+    }
+    else
+    {
+        pSource->x = iMinX;
+        pSource->y = iMinY;
+        pSource->w = iMaxX - iMinX + 1;
+        pSource->h = iMaxY - iMinY + 1;
+    }
+}
+
+/*!
+ * \brief  Function to hash the opaque pixels of a frame (FNV-1a).
+ *
+ * \param  pSheet  Pointer to the sheet.
+ * \param  pSource Rectangle of the opaque pixels.
+ * \return The hash of the pixels.
+ */
+static Uint32 CKR_Main_Hash(const SDL_Surface *pSheet, const SDL_Rect *pSource)
+{
+    const Uint8 *pLine = NULL;
+    Uint32       iHash = 2166136261U;
+    Sint32       iByte = 0;
+    Sint32       y     = 0;
+
+    for (y = 0 ; y < pSource->h ; ++y)
+    {
+        pLine = (const Uint8 *) pSheet->pixels + (pSource->y + y) * pSheet->pitch + pSource->x * 4;
+
+        for (iByte = 0 ; iByte < pSource->w * 4 ; ++iByte)
+        {
+            iHash = (iHash ^ pLine[iByte]) * 16777619U;
+        }
+    }
+
+    return iHash;
+}
+
+/*!
+ * \brief  Function to check if two frames have the same opaque pixels.
+ *
+ * \param  pSheet Pointer to the sheet.
+ * \param  pA     Pointer to the first frame.
+ * \param  pB     Pointer to the second frame.
+ * \return SDL_TRUE if the pixels are the same, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_IsSame(const SDL_Surface *pSheet, const CKR_Frame *pA, const CKR_Frame *pB)
+{
+    const Uint8 *pPixels = (const Uint8 *) pSheet->pixels;
+    Sint32       y       = 0;
+
+    if ((pA->iHash != pB->iHash) || (pA->sSource.w != pB->sSource.w) || (pA->sSource.h != pB->sSource.h))
+    {
+        return SDL_FALSE;
+    }
+
+    for (y = 0 ; y < pA->sSource.h ; ++y)
+    {
+        if (memcmp(pPixels + (pA->sSource.y + y) * pSheet->pitch + pA->sSource.x * 4,
+                   pPixels + (pB->sSource.y + y) * pSheet->pitch + pB->sSource.x * 4, pA->sSource.w * 4) != 0)
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to compare two unique frames, in the order of the packing.
+ *
+ * \param  pA Pointer to the index of the first frame.
+ * \param  pB Pointer to the index of the second frame.
+ * \return Less than 0, 0 or more than 0 (Highest first, then by index).
+ */
+static int CKR_Main_CompareFrames(const void *pA, const void *pB)
+{
+    Uint32 iA = *(const Uint32 *) pA;
+    Uint32 iB = *(const Uint32 *) pB;
+    Sint32 iH = CKR_main.pArrFrames[iB].sSource.h - CKR_main.pArrFrames[iA].sSource.h;
+
+    return iH ? iH : ((iA < iB) ? -1 : 1);
+}
+
+/*!
+ * \brief  Function to pack the unique frames in a sheet (Shelves).
+ *
+ * \param  iNbUnique Number of unique frames (In CKR_main.pArrOrder).
+ * \param  pSheetW   Pointer to retrieve the width of the sheet.
+ * \param  pSheetH   Pointer to retrieve the height of the sheet.
+ * \return SDL_TRUE on success, else SDL_FALSE (Too large).
+ */
+static SDL_bool CKR_Main_Pack(Uint32 iNbUnique, Uint32 *pSheetW, Uint32 *pSheetH)
+{
+    CKR_Frame *pFrame  = NULL;
+    Uint32     iArea   = 0;
+    Uint32     iWidth  = 1;
+    Uint32     iX      = 0;
+    Uint32     iY      = 0;
+    Uint32     iShelfH = 0;
+    Uint32     i       = 0;
+
+    qsort(CKR_main.pArrOrder, iNbUnique, sizeof(Uint32), CKR_Main_CompareFrames);
+
+    for (i = 0 ; i < iNbUnique ; ++i)
+    {
+        pFrame  = &CKR_main.pArrFrames[CKR_main.pArrOrder[i]];
+        iArea  += (pFrame->sSource.w + CKR_GUTTER) * (pFrame->sSource.h + CKR_GUTTER);
+        iWidth  = COM_Math_Max(iWidth, (Uint32) pFrame->sSource.w);
+    }
+
+    /* ~~~ Square sheet, to fit in a page of the atlas when possible ~~~ */
+    iWidth = COM_Math_Max(iWidth, COM_Math_Sqrt32(iArea + iArea / 8));
+
+    for (i = 0 ; i < iNbUnique ; ++i)
+    {
+        pFrame = &CKR_main.pArrFrames[CKR_main.pArrOrder[i]];
+
+        if (iX + pFrame->sSource.w > iWidth)
+        {
+            iX      = 0;
+            iY     += iShelfH + CKR_GUTTER;
+            iShelfH = 0;
+        }
+
+        pFrame->sFrame.iX = (Uint16) iX;
+        pFrame->sFrame.iY = (Uint16) iY;
+
+        iX     += pFrame->sSource.w + CKR_GUTTER;
+        iShelfH = COM_Math_Max(iShelfH, (Uint32) pFrame->sSource.h);
+    }
+
+    *pSheetW = iWidth;
+    *pSheetH = COM_Math_Max(iY + iShelfH, 1);
+
+    return ((*pSheetW <= 0xFFFF) && (*pSheetH <= 0xFFFF)) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to write a cooked sprite.
+ *
+ * \param  szPath  Path of the sprite (Under the output folder).
+ * \param  pHeader Pointer to the header (Its size of data is set).
+ * \param  pPixels Pointer to the pixels of the cooked sheet.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_Write(const char *szPath, SDL_SpriteCooked *pHeader, const Uint8 *pPixels)
+{
+    char        *szOutPath = UTIL_StrBuild(CKR_main.szOut, "/", szPath, NULL);
+    FILE        *pOutput   = NULL;
+    Uint8       *pPacked   = NULL;
+    const Uint8 *pData     = pPixels;
+    size_t       iRawSize  = (size_t) pHeader->iSheetW * pHeader->iSheetH * 4;
+    size_t       iSize     = iRawSize;
+    Uint32       i         = 0;
+    SDL_bool     bRet      = SDL_FALSE;
+
+    /* ~~~ Compressed only if it saves something ~~~ */
+    if (CKR_main.bLz4)
+    {
+        pPacked = (Uint8 *) UTIL_Malloc(COM_Lz4_Bound(iRawSize));
+        iSize   = pPacked ? COM_Lz4_Compress(pPixels, iRawSize, pPacked, COM_Lz4_Bound(iRawSize)) : 0;
+
+        if (iSize && (iSize < iRawSize))
+        {
+            pHeader->iFlags |= SDL_SPRITE_COOKED_LZ4;
+            pData            = pPacked;
+        }
+        else
+        {
+            iSize = iRawSize;
+        }
+    }
+
+    pHeader->iDataSize = (Uint32) iSize;
+    pOutput            = szOutPath ? UTIL_FileOpen(szOutPath, "wb") : NULL;
+
+    if (pOutput)
+    {
+        bRet = (fwrite(pHeader, sizeof(SDL_SpriteCooked), 1, pOutput) == 1) ? SDL_TRUE : SDL_FALSE;
+
+        for (i = 0 ; bRet && (i < pHeader->iNbFrames) ; ++i)
+        {
+            bRet = (fwrite(&CKR_main.pArrFrames[i].sFrame, sizeof(SDL_SpriteFrame), 1, pOutput) == 1) ? SDL_TRUE : SDL_FALSE;
+        }
+
+        bRet = (bRet && (fwrite(pData, iSize, 1, pOutput) == 1)) ? SDL_TRUE : SDL_FALSE;
+
+        CKR_main.iOutBytes += (Uint64) ftell(pOutput);
+        UTIL_FileClose(&pOutput);
+    }
+
+    if (!bRet)
+    {
+        fprintf(stderr, "Can't write the sprite \"%s\".\n", szOutPath ? szOutPath : szPath);
+    }
+
+    UTIL_Free(pPacked);
+    UTIL_Free(szOutPath);
+
+    return bRet;
+}
+
+/*!
+ * \brief  Function to cook the frames of a sheet.
+ *
+ * \param  szPath  Path of the sprite.
+ * \param  pSheet  Pointer to the sheet (Format of the atlas).
+ * \param  iFrameW Width of a frame (0 => Whole sheet).
+ * \param  iFrameH Height of a frame (0 => Whole sheet).
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_CookSheet(const char *szPath, const SDL_Surface *pSheet, Uint32 iFrameW, Uint32 iFrameH)
+{
+    SDL_SpriteCooked sHeader;
+    CKR_Frame       *pFrame    = NULL;
+    Uint8           *pPixels   = NULL;
+    Uint32           iNbFrameW = 0;
+    Uint32           iNbFrames = 0;
+    Uint32           iNbUnique = 0;
+    Uint32           iNbEmpty  = 0;
+    Uint32           i         = 0;
+    Uint32           j         = 0;
+    Sint32           y         = 0;
+    SDL_bool         bRet      = SDL_FALSE;
+
+    if ((!iFrameW) || (!iFrameH))
+    {
+        iFrameW = pSheet->w;
+        iFrameH = pSheet->h;
+    }
+
+    iNbFrameW = pSheet->w / iFrameW;
+    iNbFrames = iNbFrameW * (pSheet->h / iFrameH);
+
+    if ((!iNbFrames) || (iFrameW > 0x7FFF) || (iFrameH > 0x7FFF))
+    {
+        fprintf(stderr, "Invalid frames in the sprite \"%s\".\n", szPath);
+        return SDL_FALSE;
+    }
+
+    CKR_main.pArrFrames = (CKR_Frame *) UTIL_Malloc(sizeof(CKR_Frame) * iNbFrames);
+    CKR_main.pArrOrder  = (Uint32 *) UTIL_Malloc(sizeof(Uint32) * iNbFrames);
+
+    if (CKR_main.pArrFrames && CKR_main.pArrOrder)
+    {
+        /* ~~~ Trim, then keep the first frame of the same pixels ~~~ */
+        for (i = 0 ; i < iNbFrames ; ++i)
+        {
+            pFrame            = &CKR_main.pArrFrames[i];
+            pFrame->sSource.x = (i % iNbFrameW) * iFrameW;
+            pFrame->sSource.y = (i / iNbFrameW) * iFrameH;
+            pFrame->sSource.w = iFrameW;
+            pFrame->sSource.h = iFrameH;
+
+            memset(&pFrame->sFrame, 0, sizeof(SDL_SpriteFrame));
+            CKR_Main_Trim(pSheet, &pFrame->sSource);
+
+            pFrame->sFrame.iOffsetX = (Sint16) (pFrame->sSource.x - (i % iNbFrameW) * iFrameW);
+            pFrame->sFrame.iOffsetY = (Sint16) (pFrame->sSource.y - (i / iNbFrameW) * iFrameH);
+            pFrame->sFrame.iW       = (Uint16) pFrame->sSource.w;
+            pFrame->sFrame.iH       = (Uint16) pFrame->sSource.h;
+            pFrame->iHash           = CKR_Main_Hash(pSheet, &pFrame->sSource);
+            pFrame->iOrigin         = i;
+
+            if (!pFrame->sSource.w)
+            {
+                pFrame->sFrame.iOffsetX = 0;
+                pFrame->sFrame.iOffsetY = 0;
+                iNbEmpty++;
+                continue;
+            }
+
+            for (j = 0 ; (j < i) && (pFrame->iOrigin == i) ; ++j)
+            {
+                if ((CKR_main.pArrFrames[j].iOrigin == j) && CKR_main.pArrFrames[j].sSource.w &&
+                    CKR_Main_IsSame(pSheet, &CKR_main.pArrFrames[j], pFrame))
+                {
+                    pFrame->iOrigin = j;
+                }
+            }
+
+            if (pFrame->iOrigin == i)
+            {
+                CKR_main.pArrOrder[iNbUnique++] = i;
+            }
+        }
+
+        memset(&sHeader, 0, sizeof(SDL_SpriteCooked));
+        memcpy(sHeader.arrMagic, SDL_SPRITE_COOKED_MAGIC, sizeof(sHeader.arrMagic));
+        sHeader.iVersion  = SDL_SPRITE_COOKED_VERSION;
+        sHeader.iFormat   = SDL_ATLAS_FORMAT;
+        sHeader.iFrameW   = iFrameW;
+        sHeader.iFrameH   = iFrameH;
+        sHeader.iNbFrames = iNbFrames;
+
+        if (CKR_Main_Pack(iNbUnique, &sHeader.iSheetW, &sHeader.iSheetH))
+        {
+            pPixels = (Uint8 *) UTIL_Malloc((size_t) sHeader.iSheetW * sHeader.iSheetH * 4);
+        }
+        else
+        {
+            fprintf(stderr, "The frames of the sprite \"%s\" don't fit in a sheet.\n", szPath);
+        }
+    }
+
+    if (pPixels)
+    {
+        memset(pPixels, 0, (size_t) sHeader.iSheetW * sHeader.iSheetH * 4);
+
+        for (i = 0 ; i < iNbFrames ; ++i)
+        {
+            pFrame = &CKR_main.pArrFrames[i];
+
+            if (pFrame->iOrigin != i)
+            {
+                pFrame->sFrame.iX = CKR_main.pArrFrames[pFrame->iOrigin].sFrame.iX;
+                pFrame->sFrame.iY = CKR_main.pArrFrames[pFrame->iOrigin].sFrame.iY;
+                continue;
+            }
+
+            for (y = 0 ; y < pFrame->sSource.h ; ++y)
+            {
+                memcpy(pPixels + ((size_t) (pFrame->sFrame.iY + y) * sHeader.iSheetW + pFrame->sFrame.iX) * 4,
+                       (const Uint8 *) pSheet->pixels + (pFrame->sSource.y + y) * pSheet->pitch + pFrame->sSource.x * 4,
+                       pFrame->sSource.w * 4);
+            }
+        }
+
+        bRet = CKR_Main_Write(szPath, &sHeader, pPixels);
+
+        if (bRet)
+        {
+            fprintf(stdout, "%s: %u frames (%u unique, %u empty), %dx%d -> %ux%u%s.\n",
+                    szPath, iNbFrames, iNbUnique, iNbEmpty, pSheet->w, pSheet->h,
+                    sHeader.iSheetW, sHeader.iSheetH, (sHeader.iFlags & SDL_SPRITE_COOKED_LZ4) ? ", LZ4" : "");
+        }
+    }
+
+    UTIL_Free(pPixels);
+    UTIL_Free(CKR_main.pArrOrder);
+    UTIL_Free(CKR_main.pArrFrames);
+
+    return bRet;
+}
+
+/*!
+ * \brief  Function to cook a sprite.
+ *
+ * \param  szPath Path of the sprite (Frame size followed by a PNG).
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_Cook(const char *szPath)
+{
+    SDL_RWops   *pPngRw  = NULL;
+    SDL_Surface *pPng    = NULL;
+    SDL_Surface *pSheet  = NULL;
+    Uint8       *pData   = NULL;
+    Uint32       iSize   = 0;
+    Uint32       iFrameW = 0;
+    Uint32       iFrameH = 0;
+    SDL_bool     bRet    = SDL_FALSE;
+
+    /* ~~~ Stored with '/' and without "./" ~~~ */
+    while ((szPath[0] == '.') && ((szPath[1] == '/') || (szPath[1] == '\\')))
+    {
+        szPath += 2;
+    }
+
+    pData = CKR_Main_ReadFile(szPath, &iSize);
+
+    if (!pData || (iSize <= 2 * sizeof(Sint32)))
+    {
+        fprintf(stderr, "Can't read the sprite \"%s\".\n", szPath);
+    }
+    else if (memcmp(pData, SDL_SPRITE_COOKED_MAGIC, 4) == 0)
+    {
+        fprintf(stderr, "The sprite \"%s\" is already cooked.\n", szPath);
+    }
+    else
+    {
+        memcpy(&iFrameW, pData, sizeof(Sint32));
+        memcpy(&iFrameH, pData + sizeof(Sint32), sizeof(Sint32));
+
+        pPngRw = SDL_RWFromConstMem(pData + 2 * sizeof(Sint32), (int) (iSize - 2 * sizeof(Sint32)));
+        pPng   = pPngRw ? IMG_LoadPNG_RW(pPngRw) : NULL;
+        pSheet = pPng ? SDL_ConvertSurfaceFormat(pPng, SDL_ATLAS_FORMAT, 0) : NULL;
+
+        if (pSheet)
+        {
+            bRet = CKR_Main_CookSheet(szPath, pSheet, iFrameW, iFrameH);
+        }
+        else
+        {
+            fprintf(stderr, "Can't decode the sprite \"%s\": %s\n", szPath, SDL_GetError( ));
+        }
+
+        if (pPngRw)
+        {
+            SDL_FreeRW(pPngRw);
+        }
+
+        SDL_FreeSurface(pSheet);
+        SDL_FreeSurface(pPng);
+
+        CKR_main.iInBytes  += iSize;
+        CKR_main.iNbCooked += bRet ? 1 : 0;
+    }
+
+    UTIL_Free(pData);
+
+    return bRet;
+}
+
+/*!
+ * \brief  Function to cook the sprites listed on the standard input.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_CookList(void)
+{
+    char     szLine[CKR_PATH_MAX];
+    size_t   iLength = 0;
+    SDL_bool bRet    = SDL_TRUE;
+
+    while (fgets(szLine, sizeof(szLine), stdin))
+    {
+        iLength = strlen(szLine);
+
+        while (iLength && ((szLine[iLength - 1] == '\n') || (szLine[iLength - 1] == '\r')))
+        {
+            szLine[--iLength] = '\0';
+        }
+
+        if (iLength && !CKR_Main_Cook(szLine))
+        {
+            bRet = SDL_FALSE;
+        }
+    }
+
+    return bRet;
+}
+
+/*!
+ * \brief  Function to parse the options.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool CKR_Main_ParseArgs(int argc, char *argv[])
+{
+    Uint32 iNbSprites = 0;
+    int    i          = 0;
+
+    CKR_main.szOut = NULL;
+    CKR_main.bLz4  = SDL_FALSE;
+
+    for (i = 1 ; i < argc ; ++i)
+    {
+        if (strcmp(argv[i], "--out") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Missing value for option \"%s\".\n", argv[i]);
+                return SDL_FALSE;
+            }
+
+            CKR_main.szOut = argv[++i];
+        }
+        else if (strcmp(argv[i], "--lz4") == 0)
+        {
+            CKR_main.bLz4 = SDL_TRUE;
+        }
+        else
+        {
+            iNbSprites++;
+        }
+    }
+
+    if (!CKR_main.szOut || !iNbSprites)
+    {
+        fprintf(stderr, "Usage: cook [--lz4] --out <folder> <sprites...> (Or '-' to read the sprites on the standard input).\n");
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Entry point of the cooker.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return EXIT_SUCCESS if every sprite is cooked, else EXIT_FAILURE.
+ */
+int main(int argc, char *argv[])
+{
+    SDL_bool bParsed = CKR_Main_ParseArgs(argc, argv);
+    SDL_bool bRet    = bParsed;
+    int      i       = 0;
+
+    /* ~~~ A sprite that fails doesn't stop the others ~~~ */
+    for (i = 1 ; bParsed && (i < argc) ; ++i)
+    {
+        if (strcmp(argv[i], "--out") == 0)
+        {
+            ++i;
+        }
+        else if (strcmp(argv[i], "-") == 0)
+        {
+            bRet = (CKR_Main_CookList( ) && bRet) ? SDL_TRUE : SDL_FALSE;
+        }
+        else if (strcmp(argv[i], "--lz4") != 0)
+        {
+            bRet = (CKR_Main_Cook(argv[i]) && bRet) ? SDL_TRUE : SDL_FALSE;
+        }
+    }
+
+    if (CKR_main.iNbCooked)
+    {
+        fprintf(stdout, "%u sprites cooked, %u KB -> %u KB.\n", CKR_main.iNbCooked,
+                (Uint32) (CKR_main.iInBytes >> 10), (Uint32) (CKR_main.iOutBytes >> 10));
+    }
+
+    return bRet ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ========================================================================= */
@@ -0,0 +1,499 @@
+/* ========================================================================= */
+/*!
+ * \file    DEC_Main.c
+ * \brief   File to decode the binary logs.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ *
+ * Build it with 'Sources/COM_Log.c' and the 'COM' files, and run it on a
+ * logs file written in binary mode (See COM_Log.h for the format):
+ *
+ *     decode logs/bench.blog > bench.log
+ *
+ * The messages are formatted here with the format of their call site, and
+ * prefixed by their time since the first message (In seconds).
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* ========================================================================= */
+
+#include <SDL.h>
+
+#include "COM_If.h"
+
+/* ========================================================================= */
+
+/*! Maximum length of a conversion of a format. */
+#define DEC_SPEC_MAX 64
+
+/*!
+ * \struct DEC_Site
+ * \brief  Structure to handle a call site.
+ */
+typedef struct
+{
+    char   *szFile;   /*!< File of the call. */
+    char   *szFormat; /*!< Format of the messages. */
+    Uint32  iLine;    /*!< Line of the call. */
+} DEC_Site;
+
+/*!
+ * \struct DEC_Main
+ * \brief  Structure to handle the decoder.
+ */
+typedef struct
+{
+    FILE     *pIn;        /*!< Binary logs file. */
+    FILE     *pOut;       /*!< Text output. */
+    DEC_Site *pArrSites;  /*!< Array of the call sites (Id - 1). */
+    Uint32    iNbSites;   /*!< Number of call sites. */
+    Uint64    iFrequency; /*!< Frequency of the timestamps. */
+    Uint64    iStart;     /*!< Timestamp of the first message. */
+    SDL_bool  bStarted;   /*!< SDL_TRUE once the first message is read. */
+} DEC_Main;
+
+/*! Global variable to handle the decoder. */
+static DEC_Main DEC_main;
+
+/*! Prefixes of the messages (See COM_LogType). */
+static const char *DEC_szLogTxt[] = {"Debug   : ",
+                                     "Info    : ",
+                                     "Warning : ",
+                                     "Error   : ",
+                                     "Critical: "};
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to read bytes of the logs file.
+ *
+ * \param  pData Pointer to the output.
+ * \param  iSize Number of bytes.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool DEC_Main_Read(void *pData, size_t iSize)
+{
+    return (fread(pData, 1, iSize, DEC_main.pIn) == iSize) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to read a string of the logs file (Uint16 length + chars).
+ *
+ * \return The string (To free), or NULL on error.
+ */
+static char *DEC_Main_ReadString(void)
+{
+    char   *szText  = NULL;
+    Uint16  iLength = 0;
+
+    if (DEC_Main_Read(&iLength, sizeof(iLength)))
+    {
+        szText = (char *) UTIL_Malloc(iLength + 1);
+
+        if (szText && !DEC_Main_Read(szText, iLength))
+        {
+            UTIL_Free(szText);
+        }
+        else if (szText)
+        {
+            szText[iLength] = '\0';
+        }
+    }
+
+    return szText;
+}
+
+/*!
+ * \brief  Function to read a call site.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool DEC_Main_ReadSite(void)
+{
+    DEC_Site *pSite = NULL;
+    Uint32    iId   = 0;
+    Uint32    iLine = 0;
+
+    if (!DEC_Main_Read(&iId, sizeof(iId)) || !DEC_Main_Read(&iLine, sizeof(iLine)) || (iId != DEC_main.iNbSites + 1))
+    {
+        return SDL_FALSE;
+    }
+
+    DEC_main.pArrSites = (DEC_Site *) UTIL_Realloc(DEC_main.pArrSites, sizeof(DEC_Site) * iId);
+
+    if (!DEC_main.pArrSites)
+    {
+        return SDL_FALSE;
+    }
+
+    pSite           = &DEC_main.pArrSites[DEC_main.iNbSites++];
+    pSite->iLine    = iLine;
+    pSite->szFile   = DEC_Main_ReadString( );
+    pSite->szFormat = pSite->szFile ? DEC_Main_ReadString( ) : NULL;
+
+    return pSite->szFormat ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to get the bytes of the next argument of a message.
+ *
+ * \param  ppArg Pointer to the next argument (Moved after it).
+ * \param  pEnd  End of the arguments.
+ * \param  iSize Size of the argument.
+ * \param  pData Pointer to the output.
+ * \return SDL_TRUE on success, else SDL_FALSE (Arguments too short).
+ */
+static SDL_bool DEC_Main_Arg(const Uint8 **ppArg, const Uint8 *pEnd, size_t iSize, void *pData)
+{
+    if ((size_t) (pEnd - *ppArg) < iSize)
+    {
+        return SDL_FALSE;
+    }
+
+    memcpy(pData, *ppArg, iSize);
+    *ppArg += iSize;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to write a conversion of a format with its argument.
+ *
+ * \param  szSpec  Conversion (The '*' replaced by their value).
+ * \param  iType   Type of the argument (See COM_LogArg).
+ * \param  ppArg   Pointer to the argument (Moved after it).
+ * \param  pEnd    End of the arguments.
+ * \return SDL_TRUE on success, else SDL_FALSE (Arguments too short).
+ */
+static SDL_bool DEC_Main_WriteArg(const char *szSpec, unsigned char iType, const Uint8 **ppArg, const Uint8 *pEnd)
+{
+    char   szText[COM_LOG_MESSAGE_SIZE + 1];
+    int    iInt    = 0;
+    Sint64 iLong   = 0;
+    Uint64 iSize   = 0;
+    double fDouble = 0.0;
+    Uint16 iLength = 0;
+
+    switch (iType)
+    {
+        case COM_LOG_ARG_INT:
+            if (DEC_Main_Arg(ppArg, pEnd, 4, &iInt))
+            {
+                fprintf(DEC_main.pOut, szSpec, iInt);
+                return SDL_TRUE;
+            }
+            break;
+
+        case COM_LOG_ARG_LONG:
+            if (DEC_Main_Arg(ppArg, pEnd, 8, &iLong))
+            {
+                fprintf(DEC_main.pOut, szSpec, (long) iLong);
+                return SDL_TRUE;
+            }
+            break;
+
+        case COM_LOG_ARG_LLONG:
+            if (DEC_Main_Arg(ppArg, pEnd, 8, &iLong))
+            {
+                fprintf(DEC_main.pOut, szSpec, (long long) iLong);
+                return SDL_TRUE;
+            }
+            break;
+
+        case COM_LOG_ARG_SIZE:
+            if (DEC_Main_Arg(ppArg, pEnd, 8, &iSize))
+            {
+                fprintf(DEC_main.pOut, szSpec, (size_t) iSize);
+                return SDL_TRUE;
+            }
+            break;
+
+        case COM_LOG_ARG_POINTER:
+            if (DEC_Main_Arg(ppArg, pEnd, 8, &iSize))
+            {
+                fprintf(DEC_main.pOut, szSpec, (void *) (size_t) iSize);
+                return SDL_TRUE;
+            }
+            break;
+
+        case COM_LOG_ARG_DOUBLE:
+            if (DEC_Main_Arg(ppArg, pEnd, 8, &fDouble))
+            {
+                fprintf(DEC_main.pOut, szSpec, fDouble);
+                return SDL_TRUE;
+            }
+            break;
+
+        default:
+            if (DEC_Main_Arg(ppArg, pEnd, 2, &iLength) && (iLength <= COM_LOG_MESSAGE_SIZE) && DEC_Main_Arg(ppArg, pEnd, iLength, szText))
+            {
+                szText[iLength] = '\0';
+                fprintf(DEC_main.pOut, szSpec, szText);
+                return SDL_TRUE;
+            }
+            break;
+    }
+
+    return SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to write a message with the format of its call site.
+ *
+ * \param  szFormat Format of the call site.
+ * \param  pArgs    Raw arguments of the message.
+ * \param  iSize    Size of the arguments.
+ * \return SDL_TRUE on success, else SDL_FALSE (Arguments not matching the format).
+ */
+static SDL_bool DEC_Main_WriteMessage(const char *szFormat, const Uint8 *pArgs, Uint16 iSize)
+{
+    const Uint8   *pEnd      = pArgs + iSize;
+    const char    *pChar     = szFormat;
+    const char    *pSpecEnd  = NULL;
+    unsigned char  arrArgs[COM_LOG_MAX_ARGS];
+    int            iNbArgs   = 0;
+    char           szSpec[DEC_SPEC_MAX];
+    size_t         iSpecSize = 0;
+    int            iStar     = 0;
+    int            i         = 0;
+
+    while (*pChar)
+    {
+        if (*pChar != '%')
+        {
+            fputc(*pChar++, DEC_main.pOut);
+            continue;
+        }
+
+        iNbArgs  = 0;
+        pSpecEnd = COM_Log_ParseSpec(pChar, arrArgs, &iNbArgs);
+
+        if (!pSpecEnd)
+        {
+            return SDL_FALSE;
+        }
+
+        if (!iNbArgs)
+        {
+            fputc('%', DEC_main.pOut);
+            pChar = pSpecEnd;
+            continue;
+        }
+
+        /* ~~~ The '*' replaced by the width and the precision ~~~ */
+        iSpecSize = 0;
+
+        for (i = 0; pChar < pSpecEnd; pChar++)
+        {
+            if (iSpecSize + 16 >= DEC_SPEC_MAX)
+            {
+                return SDL_FALSE;
+            }
+
+            if (*pChar == '*')
+            {
+                if (!DEC_Main_Arg(&pArgs, pEnd, 4, &iStar))
+                {
+                    return SDL_FALSE;
+                }
+
+                iSpecSize += (size_t) snprintf(szSpec + iSpecSize, DEC_SPEC_MAX - iSpecSize, "%d", iStar);
+                i++;
+            }
+            else
+            {
+                szSpec[iSpecSize++] = *pChar;
+            }
+        }
+
+        szSpec[iSpecSize] = '\0';
+
+        if (!DEC_Main_WriteArg(szSpec, arrArgs[i], &pArgs, pEnd))
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to write the time and the prefix of a message.
+ *
+ * \param  iLevel Type of the message (See COM_LogType).
+ * \param  iTime  Timestamp of the message.
+ * \return SDL_TRUE on success, else SDL_FALSE (Unknown type).
+ */
+static SDL_bool DEC_Main_WritePrefix(Uint8 iLevel, Uint64 iTime)
+{
+    if (iLevel > COM_LOG_CRITICAL)
+    {
+        return SDL_FALSE;
+    }
+
+    if (!DEC_main.bStarted)
+    {
+        DEC_main.iStart   = iTime;
+        DEC_main.bStarted = SDL_TRUE;
+    }
+
+    fprintf(DEC_main.pOut, "[%12.6f] %s", (double) (iTime - DEC_main.iStart) / (double) DEC_main.iFrequency, DEC_szLogTxt[iLevel]);
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to decode the logs file.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool DEC_Main_Decode(void)
+{
+    Uint8      arrData[COM_LOG_MESSAGE_SIZE];
+    char       szMagic[4];
+    char       szTimeBuffer[128];
+    Uint32     iVersion = 0;
+    Uint64     iDate    = 0;
+    time_t     sTime;
+    Uint8      iKind    = 0;
+    Uint32     iId      = 0;
+    Uint8      iLevel   = 0;
+    Uint64     iTime    = 0;
+    Uint16     iSize    = 0;
+    Uint32     iValue   = 0;
+
+    if (!DEC_Main_Read(szMagic, 4) || memcmp(szMagic, COM_LOG_MAGIC, 4) || !DEC_Main_Read(&iVersion, sizeof(iVersion)) ||
+        (iVersion != COM_LOG_VERSION) || !DEC_Main_Read(&DEC_main.iFrequency, 8) || !DEC_Main_Read(&iDate, 8) || !DEC_main.iFrequency)
+    {
+        fprintf(stderr, "Not a binary logs file (Or not version %d).\n", COM_LOG_VERSION);
+        return SDL_FALSE;
+    }
+
+    sTime = (time_t) iDate;
+    strftime(szTimeBuffer, sizeof(szTimeBuffer), "%A %Y-%m-%d -- %H:%M:%S", localtime(&sTime));
+
+    fprintf(DEC_main.pOut, "***********************************************************************\n");
+    fprintf(DEC_main.pOut, "                    %s\n", szTimeBuffer);
+    fprintf(DEC_main.pOut, "***********************************************************************\n\n");
+
+    while (DEC_Main_Read(&iKind, sizeof(iKind)))
+    {
+        switch (iKind)
+        {
+            case COM_LOG_ENTRY_SITE:
+                if (!DEC_Main_ReadSite( ))
+                {
+                    fprintf(stderr, "Corrupted call site (Site %u).\n", DEC_main.iNbSites + 1);
+                    return SDL_FALSE;
+                }
+                break;
+
+            case COM_LOG_ENTRY_MESSAGE:
+            case COM_LOG_ENTRY_TEXT:
+                iId = 0;
+
+                if (((iKind == COM_LOG_ENTRY_MESSAGE) && !DEC_Main_Read(&iId, sizeof(iId))) || !DEC_Main_Read(&iLevel, sizeof(iLevel)) ||
+                    !DEC_Main_Read(&iTime, sizeof(iTime)) || !DEC_Main_Read(&iSize, sizeof(iSize)) || (iSize > COM_LOG_MESSAGE_SIZE) ||
+                    !DEC_Main_Read(arrData, iSize) || (iId > DEC_main.iNbSites) || !DEC_Main_WritePrefix(iLevel, iTime))
+                {
+                    fprintf(stderr, "Corrupted message.\n");
+                    return SDL_FALSE;
+                }
+
+                if (!iId)
+                {
+                    fwrite(arrData, 1, iSize, DEC_main.pOut);
+                }
+                else if (!DEC_Main_WriteMessage(DEC_main.pArrSites[iId - 1].szFormat, arrData, iSize))
+                {
+                    fprintf(DEC_main.pOut, " <Arguments not matching \"%s\" (%s l. %u)>",
+                            DEC_main.pArrSites[iId - 1].szFormat, DEC_main.pArrSites[iId - 1].szFile, DEC_main.pArrSites[iId - 1].iLine);
+                }
+
+                fputc('\n', DEC_main.pOut);
+                break;
+
+            case COM_LOG_ENTRY_DROPPED:
+            case COM_LOG_ENTRY_SIGNAL:
+                if (!DEC_Main_Read(&iValue, sizeof(iValue)))
+                {
+                    fprintf(stderr, "Corrupted entry.\n");
+                    return SDL_FALSE;
+                }
+
+                if (iKind == COM_LOG_ENTRY_DROPPED)
+                {
+                    fprintf(DEC_main.pOut, "%s%u messages dropped (Logs ring full)\n", DEC_szLogTxt[COM_LOG_WARNING], iValue);
+                }
+                else
+                {
+                    fprintf(DEC_main.pOut, "%sSignal %u received\n", DEC_szLogTxt[COM_LOG_CRITICAL], iValue);
+                }
+                break;
+
+            default:
+                fprintf(stderr, "Unknown entry %d.\n", iKind);
+                return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Main function of the decoder.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return EXIT_SUCCESS on success, else EXIT_FAILURE.
+ */
+int main(int argc, char *argv[])
+{
+    int    iResult = EXIT_FAILURE;
+    Uint32 i       = 0;
+
+    if ((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "Usage: decode <logs.blog> [<logs.log>] (The text is written on the standard output by default).\n");
+        return EXIT_FAILURE;
+    }
+
+    DEC_main.pIn  = fopen(argv[1], "rb");
+    DEC_main.pOut = (argc == 3) ? fopen(argv[2], "w") : stdout;
+
+    if (!DEC_main.pIn || !DEC_main.pOut)
+    {
+        fprintf(stderr, "Can't open \"%s\".\n", DEC_main.pIn ? argv[2] : argv[1]);
+    }
+    else if (DEC_Main_Decode( ))
+    {
+        iResult = EXIT_SUCCESS;
+    }
+
+    for (i = 0 ; i < DEC_main.iNbSites ; ++i)
+    {
+        UTIL_Free(DEC_main.pArrSites[i].szFile);
+        UTIL_Free(DEC_main.pArrSites[i].szFormat);
+    }
+
+    UTIL_Free(DEC_main.pArrSites);
+
+    if (DEC_main.pIn)
+    {
+        fclose(DEC_main.pIn);
+    }
+
+    if (DEC_main.pOut && (DEC_main.pOut != stdout))
+    {
+        fclose(DEC_main.pOut);
+    }
+
+    return iResult;
+}
+
+/* ========================================================================= */
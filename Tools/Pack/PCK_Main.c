@@ -0,0 +1,410 @@
+/* ========================================================================= */
+/*!
+ * \file    PCK_Main.c
+ * \brief   File to build a pack of the assets.
+ * \author  Nyuu / Orlyn / Red
+ * \version 1.0
+ * \date    18 October 2026
+ *
+ * Build it with 'Sources/SDL_Pack.c' and the 'COM' files, and run it from
+ * 'Other/Ressources' with the files to pack, given as arguments or as a
+ * list on the standard input ('-'):
+ *
+ *     find sprites sounds musics fonts -type f | pack --out data.pak -
+ *
+ * The paths are stored as given, with '/', and looked up the same way by
+ * UTIL_RWOpen once the pack is mounted (See SDL_Pack.h for the format).
+ */
+/* ========================================================================= */
+/* Author  | Date     | Comments                                             */
+/* --------+----------+----------------------------------------------------- */
+/* Nyuu    | 18/10/26 | Creation.                                            */
+/* Nyuu    | 18/10/26 | Check the allocations and the writes of the pack.    */
+/* ========================================================================= */
+
+#include "SDL_Pack.h"
+
+/* ========================================================================= */
+
+/*! Maximum length of a path read on the standard input. */
+#define PCK_PATH_MAX 1024
+
+/*!
+ * \struct PCK_File
+ * \brief  Structure to handle a file to pack.
+ */
+typedef struct
+{
+    char   *szPath;  /*!< Path of the file, as stored in the pack. */
+    Uint32  iHash;   /*!< Hash of the path. */
+    Uint32  iSize;   /*!< Size of the file (In bytes). */
+    Uint32  iOffset; /*!< Offset of the data in the pack. */
+} PCK_File;
+
+/*!
+ * \struct PCK_Main
+ * \brief  Structure to handle the packer.
+ */
+typedef struct
+{
+    PCK_File   *pArrFiles; /*!< Array of the files to pack. */
+    Uint32      iNbFiles;  /*!< Number of files to pack. */
+    Uint32      iMaxFiles; /*!< Capacity of the array of files. */
+    const char *szOut;     /*!< Path of the pack. */
+} PCK_Main;
+
+/*! Global variable to handle the packer. */
+static PCK_Main PCK_main;
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Function to add a file to pack.
+ *
+ * \param  szPath Path of the file.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_AddFile(const char *szPath)
+{
+    PCK_File *pArrFiles = NULL;
+    PCK_File *pFile     = NULL;
+    char     *pChar     = NULL;
+    Uint32    iNewMax   = 0;
+
+    if (PCK_main.iNbFiles == PCK_main.iMaxFiles)
+    {
+        iNewMax   = PCK_main.iMaxFiles ? (PCK_main.iMaxFiles * 2) : 256;
+        pArrFiles = (PCK_File *) UTIL_Realloc(PCK_main.pArrFiles, sizeof(PCK_File) * iNewMax);
+
+        if (!pArrFiles)
+        {
+            fprintf(stderr, "Not enough memory for %u files.\n", iNewMax);
+            return SDL_FALSE;
+        }
+
+        PCK_main.pArrFiles = pArrFiles;
+        PCK_main.iMaxFiles = iNewMax;
+    }
+
+    /* ~~~ Stored with '/' and without "./" ~~~ */
+    while ((szPath[0] == '.') && ((szPath[1] == '/') || (szPath[1] == '\\')))
+    {
+        szPath += 2;
+    }
+
+    pFile         = &PCK_main.pArrFiles[PCK_main.iNbFiles];
+    pFile->szPath = UTIL_StrCopy(szPath);
+
+    if (!pFile->szPath)
+    {
+        return SDL_FALSE;
+    }
+
+    for (pChar = pFile->szPath ; *pChar ; ++pChar)
+    {
+        *pChar = (*pChar == '\\') ? '/' : *pChar;
+    }
+
+    pFile->iHash   = SDL_Pack_Hash(pFile->szPath);
+    pFile->iSize   = 0;
+    pFile->iOffset = 0;
+
+    PCK_main.iNbFiles++;
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to read the files to pack on the standard input.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_ReadList(void)
+{
+    char   szLine[PCK_PATH_MAX];
+    size_t iLength = 0;
+
+    while (fgets(szLine, sizeof(szLine), stdin))
+    {
+        iLength = strlen(szLine);
+
+        while (iLength && ((szLine[iLength - 1] == '\n') || (szLine[iLength - 1] == '\r')))
+        {
+            szLine[--iLength] = '\0';
+        }
+
+        if (iLength && !PCK_Main_AddFile(szLine))
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to parse the arguments.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_ParseArgs(int argc, char *argv[])
+{
+    int i = 0;
+
+    PCK_main.szOut = NULL;
+
+    for (i = 1 ; i < argc ; ++i)
+    {
+        if (strcmp(argv[i], "--out") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Missing value for option \"%s\".\n", argv[i]);
+                return SDL_FALSE;
+            }
+
+            PCK_main.szOut = argv[++i];
+        }
+        else if (strcmp(argv[i], "-") == 0)
+        {
+            if (!PCK_Main_ReadList( ))
+            {
+                return SDL_FALSE;
+            }
+        }
+        else if (!PCK_Main_AddFile(argv[i]))
+        {
+            return SDL_FALSE;
+        }
+    }
+
+    if (!PCK_main.szOut || !PCK_main.iNbFiles)
+    {
+        fprintf(stderr, "Usage: pack --out <pack> <files...> (Or '-' to read the files on the standard input).\n");
+        return SDL_FALSE;
+    }
+
+    return SDL_TRUE;
+}
+
+/*!
+ * \brief  Function to compare two files, in the order of the index.
+ *
+ * \param  pA Pointer to the first file.
+ * \param  pB Pointer to the second file.
+ * \return Less than 0, 0 or more than 0 (See SDL_Pack_Compare).
+ */
+static int PCK_Main_CompareFiles(const void *pA, const void *pB)
+{
+    const PCK_File *pFileA = (const PCK_File *) pA;
+    const PCK_File *pFileB = (const PCK_File *) pB;
+
+    return SDL_Pack_Compare(pFileA->iHash, pFileA->szPath, pFileB->iHash, pFileB->szPath);
+}
+
+/*!
+ * \brief  Function to write data in the pack.
+ *
+ * \param  pPack Pointer to the pack.
+ * \param  pData Pointer to the data.
+ * \param  iSize Size of the data (In bytes).
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_WriteData(FILE *pPack, const void *pData, size_t iSize)
+{
+    return (fwrite(pData, 1, iSize, pPack) == iSize) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to copy a file in the pack.
+ *
+ * \param  pPack Pointer to the pack.
+ * \param  pFile Pointer to the file (Its size is checked again).
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_CopyFile(FILE *pPack, const PCK_File *pFile)
+{
+    char    arrBuffer[64 * 1024];
+    FILE   *pInput  = fopen(pFile->szPath, "rb");
+    size_t  iRead   = 0;
+    Uint32  iCopied = 0;
+
+    if (!pInput)
+    {
+        return SDL_FALSE;
+    }
+
+    while ((iRead = fread(arrBuffer, 1, sizeof(arrBuffer), pInput)) > 0)
+    {
+        if (fwrite(arrBuffer, 1, iRead, pPack) != iRead)
+        {
+            break;
+        }
+
+        iCopied += (Uint32) iRead;
+    }
+
+    fclose(pInput);
+
+    return (iCopied == pFile->iSize) ? SDL_TRUE : SDL_FALSE;
+}
+
+/*!
+ * \brief  Function to write the pack.
+ *
+ * \return SDL_TRUE on success, else SDL_FALSE.
+ */
+static SDL_bool PCK_Main_Write(void)
+{
+    static const char arrZeros[SDL_PACK_ALIGN] = { 0 };
+    SDL_PackHeader    sHeader;
+    SDL_PackEntry     sEntry;
+    PCK_File         *pFile   = NULL;
+    FILE             *pPack   = NULL;
+    FILE             *pInput  = NULL;
+    SDL_bool          bOk     = SDL_TRUE;
+    Uint64            iOffset = 0;
+    Uint32            iPaths  = 0;
+    Uint32            i       = 0;
+
+    qsort(PCK_main.pArrFiles, PCK_main.iNbFiles, sizeof(PCK_File), PCK_Main_CompareFiles);
+
+    /* ~~~ Layout: header, index, paths, then the aligned data ~~~ */
+    for (i = 0 ; i < PCK_main.iNbFiles ; ++i)
+    {
+        pFile = &PCK_main.pArrFiles[i];
+
+        if ((i > 0) && (PCK_Main_CompareFiles(pFile - 1, pFile) == 0))
+        {
+            fprintf(stderr, "File given twice \"%s\".\n", pFile->szPath);
+            return SDL_FALSE;
+        }
+
+        pInput = fopen(pFile->szPath, "rb");
+
+        if (!pInput || fseek(pInput, 0, SEEK_END) || (ftell(pInput) < 0))
+        {
+            fprintf(stderr, "Can't read the file \"%s\".\n", pFile->szPath);
+
+            if (pInput)
+            {
+                fclose(pInput);
+            }
+
+            return SDL_FALSE;
+        }
+
+        pFile->iSize = (Uint32) ftell(pInput);
+        fclose(pInput);
+
+        iPaths += (Uint32) strlen(pFile->szPath) + 1;
+    }
+
+    iOffset = sizeof(SDL_PackHeader) + (Uint64) PCK_main.iNbFiles * sizeof(SDL_PackEntry) + iPaths;
+
+    for (i = 0 ; i < PCK_main.iNbFiles ; ++i)
+    {
+        iOffset                        = (iOffset + SDL_PACK_ALIGN - 1) & ~((Uint64) SDL_PACK_ALIGN - 1);
+        PCK_main.pArrFiles[i].iOffset  = (Uint32) iOffset;
+        iOffset                       += PCK_main.pArrFiles[i].iSize;
+    }
+
+    if (iOffset > 0xFFFFFFFF)
+    {
+        fprintf(stderr, "The pack would exceed 4 GB.\n");
+        return SDL_FALSE;
+    }
+
+    pPack = UTIL_FileOpen(PCK_main.szOut, "wb");
+
+    if (!pPack)
+    {
+        fprintf(stderr, "Can't write the pack \"%s\".\n", PCK_main.szOut);
+        return SDL_FALSE;
+    }
+
+    memcpy(sHeader.arrMagic, SDL_PACK_MAGIC, sizeof(sHeader.arrMagic));
+    sHeader.iVersion   = SDL_PACK_VERSION;
+    sHeader.iNbEntries = PCK_main.iNbFiles;
+    sHeader.iPathsSize = iPaths;
+
+    bOk = PCK_Main_WriteData(pPack, &sHeader, sizeof(SDL_PackHeader));
+
+    for (i = 0, iPaths = 0 ; (i < PCK_main.iNbFiles) && bOk ; ++i)
+    {
+        pFile          = &PCK_main.pArrFiles[i];
+        sEntry.iHash   = pFile->iHash;
+        sEntry.iPath   = iPaths;
+        sEntry.iOffset = pFile->iOffset;
+        sEntry.iSize   = pFile->iSize;
+        iPaths        += (Uint32) strlen(pFile->szPath) + 1;
+
+        bOk = PCK_Main_WriteData(pPack, &sEntry, sizeof(SDL_PackEntry));
+    }
+
+    for (i = 0 ; (i < PCK_main.iNbFiles) && bOk ; ++i)
+    {
+        bOk = PCK_Main_WriteData(pPack, PCK_main.pArrFiles[i].szPath, strlen(PCK_main.pArrFiles[i].szPath) + 1);
+    }
+
+    for (i = 0 ; (i < PCK_main.iNbFiles) && bOk ; ++i)
+    {
+        pFile = &PCK_main.pArrFiles[i];
+        bOk   = PCK_Main_WriteData(pPack, arrZeros, pFile->iOffset - (Uint32) ftell(pPack));
+
+        if (bOk && !PCK_Main_CopyFile(pPack, pFile))
+        {
+            fprintf(stderr, "Can't copy the file \"%s\".\n", pFile->szPath);
+            UTIL_FileClose(&pPack);
+            return SDL_FALSE;
+        }
+    }
+
+    /* ~~~ The buffered data may still fail to be written ~~~ */
+    bOk     = (bOk && (fflush(pPack) == 0) && !ferror(pPack)) ? SDL_TRUE : SDL_FALSE;
+    iOffset = (Uint64) ftell(pPack);
+    UTIL_FileClose(&pPack);
+
+    if (!bOk)
+    {
+        fprintf(stderr, "Can't write the pack \"%s\".\n", PCK_main.szOut);
+        return SDL_FALSE;
+    }
+
+    fprintf(stdout, "%s: %u files, %u KB.\n", PCK_main.szOut, PCK_main.iNbFiles, (Uint32) (iOffset >> 10));
+
+    return SDL_TRUE;
+}
+
+/* ========================================================================= */
+
+/*!
+ * \brief  Entry point of the packer.
+ *
+ * \param  argc Number of arguments.
+ * \param  argv Array of arguments.
+ * \return EXIT_SUCCESS on success, else EXIT_FAILURE.
+ */
+int main(int argc, char *argv[])
+{
+    int    iResult = EXIT_FAILURE;
+    Uint32 i       = 0;
+
+    if (PCK_Main_ParseArgs(argc, argv) && PCK_Main_Write( ))
+    {
+        iResult = EXIT_SUCCESS;
+    }
+
+    for (i = 0 ; i < PCK_main.iNbFiles ; ++i)
+    {
+        UTIL_Free(PCK_main.pArrFiles[i].szPath);
+    }
+
+    UTIL_Free(PCK_main.pArrFiles);
+
+    return iResult;
+}
+
+/* ========================================================================= */